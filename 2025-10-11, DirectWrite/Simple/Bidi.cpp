@@ -0,0 +1,946 @@
+#include "Bidi.h"
+
+#include <algorithm>
+
+#include "Shaper.h"
+#include "UnicodeTable.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define BIDI_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    using BC = BidiClass;
+
+    struct BracketPair
+    {
+        char32_t open;
+        char32_t close;
+    };
+
+    // Generated from the Unicode 14.0 UCD (DerivedBidiClass.txt, BidiBrackets.txt). L is left
+    // out, it is the default value.
+    const PropertyRange<BC> BidiClassRanges[] =
+    {
+        { 0x0000, 0x0008, BC::BN }, { 0x0009, 0x0009, BC::S }, { 0x000A, 0x000A, BC::B },
+        { 0x000B, 0x000B, BC::S }, { 0x000C, 0x000C, BC::WS }, { 0x000D, 0x000D, BC::B },
+        { 0x000E, 0x001B, BC::BN }, { 0x001C, 0x001E, BC::B }, { 0x001F, 0x001F, BC::S },
+        { 0x0020, 0x0020, BC::WS }, { 0x0021, 0x0022, BC::ON }, { 0x0023, 0x0025, BC::ET },
+        { 0x0026, 0x002A, BC::ON }, { 0x002B, 0x002B, BC::ES }, { 0x002C, 0x002C, BC::CS },
+        { 0x002D, 0x002D, BC::ES }, { 0x002E, 0x002F, BC::CS }, { 0x0030, 0x0039, BC::EN },
+        { 0x003A, 0x003A, BC::CS }, { 0x003B, 0x0040, BC::ON }, { 0x005B, 0x0060, BC::ON },
+        { 0x007B, 0x007E, BC::ON }, { 0x007F, 0x0084, BC::BN }, { 0x0085, 0x0085, BC::B },
+        { 0x0086, 0x009F, BC::BN }, { 0x00A0, 0x00A0, BC::CS }, { 0x00A1, 0x00A1, BC::ON },
+        { 0x00A2, 0x00A5, BC::ET }, { 0x00A6, 0x00A9, BC::ON }, { 0x00AB, 0x00AC, BC::ON },
+        { 0x00AD, 0x00AD, BC::BN }, { 0x00AE, 0x00AF, BC::ON }, { 0x00B0, 0x00B1, BC::ET },
+        { 0x00B2, 0x00B3, BC::EN }, { 0x00B4, 0x00B4, BC::ON }, { 0x00B6, 0x00B8, BC::ON },
+        { 0x00B9, 0x00B9, BC::EN }, { 0x00BB, 0x00BF, BC::ON }, { 0x00D7, 0x00D7, BC::ON },
+        { 0x00F7, 0x00F7, BC::ON }, { 0x02B9, 0x02BA, BC::ON }, { 0x02C2, 0x02CF, BC::ON },
+        { 0x02D2, 0x02DF, BC::ON }, { 0x02E5, 0x02ED, BC::ON }, { 0x02EF, 0x02FF, BC::ON },
+        { 0x0300, 0x036F, BC::NSM }, { 0x0374, 0x0375, BC::ON }, { 0x037E, 0x037E, BC::ON },
+        { 0x0384, 0x0385, BC::ON }, { 0x0387, 0x0387, BC::ON }, { 0x03F6, 0x03F6, BC::ON },
+        { 0x0483, 0x0489, BC::NSM }, { 0x058A, 0x058A, BC::ON }, { 0x058D, 0x058E, BC::ON },
+        { 0x058F, 0x058F, BC::ET }, { 0x0590, 0x0590, BC::R }, { 0x0591, 0x05BD, BC::NSM },
+        { 0x05BE, 0x05BE, BC::R }, { 0x05BF, 0x05BF, BC::NSM }, { 0x05C0, 0x05C0, BC::R },
+        { 0x05C1, 0x05C2, BC::NSM }, { 0x05C3, 0x05C3, BC::R }, { 0x05C4, 0x05C5, BC::NSM },
+        { 0x05C6, 0x05C6, BC::R }, { 0x05C7, 0x05C7, BC::NSM }, { 0x05C8, 0x05FF, BC::R },
+        { 0x0600, 0x0605, BC::AN }, { 0x0606, 0x0607, BC::ON }, { 0x0608, 0x0608, BC::AL },
+        { 0x0609, 0x060A, BC::ET }, { 0x060B, 0x060B, BC::AL }, { 0x060C, 0x060C, BC::CS },
+        { 0x060D, 0x060D, BC::AL }, { 0x060E, 0x060F, BC::ON }, { 0x0610, 0x061A, BC::NSM },
+        { 0x061B, 0x064A, BC::AL }, { 0x064B, 0x065F, BC::NSM }, { 0x0660, 0x0669, BC::AN },
+        { 0x066A, 0x066A, BC::ET }, { 0x066B, 0x066C, BC::AN }, { 0x066D, 0x066F, BC::AL },
+        { 0x0670, 0x0670, BC::NSM }, { 0x0671, 0x06D5, BC::AL }, { 0x06D6, 0x06DC, BC::NSM },
+        { 0x06DD, 0x06DD, BC::AN }, { 0x06DE, 0x06DE, BC::ON }, { 0x06DF, 0x06E4, BC::NSM },
+        { 0x06E5, 0x06E6, BC::AL }, { 0x06E7, 0x06E8, BC::NSM }, { 0x06E9, 0x06E9, BC::ON },
+        { 0x06EA, 0x06ED, BC::NSM }, { 0x06EE, 0x06EF, BC::AL }, { 0x06F0, 0x06F9, BC::EN },
+        { 0x06FA, 0x0710, BC::AL }, { 0x0711, 0x0711, BC::NSM }, { 0x0712, 0x072F, BC::AL },
+        { 0x0730, 0x074A, BC::NSM }, { 0x074B, 0x07A5, BC::AL }, { 0x07A6, 0x07B0, BC::NSM },
+        { 0x07B1, 0x07BF, BC::AL }, { 0x07C0, 0x07EA, BC::R }, { 0x07EB, 0x07F3, BC::NSM },
+        { 0x07F4, 0x07F5, BC::R }, { 0x07F6, 0x07F9, BC::ON }, { 0x07FA, 0x07FC, BC::R },
+        { 0x07FD, 0x07FD, BC::NSM }, { 0x07FE, 0x0815, BC::R }, { 0x0816, 0x0819, BC::NSM },
+        { 0x081A, 0x081A, BC::R }, { 0x081B, 0x0823, BC::NSM }, { 0x0824, 0x0824, BC::R },
+        { 0x0825, 0x0827, BC::NSM }, { 0x0828, 0x0828, BC::R }, { 0x0829, 0x082D, BC::NSM },
+        { 0x082E, 0x0858, BC::R }, { 0x0859, 0x085B, BC::NSM }, { 0x085C, 0x085F, BC::R },
+        { 0x0860, 0x088F, BC::AL }, { 0x0890, 0x0891, BC::AN }, { 0x0892, 0x0897, BC::AL },
+        { 0x0898, 0x089F, BC::NSM }, { 0x08A0, 0x08C9, BC::AL }, { 0x08CA, 0x08E1, BC::NSM },
+        { 0x08E2, 0x08E2, BC::AN }, { 0x08E3, 0x0902, BC::NSM }, { 0x093A, 0x093A, BC::NSM },
+        { 0x093C, 0x093C, BC::NSM }, { 0x0941, 0x0948, BC::NSM }, { 0x094D, 0x094D, BC::NSM },
+        { 0x0951, 0x0957, BC::NSM }, { 0x0962, 0x0963, BC::NSM }, { 0x0981, 0x0981, BC::NSM },
+        { 0x09BC, 0x09BC, BC::NSM }, { 0x09C1, 0x09C4, BC::NSM }, { 0x09CD, 0x09CD, BC::NSM },
+        { 0x09E2, 0x09E3, BC::NSM }, { 0x09F2, 0x09F3, BC::ET }, { 0x09FB, 0x09FB, BC::ET },
+        { 0x09FE, 0x09FE, BC::NSM }, { 0x0A01, 0x0A02, BC::NSM }, { 0x0A3C, 0x0A3C, BC::NSM },
+        { 0x0A41, 0x0A42, BC::NSM }, { 0x0A47, 0x0A48, BC::NSM }, { 0x0A4B, 0x0A4D, BC::NSM },
+        { 0x0A51, 0x0A51, BC::NSM }, { 0x0A70, 0x0A71, BC::NSM }, { 0x0A75, 0x0A75, BC::NSM },
+        { 0x0A81, 0x0A82, BC::NSM }, { 0x0ABC, 0x0ABC, BC::NSM }, { 0x0AC1, 0x0AC5, BC::NSM },
+        { 0x0AC7, 0x0AC8, BC::NSM }, { 0x0ACD, 0x0ACD, BC::NSM }, { 0x0AE2, 0x0AE3, BC::NSM },
+        { 0x0AF1, 0x0AF1, BC::ET }, { 0x0AFA, 0x0AFF, BC::NSM }, { 0x0B01, 0x0B01, BC::NSM },
+        { 0x0B3C, 0x0B3C, BC::NSM }, { 0x0B3F, 0x0B3F, BC::NSM }, { 0x0B41, 0x0B44, BC::NSM },
+        { 0x0B4D, 0x0B4D, BC::NSM }, { 0x0B55, 0x0B56, BC::NSM }, { 0x0B62, 0x0B63, BC::NSM },
+        { 0x0B82, 0x0B82, BC::NSM }, { 0x0BC0, 0x0BC0, BC::NSM }, { 0x0BCD, 0x0BCD, BC::NSM },
+        { 0x0BF3, 0x0BF8, BC::ON }, { 0x0BF9, 0x0BF9, BC::ET }, { 0x0BFA, 0x0BFA, BC::ON },
+        { 0x0C00, 0x0C00, BC::NSM }, { 0x0C04, 0x0C04, BC::NSM }, { 0x0C3C, 0x0C3C, BC::NSM },
+        { 0x0C3E, 0x0C40, BC::NSM }, { 0x0C46, 0x0C48, BC::NSM }, { 0x0C4A, 0x0C4D, BC::NSM },
+        { 0x0C55, 0x0C56, BC::NSM }, { 0x0C62, 0x0C63, BC::NSM }, { 0x0C78, 0x0C7E, BC::ON },
+        { 0x0C81, 0x0C81, BC::NSM }, { 0x0CBC, 0x0CBC, BC::NSM }, { 0x0CCC, 0x0CCD, BC::NSM },
+        { 0x0CE2, 0x0CE3, BC::NSM }, { 0x0D00, 0x0D01, BC::NSM }, { 0x0D3B, 0x0D3C, BC::NSM },
+        { 0x0D41, 0x0D44, BC::NSM }, { 0x0D4D, 0x0D4D, BC::NSM }, { 0x0D62, 0x0D63, BC::NSM },
+        { 0x0D81, 0x0D81, BC::NSM }, { 0x0DCA, 0x0DCA, BC::NSM }, { 0x0DD2, 0x0DD4, BC::NSM },
+        { 0x0DD6, 0x0DD6, BC::NSM }, { 0x0E31, 0x0E31, BC::NSM }, { 0x0E34, 0x0E3A, BC::NSM },
+        { 0x0E3F, 0x0E3F, BC::ET }, { 0x0E47, 0x0E4E, BC::NSM }, { 0x0EB1, 0x0EB1, BC::NSM },
+        { 0x0EB4, 0x0EBC, BC::NSM }, { 0x0EC8, 0x0ECD, BC::NSM }, { 0x0F18, 0x0F19, BC::NSM },
+        { 0x0F35, 0x0F35, BC::NSM }, { 0x0F37, 0x0F37, BC::NSM }, { 0x0F39, 0x0F39, BC::NSM },
+        { 0x0F3A, 0x0F3D, BC::ON }, { 0x0F71, 0x0F7E, BC::NSM }, { 0x0F80, 0x0F84, BC::NSM },
+        { 0x0F86, 0x0F87, BC::NSM }, { 0x0F8D, 0x0F97, BC::NSM }, { 0x0F99, 0x0FBC, BC::NSM },
+        { 0x0FC6, 0x0FC6, BC::NSM }, { 0x102D, 0x1030, BC::NSM }, { 0x1032, 0x1037, BC::NSM },
+        { 0x1039, 0x103A, BC::NSM }, { 0x103D, 0x103E, BC::NSM }, { 0x1058, 0x1059, BC::NSM },
+        { 0x105E, 0x1060, BC::NSM }, { 0x1071, 0x1074, BC::NSM }, { 0x1082, 0x1082, BC::NSM },
+        { 0x1085, 0x1086, BC::NSM }, { 0x108D, 0x108D, BC::NSM }, { 0x109D, 0x109D, BC::NSM },
+        { 0x135D, 0x135F, BC::NSM }, { 0x1390, 0x1399, BC::ON }, { 0x1400, 0x1400, BC::ON },
+        { 0x1680, 0x1680, BC::WS }, { 0x169B, 0x169C, BC::ON }, { 0x1712, 0x1714, BC::NSM },
+        { 0x1732, 0x1733, BC::NSM }, { 0x1752, 0x1753, BC::NSM }, { 0x1772, 0x1773, BC::NSM },
+        { 0x17B4, 0x17B5, BC::NSM }, { 0x17B7, 0x17BD, BC::NSM }, { 0x17C6, 0x17C6, BC::NSM },
+        { 0x17C9, 0x17D3, BC::NSM }, { 0x17DB, 0x17DB, BC::ET }, { 0x17DD, 0x17DD, BC::NSM },
+        { 0x17F0, 0x17F9, BC::ON }, { 0x1800, 0x180A, BC::ON }, { 0x180B, 0x180D, BC::NSM },
+        { 0x180E, 0x180E, BC::BN }, { 0x180F, 0x180F, BC::NSM }, { 0x1885, 0x1886, BC::NSM },
+        { 0x18A9, 0x18A9, BC::NSM }, { 0x1920, 0x1922, BC::NSM }, { 0x1927, 0x1928, BC::NSM },
+        { 0x1932, 0x1932, BC::NSM }, { 0x1939, 0x193B, BC::NSM }, { 0x1940, 0x1940, BC::ON },
+        { 0x1944, 0x1945, BC::ON }, { 0x19DE, 0x19FF, BC::ON }, { 0x1A17, 0x1A18, BC::NSM },
+        { 0x1A1B, 0x1A1B, BC::NSM }, { 0x1A56, 0x1A56, BC::NSM }, { 0x1A58, 0x1A5E, BC::NSM },
+        { 0x1A60, 0x1A60, BC::NSM }, { 0x1A62, 0x1A62, BC::NSM }, { 0x1A65, 0x1A6C, BC::NSM },
+        { 0x1A73, 0x1A7C, BC::NSM }, { 0x1A7F, 0x1A7F, BC::NSM }, { 0x1AB0, 0x1ACE, BC::NSM },
+        { 0x1B00, 0x1B03, BC::NSM }, { 0x1B34, 0x1B34, BC::NSM }, { 0x1B36, 0x1B3A, BC::NSM },
+        { 0x1B3C, 0x1B3C, BC::NSM }, { 0x1B42, 0x1B42, BC::NSM }, { 0x1B6B, 0x1B73, BC::NSM },
+        { 0x1B80, 0x1B81, BC::NSM }, { 0x1BA2, 0x1BA5, BC::NSM }, { 0x1BA8, 0x1BA9, BC::NSM },
+        { 0x1BAB, 0x1BAD, BC::NSM }, { 0x1BE6, 0x1BE6, BC::NSM }, { 0x1BE8, 0x1BE9, BC::NSM },
+        { 0x1BED, 0x1BED, BC::NSM }, { 0x1BEF, 0x1BF1, BC::NSM }, { 0x1C2C, 0x1C33, BC::NSM },
+        { 0x1C36, 0x1C37, BC::NSM }, { 0x1CD0, 0x1CD2, BC::NSM }, { 0x1CD4, 0x1CE0, BC::NSM },
+        { 0x1CE2, 0x1CE8, BC::NSM }, { 0x1CED, 0x1CED, BC::NSM }, { 0x1CF4, 0x1CF4, BC::NSM },
+        { 0x1CF8, 0x1CF9, BC::NSM }, { 0x1DC0, 0x1DFF, BC::NSM }, { 0x1FBD, 0x1FBD, BC::ON },
+        { 0x1FBF, 0x1FC1, BC::ON }, { 0x1FCD, 0x1FCF, BC::ON }, { 0x1FDD, 0x1FDF, BC::ON },
+        { 0x1FED, 0x1FEF, BC::ON }, { 0x1FFD, 0x1FFE, BC::ON }, { 0x2000, 0x200A, BC::WS },
+        { 0x200B, 0x200D, BC::BN }, { 0x200F, 0x200F, BC::R }, { 0x2010, 0x2027, BC::ON },
+        { 0x2028, 0x2028, BC::WS }, { 0x2029, 0x2029, BC::B }, { 0x202A, 0x202A, BC::LRE },
+        { 0x202B, 0x202B, BC::RLE }, { 0x202C, 0x202C, BC::PDF }, { 0x202D, 0x202D, BC::LRO },
+        { 0x202E, 0x202E, BC::RLO }, { 0x202F, 0x202F, BC::CS }, { 0x2030, 0x2034, BC::ET },
+        { 0x2035, 0x2043, BC::ON }, { 0x2044, 0x2044, BC::CS }, { 0x2045, 0x205E, BC::ON },
+        { 0x205F, 0x205F, BC::WS }, { 0x2060, 0x2065, BC::BN }, { 0x2066, 0x2066, BC::LRI },
+        { 0x2067, 0x2067, BC::RLI }, { 0x2068, 0x2068, BC::FSI }, { 0x2069, 0x2069, BC::PDI },
+        { 0x206A, 0x206F, BC::BN }, { 0x2070, 0x2070, BC::EN }, { 0x2074, 0x2079, BC::EN },
+        { 0x207A, 0x207B, BC::ES }, { 0x207C, 0x207E, BC::ON }, { 0x2080, 0x2089, BC::EN },
+        { 0x208A, 0x208B, BC::ES }, { 0x208C, 0x208E, BC::ON }, { 0x20A0, 0x20CF, BC::ET },
+        { 0x20D0, 0x20F0, BC::NSM }, { 0x2100, 0x2101, BC::ON }, { 0x2103, 0x2106, BC::ON },
+        { 0x2108, 0x2109, BC::ON }, { 0x2114, 0x2114, BC::ON }, { 0x2116, 0x2118, BC::ON },
+        { 0x211E, 0x2123, BC::ON }, { 0x2125, 0x2125, BC::ON }, { 0x2127, 0x2127, BC::ON },
+        { 0x2129, 0x2129, BC::ON }, { 0x212E, 0x212E, BC::ET }, { 0x213A, 0x213B, BC::ON },
+        { 0x2140, 0x2144, BC::ON }, { 0x214A, 0x214D, BC::ON }, { 0x2150, 0x215F, BC::ON },
+        { 0x2189, 0x218B, BC::ON }, { 0x2190, 0x2211, BC::ON }, { 0x2212, 0x2212, BC::ES },
+        { 0x2213, 0x2213, BC::ET }, { 0x2214, 0x2335, BC::ON }, { 0x237B, 0x2394, BC::ON },
+        { 0x2396, 0x2426, BC::ON }, { 0x2440, 0x244A, BC::ON }, { 0x2460, 0x2487, BC::ON },
+        { 0x2488, 0x249B, BC::EN }, { 0x24EA, 0x26AB, BC::ON }, { 0x26AD, 0x27FF, BC::ON },
+        { 0x2900, 0x2B73, BC::ON }, { 0x2B76, 0x2B95, BC::ON }, { 0x2B97, 0x2BFF, BC::ON },
+        { 0x2CE5, 0x2CEA, BC::ON }, { 0x2CEF, 0x2CF1, BC::NSM }, { 0x2CF9, 0x2CFF, BC::ON },
+        { 0x2D7F, 0x2D7F, BC::NSM }, { 0x2DE0, 0x2DFF, BC::NSM }, { 0x2E00, 0x2E5D, BC::ON },
+        { 0x2E80, 0x2E99, BC::ON }, { 0x2E9B, 0x2EF3, BC::ON }, { 0x2F00, 0x2FD5, BC::ON },
+        { 0x2FF0, 0x2FFB, BC::ON }, { 0x3000, 0x3000, BC::WS }, { 0x3001, 0x3004, BC::ON },
+        { 0x3008, 0x3020, BC::ON }, { 0x302A, 0x302D, BC::NSM }, { 0x3030, 0x3030, BC::ON },
+        { 0x3036, 0x3037, BC::ON }, { 0x303D, 0x303F, BC::ON }, { 0x3099, 0x309A, BC::NSM },
+        { 0x309B, 0x309C, BC::ON }, { 0x30A0, 0x30A0, BC::ON }, { 0x30FB, 0x30FB, BC::ON },
+        { 0x31C0, 0x31E3, BC::ON }, { 0x321D, 0x321E, BC::ON }, { 0x3250, 0x325F, BC::ON },
+        { 0x327C, 0x327E, BC::ON }, { 0x32B1, 0x32BF, BC::ON }, { 0x32CC, 0x32CF, BC::ON },
+        { 0x3377, 0x337A, BC::ON }, { 0x33DE, 0x33DF, BC::ON }, { 0x33FF, 0x33FF, BC::ON },
+        { 0x4DC0, 0x4DFF, BC::ON }, { 0xA490, 0xA4C6, BC::ON }, { 0xA60D, 0xA60F, BC::ON },
+        { 0xA66F, 0xA672, BC::NSM }, { 0xA673, 0xA673, BC::ON }, { 0xA674, 0xA67D, BC::NSM },
+        { 0xA67E, 0xA67F, BC::ON }, { 0xA69E, 0xA69F, BC::NSM }, { 0xA6F0, 0xA6F1, BC::NSM },
+        { 0xA700, 0xA721, BC::ON }, { 0xA788, 0xA788, BC::ON }, { 0xA802, 0xA802, BC::NSM },
+        { 0xA806, 0xA806, BC::NSM }, { 0xA80B, 0xA80B, BC::NSM }, { 0xA825, 0xA826, BC::NSM },
+        { 0xA828, 0xA82B, BC::ON }, { 0xA82C, 0xA82C, BC::NSM }, { 0xA838, 0xA839, BC::ET },
+        { 0xA874, 0xA877, BC::ON }, { 0xA8C4, 0xA8C5, BC::NSM }, { 0xA8E0, 0xA8F1, BC::NSM },
+        { 0xA8FF, 0xA8FF, BC::NSM }, { 0xA926, 0xA92D, BC::NSM }, { 0xA947, 0xA951, BC::NSM },
+        { 0xA980, 0xA982, BC::NSM }, { 0xA9B3, 0xA9B3, BC::NSM }, { 0xA9B6, 0xA9B9, BC::NSM },
+        { 0xA9BC, 0xA9BD, BC::NSM }, { 0xA9E5, 0xA9E5, BC::NSM }, { 0xAA29, 0xAA2E, BC::NSM },
+        { 0xAA31, 0xAA32, BC::NSM }, { 0xAA35, 0xAA36, BC::NSM }, { 0xAA43, 0xAA43, BC::NSM },
+        { 0xAA4C, 0xAA4C, BC::NSM }, { 0xAA7C, 0xAA7C, BC::NSM }, { 0xAAB0, 0xAAB0, BC::NSM },
+        { 0xAAB2, 0xAAB4, BC::NSM }, { 0xAAB7, 0xAAB8, BC::NSM }, { 0xAABE, 0xAABF, BC::NSM },
+        { 0xAAC1, 0xAAC1, BC::NSM }, { 0xAAEC, 0xAAED, BC::NSM }, { 0xAAF6, 0xAAF6, BC::NSM },
+        { 0xAB6A, 0xAB6B, BC::ON }, { 0xABE5, 0xABE5, BC::NSM }, { 0xABE8, 0xABE8, BC::NSM },
+        { 0xABED, 0xABED, BC::NSM }, { 0xFB1D, 0xFB1D, BC::R }, { 0xFB1E, 0xFB1E, BC::NSM },
+        { 0xFB1F, 0xFB28, BC::R }, { 0xFB29, 0xFB29, BC::ES }, { 0xFB2A, 0xFB4F, BC::R },
+        { 0xFB50, 0xFD3D, BC::AL }, { 0xFD3E, 0xFD4F, BC::ON }, { 0xFD50, 0xFDCE, BC::AL },
+        { 0xFDCF, 0xFDCF, BC::ON }, { 0xFDD0, 0xFDEF, BC::BN }, { 0xFDF0, 0xFDFC, BC::AL },
+        { 0xFDFD, 0xFDFF, BC::ON }, { 0xFE00, 0xFE0F, BC::NSM }, { 0xFE10, 0xFE19, BC::ON },
+        { 0xFE20, 0xFE2F, BC::NSM }, { 0xFE30, 0xFE4F, BC::ON }, { 0xFE50, 0xFE50, BC::CS },
+        { 0xFE51, 0xFE51, BC::ON }, { 0xFE52, 0xFE52, BC::CS }, { 0xFE54, 0xFE54, BC::ON },
+        { 0xFE55, 0xFE55, BC::CS }, { 0xFE56, 0xFE5E, BC::ON }, { 0xFE5F, 0xFE5F, BC::ET },
+        { 0xFE60, 0xFE61, BC::ON }, { 0xFE62, 0xFE63, BC::ES }, { 0xFE64, 0xFE66, BC::ON },
+        { 0xFE68, 0xFE68, BC::ON }, { 0xFE69, 0xFE6A, BC::ET }, { 0xFE6B, 0xFE6B, BC::ON },
+        { 0xFE70, 0xFEFE, BC::AL }, { 0xFEFF, 0xFEFF, BC::BN }, { 0xFF01, 0xFF02, BC::ON },
+        { 0xFF03, 0xFF05, BC::ET }, { 0xFF06, 0xFF0A, BC::ON }, { 0xFF0B, 0xFF0B, BC::ES },
+        { 0xFF0C, 0xFF0C, BC::CS }, { 0xFF0D, 0xFF0D, BC::ES }, { 0xFF0E, 0xFF0F, BC::CS },
+        { 0xFF10, 0xFF19, BC::EN }, { 0xFF1A, 0xFF1A, BC::CS }, { 0xFF1B, 0xFF20, BC::ON },
+        { 0xFF3B, 0xFF40, BC::ON }, { 0xFF5B, 0xFF65, BC::ON }, { 0xFFE0, 0xFFE1, BC::ET },
+        { 0xFFE2, 0xFFE4, BC::ON }, { 0xFFE5, 0xFFE6, BC::ET }, { 0xFFE8, 0xFFEE, BC::ON },
+        { 0xFFF0, 0xFFF8, BC::BN }, { 0xFFF9, 0xFFFD, BC::ON }, { 0xFFFE, 0xFFFF, BC::BN },
+        { 0x10101, 0x10101, BC::ON }, { 0x10140, 0x1018C, BC::ON }, { 0x10190, 0x1019C, BC::ON },
+        { 0x101A0, 0x101A0, BC::ON }, { 0x101FD, 0x101FD, BC::NSM }, { 0x102E0, 0x102E0, BC::NSM },
+        { 0x102E1, 0x102FB, BC::EN }, { 0x10376, 0x1037A, BC::NSM }, { 0x10800, 0x1091E, BC::R },
+        { 0x1091F, 0x1091F, BC::ON }, { 0x10920, 0x10A00, BC::R }, { 0x10A01, 0x10A03, BC::NSM },
+        { 0x10A04, 0x10A04, BC::R }, { 0x10A05, 0x10A06, BC::NSM }, { 0x10A07, 0x10A0B, BC::R },
+        { 0x10A0C, 0x10A0F, BC::NSM }, { 0x10A10, 0x10A37, BC::R }, { 0x10A38, 0x10A3A, BC::NSM },
+        { 0x10A3B, 0x10A3E, BC::R }, { 0x10A3F, 0x10A3F, BC::NSM }, { 0x10A40, 0x10AE4, BC::R },
+        { 0x10AE5, 0x10AE6, BC::NSM }, { 0x10AE7, 0x10B38, BC::R }, { 0x10B39, 0x10B3F, BC::ON },
+        { 0x10B40, 0x10CFF, BC::R }, { 0x10D00, 0x10D23, BC::AL }, { 0x10D24, 0x10D27, BC::NSM },
+        { 0x10D28, 0x10D2F, BC::AL }, { 0x10D30, 0x10D39, BC::AN }, { 0x10D3A, 0x10D3F, BC::AL },
+        { 0x10D40, 0x10E5F, BC::R }, { 0x10E60, 0x10E7E, BC::AN }, { 0x10E7F, 0x10EAA, BC::R },
+        { 0x10EAB, 0x10EAC, BC::NSM }, { 0x10EAD, 0x10F2F, BC::R }, { 0x10F30, 0x10F45, BC::AL },
+        { 0x10F46, 0x10F50, BC::NSM }, { 0x10F51, 0x10F6F, BC::AL }, { 0x10F70, 0x10F81, BC::R },
+        { 0x10F82, 0x10F85, BC::NSM }, { 0x10F86, 0x10FFF, BC::R }, { 0x11001, 0x11001, BC::NSM },
+        { 0x11038, 0x11046, BC::NSM }, { 0x11052, 0x11065, BC::ON }, { 0x11070, 0x11070, BC::NSM },
+        { 0x11073, 0x11074, BC::NSM }, { 0x1107F, 0x11081, BC::NSM }, { 0x110B3, 0x110B6, BC::NSM },
+        { 0x110B9, 0x110BA, BC::NSM }, { 0x110C2, 0x110C2, BC::NSM }, { 0x11100, 0x11102, BC::NSM },
+        { 0x11127, 0x1112B, BC::NSM }, { 0x1112D, 0x11134, BC::NSM }, { 0x11173, 0x11173, BC::NSM },
+        { 0x11180, 0x11181, BC::NSM }, { 0x111B6, 0x111BE, BC::NSM }, { 0x111C9, 0x111CC, BC::NSM },
+        { 0x111CF, 0x111CF, BC::NSM }, { 0x1122F, 0x11231, BC::NSM }, { 0x11234, 0x11234, BC::NSM },
+        { 0x11236, 0x11237, BC::NSM }, { 0x1123E, 0x1123E, BC::NSM }, { 0x112DF, 0x112DF, BC::NSM },
+        { 0x112E3, 0x112EA, BC::NSM }, { 0x11300, 0x11301, BC::NSM }, { 0x1133B, 0x1133C, BC::NSM },
+        { 0x11340, 0x11340, BC::NSM }, { 0x11366, 0x1136C, BC::NSM }, { 0x11370, 0x11374, BC::NSM },
+        { 0x11438, 0x1143F, BC::NSM }, { 0x11442, 0x11444, BC::NSM }, { 0x11446, 0x11446, BC::NSM },
+        { 0x1145E, 0x1145E, BC::NSM }, { 0x114B3, 0x114B8, BC::NSM }, { 0x114BA, 0x114BA, BC::NSM },
+        { 0x114BF, 0x114C0, BC::NSM }, { 0x114C2, 0x114C3, BC::NSM }, { 0x115B2, 0x115B5, BC::NSM },
+        { 0x115BC, 0x115BD, BC::NSM }, { 0x115BF, 0x115C0, BC::NSM }, { 0x115DC, 0x115DD, BC::NSM },
+        { 0x11633, 0x1163A, BC::NSM }, { 0x1163D, 0x1163D, BC::NSM }, { 0x1163F, 0x11640, BC::NSM },
+        { 0x11660, 0x1166C, BC::ON }, { 0x116AB, 0x116AB, BC::NSM }, { 0x116AD, 0x116AD, BC::NSM },
+        { 0x116B0, 0x116B5, BC::NSM }, { 0x116B7, 0x116B7, BC::NSM }, { 0x1171D, 0x1171F, BC::NSM },
+        { 0x11722, 0x11725, BC::NSM }, { 0x11727, 0x1172B, BC::NSM }, { 0x1182F, 0x11837, BC::NSM },
+        { 0x11839, 0x1183A, BC::NSM }, { 0x1193B, 0x1193C, BC::NSM }, { 0x1193E, 0x1193E, BC::NSM },
+        { 0x11943, 0x11943, BC::NSM }, { 0x119D4, 0x119D7, BC::NSM }, { 0x119DA, 0x119DB, BC::NSM },
+        { 0x119E0, 0x119E0, BC::NSM }, { 0x11A01, 0x11A06, BC::NSM }, { 0x11A09, 0x11A0A, BC::NSM },
+        { 0x11A33, 0x11A38, BC::NSM }, { 0x11A3B, 0x11A3E, BC::NSM }, { 0x11A47, 0x11A47, BC::NSM },
+        { 0x11A51, 0x11A56, BC::NSM }, { 0x11A59, 0x11A5B, BC::NSM }, { 0x11A8A, 0x11A96, BC::NSM },
+        { 0x11A98, 0x11A99, BC::NSM }, { 0x11C30, 0x11C36, BC::NSM }, { 0x11C38, 0x11C3D, BC::NSM },
+        { 0x11C92, 0x11CA7, BC::NSM }, { 0x11CAA, 0x11CB0, BC::NSM }, { 0x11CB2, 0x11CB3, BC::NSM },
+        { 0x11CB5, 0x11CB6, BC::NSM }, { 0x11D31, 0x11D36, BC::NSM }, { 0x11D3A, 0x11D3A, BC::NSM },
+        { 0x11D3C, 0x11D3D, BC::NSM }, { 0x11D3F, 0x11D45, BC::NSM }, { 0x11D47, 0x11D47, BC::NSM },
+        { 0x11D90, 0x11D91, BC::NSM }, { 0x11D95, 0x11D95, BC::NSM }, { 0x11D97, 0x11D97, BC::NSM },
+        { 0x11EF3, 0x11EF4, BC::NSM }, { 0x11FD5, 0x11FDC, BC::ON }, { 0x11FDD, 0x11FE0, BC::ET },
+        { 0x11FE1, 0x11FF1, BC::ON }, { 0x16AF0, 0x16AF4, BC::NSM }, { 0x16B30, 0x16B36, BC::NSM },
+        { 0x16F4F, 0x16F4F, BC::NSM }, { 0x16F8F, 0x16F92, BC::NSM }, { 0x16FE2, 0x16FE2, BC::ON },
+        { 0x16FE4, 0x16FE4, BC::NSM }, { 0x1BC9D, 0x1BC9E, BC::NSM }, { 0x1BCA0, 0x1BCA3, BC::BN },
+        { 0x1CF00, 0x1CF2D, BC::NSM }, { 0x1CF30, 0x1CF46, BC::NSM }, { 0x1D167, 0x1D169, BC::NSM },
+        { 0x1D173, 0x1D17A, BC::BN }, { 0x1D17B, 0x1D182, BC::NSM }, { 0x1D185, 0x1D18B, BC::NSM },
+        { 0x1D1AA, 0x1D1AD, BC::NSM }, { 0x1D1E9, 0x1D1EA, BC::ON }, { 0x1D200, 0x1D241, BC::ON },
+        { 0x1D242, 0x1D244, BC::NSM }, { 0x1D245, 0x1D245, BC::ON }, { 0x1D300, 0x1D356, BC::ON },
+        { 0x1D6DB, 0x1D6DB, BC::ON }, { 0x1D715, 0x1D715, BC::ON }, { 0x1D74F, 0x1D74F, BC::ON },
+        { 0x1D789, 0x1D789, BC::ON }, { 0x1D7C3, 0x1D7C3, BC::ON }, { 0x1D7CE, 0x1D7FF, BC::EN },
+        { 0x1DA00, 0x1DA36, BC::NSM }, { 0x1DA3B, 0x1DA6C, BC::NSM }, { 0x1DA75, 0x1DA75, BC::NSM },
+        { 0x1DA84, 0x1DA84, BC::NSM }, { 0x1DA9B, 0x1DA9F, BC::NSM }, { 0x1DAA1, 0x1DAAF, BC::NSM },
+        { 0x1E000, 0x1E006, BC::NSM }, { 0x1E008, 0x1E018, BC::NSM }, { 0x1E01B, 0x1E021, BC::NSM },
+        { 0x1E023, 0x1E024, BC::NSM }, { 0x1E026, 0x1E02A, BC::NSM }, { 0x1E130, 0x1E136, BC::NSM },
+        { 0x1E2AE, 0x1E2AE, BC::NSM }, { 0x1E2EC, 0x1E2EF, BC::NSM }, { 0x1E2FF, 0x1E2FF, BC::ET },
+        { 0x1E800, 0x1E8CF, BC::R }, { 0x1E8D0, 0x1E8D6, BC::NSM }, { 0x1E8D7, 0x1E943, BC::R },
+        { 0x1E944, 0x1E94A, BC::NSM }, { 0x1E94B, 0x1EC6F, BC::R }, { 0x1EC70, 0x1ECBF, BC::AL },
+        { 0x1ECC0, 0x1ECFF, BC::R }, { 0x1ED00, 0x1ED4F, BC::AL }, { 0x1ED50, 0x1EDFF, BC::R },
+        { 0x1EE00, 0x1EEEF, BC::AL }, { 0x1EEF0, 0x1EEF1, BC::ON }, { 0x1EEF2, 0x1EEFF, BC::AL },
+        { 0x1EF00, 0x1EFFF, BC::R }, { 0x1F000, 0x1F02B, BC::ON }, { 0x1F030, 0x1F093, BC::ON },
+        { 0x1F0A0, 0x1F0AE, BC::ON }, { 0x1F0B1, 0x1F0BF, BC::ON }, { 0x1F0C1, 0x1F0CF, BC::ON },
+        { 0x1F0D1, 0x1F0F5, BC::ON }, { 0x1F100, 0x1F10A, BC::EN }, { 0x1F10B, 0x1F10F, BC::ON },
+        { 0x1F12F, 0x1F12F, BC::ON }, { 0x1F16A, 0x1F16F, BC::ON }, { 0x1F1AD, 0x1F1AD, BC::ON },
+        { 0x1F260, 0x1F265, BC::ON }, { 0x1F300, 0x1F6D7, BC::ON }, { 0x1F6DD, 0x1F6EC, BC::ON },
+        { 0x1F6F0, 0x1F6FC, BC::ON }, { 0x1F700, 0x1F773, BC::ON }, { 0x1F780, 0x1F7D8, BC::ON },
+        { 0x1F7E0, 0x1F7EB, BC::ON }, { 0x1F7F0, 0x1F7F0, BC::ON }, { 0x1F800, 0x1F80B, BC::ON },
+        { 0x1F810, 0x1F847, BC::ON }, { 0x1F850, 0x1F859, BC::ON }, { 0x1F860, 0x1F887, BC::ON },
+        { 0x1F890, 0x1F8AD, BC::ON }, { 0x1F8B0, 0x1F8B1, BC::ON }, { 0x1F900, 0x1FA53, BC::ON },
+        { 0x1FA60, 0x1FA6D, BC::ON }, { 0x1FA70, 0x1FA74, BC::ON }, { 0x1FA78, 0x1FA7C, BC::ON },
+        { 0x1FA80, 0x1FA86, BC::ON }, { 0x1FA90, 0x1FAAC, BC::ON }, { 0x1FAB0, 0x1FABA, BC::ON },
+        { 0x1FAC0, 0x1FAC5, BC::ON }, { 0x1FAD0, 0x1FAD9, BC::ON }, { 0x1FAE0, 0x1FAE7, BC::ON },
+        { 0x1FAF0, 0x1FAF6, BC::ON }, { 0x1FB00, 0x1FB92, BC::ON }, { 0x1FB94, 0x1FBCA, BC::ON },
+        { 0x1FBF0, 0x1FBF9, BC::EN }, { 0x1FFFE, 0x1FFFF, BC::BN }, { 0x2FFFE, 0x2FFFF, BC::BN },
+        { 0x3FFFE, 0x3FFFF, BC::BN }, { 0x4FFFE, 0x4FFFF, BC::BN }, { 0x5FFFE, 0x5FFFF, BC::BN },
+        { 0x6FFFE, 0x6FFFF, BC::BN }, { 0x7FFFE, 0x7FFFF, BC::BN }, { 0x8FFFE, 0x8FFFF, BC::BN },
+        { 0x9FFFE, 0x9FFFF, BC::BN }, { 0xAFFFE, 0xAFFFF, BC::BN }, { 0xBFFFE, 0xBFFFF, BC::BN },
+        { 0xCFFFE, 0xCFFFF, BC::BN }, { 0xDFFFE, 0xE00FF, BC::BN }, { 0xE0100, 0xE01EF, BC::NSM },
+        { 0xE01F0, 0xE0FFF, BC::BN }, { 0xEFFFE, 0xEFFFF, BC::BN }, { 0xFFFFE, 0xFFFFF, BC::BN },
+        { 0x10FFFE, 0x10FFFF, BC::BN },
+    };
+
+    const BracketPair BracketPairs[] =
+    {
+        { 0x0028, 0x0029 }, { 0x005B, 0x005D }, { 0x007B, 0x007D }, { 0x0F3A, 0x0F3B },
+        { 0x0F3C, 0x0F3D }, { 0x169B, 0x169C }, { 0x2045, 0x2046 }, { 0x207D, 0x207E },
+        { 0x208D, 0x208E }, { 0x2308, 0x2309 }, { 0x230A, 0x230B }, { 0x2329, 0x232A },
+        { 0x2768, 0x2769 }, { 0x276A, 0x276B }, { 0x276C, 0x276D }, { 0x276E, 0x276F },
+        { 0x2770, 0x2771 }, { 0x2772, 0x2773 }, { 0x2774, 0x2775 }, { 0x27C5, 0x27C6 },
+        { 0x27E6, 0x27E7 }, { 0x27E8, 0x27E9 }, { 0x27EA, 0x27EB }, { 0x27EC, 0x27ED },
+        { 0x27EE, 0x27EF }, { 0x2983, 0x2984 }, { 0x2985, 0x2986 }, { 0x2987, 0x2988 },
+        { 0x2989, 0x298A }, { 0x298B, 0x298C }, { 0x298D, 0x2990 }, { 0x298F, 0x298E },
+        { 0x2991, 0x2992 }, { 0x2993, 0x2994 }, { 0x2995, 0x2996 }, { 0x2997, 0x2998 },
+        { 0x29D8, 0x29D9 }, { 0x29DA, 0x29DB }, { 0x29FC, 0x29FD }, { 0x2E22, 0x2E23 },
+        { 0x2E24, 0x2E25 }, { 0x2E26, 0x2E27 }, { 0x2E28, 0x2E29 }, { 0x2E55, 0x2E56 },
+        { 0x2E57, 0x2E58 }, { 0x2E59, 0x2E5A }, { 0x2E5B, 0x2E5C }, { 0x3008, 0x3009 },
+        { 0x300A, 0x300B }, { 0x300C, 0x300D }, { 0x300E, 0x300F }, { 0x3010, 0x3011 },
+        { 0x3014, 0x3015 }, { 0x3016, 0x3017 }, { 0x3018, 0x3019 }, { 0x301A, 0x301B },
+        { 0xFE59, 0xFE5A }, { 0xFE5B, 0xFE5C }, { 0xFE5D, 0xFE5E }, { 0xFF08, 0xFF09 },
+        { 0xFF3B, 0xFF3D }, { 0xFF5B, 0xFF5D }, { 0xFF5F, 0xFF60 }, { 0xFF62, 0xFF63 },
+    };
+
+    const TwoStageTable& GetBidiClassTable()
+    {
+        static const TwoStageTable table = []
+        {
+            std::vector<uint8_t> full(TwoStageTable::CodePointCount, (uint8_t)BC::L);
+            FillRanges(full, BidiClassRanges);
+            return TwoStageTable(full);
+        }();
+
+        return table;
+    }
+
+    // U+2329 and U+232A are canonically equivalent to U+3008 and U+3009 (BD16)
+    char32_t GetCanonicalBracket(char32_t c)
+    {
+        if (c == 0x2329) return 0x3008;
+        if (c == 0x232A) return 0x3009;
+        return c;
+    }
+
+    // Returns the canonical closing bracket of an opening bracket, 0 for other characters
+    char32_t GetClosingBracket(char32_t c)
+    {
+        for (const BracketPair& pair : BracketPairs)
+            if (pair.open == c) return GetCanonicalBracket(pair.close);
+        return 0;
+    }
+
+    bool IsClosingBracket(char32_t c)
+    {
+        for (const BracketPair& pair : BracketPairs)
+            if (pair.close == c) return true;
+        return false;
+    }
+
+    bool IsIsolateInitiator(BC c) { return c == BC::LRI || c == BC::RLI || c == BC::FSI; }
+    bool IsRemovedByX9(BC c) { return c == BC::LRE || c == BC::RLE || c == BC::LRO || c == BC::RLO || c == BC::PDF || c == BC::BN; }
+    bool IsNeutralOrIsolate(BC c) { return c == BC::B || c == BC::S || c == BC::WS || c == BC::ON || IsIsolateInitiator(c) || c == BC::PDI; }
+
+    // Direction a resolved class counts as in N0 and N1; ON for neutrals
+    BC GetStrongDirection(BC c)
+    {
+        if (c == BC::L) return BC::L;
+        if (c == BC::R || c == BC::AL || c == BC::EN || c == BC::AN) return BC::R;
+        return BC::ON;
+    }
+
+    BC GetEmbeddingDirection(uint8_t level) { return (level & 1) ? BC::R : BC::L; }
+
+    // Anything that can lift a left to right paragraph above level 0
+    bool CanBeRightToLeft(BC c)
+    {
+        switch (c)
+        {
+        case BC::R: case BC::AL: case BC::AN:
+        case BC::LRE: case BC::LRO: case BC::RLE: case BC::RLO: case BC::PDF:
+        case BC::LRI: case BC::RLI: case BC::FSI: case BC::PDI:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    constexpr uint8_t MaxDepth = 125;
+}
+
+BidiClass GetBidiClass(char32_t c)
+{
+    return (BC)GetBidiClassTable().Get(c);
+}
+
+bool IsLeftToRightOnly(std::u16string_view text)
+{
+    size_t i = 0;
+
+    while (i < text.size())
+    {
+#ifdef BIDI_SSE2
+        // skip blocks of eight units below U+0590: saturating U+058F - unit is zero for all of them
+        const __m128i limit = _mm_set1_epi16(0x058F);
+        while (i + 8 <= text.size())
+        {
+            __m128i units = _mm_loadu_si128((const __m128i*)(text.data() + i));
+            __m128i above = _mm_subs_epu16(units, limit);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(above, _mm_setzero_si128())) != 0xFFFF) break;
+            i += 8;
+        }
+
+        if (i == text.size()) break;
+#endif
+
+        if (text[i] < 0x0590)
+        {
+            i++;
+            continue;
+        }
+
+        if (CanBeRightToLeft(GetBidiClass(DecodeUtf16(text, i)))) return false;
+    }
+
+    return true;
+}
+
+void BidiParagraph::SetText(std::u16string_view text, BidiDirection direction)
+{
+    this->text = text;
+    size_t n = text.size();
+
+    if (direction != BidiDirection::RightToLeft && ::IsLeftToRightOnly(text))
+    {
+        leftToRightOnly = true;
+        paragraphLevel = 0;
+        levels.assign(n, 0);
+        return;
+    }
+
+    leftToRightOnly = false;
+
+    // trailing surrogates take no part, like BN
+    classes.resize(n);
+    for (size_t i = 0; i < n;)
+    {
+        size_t start = i;
+        classes[start] = GetBidiClass(DecodeUtf16(text, i));
+        for (size_t j = start + 1; j < i; j++)
+            classes[j] = BC::BN;
+    }
+
+    originalClasses = classes;
+    levels.resize(n);
+
+    MatchIsolates();
+
+    if (direction == BidiDirection::Auto)
+        paragraphLevel = GetFirstStrongLevel(0, n, 0);
+    else
+        paragraphLevel = direction == BidiDirection::RightToLeft ? 1 : 0;
+
+    ResolveExplicitLevels();
+    ResolveSequences();
+
+    // X9 removed characters take the level of the one before them
+    for (size_t i = 0; i < n; i++)
+    {
+        if (IsRemovedByX9(originalClasses[i]))
+            levels[i] = i == 0 ? paragraphLevel : levels[i - 1];
+    }
+}
+
+// BD9: pairs isolate initiators with their PDIs, stopping at paragraph separators
+void BidiParagraph::MatchIsolates()
+{
+    size_t n = text.size();
+    matchingPdi.assign(n, (uint32_t)n);
+    matchingInitiator.assign(n, (uint32_t)n);
+
+    std::vector<uint32_t>& open = sequence;
+    open.clear();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        BC c = classes[i];
+
+        if (IsIsolateInitiator(c))
+        {
+            open.push_back((uint32_t)i);
+        }
+        else if (c == BC::PDI && !open.empty())
+        {
+            matchingPdi[open.back()] = (uint32_t)i;
+            matchingInitiator[i] = open.back();
+            open.pop_back();
+        }
+        else if (c == BC::B)
+        {
+            open.clear();
+        }
+    }
+}
+
+// P2, P3: level of the first L, R or AL in [start, end), skipping isolates
+uint8_t BidiParagraph::GetFirstStrongLevel(size_t start, size_t end, uint8_t fallback) const
+{
+    for (size_t i = start; i < end; i++)
+    {
+        BC c = classes[i];
+
+        if (c == BC::L) return 0;
+        if (c == BC::R || c == BC::AL) return 1;
+        if (c == BC::B) break;
+
+        if (IsIsolateInitiator(c))
+        {
+            i = matchingPdi[i];
+            if (i >= end) break;
+        }
+    }
+
+    return fallback;
+}
+
+// X1-X8
+void BidiParagraph::ResolveExplicitLevels()
+{
+    struct Status
+    {
+        uint8_t level;
+        BC override;    // ON for none
+        bool isolate;
+    };
+
+    Status stack[MaxDepth + 2];
+    int depth = 0;
+    stack[0] = { paragraphLevel, BC::ON, false };
+
+    int overflowIsolates = 0;
+    int overflowEmbeddings = 0;
+    int validIsolates = 0;
+
+    auto nextLevel = [&](bool rightToLeft)
+    {
+        uint8_t level = stack[depth].level;
+        return (uint8_t)(rightToLeft ? (level + 1) | 1 : (level + 2) & ~1);
+    };
+
+    auto applyOverride = [&](size_t i)
+    {
+        levels[i] = stack[depth].level;
+        if (stack[depth].override != BC::ON) classes[i] = stack[depth].override;
+    };
+
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        BC c = classes[i];
+
+        switch (c)
+        {
+        case BC::RLE: case BC::LRE: case BC::RLO: case BC::LRO:
+        {
+            uint8_t level = nextLevel(c == BC::RLE || c == BC::RLO);
+            levels[i] = stack[depth].level;
+
+            if (level <= MaxDepth && overflowIsolates == 0 && overflowEmbeddings == 0)
+                stack[++depth] = { level, c == BC::RLO ? BC::R : c == BC::LRO ? BC::L : BC::ON, false };
+            else if (overflowIsolates == 0)
+                overflowEmbeddings++;
+            break;
+        }
+
+        case BC::RLI: case BC::LRI: case BC::FSI:
+        {
+            applyOverride(i);
+
+            bool rightToLeft = c == BC::RLI;
+            if (c == BC::FSI) rightToLeft = GetFirstStrongLevel(i + 1, matchingPdi[i], 0) == 1;
+
+            uint8_t level = nextLevel(rightToLeft);
+            if (level <= MaxDepth && overflowIsolates == 0 && overflowEmbeddings == 0)
+            {
+                validIsolates++;
+                stack[++depth] = { level, BC::ON, true };
+            }
+            else
+            {
+                overflowIsolates++;
+            }
+            break;
+        }
+
+        case BC::PDI:
+            if (overflowIsolates > 0)
+            {
+                overflowIsolates--;
+            }
+            else if (validIsolates > 0)
+            {
+                overflowEmbeddings = 0;
+                while (!stack[depth].isolate) depth--;
+                depth--;
+                validIsolates--;
+            }
+            applyOverride(i);
+            break;
+
+        case BC::PDF:
+            if (overflowIsolates > 0) {}
+            else if (overflowEmbeddings > 0) overflowEmbeddings--;
+            else if (!stack[depth].isolate && depth > 0) depth--;
+            levels[i] = stack[depth].level;
+            break;
+
+        case BC::B:
+            // X8: a separator inside the text ends every embedding
+            levels[i] = paragraphLevel;
+            depth = 0;
+            overflowIsolates = 0;
+            overflowEmbeddings = 0;
+            validIsolates = 0;
+            break;
+
+        case BC::BN:
+            levels[i] = stack[depth].level;
+            break;
+
+        default:
+            applyOverride(i);
+            break;
+        }
+    }
+}
+
+// X10: splits the text into isolating run sequences and resolves each
+void BidiParagraph::ResolveSequences()
+{
+    size_t n = text.size();
+
+    // level runs over the characters X9 keeps, as [start, end) into 'kept'
+    std::vector<uint32_t> kept;
+    kept.reserve(n);
+    for (size_t i = 0; i < n; i++)
+        if (!IsRemovedByX9(originalClasses[i])) kept.push_back((uint32_t)i);
+
+    struct LevelRun
+    {
+        uint32_t start;
+        uint32_t end;
+        uint8_t level;  // explicit, before earlier sequences resolve theirs
+        bool done;
+    };
+
+    std::vector<LevelRun> runs;
+    std::vector<uint32_t> runStartingAt(n, UINT32_MAX);
+
+    for (uint32_t k = 0; k < kept.size();)
+    {
+        uint32_t end = k + 1;
+        while (end < kept.size() && levels[kept[end]] == levels[kept[k]]) end++;
+
+        runStartingAt[kept[k]] = (uint32_t)runs.size();
+        runs.push_back({ k, end, levels[kept[k]], false });
+        k = end;
+    }
+
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        if (runs[r].done) continue;
+
+        // chain the runs joined by matching isolate initiators and PDIs
+        sequence.clear();
+        size_t current = r;
+
+        for (;;)
+        {
+            LevelRun& run = runs[current];
+            run.done = true;
+            for (uint32_t k = run.start; k < run.end; k++)
+                sequence.push_back(kept[k]);
+
+            uint32_t last = kept[run.end - 1];
+            if (!IsIsolateInitiator(originalClasses[last]) || matchingPdi[last] == n) break;
+
+            uint32_t next = runStartingAt[matchingPdi[last]];
+            if (next == UINT32_MAX) break;
+            current = next;
+        }
+
+        uint8_t level = runs[r].level;
+
+        uint8_t before = r == 0 ? paragraphLevel : runs[r - 1].level;
+        uint8_t after = paragraphLevel;
+        uint32_t last = sequence.back();
+        bool unmatchedInitiator = IsIsolateInitiator(originalClasses[last]) && matchingPdi[last] == n;
+        if (!unmatchedInitiator && current + 1 < runs.size()) after = runs[current + 1].level;
+
+        ResolveSequence(GetEmbeddingDirection(std::max(level, before)), GetEmbeddingDirection(std::max(level, after)));
+    }
+}
+
+// W1-W7, N0-N2 and I1-I2 over one isolating run sequence
+void BidiParagraph::ResolveSequence(BidiClass sos, BidiClass eos)
+{
+    size_t m = sequence.size();
+    std::vector<BC>& c = sequenceClasses;
+    c.resize(m);
+    for (size_t k = 0; k < m; k++)
+        c[k] = classes[sequence[k]];
+
+    // W1
+    BC previous = sos;
+    for (size_t k = 0; k < m; k++)
+    {
+        if (c[k] == BC::NSM) c[k] = IsIsolateInitiator(previous) || previous == BC::PDI ? BC::ON : previous;
+        previous = c[k];
+    }
+
+    // W2, W3
+    BC lastStrong = sos;
+    for (size_t k = 0; k < m; k++)
+    {
+        if (c[k] == BC::L || c[k] == BC::R || c[k] == BC::AL) lastStrong = c[k];
+        else if (c[k] == BC::EN && lastStrong == BC::AL) c[k] = BC::AN;
+    }
+
+    for (size_t k = 0; k < m; k++)
+        if (c[k] == BC::AL) c[k] = BC::R;
+
+    // W4
+    for (size_t k = 1; k + 1 < m; k++)
+    {
+        if (c[k] == BC::ES && c[k - 1] == BC::EN && c[k + 1] == BC::EN) c[k] = BC::EN;
+        else if (c[k] == BC::CS && c[k - 1] == c[k + 1] && (c[k - 1] == BC::EN || c[k - 1] == BC::AN)) c[k] = c[k - 1];
+    }
+
+    // W5
+    for (size_t k = 0; k < m;)
+    {
+        if (c[k] != BC::ET)
+        {
+            k++;
+            continue;
+        }
+
+        size_t end = k;
+        while (end < m && c[end] == BC::ET) end++;
+
+        if ((k > 0 && c[k - 1] == BC::EN) || (end < m && c[end] == BC::EN))
+            std::fill(c.begin() + k, c.begin() + end, BC::EN);
+        k = end;
+    }
+
+    // W6, W7
+    lastStrong = sos;
+    for (size_t k = 0; k < m; k++)
+    {
+        if (c[k] == BC::ES || c[k] == BC::ET || c[k] == BC::CS) c[k] = BC::ON;
+
+        if (c[k] == BC::L || c[k] == BC::R) lastStrong = c[k];
+        else if (c[k] == BC::EN && lastStrong == BC::L) c[k] = BC::L;
+    }
+
+    uint8_t level = levels[sequence.front()];
+    BC embedding = GetEmbeddingDirection(level);
+
+    ResolveBrackets(sos, embedding);
+
+    // N1, N2
+    for (size_t k = 0; k < m;)
+    {
+        if (!IsNeutralOrIsolate(c[k]))
+        {
+            k++;
+            continue;
+        }
+
+        size_t end = k;
+        while (end < m && IsNeutralOrIsolate(c[end])) end++;
+
+        BC leading = k == 0 ? sos : GetStrongDirection(c[k - 1]);
+        BC trailing = end == m ? eos : GetStrongDirection(c[end]);
+        std::fill(c.begin() + k, c.begin() + end, leading == trailing ? leading : embedding);
+        k = end;
+    }
+
+    // I1, I2
+    for (size_t k = 0; k < m; k++)
+    {
+        uint8_t& l = levels[sequence[k]];
+
+        if ((l & 1) == 0)
+        {
+            if (c[k] == BC::R) l += 1;
+            else if (c[k] == BC::AN || c[k] == BC::EN) l += 2;
+        }
+        else if (c[k] == BC::L || c[k] == BC::EN || c[k] == BC::AN)
+        {
+            l += 1;
+        }
+    }
+}
+
+// N0: bracket pairs take the embedding direction if it occurs inside them, otherwise the
+// opposite direction if that occurs inside and before them
+void BidiParagraph::ResolveBrackets(BidiClass sos, BidiClass embedding)
+{
+    std::vector<BC>& c = sequenceClasses;
+    size_t m = sequence.size();
+
+    // BD16
+    struct Opening
+    {
+        char32_t closing;
+        uint32_t position;
+    };
+
+    constexpr size_t MaxOpenings = 63;
+    Opening openings[MaxOpenings];
+    size_t openCount = 0;
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+    for (size_t k = 0; k < m; k++)
+    {
+        if (c[k] != BC::ON) continue;
+
+        char16_t unit = text[sequence[k]];
+        if (unit >= 0xD800 && unit <= 0xDFFF) continue;     // no brackets outside the BMP
+
+        char32_t ch = GetCanonicalBracket(unit);
+
+        if (char32_t closing = GetClosingBracket(ch))
+        {
+            if (openCount == MaxOpenings) break;
+            openings[openCount++] = { closing, (uint32_t)k };
+        }
+        else if (IsClosingBracket(unit))
+        {
+            for (size_t j = openCount; j-- > 0;)
+            {
+                if (openings[j].closing == ch)
+                {
+                    // Pops the opening with everything above it, so each one pairs once. ICU's
+                    // ubidi (checked against 72) differs here: a U+2329 or U+3008 that already has
+                    // its pair still takes a later U+232A or U+3009.
+                    pairs.push_back({ openings[j].position, (uint32_t)k });
+                    openCount = j;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (pairs.empty()) return;
+
+    std::sort(pairs.begin(), pairs.end());
+
+    BC opposite = embedding == BC::L ? BC::R : BC::L;
+
+    auto setBracket = [&](size_t k, BC direction)
+    {
+        c[k] = direction;
+
+        // W1 gave NSMs after the bracket its old class. ICU's ubidi skips this after a closing
+        // bracket that N0 set against the embedding direction, leaving those marks to N1 and N2;
+        // this follows the last paragraph of N0 instead.
+        for (size_t j = k + 1; j < m && originalClasses[sequence[j]] == BC::NSM; j++)
+            c[j] = direction;
+    };
+
+    for (auto [open, close] : pairs)
+    {
+        bool hasEmbedding = false;
+        bool hasOpposite = false;
+
+        for (size_t k = open + 1; k < close; k++)
+        {
+            BC direction = GetStrongDirection(c[k]);
+            if (direction == embedding) hasEmbedding = true;
+            else if (direction == opposite) hasOpposite = true;
+        }
+
+        BC direction;
+        if (hasEmbedding)
+        {
+            direction = embedding;
+        }
+        else if (hasOpposite)
+        {
+            BC preceding = sos;
+            for (size_t k = open; k-- > 0;)
+            {
+                BC strong = GetStrongDirection(c[k]);
+                if (strong != BC::ON)
+                {
+                    preceding = strong;
+                    break;
+                }
+            }
+
+            direction = preceding == opposite ? opposite : embedding;
+        }
+        else
+        {
+            continue;
+        }
+
+        setBracket(open, direction);
+        setBracket(close, direction);
+    }
+}
+
+void BidiParagraph::GetLineRuns(uint32_t lineStart, uint32_t lineLength, std::vector<BidiRun>& runs) const
+{
+    if (lineLength == 0) return;
+
+    if (leftToRightOnly)
+    {
+        runs.push_back({ lineStart, lineLength, 0 });
+        return;
+    }
+
+    // L1: separators, and whitespace before them or at the end of the line, go back to the
+    // paragraph level
+    std::vector<uint8_t> lineLevels(levels.begin() + lineStart, levels.begin() + lineStart + lineLength);
+
+    auto isWhitespace = [](BC c) { return c == BC::WS || IsIsolateInitiator(c) || c == BC::PDI || IsRemovedByX9(c); };
+
+    bool trailing = true;
+    for (uint32_t k = lineLength; k-- > 0;)
+    {
+        BC c = originalClasses[lineStart + k];
+
+        if (c == BC::S || c == BC::B)
+        {
+            lineLevels[k] = paragraphLevel;
+            trailing = true;
+        }
+        else if (trailing && isWhitespace(c))
+        {
+            lineLevels[k] = paragraphLevel;
+        }
+        else
+        {
+            trailing = false;
+        }
+    }
+
+    // L2: runs in logical order, then reverse every sequence at or above each odd level
+    size_t first = runs.size();
+    uint8_t highest = 0;
+    uint8_t lowestOdd = UINT8_MAX;
+
+    for (uint32_t k = 0; k < lineLength;)
+    {
+        uint32_t end = k + 1;
+        while (end < lineLength && lineLevels[end] == lineLevels[k]) end++;
+
+        uint8_t level = lineLevels[k];
+        runs.push_back({ lineStart + k, end - k, level });
+        highest = std::max(highest, level);
+        if (level & 1) lowestOdd = std::min(lowestOdd, level);
+        k = end;
+    }
+
+    for (uint8_t level = highest; level >= lowestOdd && level > 0; level--)
+    {
+        for (size_t r = first; r < runs.size();)
+        {
+            if (runs[r].level < level)
+            {
+                r++;
+                continue;
+            }
+
+            size_t end = r + 1;
+            while (end < runs.size() && runs[end].level >= level) end++;
+            std::reverse(runs.begin() + r, runs.begin() + end);
+            r = end;
+        }
+    }
+}
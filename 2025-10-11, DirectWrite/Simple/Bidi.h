@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Bidi_Class values (UAX #9)
+enum class BidiClass : uint8_t
+{
+    L, R, AL, EN, ES, ET, AN, CS, NSM, BN, B, S, WS, ON,
+    LRE, LRO, RLE, RLO, PDF, LRI, RLI, FSI, PDI,
+    Count,
+};
+
+enum class BidiDirection
+{
+    LeftToRight,
+    RightToLeft,
+    Auto,       // from the first strong character (P2, P3), left to right if there is none
+};
+
+// Part of a line at one embedding level, odd levels run right to left
+struct BidiRun
+{
+    uint32_t textStart;     // relative to the paragraph
+    uint32_t textLength;
+    uint8_t level;
+};
+
+// Looked up in a two-stage table generated from the Unicode 14.0 DerivedBidiClass.txt
+BidiClass GetBidiClass(char32_t c);
+
+// True if nothing in 'text' can resolve above level 0 in a left to right paragraph: no R, AL or
+// AN characters and no explicit embeddings, overrides or isolates. Code units below U+0590 are
+// never right to left and are skipped eight at a time with SSE2.
+bool IsLeftToRightOnly(std::u16string_view text);
+
+// Resolved embedding levels of one paragraph (UAX #9 P2-I2) and its lines in display order (L1,
+// L2). Nearly all of our text is left to right, so SetText first checks IsLeftToRightOnly and
+// only runs the full algorithm when that fails; pure left to right text resolves to all zeros
+// without classifying a single character.
+//
+// Levels are per UTF-16 code unit. Characters removed by X9 (BN, embeddings, overrides, PDF) get
+// the level of the character before them. Scratch storage is reused across SetText calls.
+class BidiParagraph
+{
+    std::u16string_view text;
+    std::vector<BidiClass> originalClasses;
+    std::vector<BidiClass> classes;
+    std::vector<uint8_t> levels;
+    std::vector<uint32_t> matchingPdi;      // for isolate initiators, text.size() if unmatched
+    std::vector<uint32_t> matchingInitiator;// for PDIs, text.size() if unmatched
+    uint8_t paragraphLevel = 0;
+    bool leftToRightOnly = true;
+
+    // X10 scratch
+    std::vector<uint32_t> sequence;
+    std::vector<BidiClass> sequenceClasses;
+
+public:
+    // 'text' must stay alive while the paragraph is used
+    void SetText(std::u16string_view text, BidiDirection direction = BidiDirection::Auto);
+
+    bool IsLeftToRightOnly() const { return leftToRightOnly; }
+    uint8_t GetParagraphLevel() const { return paragraphLevel; }
+    const std::vector<uint8_t>& GetLevels() const { return levels; }
+
+    // Appends the runs of the line [lineStart, lineStart + lineLength) in visual order, left to
+    // right. The glyphs of an odd level run are displayed in reverse.
+    void GetLineRuns(uint32_t lineStart, uint32_t lineLength, std::vector<BidiRun>& runs) const;
+
+private:
+    void MatchIsolates();
+    uint8_t GetFirstStrongLevel(size_t start, size_t end, uint8_t fallback) const;
+    void ResolveExplicitLevels();
+    void ResolveSequences();
+    void ResolveSequence(BidiClass sos, BidiClass eos);
+    void ResolveBrackets(BidiClass sos, BidiClass embedding);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Vertical metrics of a face, in design units
+struct FontMetrics
+{
+    uint16_t designUnitsPerEm;
+    int32_t ascent;
+    int32_t descent;
+    int32_t lineGap;
+};
+
+// Raw sfnt table, big-endian as stored in the font file. Empty if the face does not have it.
+struct FontTable
+{
+    const uint8_t* data;
+    size_t size;
+};
+
+constexpr uint32_t MakeFontTableTag(char a, char b, char c, char d)
+{
+    return (uint32_t)(uint8_t)a << 24 | (uint32_t)(uint8_t)b << 16 | (uint32_t)(uint8_t)c << 8 | (uint8_t)d;
+}
+
+// Big-endian reads that return 0 past the end, so a truncated or corrupt table reads as empty
+// instead of reading out of bounds
+struct FontTableReader
+{
+    const uint8_t* data;
+    size_t size;
+
+    uint8_t U8(size_t offset) const { return offset < size ? data[offset] : 0; }
+
+    uint16_t U16(size_t offset) const
+    {
+        return offset < size && size - offset >= 2 ? (uint16_t)(data[offset] << 8 | data[offset + 1]) : 0;
+    }
+
+    int16_t S16(size_t offset) const { return (int16_t)U16(offset); }
+    uint32_t U32(size_t offset) const { return (uint32_t)U16(offset) << 16 | U16(offset + 2); }
+};
+
+// Receives glyph contours, in design units with y pointing up
+class GlyphOutlineSink
+{
+public:
+    virtual ~GlyphOutlineSink() = default;
+
+    virtual void MoveTo(float x, float y) = 0;
+    virtual void LineTo(float x, float y) = 0;
+    virtual void QuadTo(float cx, float cy, float x, float y) = 0;
+    virtual void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) = 0;
+    virtual void Close() = 0;
+};
+
+// Portable view of a font face.
+// The text pipeline talks to fonts only through this interface, so it can run without DirectWrite.
+class FontFace
+{
+public:
+    virtual ~FontFace() = default;
+
+    // Identifies the face in cache keys. Two faces must not share an id.
+    virtual uint32_t GetId() const = 0;
+
+    virtual FontMetrics GetMetrics() const = 0;
+
+    // cmap lookup, returns 0 (.notdef) if the face has no glyph for the code point
+    virtual uint16_t GetGlyphIndex(char32_t codePoint) const = 0;
+
+    // Horizontal advance in design units
+    virtual int32_t GetGlyphAdvance(uint16_t glyphIndex) const = 0;
+
+    // Pair adjustment in design units, 0 if the pair is not kerned
+    virtual int32_t GetKerning(uint16_t leftGlyph, uint16_t rightGlyph) const = 0;
+
+    // Decodes the glyph's contours into 'sink', for faces whose outlines GlyphOutlineCache cannot
+    // read from a glyf table itself (CFF fonts, faces that do not expose their tables).
+    // Returns false if the face provides no outlines; a glyph without contours returns true.
+    virtual bool GetGlyphOutline(uint16_t glyphIndex, GlyphOutlineSink& sink) const { return false; }
+
+    // Table data as IDWriteFontFace::TryGetFontTable returns it, valid for the lifetime of the face.
+    // Faces that do not expose their tables return an empty table.
+    virtual FontTable GetFontTable(uint32_t tag) const { return { nullptr, 0 }; }
+};
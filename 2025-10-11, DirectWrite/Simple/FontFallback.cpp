@@ -0,0 +1,112 @@
+#include "FontFallback.h"
+
+#include "Shaper.h"
+
+namespace
+{
+    // Code points that attach to or sit between their neighbours
+    bool PrefersCurrentFont(char32_t c)
+    {
+        return c == 0x20 || c == 0xA0 || c == 0x3000
+            || (0x0300 <= c && c <= 0x036F)     // combining diacritical marks
+            || (0x1160 <= c && c <= 0x11FF)     // Hangul medial vowels and final consonants
+            || (0x1AB0 <= c && c <= 0x1AFF)
+            || (0x200C <= c && c <= 0x200D)     // ZWNJ, ZWJ
+            || (0x20D0 <= c && c <= 0x20FF)
+            || (0xFE00 <= c && c <= 0xFE0F)     // variation selectors
+            || (0xFE20 <= c && c <= 0xFE2F)
+            || (0x1F3FB <= c && c <= 0x1F3FF)   // emoji skin tone modifiers
+            || (0xE0020 <= c && c <= 0xE007F)   // emoji tag sequences
+            || (0xE0100 <= c && c <= 0xE01EF);
+    }
+}
+
+FontCoverage::FontCoverage(const FontFace& face)
+    : face(&face)
+    , pages(PageCount, PageUnknown)
+{
+}
+
+uint16_t FontCoverage::BuildPage(uint32_t page)
+{
+    uint64_t bits[4] = {};
+    uint32_t covered = 0;
+
+    char32_t first = (char32_t)page << 8;
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        if (face->GetGlyphIndex(first + i) != 0)
+        {
+            bits[i >> 6] |= 1ull << (i & 63);
+            covered++;
+        }
+    }
+
+    uint16_t state;
+    if (covered == 0)
+    {
+        state = PageEmpty;
+    }
+    else if (covered == 256)
+    {
+        state = PageFull;
+    }
+    else
+    {
+        state = (uint16_t)(PageBitmapBase + bitmaps.size() / 4);
+        bitmaps.insert(bitmaps.end(), bits, bits + 4);
+    }
+
+    pages[page] = state;
+    return state;
+}
+
+void FontFallback::AddFont(const FontFace& face)
+{
+    chain.emplace_back(face);
+}
+
+int FontFallback::FindFont(char32_t codePoint)
+{
+    for (size_t i = 0; i < chain.size(); i++)
+    {
+        if (chain[i].Covers(codePoint))
+            return (int)i;
+    }
+    return -1;
+}
+
+void FontFallback::Itemize(std::u16string_view text, std::vector<FontRun>& runs)
+{
+    if (text.empty() || chain.empty()) return;
+
+    size_t firstRun = runs.size();
+    int current = -1; // font of the run being built, -1 for none yet
+
+    size_t i = 0;
+    while (i < text.size())
+    {
+        uint32_t start = (uint32_t)i;
+        char32_t codePoint = DecodeUtf16(text, i);
+
+        int font;
+        if (current >= 0 && PrefersCurrentFont(codePoint) && chain[current].Covers(codePoint))
+            font = current;
+        else
+            font = FindFont(codePoint);
+
+        bool missing = font < 0;
+        if (missing) font = 0;
+
+        if (runs.size() > firstRun && runs.back().fontIndex == (uint32_t)font && runs.back().missing == missing)
+        {
+            runs.back().textLength += (uint32_t)i - start;
+        }
+        else
+        {
+            runs.push_back({ start, (uint32_t)i - start, (uint32_t)font, missing });
+        }
+
+        current = missing ? -1 : font;
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "FontFace.h"
+
+// cmap coverage of one face, built lazily in 256 code point pages.
+// A page is either known empty, known full, or a 256-bit bitmap, so repeated lookups cost one
+// index load and one bit test. Not thread safe: pages are filled on first use.
+class FontCoverage
+{
+    enum : uint16_t
+    {
+        PageUnknown = 0,
+        PageEmpty = 1,
+        PageFull = 2,
+        PageBitmapBase = 3,
+    };
+
+    static constexpr uint32_t PageCount = 0x110000 >> 8;
+
+    const FontFace* face;
+    std::vector<uint16_t> pages;            // PageCount entries
+    std::vector<uint64_t> bitmaps;          // 4 words per bitmap page
+
+public:
+    explicit FontCoverage(const FontFace& face);
+
+    const FontFace& GetFace() const { return *face; }
+
+    bool Covers(char32_t codePoint)
+    {
+        uint32_t page = codePoint >> 8;
+        if (page >= PageCount) return false;
+
+        uint16_t state = pages[page];
+        if (state == PageUnknown) state = BuildPage(page);
+
+        if (state == PageEmpty) return false;
+        if (state == PageFull) return true;
+
+        const uint64_t* bits = &bitmaps[(size_t)(state - PageBitmapBase) * 4];
+        uint32_t bit = codePoint & 0xFF;
+        return (bits[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    size_t GetMemoryUsage() const { return pages.size() * sizeof(uint16_t) + bitmaps.size() * sizeof(uint64_t); }
+
+private:
+    uint16_t BuildPage(uint32_t page);
+};
+
+struct FontRun
+{
+    uint32_t textStart;     // UTF-16 code units
+    uint32_t textLength;
+    uint32_t fontIndex;     // index into the fallback chain
+    bool missing;           // no face in the chain has these glyphs, fontIndex is 0
+};
+
+// Ordered list of faces tried for each code point, e.g. "Malgun Gothic", then a Latin face,
+// an emoji face and a CJK face.
+class FontFallback
+{
+    std::vector<FontCoverage> chain;
+
+public:
+    void AddFont(const FontFace& face);
+
+    size_t GetFontCount() const { return chain.size(); }
+    const FontFace& GetFont(size_t index) const { return chain[index].GetFace(); }
+
+    // Splits text into runs of the first face that covers each code point, in one pass.
+    // Spaces, combining marks, joiners and variation selectors stay with the current run's face
+    // when it covers them, so clusters and words are not split between faces.
+    // Runs are appended to 'runs'.
+    void Itemize(std::u16string_view text, std::vector<FontRun>& runs);
+
+    // Index of the first face covering the code point, or -1
+    int FindFont(char32_t codePoint);
+};
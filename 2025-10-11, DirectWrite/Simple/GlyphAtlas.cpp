@@ -0,0 +1,150 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // empty pixels around each glyph, so bilinear sampling does not bleed into neighbours
+    constexpr int Padding = 1;
+}
+
+void PlaceGlyphs(const ShapedGlyph* glyphs, size_t count, float originX, float baselineY, int buckets, std::vector<GlyphPlacement>& placements)
+{
+    float penX = originX;
+    for (size_t i = 0; i < count; i++)
+    {
+        const ShapedGlyph& glyph = glyphs[i];
+
+        float x = penX + glyph.offsetX;
+        float pixelX = floorf(x);
+        int bucket = (int)floorf((x - pixelX) * buckets + 0.5f);
+
+        // rounding up past the last bucket is the next whole pixel
+        if (bucket == buckets)
+        {
+            pixelX += 1.0f;
+            bucket = 0;
+        }
+
+        placements.push_back({ glyph.glyphIndex, (uint8_t)bucket, (int32_t)pixelX, (int32_t)floorf(baselineY + glyph.offsetY + 0.5f) });
+        penX += glyph.advance;
+    }
+}
+
+size_t GlyphAtlas::KeyHash::operator()(const Key& key) const
+{
+    uint32_t sizeBits;
+    memcpy(&sizeBits, &key.fontSize, sizeof(sizeBits));
+
+    uint64_t h = ((uint64_t)key.fontId << 32 | sizeBits) ^ ((uint64_t)key.glyphIndex << 8 | key.subpixelBucket) * 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 31)) * 0xBF58476D1CE4E5B9ull;
+    return (size_t)(h ^ (h >> 29));
+}
+
+GlyphAtlas::GlyphAtlas(int width, int height, int subpixelBuckets)
+    : width(width)
+    , height(height)
+    , buckets(subpixelBuckets < 1 ? 1 : subpixelBuckets)
+    , pixels((size_t)width * height, 0)
+    , usedPixels(0)
+    , hits(0)
+    , misses(0)
+    , generation(0)
+{
+}
+
+void GlyphAtlas::SetSubpixelBuckets(int buckets)
+{
+    if (buckets < 1) buckets = 1;
+    if (this->buckets == buckets) return;
+
+    this->buckets = buckets;
+    Clear();
+}
+
+void GlyphAtlas::Clear()
+{
+    std::fill(pixels.begin(), pixels.end(), (uint8_t)0);
+    shelves.clear();
+    glyphs.clear();
+    usedPixels = 0;
+    generation++;
+}
+
+bool GlyphAtlas::Allocate(int glyphWidth, int glyphHeight, int& x, int& y)
+{
+    int paddedWidth = glyphWidth + Padding;
+    int paddedHeight = glyphHeight + Padding;
+
+    // the shelf that wastes the least height
+    Shelf* best = nullptr;
+    for (Shelf& shelf : shelves)
+    {
+        if (shelf.height >= paddedHeight && shelf.nextX + paddedWidth <= width)
+        {
+            if (!best || shelf.height < best->height)
+                best = &shelf;
+        }
+    }
+
+    if (!best)
+    {
+        int top = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+        if (top + paddedHeight > height || paddedWidth > width) return false;
+
+        shelves.push_back({ top, paddedHeight, 0 });
+        best = &shelves.back();
+    }
+
+    x = best->nextX;
+    y = best->y;
+    best->nextX += paddedWidth;
+    return true;
+}
+
+const AtlasGlyph* GlyphAtlas::GetGlyph(GlyphRasterizer& rasterizer, const FontFace& face, float fontSize, const GlyphPlacement& placement)
+{
+    Key key { face.GetId(), fontSize, placement.glyphIndex, placement.subpixelBucket };
+
+    auto it = glyphs.find(key);
+    if (it != glyphs.end())
+    {
+        hits++;
+        return &it->second;
+    }
+
+    misses++;
+
+    float subpixelOffset = (float)placement.subpixelBucket / buckets;
+    if (!rasterizer.Rasterize(face, placement.glyphIndex, fontSize, subpixelOffset, scratch))
+        return nullptr;
+
+    AtlasGlyph glyph {};
+    glyph.width = (uint16_t)scratch.width;
+    glyph.height = (uint16_t)scratch.height;
+    glyph.bearingX = (int16_t)scratch.bearingX;
+    glyph.bearingY = (int16_t)scratch.bearingY;
+
+    // blank glyphs (spaces) take no atlas space
+    if (scratch.width > 0 && scratch.height > 0)
+    {
+        int x, y;
+        if (!Allocate(scratch.width, scratch.height, x, y)) return nullptr;
+
+        for (int row = 0; row < scratch.height; row++)
+            memcpy(&pixels[(size_t)(y + row) * width + x], &scratch.coverage[(size_t)row * scratch.width], scratch.width);
+
+        glyph.x = (uint16_t)x;
+        glyph.y = (uint16_t)y;
+        usedPixels += (size_t)scratch.width * scratch.height;
+    }
+
+    return &glyphs.emplace(key, glyph).first->second;
+}
+
+GlyphAtlasStats GlyphAtlas::GetStats() const
+{
+    return { glyphs.size(), usedPixels, pixels.size(), hits, misses };
+}
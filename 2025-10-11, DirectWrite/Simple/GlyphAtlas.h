@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "FontFace.h"
+#include "Shaper.h"
+
+// 8-bit coverage of one glyph. (bearingX, bearingY) is the offset of the top-left pixel from the
+// pen position on the baseline, y pointing down.
+struct GlyphBitmap
+{
+    int width;
+    int height;
+    int bearingX;
+    int bearingY;
+    std::vector<uint8_t> coverage;
+};
+
+class GlyphRasterizer
+{
+public:
+    virtual ~GlyphRasterizer() = default;
+
+    // Renders the glyph with its origin shifted right by subpixelOffset (0 <= offset < 1 pixel)
+    virtual bool Rasterize(const FontFace& face, uint16_t glyphIndex, float fontSize, float subpixelOffset, GlyphBitmap& bitmap) = 0;
+};
+
+struct AtlasGlyph
+{
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    int16_t bearingX;
+    int16_t bearingY;
+};
+
+// Where to draw one glyph: whole pixel pen position plus the subpixel variant to use
+struct GlyphPlacement
+{
+    uint16_t glyphIndex;
+    uint8_t subpixelBucket;
+    int32_t x;
+    int32_t y;
+};
+
+struct GlyphAtlasStats
+{
+    size_t glyphCount;      // distinct (glyph, size, subpixel variant) entries
+    size_t usedPixels;
+    size_t capacityPixels;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+// Splits fractional pen positions into a whole pixel and one of 'buckets' horizontal subpixel
+// variants. Glyph origins that land between pixels (centered text, animation) keep their position
+// to within 1 / (2 * buckets) pixel instead of jumping a whole pixel, while the atlas only holds
+// 'buckets' variants per glyph. buckets = 1 snaps to whole pixels.
+//
+// Appends one placement per glyph, starting at (originX, baselineY).
+void PlaceGlyphs(const ShapedGlyph* glyphs, size_t count, float originX, float baselineY, int buckets, std::vector<GlyphPlacement>& placements);
+
+// Largest horizontal position error introduced by PlaceGlyphs, in pixels
+inline float GetSubpixelPositionError(int buckets) { return 0.5f / buckets; }
+
+// Single-channel glyph cache texture (CPU side), shelf packed.
+// Entries are keyed by face, glyph, size and subpixel bucket, so each variant is rasterized once.
+class GlyphAtlas
+{
+    struct Key
+    {
+        uint32_t fontId;
+        float fontSize;
+        uint16_t glyphIndex;
+        uint8_t subpixelBucket;
+
+        bool operator==(const Key& other) const = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Shelf
+    {
+        int y;
+        int height;
+        int nextX;
+    };
+
+    int width;
+    int height;
+    int buckets;
+    std::vector<uint8_t> pixels;
+    std::vector<Shelf> shelves;
+    std::unordered_map<Key, AtlasGlyph, KeyHash> glyphs;
+    GlyphBitmap scratch;
+
+    size_t usedPixels;
+    uint64_t hits;
+    uint64_t misses;
+    uint32_t generation;
+
+public:
+    GlyphAtlas(int width, int height, int subpixelBuckets = 4);
+
+    int GetSubpixelBuckets() const { return buckets; }
+
+    // Changing the bucket count clears the atlas
+    void SetSubpixelBuckets(int buckets);
+
+    // Returns the atlas entry for the placement, rasterizing it on a miss.
+    // Returns nullptr if the rasterizer failed or the atlas is full; Clear() and draw again then.
+    const AtlasGlyph* GetGlyph(GlyphRasterizer& rasterizer, const FontFace& face, float fontSize, const GlyphPlacement& placement);
+
+    void Clear();
+
+    const uint8_t* GetPixels() const { return pixels.data(); }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    // Bumped whenever existing entries are invalidated, so uploaded copies know to refresh
+    uint32_t GetGeneration() const { return generation; }
+
+    GlyphAtlasStats GetStats() const;
+
+private:
+    bool Allocate(int glyphWidth, int glyphHeight, int& x, int& y);
+};
@@ -0,0 +1,544 @@
+#include "GlyphOutlineCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+    const uint32_t HeadTag = MakeFontTableTag('h', 'e', 'a', 'd');
+    const uint32_t LocaTag = MakeFontTableTag('l', 'o', 'c', 'a');
+    const uint32_t GlyfTag = MakeFontTableTag('g', 'l', 'y', 'f');
+
+    // Composite glyphs rarely nest more than two or three levels; the limit also ends cycles in
+    // corrupt fonts
+    const int MaxCompositeDepth = 8;
+
+    // Simple glyph point flags
+    const uint8_t OnCurvePoint = 0x01;
+    const uint8_t XShortVector = 0x02;
+    const uint8_t YShortVector = 0x04;
+    const uint8_t RepeatFlag = 0x08;
+    const uint8_t XIsSameOrPositive = 0x10;
+    const uint8_t YIsSameOrPositive = 0x20;
+
+    // Composite glyph component flags
+    const uint16_t ArgsAreWords = 0x0001;
+    const uint16_t ArgsAreXYValues = 0x0002;
+    const uint16_t HaveScale = 0x0008;
+    const uint16_t MoreComponents = 0x0020;
+    const uint16_t HaveXYScale = 0x0040;
+    const uint16_t HaveTwoByTwo = 0x0080;
+
+    // Places a component: x' = xx * x + yx * y + dx, y' = xy * x + yy * y + dy
+    struct Transform
+    {
+        float xx = 1, xy = 0, yx = 0, yy = 1;
+        float dx = 0, dy = 0;
+
+        // This transform applied after 'inner'
+        Transform Then(const Transform& inner) const
+        {
+            Transform result;
+            result.xx = xx * inner.xx + yx * inner.xy;
+            result.xy = xy * inner.xx + yy * inner.xy;
+            result.yx = xx * inner.yx + yx * inner.yy;
+            result.yy = xy * inner.yx + yy * inner.yy;
+            result.dx = xx * inner.dx + yx * inner.dy + dx;
+            result.dy = xy * inner.dx + yy * inner.dy + dy;
+            return result;
+        }
+    };
+
+    struct Point
+    {
+        float x;
+        float y;
+    };
+
+    Point Midpoint(const Point& a, const Point& b) { return { (a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f }; }
+
+    float ReadF2Dot14(const FontTableReader& t, size_t offset) { return t.S16(offset) / 16384.0f; }
+
+    class GlyfDecoder
+    {
+        FontTableReader loca;
+        FontTableReader glyf;
+        bool longOffsets;
+        GlyphOutlineSink& sink;
+
+        // Reused by the glyphs of a composite
+        std::vector<uint16_t> endPoints;
+        std::vector<uint8_t> flags;
+        std::vector<Point> points;
+
+    public:
+        GlyfDecoder(const FontTable& headTable, const FontTable& locaTable, const FontTable& glyfTable, GlyphOutlineSink& sink)
+            : loca { locaTable.data, locaTable.size }
+            , glyf { glyfTable.data, glyfTable.size }
+            , longOffsets(FontTableReader { headTable.data, headTable.size }.S16(50) == 1)
+            , sink(sink)
+        {
+        }
+
+        void Decode(uint16_t glyphIndex, const Transform& transform, int depth)
+        {
+            size_t start, end;
+            if (longOffsets)
+            {
+                if ((glyphIndex + 2) * (size_t)4 > loca.size) return;
+                start = loca.U32(glyphIndex * (size_t)4);
+                end = loca.U32((glyphIndex + 1) * (size_t)4);
+            }
+            else
+            {
+                if ((glyphIndex + 2) * (size_t)2 > loca.size) return;
+                start = loca.U16(glyphIndex * (size_t)2) * (size_t)2;
+                end = loca.U16((glyphIndex + 1) * (size_t)2) * (size_t)2;
+            }
+
+            // an empty range is a glyph without contours, such as the space
+            if (end > glyf.size || start + 10 > end) return;
+
+            int16_t contourCount = glyf.S16(start);
+            if (contourCount >= 0)
+                DecodeSimple(start + 10, end, contourCount, transform);
+            else if (depth < MaxCompositeDepth)
+                DecodeComposite(start + 10, end, transform, depth);
+        }
+
+    private:
+        // Reads every point before emitting any, so a corrupt glyph draws nothing rather than
+        // half of itself
+        void DecodeSimple(size_t offset, size_t end, size_t contourCount, const Transform& transform)
+        {
+            endPoints.resize(contourCount);
+            for (size_t i = 0; i < contourCount; i++)
+            {
+                endPoints[i] = glyf.U16(offset + i * 2);
+                if (i > 0 && endPoints[i] <= endPoints[i - 1]) return;
+            }
+
+            size_t pointCount = contourCount == 0 ? 0 : endPoints.back() + (size_t)1;
+            offset += contourCount * 2;
+            offset += 2 + glyf.U16(offset);
+
+            flags.clear();
+            while (flags.size() < pointCount && offset < end)
+            {
+                uint8_t flag = glyf.U8(offset++);
+                size_t repeat = flag & RepeatFlag ? glyf.U8(offset++) + (size_t)1 : 1;
+                flags.insert(flags.end(), std::min(repeat, pointCount - flags.size()), flag);
+            }
+
+            if (flags.size() < pointCount) return;
+
+            points.resize(pointCount);
+            int32_t x = 0;
+            for (size_t i = 0; i < pointCount; i++)
+            {
+                if (flags[i] & XShortVector)
+                {
+                    int32_t delta = glyf.U8(offset++);
+                    x += flags[i] & XIsSameOrPositive ? delta : -delta;
+                }
+                else if (!(flags[i] & XIsSameOrPositive))
+                {
+                    x += glyf.S16(offset);
+                    offset += 2;
+                }
+
+                points[i].x = (float)x;
+            }
+
+            int32_t y = 0;
+            for (size_t i = 0; i < pointCount; i++)
+            {
+                if (flags[i] & YShortVector)
+                {
+                    int32_t delta = glyf.U8(offset++);
+                    y += flags[i] & YIsSameOrPositive ? delta : -delta;
+                }
+                else if (!(flags[i] & YIsSameOrPositive))
+                {
+                    y += glyf.S16(offset);
+                    offset += 2;
+                }
+
+                points[i].y = (float)y;
+            }
+
+            if (offset > end) return;
+
+            for (Point& point : points)
+            {
+                point = { transform.xx * point.x + transform.yx * point.y + transform.dx,
+                          transform.xy * point.x + transform.yy * point.y + transform.dy };
+            }
+
+            size_t first = 0;
+            for (uint16_t last : endPoints)
+            {
+                EmitContour(first, last);
+                first = last + (size_t)1;
+            }
+        }
+
+        // Quadratic B-spline to segments: two off-curve points in a row imply an on-curve point
+        // halfway between them. A contour may start off the curve, at the last point or at the
+        // midpoint of the first and the last.
+        void EmitContour(size_t first, size_t last)
+        {
+            // single points are hinting anchors and draw nothing
+            if (last == first) return;
+
+            auto onCurve = [&](size_t i) { return (flags[i] & OnCurvePoint) != 0; };
+
+            Point start;
+            size_t begin = first, end = last + 1;
+            if (onCurve(first))
+            {
+                start = points[first];
+                begin = first + 1;
+            }
+            else if (onCurve(last))
+            {
+                start = points[last];
+                end = last;
+            }
+            else
+            {
+                start = Midpoint(points[first], points[last]);
+            }
+
+            sink.MoveTo(start.x, start.y);
+
+            bool hasControl = false;
+            Point control = {};
+            for (size_t i = begin; i < end; i++)
+            {
+                const Point& point = points[i];
+                if (onCurve(i))
+                {
+                    if (hasControl) sink.QuadTo(control.x, control.y, point.x, point.y);
+                    else sink.LineTo(point.x, point.y);
+                    hasControl = false;
+                }
+                else
+                {
+                    if (hasControl)
+                    {
+                        Point middle = Midpoint(control, point);
+                        sink.QuadTo(control.x, control.y, middle.x, middle.y);
+                    }
+
+                    control = point;
+                    hasControl = true;
+                }
+            }
+
+            if (hasControl) sink.QuadTo(control.x, control.y, start.x, start.y);
+            sink.Close();
+        }
+
+        // Components that attach by point numbers instead of offsets are placed at their origin;
+        // offsets are never scaled, as in fonts without SCALED_COMPONENT_OFFSET
+        void DecodeComposite(size_t offset, size_t end, const Transform& transform, int depth)
+        {
+            uint16_t componentFlags;
+            do
+            {
+                if (offset + 4 > end) return;
+                componentFlags = glyf.U16(offset);
+                uint16_t component = glyf.U16(offset + 2);
+                offset += 4;
+
+                Transform local;
+                if (componentFlags & ArgsAreWords)
+                {
+                    local.dx = glyf.S16(offset);
+                    local.dy = glyf.S16(offset + 2);
+                    offset += 4;
+                }
+                else
+                {
+                    local.dx = (int8_t)glyf.U8(offset);
+                    local.dy = (int8_t)glyf.U8(offset + 1);
+                    offset += 2;
+                }
+
+                if (!(componentFlags & ArgsAreXYValues))
+                    local.dx = local.dy = 0;
+
+                if (componentFlags & HaveScale)
+                {
+                    local.xx = local.yy = ReadF2Dot14(glyf, offset);
+                    offset += 2;
+                }
+                else if (componentFlags & HaveXYScale)
+                {
+                    local.xx = ReadF2Dot14(glyf, offset);
+                    local.yy = ReadF2Dot14(glyf, offset + 2);
+                    offset += 4;
+                }
+                else if (componentFlags & HaveTwoByTwo)
+                {
+                    local.xx = ReadF2Dot14(glyf, offset);
+                    local.xy = ReadF2Dot14(glyf, offset + 2);
+                    local.yx = ReadF2Dot14(glyf, offset + 4);
+                    local.yy = ReadF2Dot14(glyf, offset + 6);
+                    offset += 8;
+                }
+
+                if (offset > end) return;
+                Decode(component, transform.Then(local), depth + 1);
+            }
+            while (componentFlags & MoreComponents);
+        }
+    };
+
+    // Collects what the face decodes, before it is copied into the arena
+    class OutlineRecorder : public GlyphOutlineSink
+    {
+    public:
+        std::vector<OutlinePoint> points;
+        std::vector<OutlineVerb> verbs;
+
+        void MoveTo(float x, float y) override { Add(OutlineVerb::MoveTo, x, y); }
+        void LineTo(float x, float y) override { Add(OutlineVerb::LineTo, x, y); }
+
+        void QuadTo(float cx, float cy, float x, float y) override
+        {
+            AddPoint(cx, cy);
+            Add(OutlineVerb::QuadTo, x, y);
+        }
+
+        void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) override
+        {
+            AddPoint(c1x, c1y);
+            AddPoint(c2x, c2y);
+            Add(OutlineVerb::CubicTo, x, y);
+        }
+
+        void Close() override { verbs.push_back(OutlineVerb::Close); }
+
+    private:
+        static int16_t ToDesignUnits(float value)
+        {
+            return (int16_t)std::clamp(std::lround(value), (long)INT16_MIN, (long)INT16_MAX);
+        }
+
+        void AddPoint(float x, float y) { points.push_back({ ToDesignUnits(x), ToDesignUnits(y) }); }
+
+        void Add(OutlineVerb verb, float x, float y)
+        {
+            AddPoint(x, y);
+            verbs.push_back(verb);
+        }
+    };
+}
+
+bool DecodeTrueTypeOutline(const FontFace& face, uint16_t glyphIndex, GlyphOutlineSink& sink)
+{
+    FontTable head = face.GetFontTable(HeadTag);
+    FontTable loca = face.GetFontTable(LocaTag);
+    FontTable glyf = face.GetFontTable(GlyfTag);
+    if (!head.data || !loca.data || !glyf.data) return false;
+
+    GlyfDecoder(head, loca, glyf, sink).Decode(glyphIndex, Transform(), 0);
+    return true;
+}
+
+void GlyphOutline::Emit(float fontSize, float originX, float baselineY, GlyphOutlineSink& sink) const
+{
+    float scale = fontSize / designUnitsPerEm;
+    const OutlinePoint* p = points;
+
+    auto x = [&](int i) { return originX + p[i].x * scale; };
+    auto y = [&](int i) { return baselineY - p[i].y * scale; };
+
+    for (uint32_t i = 0; i < verbCount; i++)
+    {
+        switch (verbs[i])
+        {
+        case OutlineVerb::MoveTo:
+            sink.MoveTo(x(0), y(0));
+            p += 1;
+            break;
+
+        case OutlineVerb::LineTo:
+            sink.LineTo(x(0), y(0));
+            p += 1;
+            break;
+
+        case OutlineVerb::QuadTo:
+            sink.QuadTo(x(0), y(0), x(1), y(1));
+            p += 2;
+            break;
+
+        case OutlineVerb::CubicTo:
+            sink.CubicTo(x(0), y(0), x(1), y(1), x(2), y(2));
+            p += 3;
+            break;
+
+        case OutlineVerb::Close:
+            sink.Close();
+            break;
+        }
+    }
+}
+
+GlyphOutlineCache::GlyphOutlineCache(size_t byteBudget)
+    : byteBudget(byteBudget)
+    , bytes(0)
+    , evictions(0)
+    , hits(0)
+    , misses(0)
+    , decodeNanoseconds(0)
+{
+}
+
+GlyphOutline GlyphOutlineCache::MakeOutline(const Entry& entry) const
+{
+    GlyphOutline outline;
+    outline.storage = entry.chunk;
+    outline.points = (const OutlinePoint*)(entry.chunk->data.get() + entry.offset);
+    outline.verbs = (const OutlineVerb*)(outline.points + entry.pointCount);
+    outline.pointCount = entry.pointCount;
+    outline.verbCount = entry.verbCount;
+    outline.designUnitsPerEm = entry.designUnitsPerEm;
+    return outline;
+}
+
+GlyphOutline GlyphOutlineCache::GetOutline(const FontFace& face, uint16_t glyphIndex)
+{
+    uint32_t fontId = face.GetId();
+    uint64_t key = MakeKey(fontId, glyphIndex);
+
+    {
+        std::shared_lock lock(mutex);
+
+        auto it = entries.find(key);
+        if (it != entries.end())
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return MakeOutline(it->second);
+        }
+
+        if (facesWithoutOutlines.count(fontId) != 0) return GlyphOutline();
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+
+    auto start = std::chrono::steady_clock::now();
+    OutlineRecorder recorder;
+    bool hasOutlines = DecodeTrueTypeOutline(face, glyphIndex, recorder) || face.GetGlyphOutline(glyphIndex, recorder);
+    auto end = std::chrono::steady_clock::now();
+    decodeNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+
+    std::unique_lock lock(mutex);
+
+    if (!hasOutlines)
+    {
+        facesWithoutOutlines.insert(fontId);
+        return GlyphOutline();
+    }
+
+    // another thread may have decoded the same glyph meanwhile
+    auto it = entries.find(key);
+    if (it != entries.end()) return MakeOutline(it->second);
+
+    size_t pointBytes = recorder.points.size() * sizeof(OutlinePoint);
+    size_t verbBytes = recorder.verbs.size() * sizeof(OutlineVerb);
+
+    Entry entry;
+    entry.pointCount = (uint32_t)recorder.points.size();
+    entry.verbCount = (uint32_t)recorder.verbs.size();
+    entry.designUnitsPerEm = face.GetMetrics().designUnitsPerEm;
+
+    uint8_t* data = Allocate(pointBytes + verbBytes, entry.chunk, entry.offset);
+    if (pointBytes != 0) std::memcpy(data, recorder.points.data(), pointBytes);
+    if (verbBytes != 0) std::memcpy(data + pointBytes, recorder.verbs.data(), verbBytes);
+    entry.chunk->keys.push_back(key);
+
+    return MakeOutline(entries.emplace(key, std::move(entry)).first->second);
+}
+
+uint8_t* GlyphOutlineCache::Allocate(size_t size, std::shared_ptr<Chunk>& chunk, uint32_t& offset)
+{
+    // keep points 4 byte aligned
+    size = (size + 3) & ~(size_t)3;
+
+    if (chunks.empty() || chunks.back()->capacity - chunks.back()->used < size)
+    {
+        size_t capacity = std::max(ChunkSize, size);
+        while (!chunks.empty() && bytes + capacity > byteBudget)
+            RetireOldestChunk();
+
+        auto next = std::make_shared<Chunk>();
+        next->data = std::make_unique<uint8_t[]>(capacity);
+        next->capacity = capacity;
+        next->used = 0;
+
+        chunks.push_back(std::move(next));
+        bytes += capacity;
+    }
+
+    chunk = chunks.back();
+    offset = (uint32_t)chunk->used;
+    chunk->used += size;
+    return chunk->data.get() + offset;
+}
+
+void GlyphOutlineCache::RetireOldestChunk()
+{
+    std::shared_ptr<Chunk> chunk = std::move(chunks.front());
+    chunks.pop_front();
+    bytes -= chunk->capacity;
+
+    for (uint64_t key : chunk->keys)
+    {
+        auto it = entries.find(key);
+        if (it != entries.end() && it->second.chunk == chunk)
+        {
+            entries.erase(it);
+            evictions++;
+        }
+    }
+}
+
+void GlyphOutlineCache::Clear()
+{
+    std::unique_lock lock(mutex);
+
+    entries.clear();
+    facesWithoutOutlines.clear();
+    chunks.clear();
+    bytes = 0;
+}
+
+GlyphOutlineCacheStats GlyphOutlineCache::GetStats() const
+{
+    std::shared_lock lock(mutex);
+
+    GlyphOutlineCacheStats result;
+    result.hits = hits.load(std::memory_order_relaxed);
+    result.misses = misses.load(std::memory_order_relaxed);
+    result.evictions = evictions;
+    result.decodeMicroseconds = decodeNanoseconds.load(std::memory_order_relaxed) / 1000.0;
+    result.glyphCount = entries.size();
+    result.bytes = bytes;
+    return result;
+}
+
+void GlyphOutlineCache::ResetStats()
+{
+    std::unique_lock lock(mutex);
+
+    hits = 0;
+    misses = 0;
+    decodeNanoseconds = 0;
+    evictions = 0;
+}
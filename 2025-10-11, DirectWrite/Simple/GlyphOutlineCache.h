@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "FontFace.h"
+
+enum class OutlineVerb : uint8_t
+{
+    MoveTo,
+    LineTo,
+    QuadTo,     // one control point, then the end point
+    CubicTo,    // two control points, then the end point
+    Close,
+};
+
+// Design unit coordinates; glyf coordinates are 16-bit, CFF ones are rounded to whole units
+struct OutlinePoint
+{
+    int16_t x;
+    int16_t y;
+};
+
+// Unscaled contours of one glyph, stored in a GlyphOutlineCache arena.
+// Keeps its arena chunk alive, so it stays valid after the glyph is evicted.
+class GlyphOutline
+{
+    friend class GlyphOutlineCache;
+
+    std::shared_ptr<const void> storage;
+    const OutlinePoint* points = nullptr;
+    const OutlineVerb* verbs = nullptr;
+    uint32_t pointCount = 0;
+    uint32_t verbCount = 0;
+    uint16_t designUnitsPerEm = 0;
+
+public:
+    // False if the face has no outlines
+    explicit operator bool() const { return storage != nullptr; }
+
+    const OutlinePoint* GetPoints() const { return points; }
+    const OutlineVerb* GetVerbs() const { return verbs; }
+    uint32_t GetPointCount() const { return pointCount; }
+    uint32_t GetVerbCount() const { return verbCount; }
+    uint16_t GetDesignUnitsPerEm() const { return designUnitsPerEm; }
+
+    // Replays the contours scaled to fontSize pixels per em, with y pointing down and the glyph
+    // origin at (originX, baselineY)
+    void Emit(float fontSize, float originX, float baselineY, GlyphOutlineSink& sink) const;
+};
+
+struct GlyphOutlineCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;         // glyphs dropped with their chunk
+    double decodeMicroseconds;  // spent decoding glyf or in FontFace::GetGlyphOutline
+    size_t glyphCount;
+    size_t bytes;               // arena chunks, including unused tails
+};
+
+// Decodes the glyph's TrueType contours, composite glyphs included, from the face's head, loca and
+// glyf tables into 'sink'. Returns false if the face does not expose those tables, as CFF fonts do
+// not have them; a corrupt glyph decodes to nothing.
+bool DecodeTrueTypeOutline(const FontFace& face, uint16_t glyphIndex, GlyphOutlineSink& sink);
+
+// Decoded glyph contours keyed by (face, glyph) only, so a DPI or zoom change that changes every
+// font size re-rasterizes from the cache with a scale transform instead of parsing glyf/CFF again.
+// Outlines come from DecodeTrueTypeOutline, or from FontFace::GetGlyphOutline for faces without
+// a glyf table.
+//
+// Outlines are packed into 64 KB arena chunks at 4 + 1 bytes per point and verb. When a new chunk
+// would exceed the byte budget the oldest chunk is dropped with every glyph in it, which keeps
+// eviction O(glyphs in the chunk) with no per-glyph bookkeeping. Outlines handed out share
+// ownership of their chunk, so eviction never invalidates a glyph another thread is drawing.
+//
+// Safe to use from several threads: lookups take a shared lock, and outlines are decoded outside
+// the lock, so a slow font parse does not block other readers.
+class GlyphOutlineCache
+{
+    struct Chunk
+    {
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity;
+        size_t used;
+        std::vector<uint64_t> keys;
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<Chunk> chunk;
+        uint32_t offset;
+        uint32_t pointCount;
+        uint32_t verbCount;
+        uint16_t designUnitsPerEm;
+    };
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::unordered_set<uint32_t> facesWithoutOutlines;
+    std::deque<std::shared_ptr<Chunk>> chunks;  // oldest first
+    size_t byteBudget;
+    size_t bytes;
+    uint64_t evictions;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> decodeNanoseconds;
+
+public:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    explicit GlyphOutlineCache(size_t byteBudget = 4 * 1024 * 1024);
+
+    // Returns the glyph's outline, decoding it on a miss. The result is empty (false) if the
+    // face provides no outlines.
+    GlyphOutline GetOutline(const FontFace& face, uint16_t glyphIndex);
+
+    void Clear();
+    GlyphOutlineCacheStats GetStats() const;
+    void ResetStats();
+
+private:
+    static uint64_t MakeKey(uint32_t fontId, uint16_t glyphIndex) { return ((uint64_t)fontId << 16) | glyphIndex; }
+
+    GlyphOutline MakeOutline(const Entry& entry) const;
+    uint8_t* Allocate(size_t size, std::shared_ptr<Chunk>& chunk, uint32_t& offset);
+    void RetireOldestChunk();
+};
@@ -0,0 +1,55 @@
+#include "Hangul.h"
+
+namespace Hangul
+{
+    // All conjoining jamo and syllables are in the BMP, so UTF-16 code units can be processed
+    // directly; surrogates never match and are copied through.
+
+    void DecomposeText(std::u16string_view text, std::u16string& out)
+    {
+        out.reserve(out.size() + text.size());
+
+        size_t runStart = 0;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            char32_t c = text[i];
+            if (!IsSyllable(c)) continue;
+
+            out.append(text.data() + runStart, i - runStart);
+
+            char32_t jamo[3];
+            size_t count = Decompose(c, jamo);
+            for (size_t j = 0; j < count; j++)
+                out.push_back((char16_t)jamo[j]);
+
+            runStart = i + 1;
+        }
+
+        out.append(text.data() + runStart, text.size() - runStart);
+    }
+
+    void ComposeText(std::u16string_view text, std::u16string& out)
+    {
+        out.reserve(out.size() + text.size());
+
+        size_t outStart = out.size();
+        size_t runStart = 0;
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            // only vowels and trailing consonants can compose with what precedes them
+            char32_t c = text[i];
+            if (!IsVowelJamo(c) && !IsTrailingJamo(c)) continue;
+
+            out.append(text.data() + runStart, i - runStart);
+            runStart = i + 1;
+
+            char32_t composed = out.size() > outStart ? Compose(out.back(), c) : 0;
+            if (composed != 0)
+                out.back() = (char16_t)composed;
+            else
+                out.push_back((char16_t)c);
+        }
+
+        out.append(text.data() + runStart, text.size() - runStart);
+    }
+}
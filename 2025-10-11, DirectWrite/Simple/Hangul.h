@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Arithmetic Hangul composition and decomposition (Unicode chapter 3.12).
+// Precomposed syllables are laid out as ((L * VCount) + V) * TCount + T from U+AC00,
+// so no table lookups are needed.
+namespace Hangul
+{
+    constexpr char32_t SBase = 0xAC00;
+    constexpr char32_t LBase = 0x1100;
+    constexpr char32_t VBase = 0x1161;
+    constexpr char32_t TBase = 0x11A7; // TIndex 0 means no trailing consonant
+    constexpr char32_t LCount = 19;
+    constexpr char32_t VCount = 21;
+    constexpr char32_t TCount = 28;
+    constexpr char32_t NCount = VCount * TCount;
+    constexpr char32_t SCount = LCount * NCount;
+
+    inline bool IsSyllable(char32_t c) { return c - SBase < SCount; }
+    inline bool IsLeadingJamo(char32_t c) { return c - LBase < LCount; }
+    inline bool IsVowelJamo(char32_t c) { return c - VBase < VCount; }
+    inline bool IsTrailingJamo(char32_t c) { return c - (TBase + 1) < TCount - 1; }
+
+    // LV syllables have no trailing consonant and can still take one
+    inline bool IsLVSyllable(char32_t c) { return IsSyllable(c) && (c - SBase) % TCount == 0; }
+
+    // Writes the canonical decomposition of a syllable (2 or 3 conjoining jamo) and returns the count.
+    // Returns 0 if c is not a precomposed syllable.
+    inline size_t Decompose(char32_t c, char32_t out[3])
+    {
+        if (!IsSyllable(c)) return 0;
+
+        char32_t sIndex = c - SBase;
+        out[0] = LBase + sIndex / NCount;
+        out[1] = VBase + (sIndex % NCount) / TCount;
+
+        char32_t tIndex = sIndex % TCount;
+        if (tIndex == 0) return 2;
+
+        out[2] = TBase + tIndex;
+        return 3;
+    }
+
+    // Canonical composition of a pair (L + V or LV + T). Returns 0 if the pair does not compose.
+    inline char32_t Compose(char32_t first, char32_t second)
+    {
+        if (IsLeadingJamo(first) && IsVowelJamo(second))
+            return SBase + ((first - LBase) * VCount + (second - VBase)) * TCount;
+
+        if (IsLVSyllable(first) && IsTrailingJamo(second))
+            return first + (second - TBase);
+
+        return 0;
+    }
+
+    // NFD/NFC of Hangul in UTF-16 text. Only Hangul is (de)composed; other code points are copied
+    // unchanged, so the result is the full normalization form only for text without other
+    // decomposable characters. Output is appended to 'out'.
+    void DecomposeText(std::u16string_view text, std::u16string& out);
+    void ComposeText(std::u16string_view text, std::u16string& out);
+}
@@ -0,0 +1,530 @@
+#include "KerningTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+
+#include "Shaper.h"
+
+namespace
+{
+    const uint32_t GposTag = MakeFontTableTag('G', 'P', 'O', 'S');
+    const uint32_t KernTag = MakeFontTableTag('k', 'e', 'r', 'n');
+    const uint32_t KernFeatureTag = MakeFontTableTag('k', 'e', 'r', 'n');
+
+    const uint16_t PairAdjustmentLookup = 2;
+    const uint16_t ExtensionLookup = 9;
+
+    const size_t NoValue = SIZE_MAX;
+
+    size_t GetValueRecordSize(uint16_t valueFormat)
+    {
+        return 2 * (size_t)std::popcount((unsigned)(valueFormat & 0xFF));
+    }
+
+    // Offset of XAdvance inside a value record of the format, NoValue if it has none
+    size_t GetXAdvanceOffset(uint16_t valueFormat)
+    {
+        return valueFormat & 0x4 ? GetValueRecordSize(valueFormat & 0x3) : NoValue;
+    }
+
+    // Index of the glyph in a Coverage table, -1 if it is not covered
+    int32_t FindCoverageIndex(const FontTableReader& t, size_t coverage, uint16_t glyph)
+    {
+        uint16_t format = t.U16(coverage);
+        uint32_t low = 0;
+        uint32_t high = t.U16(coverage + 2);
+
+        if (format == 1)
+        {
+            while (low < high)
+            {
+                uint32_t middle = (low + high) / 2;
+                uint16_t value = t.U16(coverage + 4 + middle * 2);
+                if (value == glyph) return (int32_t)middle;
+                if (value < glyph) low = middle + 1; else high = middle;
+            }
+        }
+        else if (format == 2)
+        {
+            while (low < high)
+            {
+                uint32_t middle = (low + high) / 2;
+                size_t range = coverage + 4 + middle * 6;
+                if (glyph < t.U16(range)) high = middle;
+                else if (glyph > t.U16(range + 2)) low = middle + 1;
+                else return t.U16(range + 4) + glyph - t.U16(range);
+            }
+        }
+
+        return -1;
+    }
+
+    // Class of the glyph in a ClassDef table; glyphs it does not list are class 0
+    uint16_t GetGlyphClass(const FontTableReader& t, size_t classDef, uint16_t glyph)
+    {
+        uint16_t format = t.U16(classDef);
+        if (format == 1)
+        {
+            uint16_t start = t.U16(classDef + 2);
+            uint16_t count = t.U16(classDef + 4);
+            return glyph >= start && glyph - start < count ? t.U16(classDef + 6 + (size_t)(glyph - start) * 2) : 0;
+        }
+
+        if (format == 2)
+        {
+            uint32_t low = 0;
+            uint32_t high = t.U16(classDef + 2);
+            while (low < high)
+            {
+                uint32_t middle = (low + high) / 2;
+                size_t range = classDef + 4 + middle * 6;
+                if (glyph < t.U16(range)) high = middle;
+                else if (glyph > t.U16(range + 2)) low = middle + 1;
+                else return t.U16(range + 4);
+            }
+        }
+
+        return 0;
+    }
+
+    // Header fields shared by both PairPos formats
+    struct PairPos
+    {
+        uint16_t format;
+        size_t coverage;
+        size_t recordSize;      // value record 1 and 2
+        size_t xAdvance;        // inside value record 1
+
+        PairPos(const FontTableReader& t, size_t subtable)
+            : format(t.U16(subtable))
+            , coverage(subtable + t.U16(subtable + 2))
+            , recordSize(GetValueRecordSize(t.U16(subtable + 4)) + GetValueRecordSize(t.U16(subtable + 6)))
+            , xAdvance(GetXAdvanceOffset(t.U16(subtable + 4)))
+        {
+        }
+
+        int32_t ReadValue(const FontTableReader& t, size_t record) const { return xAdvance == NoValue ? 0 : t.S16(record + xAdvance); }
+    };
+
+    // Returns true if the PairPos subtable has an entry for the pair, which ends the search in its
+    // lookup, and the adjustment in 'value'
+    bool ReadPairAdjustment(const FontTableReader& t, size_t subtable, uint16_t left, uint16_t right, int32_t& value)
+    {
+        PairPos pairPos(t, subtable);
+
+        int32_t coverageIndex = FindCoverageIndex(t, pairPos.coverage, left);
+        if (coverageIndex < 0) return false;
+
+        if (pairPos.format == 1)
+        {
+            if (coverageIndex >= t.U16(subtable + 8)) return false;
+
+            // pair value records sorted by second glyph
+            size_t pairSet = subtable + t.U16(subtable + 10 + (size_t)coverageIndex * 2);
+            size_t stride = 2 + pairPos.recordSize;
+            uint32_t low = 0;
+            uint32_t high = t.U16(pairSet);
+            while (low < high)
+            {
+                uint32_t middle = (low + high) / 2;
+                size_t record = pairSet + 2 + middle * stride;
+                uint16_t second = t.U16(record);
+                if (second == right)
+                {
+                    value = pairPos.ReadValue(t, record + 2);
+                    return true;
+                }
+
+                if (second < right) low = middle + 1; else high = middle;
+            }
+
+            return false;
+        }
+
+        if (pairPos.format == 2)
+        {
+            uint16_t class1Count = t.U16(subtable + 12);
+            uint16_t class2Count = t.U16(subtable + 14);
+            uint16_t class1 = GetGlyphClass(t, subtable + t.U16(subtable + 8), left);
+            uint16_t class2 = GetGlyphClass(t, subtable + t.U16(subtable + 10), right);
+            if (class1 >= class1Count || class2 >= class2Count) return false;
+
+            value = pairPos.ReadValue(t, subtable + 16 + ((size_t)class1 * class2Count + class2) * pairPos.recordSize);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Format 0 kern subtable: header, then pairs sorted by (left, right)
+    struct KernSubtable
+    {
+        size_t pairs;
+        uint16_t pairCount;
+        bool override;
+
+        KernSubtable(const FontTableReader& t, size_t subtable)
+            : pairs(subtable + 14)
+            , pairCount(t.U16(subtable + 6))
+            , override((t.U16(subtable + 4) & 0x8) != 0)
+        {
+        }
+    };
+}
+
+KerningTable::KerningTable(const FontFace& face, const std::vector<uint16_t>& glyphs)
+    : face(&face)
+    , source(KerningSource::FontFace)
+    , table { nullptr, 0 }
+    , glyphCount(0)
+{
+    ReadGpos();
+    if (lookups.empty()) ReadKern();
+
+    std::vector<uint16_t> unique = glyphs;
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    if (unique.size() >= NotFlattened) unique.resize(NotFlattened - 1);
+
+    glyphCount = (uint32_t)unique.size();
+    if (glyphCount == 0) return;
+
+    denseIndex.assign((size_t)unique.back() + 1, NotFlattened);
+    for (uint32_t i = 0; i < glyphCount; i++)
+        denseIndex[unique[i]] = (uint16_t)i;
+
+    std::vector<int32_t> values((size_t)glyphCount * glyphCount, 0);
+    Flatten(unique, values);
+
+    // the shared zero row
+    rows.assign(glyphCount, 0);
+    rowOffset.assign(glyphCount, 0);
+
+    for (uint32_t left = 0; left < glyphCount; left++)
+    {
+        int32_t* row = &values[(size_t)left * glyphCount];
+
+        bool kerned = false;
+        for (uint32_t right = 0; right < glyphCount; right++)
+        {
+            // INT16_MIN marks values that only the full lookup can return
+            if (row[right] <= INT16_MIN || row[right] > INT16_MAX) row[right] = INT16_MIN;
+            kerned |= row[right] != 0;
+        }
+
+        if (kerned)
+        {
+            rowOffset[left] = (uint32_t)rows.size();
+            rows.insert(rows.end(), row, row + glyphCount);
+        }
+    }
+}
+
+void KerningTable::ReadGpos()
+{
+    FontTable gpos = face->GetFontTable(GposTag);
+    FontTableReader t { gpos.data, gpos.size };
+    if (t.U16(0) != 1) return;
+
+    size_t featureList = t.U16(6);
+    size_t lookupList = t.U16(8);
+
+    // lookups apply in lookup list order, however the features list them
+    std::vector<uint16_t> lookupIndices;
+    uint16_t featureCount = t.U16(featureList);
+    for (size_t i = 0; i < featureCount; i++)
+    {
+        size_t record = featureList + 2 + i * 6;
+        if (t.U32(record) != KernFeatureTag) continue;
+
+        size_t feature = featureList + t.U16(record + 4);
+        uint16_t count = t.U16(feature + 2);
+        for (size_t k = 0; k < count; k++)
+            lookupIndices.push_back(t.U16(feature + 4 + k * 2));
+    }
+
+    std::sort(lookupIndices.begin(), lookupIndices.end());
+    lookupIndices.erase(std::unique(lookupIndices.begin(), lookupIndices.end()), lookupIndices.end());
+
+    uint16_t lookupCount = t.U16(lookupList);
+    for (uint16_t index : lookupIndices)
+    {
+        if (index >= lookupCount) break;
+
+        size_t lookup = lookupList + t.U16(lookupList + 2 + (size_t)index * 2);
+        uint16_t type = t.U16(lookup);
+        uint16_t subtableCount = t.U16(lookup + 4);
+
+        PairLookup pairLookup = { (uint32_t)pairSubtables.size(), 0 };
+        for (size_t k = 0; k < subtableCount; k++)
+        {
+            size_t subtable = lookup + t.U16(lookup + 6 + k * 2);
+            uint16_t subtableType = type;
+
+            if (type == ExtensionLookup && t.U16(subtable) == 1)
+            {
+                subtableType = t.U16(subtable + 2);
+                subtable += t.U32(subtable + 4);
+            }
+
+            uint16_t format = t.U16(subtable);
+            if (subtableType == PairAdjustmentLookup && (format == 1 || format == 2) && subtable < gpos.size)
+            {
+                pairSubtables.push_back((uint32_t)subtable);
+                pairLookup.subtableCount++;
+            }
+        }
+
+        if (pairLookup.subtableCount > 0)
+            lookups.push_back(pairLookup);
+    }
+
+    if (!lookups.empty())
+    {
+        source = KerningSource::Gpos;
+        table = gpos;
+    }
+}
+
+void KerningTable::ReadKern()
+{
+    FontTable kern = face->GetFontTable(KernTag);
+    FontTableReader t { kern.data, kern.size };
+
+    // version 0 only; Apple's version 1 tables start with a 32-bit 1.0
+    if (kern.size < 4 || t.U16(0) != 0) return;
+
+    size_t subtable = 4;
+    uint16_t subtableCount = t.U16(2);
+    for (size_t i = 0; i < subtableCount && subtable < kern.size; i++)
+    {
+        uint16_t length = t.U16(subtable + 2);
+        uint16_t coverage = t.U16(subtable + 4);
+
+        // format 0, horizontal, not minimum values, not cross-stream
+        if ((coverage >> 8) == 0 && (coverage & 0x7) == 0x1)
+            pairSubtables.push_back((uint32_t)subtable);
+
+        // fonts with more than 10920 pairs overflow 'length'; their one subtable is the last
+        if (length < 6) break;
+        subtable += length;
+    }
+
+    if (!pairSubtables.empty())
+    {
+        source = KerningSource::Kern;
+        table = kern;
+    }
+}
+
+void KerningTable::Flatten(const std::vector<uint16_t>& glyphs, std::vector<int32_t>& values) const
+{
+    FontTableReader t { table.data, table.size };
+    size_t count = glyphs.size();
+
+    auto dense = [&](uint16_t glyph)
+    {
+        return glyph < denseIndex.size() ? denseIndex[glyph] : NotFlattened;
+    };
+
+    if (source == KerningSource::FontFace)
+    {
+        for (size_t left = 0; left < count; left++)
+        {
+            for (size_t right = 0; right < count; right++)
+                values[left * count + right] = face->GetKerning(glyphs[left], glyphs[right]);
+        }
+    }
+    else if (source == KerningSource::Kern)
+    {
+        // walk the pair lists once instead of looking up every pair
+        for (uint32_t subtable : pairSubtables)
+        {
+            KernSubtable kern(t, subtable);
+            for (size_t i = 0; i < kern.pairCount; i++)
+            {
+                size_t pair = kern.pairs + i * 6;
+                uint16_t left = dense(t.U16(pair));
+                uint16_t right = dense(t.U16(pair + 2));
+                if (left == NotFlattened || right == NotFlattened) continue;
+
+                int32_t& value = values[(size_t)left * count + right];
+                value = kern.override ? t.S16(pair + 4) : value + t.S16(pair + 4);
+            }
+        }
+    }
+    else
+    {
+        // within a lookup the first subtable with an entry for a pair decides it
+        std::vector<uint8_t> decided(count * count);
+        std::vector<uint16_t> rightClasses(count);
+
+        for (const PairLookup& lookup : lookups)
+        {
+            std::fill(decided.begin(), decided.end(), (uint8_t)0);
+
+            for (uint32_t k = 0; k < lookup.subtableCount; k++)
+            {
+                size_t subtable = pairSubtables[lookup.firstSubtable + k];
+                PairPos pairPos(t, subtable);
+
+                if (pairPos.format == 1)
+                {
+                    uint16_t pairSetCount = t.U16(subtable + 8);
+                    size_t stride = 2 + pairPos.recordSize;
+
+                    for (size_t left = 0; left < count; left++)
+                    {
+                        int32_t coverageIndex = FindCoverageIndex(t, pairPos.coverage, glyphs[left]);
+                        if (coverageIndex < 0 || coverageIndex >= pairSetCount) continue;
+
+                        size_t pairSet = subtable + t.U16(subtable + 10 + (size_t)coverageIndex * 2);
+                        uint16_t pairCount = t.U16(pairSet);
+                        for (size_t i = 0; i < pairCount; i++)
+                        {
+                            size_t record = pairSet + 2 + i * stride;
+                            uint16_t right = dense(t.U16(record));
+                            if (right == NotFlattened) continue;
+
+                            size_t cell = left * count + right;
+                            if (decided[cell]) continue;
+
+                            decided[cell] = 1;
+                            values[cell] += pairPos.ReadValue(t, record + 2);
+                        }
+                    }
+                }
+                else
+                {
+                    size_t classDef1 = subtable + t.U16(subtable + 8);
+                    size_t classDef2 = subtable + t.U16(subtable + 10);
+                    uint16_t class1Count = t.U16(subtable + 12);
+                    uint16_t class2Count = t.U16(subtable + 14);
+
+                    for (size_t right = 0; right < count; right++)
+                        rightClasses[right] = GetGlyphClass(t, classDef2, glyphs[right]);
+
+                    for (size_t left = 0; left < count; left++)
+                    {
+                        if (FindCoverageIndex(t, pairPos.coverage, glyphs[left]) < 0) continue;
+
+                        uint16_t class1 = GetGlyphClass(t, classDef1, glyphs[left]);
+                        if (class1 >= class1Count) continue;
+
+                        size_t class1Record = subtable + 16 + (size_t)class1 * class2Count * pairPos.recordSize;
+                        for (size_t right = 0; right < count; right++)
+                        {
+                            size_t cell = left * count + right;
+                            if (decided[cell] || rightClasses[right] >= class2Count) continue;
+
+                            decided[cell] = 1;
+                            values[cell] += pairPos.ReadValue(t, class1Record + rightClasses[right] * pairPos.recordSize);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int32_t KerningTable::LookupKerning(uint16_t leftGlyph, uint16_t rightGlyph) const
+{
+    FontTableReader t { table.data, table.size };
+
+    if (source == KerningSource::Gpos)
+    {
+        int32_t total = 0;
+        for (const PairLookup& lookup : lookups)
+        {
+            for (uint32_t k = 0; k < lookup.subtableCount; k++)
+            {
+                int32_t value;
+                if (ReadPairAdjustment(t, pairSubtables[lookup.firstSubtable + k], leftGlyph, rightGlyph, value))
+                {
+                    total += value;
+                    break;
+                }
+            }
+        }
+
+        return total;
+    }
+
+    if (source == KerningSource::Kern)
+    {
+        uint32_t key = (uint32_t)leftGlyph << 16 | rightGlyph;
+
+        int32_t total = 0;
+        for (uint32_t subtable : pairSubtables)
+        {
+            KernSubtable kern(t, subtable);
+
+            uint32_t low = 0;
+            uint32_t high = kern.pairCount;
+            while (low < high)
+            {
+                uint32_t middle = (low + high) / 2;
+                size_t pair = kern.pairs + middle * 6;
+                uint32_t pairKey = t.U32(pair);
+                if (pairKey == key)
+                {
+                    total = kern.override ? t.S16(pair + 4) : total + t.S16(pair + 4);
+                    break;
+                }
+
+                if (pairKey < key) low = middle + 1; else high = middle;
+            }
+        }
+
+        return total;
+    }
+
+    return face->GetKerning(leftGlyph, rightGlyph);
+}
+
+size_t KerningTable::GetMemoryUsage() const
+{
+    return pairSubtables.size() * sizeof(uint32_t) + lookups.size() * sizeof(PairLookup) +
+        denseIndex.size() * sizeof(uint16_t) + rowOffset.size() * sizeof(uint32_t) + rows.size() * sizeof(int16_t);
+}
+
+std::vector<uint16_t> CollectCommonGlyphs(const FontFace& face, std::u16string_view sample, size_t maxGlyphs)
+{
+    std::unordered_map<char32_t, uint32_t> counts;
+    for (size_t i = 0; i < sample.size();)
+        counts[DecodeUtf16(sample, i)]++;
+
+    std::vector<std::pair<uint32_t, char32_t>> byCount;
+    byCount.reserve(counts.size());
+    for (auto& [codePoint, count] : counts)
+    {
+        if (codePoint < 0x20 || codePoint > 0x7E) // ASCII is added below regardless
+            byCount.push_back({ count, codePoint });
+    }
+
+    // most frequent first, ties by code point so the result is deterministic
+    std::sort(byCount.begin(), byCount.end(), [](const auto& a, const auto& b)
+    {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    std::vector<uint16_t> glyphs;
+    glyphs.reserve(maxGlyphs);
+
+    for (char32_t c = 0x20; c <= 0x7E && glyphs.size() < maxGlyphs; c++)
+    {
+        if (uint16_t glyph = face.GetGlyphIndex(c))
+            glyphs.push_back(glyph);
+    }
+
+    for (const auto& entry : byCount)
+    {
+        if (glyphs.size() >= maxGlyphs) break;
+
+        if (uint16_t glyph = face.GetGlyphIndex(entry.second))
+            glyphs.push_back(glyph);
+    }
+
+    return glyphs;
+}
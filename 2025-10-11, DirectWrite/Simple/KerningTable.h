@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "FontFace.h"
+
+// Where a KerningTable reads pair adjustments from
+enum class KerningSource
+{
+    Gpos,       // pair adjustment lookups of the GPOS 'kern' feature
+    Kern,       // format 0 subtables of the kern table, for fonts without GPOS kerning
+    FontFace,   // FontFace::GetKerning, for faces that do not expose their tables
+};
+
+// Pair adjustments of a face, read from its GPOS or kern table, with the most used glyphs
+// flattened at load time.
+// Level one maps a glyph to a dense index (or "not flattened"); level two is one row of
+// adjustments per left glyph that has any kerning, while unkerned left glyphs share an all-zero
+// row. A lookup between flattened glyphs is two loads. Other pairs are looked up in the tables
+// directly: coverage and pair or class lookups, by binary search.
+//
+// GPOS lookups are those of every 'kern' feature, whatever the script; only the first glyph's
+// x advance is read, which is what horizontal kerning sets. Device tables and variations are
+// not applied.
+class KerningTable
+{
+    static constexpr uint16_t NotFlattened = 0xFFFF;
+
+    struct PairLookup
+    {
+        uint32_t firstSubtable;     // into pairSubtables
+        uint32_t subtableCount;
+    };
+
+    const FontFace* face;
+    KerningSource source;
+    FontTable table;
+    std::vector<uint32_t> pairSubtables;    // offsets into 'table': PairPos subtables, or kern subtables
+    std::vector<PairLookup> lookups;        // GPOS only; the first subtable covering a pair decides
+
+    std::vector<uint16_t> denseIndex;   // glyph -> dense index, NotFlattened for other glyphs
+    std::vector<uint32_t> rowOffset;    // dense left index -> offset of its row in 'rows'
+    std::vector<int16_t> rows;          // row 0 is all zeros
+    uint32_t glyphCount;
+
+public:
+    // Reads the face's tables and flattens every pair of 'glyphs'. Adjustments that do not fit
+    // 16 bits are left to the table lookup.
+    KerningTable(const FontFace& face, const std::vector<uint16_t>& glyphs);
+
+    int32_t GetKerning(uint16_t leftGlyph, uint16_t rightGlyph) const
+    {
+        if (leftGlyph < denseIndex.size() && rightGlyph < denseIndex.size())
+        {
+            uint16_t left = denseIndex[leftGlyph];
+            uint16_t right = denseIndex[rightGlyph];
+            if (left != NotFlattened && right != NotFlattened)
+            {
+                int16_t value = rows[rowOffset[left] + right];
+                if (value != INT16_MIN) return value;
+            }
+        }
+
+        return LookupKerning(leftGlyph, rightGlyph);
+    }
+
+    // Without the flattened rows
+    int32_t LookupKerning(uint16_t leftGlyph, uint16_t rightGlyph) const;
+
+    KerningSource GetSource() const { return source; }
+    uint32_t GetFlattenedGlyphCount() const { return glyphCount; }
+    size_t GetMemoryUsage() const;
+
+private:
+    void ReadGpos();
+    void ReadKern();
+    void Flatten(const std::vector<uint16_t>& glyphs, std::vector<int32_t>& values) const;
+};
+
+// Picks up to maxGlyphs glyphs by how often their code points occur in 'sample', for example a
+// corpus of UI strings, with printable ASCII always included.
+std::vector<uint16_t> CollectCommonGlyphs(const FontFace& face, std::u16string_view sample, size_t maxGlyphs);
+
+// FontFace that answers GetKerning from a KerningTable and forwards everything else.
+// Shaping results match the wrapped face as long as its GetKerning reads the same tables, so it
+// keeps the wrapped face's id.
+class KernedFontFace : public FontFace
+{
+    const FontFace& face;
+    KerningTable table;
+
+public:
+    KernedFontFace(const FontFace& face, const std::vector<uint16_t>& commonGlyphs)
+        : face(face), table(face, commonGlyphs)
+    {
+    }
+
+    const KerningTable& GetKerningTable() const { return table; }
+
+    uint32_t GetId() const override { return face.GetId(); }
+    FontMetrics GetMetrics() const override { return face.GetMetrics(); }
+    uint16_t GetGlyphIndex(char32_t codePoint) const override { return face.GetGlyphIndex(codePoint); }
+    int32_t GetGlyphAdvance(uint16_t glyphIndex) const override { return face.GetGlyphAdvance(glyphIndex); }
+    int32_t GetKerning(uint16_t leftGlyph, uint16_t rightGlyph) const override { return table.GetKerning(leftGlyph, rightGlyph); }
+    bool GetGlyphOutline(uint16_t glyphIndex, GlyphOutlineSink& sink) const override { return face.GetGlyphOutline(glyphIndex, sink); }
+    FontTable GetFontTable(uint32_t tag) const override { return face.GetFontTable(tag); }
+};
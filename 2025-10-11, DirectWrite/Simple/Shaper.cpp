@@ -0,0 +1,87 @@
+#include "Shaper.h"
+
+#include "Hangul.h"
+
+void ShapeText(const FontFace& face, float fontSize, std::u16string_view text, uint32_t features, ShapedRun& run)
+{
+    run.glyphs.clear();
+    run.width = 0.0f;
+
+    float scale = fontSize / face.GetMetrics().designUnitsPerEm;
+
+    auto appendGlyph = [&](uint16_t glyphIndex, uint32_t cluster)
+    {
+        float advance = face.GetGlyphAdvance(glyphIndex) * scale;
+
+        if ((features & ShapingFeatureKerning) && !run.glyphs.empty())
+        {
+            ShapedGlyph& prev = run.glyphs.back();
+            int32_t kerning = face.GetKerning(prev.glyphIndex, glyphIndex);
+            if (kerning != 0)
+            {
+                prev.advance += kerning * scale;
+                run.width += kerning * scale;
+            }
+        }
+
+        run.glyphs.push_back({ glyphIndex, cluster, advance, 0.0f, 0.0f });
+        run.width += advance;
+    };
+
+    size_t i = 0;
+    while (i < text.size())
+    {
+        uint32_t cluster = (uint32_t)i;
+        char32_t codePoint = DecodeUtf16(text, i);
+
+        // conjoining jamo (NFD Hangul) render as one syllable glyph when the face has it
+        if (Hangul::IsLeadingJamo(codePoint) && i < text.size())
+        {
+            if (char32_t syllable = Hangul::Compose(codePoint, text[i]))
+            {
+                size_t next = i + 1;
+                if (next < text.size())
+                {
+                    if (char32_t withTrailing = Hangul::Compose(syllable, text[next]))
+                    {
+                        syllable = withTrailing;
+                        next++;
+                    }
+                }
+
+                if (uint16_t glyphIndex = face.GetGlyphIndex(syllable))
+                {
+                    appendGlyph(glyphIndex, cluster);
+                    i = next;
+                    continue;
+                }
+            }
+        }
+
+        uint16_t glyphIndex = face.GetGlyphIndex(codePoint);
+
+        // a syllable missing from the face is drawn with its conjoining jamo glyphs
+        if (glyphIndex == 0 && Hangul::IsSyllable(codePoint))
+        {
+            char32_t jamo[3];
+            uint16_t jamoGlyphs[3];
+            size_t count = Hangul::Decompose(codePoint, jamo);
+
+            size_t found = 0;
+            for (; found < count; found++)
+            {
+                jamoGlyphs[found] = face.GetGlyphIndex(jamo[found]);
+                if (jamoGlyphs[found] == 0) break;
+            }
+
+            if (found == count)
+            {
+                for (size_t j = 0; j < count; j++)
+                    appendGlyph(jamoGlyphs[j], cluster);
+                continue;
+            }
+        }
+
+        appendGlyph(glyphIndex, cluster);
+    }
+}
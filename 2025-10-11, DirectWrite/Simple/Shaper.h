@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "FontFace.h"
+
+enum ShapingFeature : uint32_t
+{
+    ShapingFeatureNone = 0,
+    ShapingFeatureKerning = 1 << 0,
+};
+
+struct ShapedGlyph
+{
+    uint16_t glyphIndex;
+    uint32_t cluster;   // index of the first UTF-16 code unit that produced this glyph
+    float advance;      // in DIPs
+    float offsetX;
+    float offsetY;
+};
+
+struct ShapedRun
+{
+    std::vector<ShapedGlyph> glyphs;
+    float width = 0.0f;
+};
+
+// Maps text to positioned glyphs: cmap lookup, advances and pair kerning.
+// fontSize is the em size in DIPs. The result is written to 'run', replacing its content.
+void ShapeText(const FontFace& face, float fontSize, std::u16string_view text, uint32_t features, ShapedRun& run);
+
+// Decodes one code point starting at text[i] and advances i. Lone surrogates decode to U+FFFD.
+inline char32_t DecodeUtf16(std::u16string_view text, size_t& i)
+{
+    char16_t c = text[i++];
+
+    if (c < 0xD800 || c > 0xDFFF) return c;
+
+    if (c <= 0xDBFF && i < text.size())
+    {
+        char16_t c2 = text[i];
+        if (0xDC00 <= c2 && c2 <= 0xDFFF)
+        {
+            i++;
+            return 0x10000 + (((char32_t)c - 0xD800) << 10) + ((char32_t)c2 - 0xDC00);
+        }
+    }
+
+    return 0xFFFD;
+}
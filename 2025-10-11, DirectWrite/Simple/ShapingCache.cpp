@@ -0,0 +1,232 @@
+#include "ShapingCache.h"
+
+#include <cstring>
+#include <utility>
+
+#include "SharedShapingCache.h"
+
+ShapingCache::ShapingCache(size_t byteBudget)
+    : slots(64, 0)
+    , byteBudget(byteBudget)
+    , bytes(0)
+    , clockHand(0)
+    , enabled(true)
+    , sharedTier(nullptr)
+    , hits(0)
+    , misses(0)
+    , evictions(0)
+{
+}
+
+uint64_t ShapingCache::Hash(uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text)
+{
+    uint32_t sizeBits;
+    memcpy(&sizeBits, &fontSize, sizeof(sizeBits));
+
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ ((uint64_t)fontId << 32 | sizeBits) ^ ((uint64_t)features << 17);
+    h ^= text.size();
+
+    auto mix = [](uint64_t h, uint64_t v)
+    {
+        h = (h ^ v) * 0xBF58476D1CE4E5B9ull;
+        return h ^ (h >> 31);
+    };
+
+    // 4 code units per step
+    size_t i = 0;
+    for (; i + 4 <= text.size(); i += 4)
+    {
+        uint64_t v;
+        memcpy(&v, text.data() + i, sizeof(v));
+        h = mix(h, v);
+    }
+
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < text.size(); i++, shift += 16)
+        tail |= (uint64_t)text[i] << shift;
+    h = mix(h, tail);
+
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+size_t ShapingCache::FindSlot(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text) const
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+
+    while (slots[slot] != 0)
+    {
+        const Entry& entry = entries[slots[slot] - 1];
+        if (entry.hash == hash && entry.fontId == fontId && entry.fontSize == fontSize &&
+            entry.features == features && entry.text == text)
+            return slot;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+void ShapingCache::Insert(uint32_t entryIndex)
+{
+    size_t mask = slots.size() - 1;
+    size_t slot = entries[entryIndex].hash & mask;
+
+    while (slots[slot] != 0)
+        slot = (slot + 1) & mask;
+
+    slots[slot] = entryIndex + 1;
+}
+
+// Backward-shift deletion, keeps probe sequences intact without tombstones
+void ShapingCache::EraseSlot(size_t slot)
+{
+    size_t mask = slots.size() - 1;
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+
+    while (slots[next] != 0)
+    {
+        size_t home = entries[slots[next] - 1].hash & mask;
+
+        // move the entry into the hole if its home slot is not between the hole and its current slot
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    slots[hole] = 0;
+}
+
+void ShapingCache::Grow()
+{
+    slots.assign(slots.size() * 2, 0);
+
+    for (uint32_t i = 0; i < (uint32_t)entries.size(); i++)
+        Insert(i);
+}
+
+size_t ShapingCache::EntryBytes(const Entry& entry)
+{
+    return sizeof(Entry) + sizeof(uint32_t) * 2 // entry plus its share of slots at max load
+        + entry.text.capacity() * sizeof(char16_t)
+        + entry.run.glyphs.capacity() * sizeof(ShapedGlyph);
+}
+
+// Returns the new position of the protected entry, which moves if it was the last one
+size_t ShapingCache::EvictOne(size_t protectedIndex)
+{
+    size_t victim;
+    while (true)
+    {
+        victim = clockHand++ % entries.size();
+        if (victim == protectedIndex) continue;
+
+        if (!entries[victim].referenced) break;
+        entries[victim].referenced = false;
+    }
+
+    Entry& entry = entries[victim];
+    EraseSlot(FindSlot(entry.hash, entry.fontId, entry.fontSize, entry.features, entry.text));
+    bytes -= entry.bytes;
+    evictions++;
+
+    // fill the gap with the last entry and repoint its slot. A swap keeps each entry's buffers with
+    // it, so pop_back frees what was counted for the victim; a move-assigned short string would
+    // keep the victim's heap buffer instead.
+    size_t last = entries.size() - 1;
+    if (victim != last)
+    {
+        Entry& moved = entries[last];
+        size_t movedSlot = FindSlot(moved.hash, moved.fontId, moved.fontSize, moved.features, moved.text);
+        slots[movedSlot] = (uint32_t)victim + 1;
+        std::swap(entries[victim], moved);
+
+        if (protectedIndex == last)
+            protectedIndex = victim;
+    }
+    entries.pop_back();
+
+    return protectedIndex;
+}
+
+const ShapedRun& ShapingCache::Shape(const FontFace& face, float fontSize, std::u16string_view text, uint32_t features)
+{
+    if (!enabled)
+    {
+        misses++;
+        ShapeText(face, fontSize, text, features, scratch);
+        return scratch;
+    }
+
+    uint32_t fontId = face.GetId();
+    uint64_t hash = Hash(fontId, fontSize, features, text);
+
+    size_t slot = FindSlot(hash, fontId, fontSize, features, text);
+    if (slots[slot] != 0)
+    {
+        hits++;
+        Entry& entry = entries[slots[slot] - 1];
+        entry.referenced = true;
+        return entry.run;
+    }
+
+    misses++;
+
+    Entry entry { hash, fontId, fontSize, features, false, 0, std::u16string(text), {} };
+    if (!sharedTier || !sharedTier->Find(hash, fontId, fontSize, features, text, entry.run))
+    {
+        ShapeText(face, fontSize, text, features, entry.run);
+        if (sharedTier) sharedTier->Publish(hash, fontId, fontSize, features, text, entry.run);
+    }
+    entry.run.glyphs.shrink_to_fit();
+
+    entry.bytes = EntryBytes(entry);
+    bytes += entry.bytes;
+    entries.push_back(std::move(entry));
+
+    size_t index = entries.size() - 1;
+
+    // keep the load factor at or below 1/2
+    if (entries.size() * 2 > slots.size())
+        Grow();
+    else
+        slots[slot] = (uint32_t)index + 1;
+
+    // the new entry always survives, even if it alone is over budget
+    while (bytes > byteBudget && entries.size() > 1)
+        index = EvictOne(index);
+
+    return entries[index].run;
+}
+
+void ShapingCache::Clear()
+{
+    slots.assign(64, 0);
+    entries.clear();
+    bytes = 0;
+    clockHand = 0;
+}
+
+void ShapingCache::SetEnabled(bool enabled)
+{
+    this->enabled = enabled;
+    if (!enabled) Clear();
+}
+
+ShapingCacheStats ShapingCache::GetStats() const
+{
+    return { hits, misses, evictions, entries.size(), bytes };
+}
+
+void ShapingCache::ResetStats()
+{
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
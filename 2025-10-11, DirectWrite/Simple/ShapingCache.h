@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Shaper.h"
+
+class SharedShapingCache;
+
+struct ShapingCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entryCount;
+    size_t bytes;
+};
+
+// Memoizes ShapeText results per (text, font face, size, features).
+// Entries live in an open-addressed table (linear probing) and are evicted in CLOCK order
+// once the total size exceeds the byte budget.
+class ShapingCache
+{
+    struct Entry
+    {
+        uint64_t hash;
+        uint32_t fontId;
+        float fontSize;
+        uint32_t features;
+        bool referenced;
+        size_t bytes;   // as counted at insert, subtracted again on eviction
+        std::u16string text;
+        ShapedRun run;
+    };
+
+    // Slot value is entry index + 1, 0 means empty
+    std::vector<uint32_t> slots;
+    std::vector<Entry> entries;
+
+    size_t byteBudget;
+    size_t bytes;
+    size_t clockHand;
+    bool enabled;
+
+    ShapedRun scratch;
+    SharedShapingCache* sharedTier;
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+public:
+    explicit ShapingCache(size_t byteBudget);
+
+    // Returns the shaped run, shaping on a miss.
+    // The reference stays valid until the next call to Shape or Clear.
+    const ShapedRun& Shape(const FontFace& face, float fontSize, std::u16string_view text, uint32_t features);
+
+    void Clear();
+
+    // A disabled cache shapes every call, so the same call sites can be measured with and without caching
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled; }
+
+    // Misses are looked up in the shared tier before shaping, and newly shaped runs are offered to it
+    void SetSharedTier(SharedShapingCache* sharedTier) { this->sharedTier = sharedTier; }
+
+    ShapingCacheStats GetStats() const;
+    void ResetStats();
+
+    static uint64_t Hash(uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text);
+
+private:
+    size_t FindSlot(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text) const;
+    void Insert(uint32_t entryIndex);
+    void EraseSlot(size_t slot);
+    void Grow();
+    size_t EvictOne(size_t protectedIndex);
+
+    static size_t EntryBytes(const Entry& entry);
+};
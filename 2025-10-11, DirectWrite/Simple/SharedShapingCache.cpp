@@ -0,0 +1,98 @@
+#include "SharedShapingCache.h"
+
+SharedShapingCache::SharedShapingCache(size_t byteBudget)
+    : byteBudget(byteBudget)
+    , bytes(0)
+    , hits(0)
+    , misses(0)
+    , published(0)
+    , dropped(0)
+    , resets(0)
+{
+}
+
+bool SharedShapingCache::Find(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text, ShapedRun& run)
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    auto it = entries.find(hash);
+    if (it != entries.end())
+    {
+        for (const Entry& entry : it->second)
+        {
+            if (entry.fontId == fontId && entry.fontSize == fontSize && entry.features == features && entry.text == text)
+            {
+                run = entry.run;
+                hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void SharedShapingCache::Publish(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text, const ShapedRun& run)
+{
+    size_t entryBytes = sizeof(Entry) + text.size() * sizeof(char16_t) + run.glyphs.size() * sizeof(ShapedGlyph);
+
+    if (entryBytes > byteBudget)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto it = entries.find(hash);
+    if (it != entries.end())
+    {
+        for (const Entry& entry : it->second)
+        {
+            // another thread got there first
+            if (entry.fontId == fontId && entry.fontSize == fontSize && entry.features == features && entry.text == text)
+                return;
+        }
+    }
+
+    // the tier has no per-entry recency to evict by (lookups only hold a shared lock), so a full
+    // tier starts over; the runs still in use are in the worker caches
+    if (bytes + entryBytes > byteBudget)
+    {
+        entries.clear();
+        bytes = 0;
+        resets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<Entry>& bucket = entries[hash];
+    bucket.push_back({ fontId, fontSize, features, std::u16string(text), run });
+    bytes += entryBytes;
+    published.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SharedShapingCache::Clear()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    entries.clear();
+    bytes = 0;
+}
+
+SharedShapingCacheStats SharedShapingCache::GetStats() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return
+    {
+        hits.load(std::memory_order_relaxed),
+        misses.load(std::memory_order_relaxed),
+        published.load(std::memory_order_relaxed),
+        dropped.load(std::memory_order_relaxed),
+        resets.load(std::memory_order_relaxed),
+        bytes,
+    };
+}
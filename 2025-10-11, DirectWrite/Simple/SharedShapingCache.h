@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Shaper.h"
+
+struct SharedShapingCacheStats
+{
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t published;
+    uint64_t dropped;   // publishes skipped because the tier was busy
+    uint64_t resets;    // times the tier was emptied to make room
+    size_t bytes;
+};
+
+// Read-mostly shaping tier shared by the per-thread ShapingCaches.
+// Lookups take a shared lock. Publishing never waits: if another thread holds the lock the run is
+// simply not shared, so workers never stall on each other. A publish that would go over the byte
+// budget empties the tier first, so it keeps sharing the most recent text however much a
+// long-lived layout shapes; runs copied out by Find stay valid. Only a run larger than the whole
+// budget is never shared.
+class SharedShapingCache
+{
+    struct Entry
+    {
+        uint32_t fontId;
+        float fontSize;
+        uint32_t features;
+        std::u16string text;
+        ShapedRun run;
+    };
+
+    mutable std::shared_mutex mutex;
+    std::unordered_map<uint64_t, std::vector<Entry>> entries;
+    size_t byteBudget;
+    size_t bytes;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> published;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> resets;
+
+public:
+    explicit SharedShapingCache(size_t byteBudget);
+
+    // Copies the run into 'run' and returns true if it is in the tier
+    bool Find(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text, ShapedRun& run);
+
+    void Publish(uint64_t hash, uint32_t fontId, float fontSize, uint32_t features, std::u16string_view text, const ShapedRun& run);
+
+    void Clear();
+    SharedShapingCacheStats GetStats() const;
+};
@@ -0,0 +1,61 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Bidi.h"
+
+// Code units per second of BidiParagraph::SetText, paragraph by paragraph as layout calls it: on
+// left to right text, which the IsLeftToRightOnly check settles, and on Arabic and Hebrew mixed
+// with Latin, numbers and brackets, which runs P2-I2 in full
+int main()
+{
+    struct Corpus
+    {
+        const char* name;
+        std::u16string paragraph;
+    };
+
+    const Corpus corpora[] =
+    {
+        { "English", u"The quick brown fox (jumps) over the lazy dog; it's 3:45 p.m. already! Café, naïve, 50% off." },
+        { "Korean", u"안녕하세요, 오늘 회의는 오후 3시에 2층 회의실에서 진행합니다. (참석: 12명)" },
+        { "Arabic", u"مرحبا بالعالم، هذا نص عربي (مع أقواس) ورقم 123 وكلمة English في الوسط. السعر ٤٥٫٥ دولار!" },
+        { "Hebrew", u"שלום עולם! זהו טקסט בעברית עם מילים באנגלית (like this one) ומספרים 3.14 ו־2025." },
+        { "Mixed", u"Version 2.1: ⁧تحديث \"مهم\" [v2]⁩ was released; ראו סעיף 4(ב) for details, تم الإصدار ١٢/٠٥." },
+    };
+
+    for (const Corpus& corpus : corpora)
+    {
+        std::vector<std::u16string> paragraphs;
+        size_t codeUnits = 0;
+        while (codeUnits < 256 * 1024)
+        {
+            // vary the paragraphs a little so they are not all the same length
+            paragraphs.push_back(corpus.paragraph.substr(paragraphs.size() % 7));
+            codeUnits += paragraphs.back().size();
+        }
+
+        // the share of paragraphs the early-out settled, to show each corpus took the path it names
+        BidiParagraph bidi;
+        size_t fastPath = 0;
+        for (const std::u16string& paragraph : paragraphs)
+        {
+            bidi.SetText(paragraph);
+            fastPath += bidi.IsLeftToRightOnly();
+        }
+
+        double seconds = MeasureSeconds(20, [&]()
+        {
+            for (const std::u16string& paragraph : paragraphs)
+            {
+                bidi.SetText(paragraph);
+                KeepResult(bidi.GetLevels());
+            }
+        });
+
+        std::printf("%-8s %6.1f M code units/s   %3.0f%% left to right only\n", corpus.name, codeUnits * 1e-6 / seconds, 100.0 * fastPath / paragraphs.size());
+    }
+
+    return 0;
+}
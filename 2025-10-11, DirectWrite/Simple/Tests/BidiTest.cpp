@@ -0,0 +1,280 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Bidi.h"
+#include "Check.h"
+
+namespace
+{
+    // In the notation of BidiCharacterTest.txt (UAX #9, Unicode 14.0): code points; paragraph
+    // direction (0 left to right, 1 right to left, 2 auto); resolved paragraph level; levels per
+    // code point after L1, x for characters X9 removes; the kept code points in display order
+    const char* BidiCases[] =
+    {
+        // P2, P3: the first strong character, skipping isolates, sets an automatic paragraph's level
+        "05D0 0020 0061;2;1;1 1 2;2 1 0",
+        "0061 0020 05D0;2;0;0 0 1;0 1 2",
+        "0627 0031;2;1;1 2;1 0",
+        "0031 0032 0020 05D0;2;1;2 2 1 1;3 2 0 1",
+        "0020 0031 002E;2;0;0 0 0;0 1 2",
+        "2067 0061 2069 05D0;2;1;1 4 1 1;3 2 1 0",
+        "2066 05D0 2069 0061;2;0;0 3 0 0;0 1 2 3",
+        "2067 0061 0020 0062;2;0;0 2 2 2;0 1 2 3",
+        "202B 0061 202C 05D0;2;0;x 2 x 1;3 1",
+
+        // W1-W7: marks, numbers and separators
+        "05D0 0300 0061;0;0;1 1 0;1 0 2",
+        "0061 0300 05D0;1;1;2 2 1;2 0 1",
+        "2067 0300 2069;0;0;0 1 0;0 1 2",
+        "0627 0031 0032;0;0;1 2 2;1 2 0",
+        "0627 0020 0031;0;0;1 1 2;2 1 0",
+        "05D0 0031 0032;0;0;1 2 2;1 2 0",
+        "0061 0031 002C 0032 05D0;0;0;0 0 0 0 1;0 1 2 3 4",
+        "0031 002B 0032;1;1;2 2 2;0 1 2",
+        "0031 002C 002C 0032;1;1;2 1 1 2;3 2 1 0",
+        "0627 0661 002C 0662;0;0;1 2 2 2;1 2 3 0",
+        "0627 0031 002C 0032;0;0;1 2 2 2;1 2 3 0",
+        "0024 0031 0025;1;1;2 2 2;0 1 2",
+        "0031 0024 0024;1;1;2 2 2;0 1 2",
+        "05D0 0024 0031;0;0;1 2 2;1 2 0",
+        "0627 0024 0031;0;0;1 1 2;2 1 0",
+        "0061 002D 0031;1;1;2 2 2;0 1 2",
+        "0061 0020 0031;1;1;2 2 2;0 1 2",
+        "0031 002E 0061;1;1;2 1 2;2 1 0",
+        "06F0 0031;1;1;2 2;0 1",
+
+        // N1, N2: neutrals between strong types of one direction take it, otherwise the embedding direction
+        "05D0 0020 05D1;0;0;1 1 1;2 1 0",
+        "05D0 0020 0061;0;0;1 0 0;0 1 2",
+        "0061 0020 05D0;1;1;2 1 1;2 1 0",
+        "05D0 0021 0031;0;0;1 1 2;2 1 0",
+        "0031 0020 05D0;0;0;0 0 1;0 1 2",
+        "0661 002C 05D0;0;0;2 1 1;2 1 0",
+        "0061 0020 0661;0;0;0 0 2;0 1 2",
+        "05D0 0020;0;0;1 0;0 1",
+        "0020 05D0;0;0;0 1;0 1",
+
+        // I1, I2
+        "0061 0031 05D0 0031;0;0;0 0 1 2;0 1 3 2",
+        "0061 0031 05D0 0661;1;1;2 2 1 2;3 2 0 1",
+        "0627 0661 0031;1;1;1 2 2;1 2 0",
+
+        // X1-X8: embeddings and overrides
+        "0061 202B 0062 202C 0063;0;0;0 x 2 x 0;0 2 4",
+        "0061 202B 05D0 202C 0063;0;0;0 x 1 x 0;0 2 4",
+        "05D0 202A 05D1 202C 05D2;1;1;1 x 3 x 1;4 2 0",
+        "202E 0061 0062 202C 0063;0;0;x 1 1 x 0;2 1 4",
+        "202D 05D0 05D1 202C;1;1;x 2 2 x;1 2",
+        "202E 0031 0032;0;0;x 1 1;2 1",
+        "202A 202B 0061 202C 202C 0062;0;0;x x 4 x x 0;2 5",
+        "0061 202C 0062;0;0;0 x 0;0 2",
+        "202B 0061 2066 0062 202C 2069 0063;0;0;x 2 2 2 x 2 2;1 2 3 5 6",
+        "0061 00AD 05D0;0;0;0 x 1;0 2",
+        "0061 200B 05D0 200B 0062;0;0;0 x 1 x 0;0 2 4",
+
+        // X5a-X6a, BD8, BD9: isolates
+        "0061 2067 0062 2069 0063;0;0;0 0 2 0 0;0 1 2 3 4",
+        "0061 2067 05D0 2069 0063;0;0;0 0 1 0 0;0 1 2 3 4",
+        "05D0 2066 0061 2069 05D1;1;1;1 1 2 1 1;4 3 2 1 0",
+        "0061 2068 05D0 0062 2069 0063;0;0;0 0 1 2 0 0;0 1 3 2 4 5",
+        "0061 2068 0062 05D0 2069 0063;1;1;2 2 2 3 2 2;0 1 2 3 4 5",
+        "05D0 2069 0061;0;0;1 0 0;0 1 2",
+        "0061 2067 0062;0;0;0 0 2;0 1 2",
+        "2067 2066 0061 2069 2069;0;0;0 1 2 0 0;0 2 1 3 4",
+        "05D0 2067 0020 2069 05D1;0;0;1 1 1 1 1;4 3 2 1 0",
+        "0031 2066 0020 2069 0032;1;1;2 1 2 1 2;4 3 2 1 0",
+        "2067 202B 0061 2069 0062;0;0;0 x 4 0 0;0 2 3 4",
+
+        // N0: bracket pairs
+        "0061 0028 0062 0029 05D0;1;1;2 2 2 2 1;4 0 1 2 3",
+        "05D0 0028 0061 0029;0;0;1 0 0 0;0 1 2 3",
+        "05D0 0028 05D1 0029 0061;0;0;1 1 1 1 0;3 2 1 0 4",
+        "0061 0028 05D0 0029 0062;0;0;0 0 1 0 0;0 1 2 3 4",
+        "0028 05D0 0029;0;0;0 1 0;0 1 2",
+        "05D0 0028 0029 0061;0;0;1 0 0 0;0 1 2 3",
+        "0061 0028 0031 0029 05D0;0;0;0 0 0 0 1;0 1 2 3 4",
+        "05D0 0028 0031 0029 0061;0;0;1 1 2 1 0;3 2 1 0 4",
+        "0627 0028 0031 0029 0061;0;0;1 1 2 1 0;3 2 1 0 4",
+        "0061 0028 05D0 0028 0062 0029 0029;0;0;0 0 1 0 0 0 0;0 1 2 3 4 5 6",
+        "0061 0028 05D0 005B 0029 005D;0;0;0 0 1 0 0 0;0 1 2 3 4 5",
+        "05D0 005B 0061 0029 005D;0;0;1 0 0 0 0;0 1 2 3 4",
+        "0061 0029 05D0 0028 0062;1;1;2 1 1 1 2;4 3 2 1 0",
+        "0061 2329 05D0 3009 0062;0;0;0 0 1 0 0;0 1 2 3 4",
+        "05D0 3008 0061 232A;1;1;1 1 2 1;3 2 1 0",
+        "0061 FF08 05D0 FF09 0062;1;1;2 1 1 1 2;4 3 2 1 0",
+        "05D0 0028 0061 0300 0029 05D1;0;0;1 0 0 0 0 1;0 1 2 3 4 5",
+        "05D0 0028 0300 0061 0029;1;1;1 1 1 2 1;4 3 2 1 0",
+
+        // N0 where ICU's ubidi decides differently (see ResolveBrackets): marks after a closing
+        // bracket that took the direction before the pair, and a closing angle bracket after the
+        // opening one already has its pair
+        "05D0 0028 05D1 0029 0300 0300 0061;0;0;1 1 1 1 1 1 0;5 4 3 2 1 0 6",
+        "0061 0028 0062 0029 0300 05D0;1;1;2 2 2 2 2 1;5 0 1 2 3 4",
+        "2329 232A 05D0 3009 0032;0;0;0 0 1 1 2;0 1 4 3 2",
+        "005A 3008 3009 05D1 232A 0031;2;0;0 0 0 1 1 2;0 1 2 5 4 3",
+
+        // L1: trailing whitespace, separators and isolates reset to the paragraph level
+        "05D0 0020 0020;0;0;1 0 0;0 1 2",
+        "0061 0020 0020;1;1;2 1 1;2 1 0",
+        "05D0 0009 05D1;0;0;1 0 1;0 1 2",
+        "0061 0020 0009 0062;1;1;2 1 1 2;3 2 1 0",
+        "05D0 2067 0020 2069 0020;0;0;1 0 0 0 0;0 1 2 3 4",
+        "0061 202B 0020 202C;0;0;0 x 0 x;0 2",
+        "0061 000A;1;1;2 1;1 0",
+
+        // Outside the BMP
+        "10900 0020 10901;0;0;1 1 1;2 1 0",
+        "0061 10900 1D7CE;0;0;0 1 2;0 2 1",
+        "1D7CE 10900;1;1;2 1;1 0",
+        "0061 1F600 05D0;2;0;0 0 1;0 1 2",
+    };
+
+    std::vector<std::string> Split(const std::string& text, char separator)
+    {
+        std::vector<std::string> fields;
+        std::istringstream stream(text);
+        std::string field;
+        while (std::getline(stream, field, separator))
+            fields.push_back(field);
+
+        return fields;
+    }
+
+    void TestBidiCases()
+    {
+        BidiParagraph paragraph;      // reused, as SetText keeps its scratch storage
+        std::vector<BidiRun> runs;
+
+        for (const char* line : BidiCases)
+        {
+            std::vector<std::string> fields = Split(line, ';');
+            CHECK(fields.size() == 5);
+
+            std::u16string text;
+            std::vector<size_t> starts;         // code unit offset of each code point
+            for (const std::string& token : Split(fields[0], ' '))
+            {
+                char32_t c = (char32_t)std::strtoul(token.c_str(), nullptr, 16);
+                starts.push_back(text.size());
+                if (c >= 0x10000)
+                {
+                    text += (char16_t)(0xD800 + ((c - 0x10000) >> 10));
+                    text += (char16_t)(0xDC00 + ((c - 0x10000) & 0x3FF));
+                }
+                else
+                {
+                    text += (char16_t)c;
+                }
+            }
+
+            std::vector<std::string> levels = Split(fields[3], ' ');
+            CHECK(levels.size() == starts.size());
+
+            paragraph.SetText(text, (BidiDirection)std::atoi(fields[1].c_str()));
+            if (paragraph.GetParagraphLevel() != std::atoi(fields[2].c_str())) std::fprintf(stderr, "%s: paragraph level\n", line);
+            CHECK(paragraph.GetParagraphLevel() == std::atoi(fields[2].c_str()));
+
+            runs.clear();
+            paragraph.GetLineRuns(0, (uint32_t)text.size(), runs);
+
+            std::vector<int> unitLevels(text.size(), -1);
+            std::vector<size_t> displayOrder;
+            for (const BidiRun& run : runs)
+            {
+                for (uint32_t k = 0; k < run.textLength; k++)
+                {
+                    size_t unit = run.textStart + (run.level % 2 ? run.textLength - 1 - k : k);
+                    unitLevels[unit] = run.level;
+
+                    for (size_t i = 0; i < starts.size(); i++)
+                    {
+                        if (starts[i] == unit && levels[i] != "x") displayOrder.push_back(i);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < starts.size(); i++)
+            {
+                if (levels[i] == "x") continue;
+
+                if (unitLevels[starts[i]] != std::atoi(levels[i].c_str())) std::fprintf(stderr, "%s: level of %zu\n", line, i);
+                CHECK(unitLevels[starts[i]] == std::atoi(levels[i].c_str()));
+            }
+
+            std::vector<size_t> expectedOrder;
+            for (const std::string& token : Split(fields[4], ' '))
+                expectedOrder.push_back(std::strtoul(token.c_str(), nullptr, 10));
+
+            if (displayOrder != expectedOrder) std::fprintf(stderr, "%s: display order\n", line);
+            CHECK(displayOrder == expectedOrder);
+        }
+    }
+
+    // Every code unit at the paragraph level, longer than one SSE2 block so both the vector and the
+    // scalar tail of IsLeftToRightOnly run
+    void TestLeftToRightOnly()
+    {
+        CHECK(IsLeftToRightOnly(u""));
+        CHECK(IsLeftToRightOnly(u"Hello, world 123 (abc) \u00E9\u4E2D\uAC00 \U0001F600"));
+        CHECK(!IsLeftToRightOnly(u"abc \u05D0"));
+        CHECK(!IsLeftToRightOnly(u"\u0661"));
+        CHECK(!IsLeftToRightOnly(u"a\u200Fb"));
+        CHECK(!IsLeftToRightOnly(u"a\u202Eb"));
+        CHECK(!IsLeftToRightOnly(u"a\u2067b\u2069"));
+        CHECK(!IsLeftToRightOnly(u"\U00010900"));
+
+        std::u16string latin(37, u'a');
+        for (size_t i = 0; i < latin.size(); i++)
+        {
+            std::u16string text = latin;
+            text[i] = u'\u05D0';
+            CHECK(!IsLeftToRightOnly(text));
+        }
+
+        BidiParagraph paragraph;
+        paragraph.SetText(latin, BidiDirection::LeftToRight);
+        CHECK(paragraph.IsLeftToRightOnly());
+
+        std::vector<BidiRun> runs;
+        paragraph.GetLineRuns(3, 20, runs);
+        CHECK(runs.size() == 1 && runs[0].textStart == 3 && runs[0].textLength == 20 && runs[0].level == 0);
+
+        // the fast path is only for left to right paragraphs
+        paragraph.SetText(latin, BidiDirection::RightToLeft);
+        CHECK(!paragraph.IsLeftToRightOnly());
+        CHECK(paragraph.GetParagraphLevel() == 1);
+    }
+
+    // L1 and L2 apply per line: the space after "abc" resolves to level 2 between left to right
+    // words, but goes to the paragraph level where it ends the first line
+    void TestLines()
+    {
+        std::u16string text = u"abc def \u05D0\u05D1";
+        BidiParagraph paragraph;
+        paragraph.SetText(text, BidiDirection::RightToLeft);
+        CHECK(paragraph.GetLevels()[3] == 2);
+
+        std::vector<BidiRun> runs;
+        paragraph.GetLineRuns(0, 4, runs);      // "abc "
+        CHECK(runs.size() == 2);
+        CHECK(runs[0].textStart == 3 && runs[0].textLength == 1 && runs[0].level == 1);
+        CHECK(runs[1].textStart == 0 && runs[1].textLength == 3 && runs[1].level == 2);
+
+        runs.clear();
+        paragraph.GetLineRuns(4, 6, runs);      // "def \u05D0\u05D1"
+        CHECK(runs.size() == 2);
+        CHECK(runs[0].textStart == 7 && runs[0].textLength == 3 && runs[0].level == 1);
+        CHECK(runs[1].textStart == 4 && runs[1].textLength == 3 && runs[1].level == 2);
+    }
+}
+
+int main()
+{
+    TestBidiCases();
+    TestLeftToRightOnly();
+    TestLines();
+    return 0;
+}
@@ -0,0 +1,47 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "FontFallback.h"
+#include "TestFont.h"
+
+// Itemization throughput of mixed Hangul, Latin, emoji and CJK text over a four-face chain, with
+// warm coverage pages
+int main()
+{
+    RangeFont korean(1, 0xAC00, 0xD7A3, true);
+    RangeFont latin(2, 0x21, 0x36F, true);
+    RangeFont emoji(3, 0x1F300, 0x1FAFF, false);
+    RangeFont cjk(4, 0x4E00, 0x9FFF, false);
+
+    FontFallback fallback;
+    fallback.AddFont(korean);
+    fallback.AddFont(latin);
+    fallback.AddFont(emoji);
+    fallback.AddFont(cjk);
+
+    const std::u16string samples[] = {
+        u"안녕하세요 hello world 😀 漢字 테스트입니다. ",
+        u"The quick brown fox jumps over the lazy dog. ",
+        u"오늘 날씨가 정말 좋네요 ☀️ 산책 가요! ",
+    };
+
+    for (const std::u16string& sample : samples)
+    {
+        std::u16string text;
+        while (text.size() < 1024 * 1024)
+            text += sample;
+
+        std::vector<FontRun> runs;
+        double seconds = MeasureSeconds(5, [&]()
+        {
+            runs.clear();
+            fallback.Itemize(text, runs);
+        });
+
+        std::printf("%6.1f M code units/s, %zu runs in %zu code units\n", text.size() / seconds * 1e-6, runs.size(), text.size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+﻿#include <random>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "FontFallback.h"
+#include "Shaper.h"
+#include "TestFont.h"
+
+namespace
+{
+    const RangeFont korean(1, 0xAC00, 0xD7A3, true);
+    const RangeFont latin(2, 0x21, 0x36F, true);
+    const RangeFont emoji(3, 0x1F300, 0x1FAFF, false);
+    const RangeFont cjk(4, 0x4E00, 0x9FFF, false);
+
+    FontFallback MakeChain()
+    {
+        FontFallback fallback;
+        fallback.AddFont(korean);
+        fallback.AddFont(latin);
+        fallback.AddFont(emoji);
+        fallback.AddFont(cjk);
+        return fallback;
+    }
+
+    void AppendUtf16(std::u16string& text, char32_t codePoint)
+    {
+        if (codePoint < 0x10000)
+        {
+            text += (char16_t)codePoint;
+        }
+        else
+        {
+            text += (char16_t)(0xD800 + ((codePoint - 0x10000) >> 10));
+            text += (char16_t)(0xDC00 + (codePoint & 0x3FF));
+        }
+    }
+
+    bool SameRuns(const std::vector<FontRun>& runs, const std::vector<FontRun>& expected)
+    {
+        if (runs.size() != expected.size()) return false;
+
+        for (size_t i = 0; i < runs.size(); i++)
+        {
+            if (runs[i].textStart != expected[i].textStart || runs[i].textLength != expected[i].textLength ||
+                runs[i].fontIndex != expected[i].fontIndex || runs[i].missing != expected[i].missing)
+                return false;
+        }
+
+        return true;
+    }
+
+    void TestRuns()
+    {
+        FontFallback fallback = MakeChain();
+        std::vector<FontRun> runs;
+
+        // the space after 안녕 stays Korean; the one after hello stays Latin; the acute accent
+        // stays with Latin, which covers it, and the Cyrillic letter is missing everywhere
+        fallback.Itemize(u"안녕 hello 😀漢字éЖ", runs);
+        CHECK(SameRuns(runs, {
+            { 0, 3, 0, false },
+            { 3, 6, 1, false },
+            { 9, 2, 2, false },
+            { 11, 2, 3, false },
+            { 13, 2, 1, false },
+            { 15, 1, 0, true },
+        }));
+
+        // runs are appended, and a space no current face covers goes to the first face with it
+        runs.clear();
+        fallback.Itemize(u"漢 字", runs);
+        fallback.Itemize(u"", runs);
+        CHECK(SameRuns(runs, { { 0, 1, 3, false }, { 1, 1, 0, false }, { 2, 1, 3, false } }));
+    }
+
+    // Itemize against a direct reading of every face's cmap, on random mixed text
+    void TestAgainstCmap()
+    {
+        FontFallback fallback = MakeChain();
+        const char32_t samples[] = { U'a', U' ', U'.', 0x301, 0x200D, 0xFE0F, 0xAC00, 0xD7A3, 0x4E00, 0x1F600, 0x1F3FB, 0x416, 0x3042 };
+
+        std::mt19937 random(11);
+        for (int round = 0; round < 2000; round++)
+        {
+            std::u16string text;
+            for (int n = random() % 40; n > 0; n--)
+                AppendUtf16(text, samples[random() % std::size(samples)]);
+
+            std::vector<FontRun> runs;
+            fallback.Itemize(text, runs);
+
+            std::vector<FontRun> expected;
+            int current = -1;
+            for (size_t i = 0; i < text.size(); )
+            {
+                uint32_t start = (uint32_t)i;
+                char32_t codePoint = DecodeUtf16(text, i);
+
+                bool attaches = codePoint == ' ' || codePoint == 0x301 || codePoint == 0x200D || codePoint == 0xFE0F || codePoint == 0x1F3FB;
+                int font = -1;
+                if (current >= 0 && attaches && fallback.GetFont(current).GetGlyphIndex(codePoint) != 0)
+                    font = current;
+
+                for (size_t f = 0; font < 0 && f < fallback.GetFontCount(); f++)
+                {
+                    if (fallback.GetFont(f).GetGlyphIndex(codePoint) != 0)
+                        font = (int)f;
+                }
+
+                FontRun run = { start, (uint32_t)i - start, (uint32_t)(font < 0 ? 0 : font), font < 0 };
+                if (!expected.empty() && expected.back().fontIndex == run.fontIndex && expected.back().missing == run.missing)
+                    expected.back().textLength += run.textLength;
+                else
+                    expected.push_back(run);
+
+                current = font;
+            }
+
+            CHECK(SameRuns(runs, expected));
+        }
+    }
+}
+
+int main()
+{
+    TestRuns();
+    TestAgainstCmap();
+    return 0;
+}
@@ -0,0 +1,81 @@
+﻿#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "GlyphAtlas.h"
+#include "TestFont.h"
+#include "TestRasterizer.h"
+#include "TextLayout.h"
+
+// Atlas size against position quality for centered labels in a box whose width animates by a
+// fraction of a pixel per frame, for 1 to 8 subpixel buckets
+int main()
+{
+    const std::u16string text =
+        u"Settings Profile Notifications Privacy Display Sound Network Storage Battery About\n"
+        u"설정 프로필 알림 개인정보 화면 소리 네트워크 저장공간 배터리 정보\n"
+        u"The quick brown fox jumps over the lazy dog 0123456789";
+    const int frames = 240;
+    const float fontSize = 13;
+
+    TestFont face;
+    TextLayout layout(face, fontSize, 1000);
+    layout.SetText(text);
+    const std::vector<ParagraphLayout>& paragraphs = layout.GetParagraphs();
+
+    std::printf("buckets  variants   pixels  max error  mean error  ns/glyph\n");
+
+    for (int buckets : { 1, 2, 4, 8 })
+    {
+        TestRasterizer rasterizer;
+        GlyphAtlas atlas(1024, 1024, buckets);
+        std::vector<GlyphPlacement> placements;
+
+        double maxError = 0;
+        double errorSum = 0;
+        size_t glyphCount = 0;
+
+        auto drawFrames = [&](bool measureError)
+        {
+            for (int frame = 0; frame < frames; frame++)
+            {
+                float boxWidth = 800 + frame * 0.37f;
+                for (const ParagraphLayout& paragraph : paragraphs)
+                {
+                    const TextLine& line = paragraph.lines[0];
+                    float originX = GetLineOriginX(line, boxWidth, TextAlignment::Center);
+
+                    placements.clear();
+                    PlaceGlyphs(&paragraph.glyphs[line.glyphStart], line.glyphCount, originX, 20, buckets, placements);
+
+                    float pen = originX;
+                    for (size_t i = 0; i < placements.size(); i++)
+                    {
+                        KeepResult(atlas.GetGlyph(rasterizer, face, fontSize, placements[i]));
+
+                        if (measureError)
+                        {
+                            double error = std::fabs(placements[i].x + (double)placements[i].subpixelBucket / buckets - pen);
+                            maxError = std::fmax(maxError, error);
+                            errorSum += error;
+                            glyphCount++;
+                        }
+
+                        pen += paragraph.glyphs[line.glyphStart + i].advance;
+                    }
+                }
+            }
+        };
+
+        drawFrames(true);
+        double seconds = MeasureSeconds(5, [&]() { drawFrames(false); });
+
+        GlyphAtlasStats stats = atlas.GetStats();
+        std::printf("%7d  %8zu  %7zu  %9.3f  %10.3f  %8.1f\n", buckets, stats.glyphCount, stats.usedPixels, maxError,
+            errorSum / glyphCount, seconds * 1e9 / glyphCount);
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "GlyphAtlas.h"
+#include "TestFont.h"
+#include "TestRasterizer.h"
+
+namespace
+{
+    // Whole pixel plus bucket has to land within GetSubpixelPositionError of the exact pen position
+    void TestPlacementError()
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> origin(0, 500);
+        std::uniform_real_distribution<float> advance(3, 12);
+
+        std::vector<ShapedGlyph> glyphs(64);
+        for (ShapedGlyph& glyph : glyphs)
+            glyph = { 10, 0, advance(random), 0, 0 };
+
+        for (int buckets : { 1, 2, 3, 4, 8 })
+        {
+            for (int run = 0; run < 1000; run++)
+            {
+                float originX = origin(random);
+                std::vector<GlyphPlacement> placements;
+                PlaceGlyphs(glyphs.data(), glyphs.size(), originX, 20.4f, buckets, placements);
+                CHECK(placements.size() == glyphs.size());
+
+                float pen = originX;
+                for (size_t i = 0; i < glyphs.size(); i++)
+                {
+                    CHECK(placements[i].subpixelBucket < buckets);
+                    CHECK(placements[i].y == 20);
+
+                    float placed = placements[i].x + (float)placements[i].subpixelBucket / buckets;
+                    CHECK(std::fabs(placed - pen) <= GetSubpixelPositionError(buckets) + 1e-3f);
+                    pen += glyphs[i].advance;
+                }
+            }
+        }
+    }
+
+    // Each (glyph, size, bucket) variant is rasterized once and packed without overlap
+    void TestAtlasVariants()
+    {
+        TestFont face;
+        TestRasterizer rasterizer;
+        GlyphAtlas atlas(256, 256, 4);
+
+        std::vector<const AtlasGlyph*> entries;
+        for (uint16_t glyph = 40; glyph < 50; glyph++)
+        {
+            for (uint8_t bucket = 0; bucket < 4; bucket++)
+            {
+                const AtlasGlyph* entry = atlas.GetGlyph(rasterizer, face, 16, { glyph, bucket, 0, 0 });
+                CHECK(entry);
+                CHECK(entry == atlas.GetGlyph(rasterizer, face, 16, { glyph, bucket, 100, 7 }));
+                entries.push_back(entry);
+            }
+        }
+
+        CHECK(rasterizer.calls == 40);
+        CHECK(atlas.GetGlyph(rasterizer, face, 17, { 40, 0, 0, 0 }) != entries[0]);
+        CHECK(atlas.GetGlyph(rasterizer, TestFont(2), 16, { 40, 0, 0, 0 }) != entries[0]);
+
+        GlyphAtlasStats stats = atlas.GetStats();
+        CHECK(stats.glyphCount == 42);
+        CHECK(stats.hits == 40);
+        CHECK(stats.misses == 42);
+
+        for (size_t a = 0; a < entries.size(); a++)
+        {
+            CHECK(entries[a]->x + entries[a]->width <= atlas.GetWidth());
+            CHECK(entries[a]->y + entries[a]->height <= atlas.GetHeight());
+
+            for (size_t b = a + 1; b < entries.size(); b++)
+            {
+                bool apart = entries[a]->x + entries[a]->width <= entries[b]->x || entries[b]->x + entries[b]->width <= entries[a]->x ||
+                    entries[a]->y + entries[a]->height <= entries[b]->y || entries[b]->y + entries[b]->height <= entries[a]->y;
+                CHECK(apart);
+            }
+        }
+
+        uint32_t generation = atlas.GetGeneration();
+        atlas.SetSubpixelBuckets(2);
+        CHECK(atlas.GetGeneration() != generation);
+        CHECK(atlas.GetStats().glyphCount == 0);
+        CHECK(atlas.GetStats().usedPixels == 0);
+    }
+
+    void TestAtlasFull()
+    {
+        TestFont face;
+        TestRasterizer rasterizer;
+        GlyphAtlas atlas(64, 64, 1);
+
+        uint16_t glyph = 40;
+        while (atlas.GetGlyph(rasterizer, face, 16, { glyph, 0, 0, 0 }))
+            glyph++;
+
+        CHECK(glyph > 40);
+        atlas.Clear();
+        CHECK(atlas.GetGlyph(rasterizer, face, 16, { glyph, 0, 0, 0 }));
+    }
+}
+
+int main()
+{
+    TestPlacementError();
+    TestAtlasVariants();
+    TestAtlasFull();
+    return 0;
+}
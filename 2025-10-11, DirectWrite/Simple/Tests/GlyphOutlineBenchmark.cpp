@@ -0,0 +1,121 @@
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+#include "Benchmark.h"
+#include "GlyphOutlineCache.h"
+#include "TableFont.h"
+
+namespace
+{
+    // glyf shaped like a Latin text face's: letters of two or three contours alternating on- and
+    // off-curve points, 40 points on average, and accented letters as base + mark composites
+    std::vector<GlyfGlyphSpec> MakeGlyphs()
+    {
+        std::vector<GlyfGlyphSpec> glyphs(300);
+        for (size_t g = 1; g < 230; g++)
+        {
+            size_t contours = 1 + g % 3;
+            for (size_t c = 0; c < contours; c++)
+            {
+                std::vector<GlyfPoint> contour;
+                size_t count = 12 + (g * 7 + c * 5) % 16;
+                float radius = 300.0f / (c + 1);
+                for (size_t i = 0; i < count; i++)
+                {
+                    float angle = 6.2831853f * i / count;
+                    contour.push_back({ (int16_t)(350 + radius * std::cos(angle)), (int16_t)(350 + radius * std::sin(angle)), i % 2 == 0 });
+                }
+
+                glyphs[g].contours.push_back(contour);
+            }
+        }
+
+        for (size_t g = 230; g < glyphs.size(); g++)
+            glyphs[g].components = { { (uint16_t)(1 + g % 60) }, { (uint16_t)(200 + g % 30), (int16_t)(g % 100), 600 } };
+
+        return glyphs;
+    }
+
+    // Stands in for a rasterizer: takes every point at the target size
+    class ScaledSink : public GlyphOutlineSink
+    {
+        GlyphOutlineSink* next;
+        float scale;
+
+    public:
+        ScaledSink(GlyphOutlineSink* next, float scale) : next(next), scale(scale) {}
+
+        void MoveTo(float x, float y) override { next->MoveTo(x * scale, -y * scale); }
+        void LineTo(float x, float y) override { next->LineTo(x * scale, -y * scale); }
+        void QuadTo(float cx, float cy, float x, float y) override { next->QuadTo(cx * scale, -cy * scale, x * scale, -y * scale); }
+        void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) override { next->CubicTo(c1x * scale, -c1y * scale, c2x * scale, -c2y * scale, x * scale, -y * scale); }
+        void Close() override { next->Close(); }
+    };
+
+    class SumSink : public GlyphOutlineSink
+    {
+    public:
+        double sum = 0;
+
+        void MoveTo(float x, float y) override { sum += x + y; }
+        void LineTo(float x, float y) override { sum += x + y; }
+        void QuadTo(float cx, float cy, float x, float y) override { sum += cx + cy + x + y; }
+        void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) override { sum += c1x + c1y + c2x + c2y + x + y; }
+        void Close() override { sum += 1; }
+    };
+}
+
+// Cost of handing every glyph of a face to the rasterizer again after a DPI change, decoding glyf
+// each time against replaying the cached outline at the new scale
+int main()
+{
+    std::vector<GlyfGlyphSpec> glyphs = MakeGlyphs();
+    TableFont face;
+    TableWriter::WriteGlyf(face.tables, glyphs, false);
+    double count = (double)glyphs.size();
+
+    const float sizes[] = { 12, 15, 18, 24 };
+    SumSink sum;
+
+    double decodeSeconds = MeasureSeconds(20, [&]()
+    {
+        for (float size : sizes)
+        {
+            ScaledSink sink(&sum, size / 1000);
+            for (uint16_t g = 0; g < glyphs.size(); g++)
+                DecodeTrueTypeOutline(face, g, sink);
+        }
+    });
+
+    double fillSeconds = MeasureSeconds(20, [&]()
+    {
+        GlyphOutlineCache cache;
+        for (uint16_t g = 0; g < glyphs.size(); g++)
+            KeepResult(cache.GetOutline(face, g));
+    });
+
+    GlyphOutlineCache cache;
+    for (uint16_t g = 0; g < glyphs.size(); g++)
+        cache.GetOutline(face, g);
+
+    double cachedSeconds = MeasureSeconds(20, [&]()
+    {
+        for (float size : sizes)
+        {
+            for (uint16_t g = 0; g < glyphs.size(); g++)
+                cache.GetOutline(face, g).Emit(size, 0, 0, sum);
+        }
+    });
+
+    KeepResult(sum.sum);
+
+    GlyphOutlineCacheStats stats = cache.GetStats();
+    double perSize = count * std::size(sizes);
+    std::printf("%zu glyphs, %zu bytes cached\n", glyphs.size(), stats.bytes);
+    std::printf("decode glyf at each size:    %.0f ns/glyph\n", decodeSeconds / perSize * 1e9);
+    std::printf("fill the cache:              %.0f ns/glyph\n", fillSeconds / count * 1e9);
+    std::printf("replay from the cache:       %.0f ns/glyph\n", cachedSeconds / perSize * 1e9);
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include <cmath>
+#include <vector>
+
+#include "Check.h"
+#include "GlyphOutlineCache.h"
+#include "TableFont.h"
+
+namespace
+{
+    const uint32_t GlyfTag = MakeFontTableTag('g', 'l', 'y', 'f');
+
+    // Every call as a verb and the points it was given
+    class RecordingSink : public GlyphOutlineSink
+    {
+    public:
+        std::vector<OutlineVerb> verbs;
+        std::vector<float> coordinates;
+
+        void MoveTo(float x, float y) override { Add(OutlineVerb::MoveTo, { x, y }); }
+        void LineTo(float x, float y) override { Add(OutlineVerb::LineTo, { x, y }); }
+        void QuadTo(float cx, float cy, float x, float y) override { Add(OutlineVerb::QuadTo, { cx, cy, x, y }); }
+        void CubicTo(float c1x, float c1y, float c2x, float c2y, float x, float y) override { Add(OutlineVerb::CubicTo, { c1x, c1y, c2x, c2y, x, y }); }
+        void Close() override { verbs.push_back(OutlineVerb::Close); }
+
+    private:
+        void Add(OutlineVerb verb, std::initializer_list<float> values)
+        {
+            verbs.push_back(verb);
+            coordinates.insert(coordinates.end(), values);
+        }
+    };
+
+    bool Near(const std::vector<float>& a, const std::vector<float>& b, float tolerance)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (std::fabs(a[i] - b[i]) > tolerance) return false;
+        }
+
+        return true;
+    }
+
+    RecordingSink Decode(const FontFace& face, uint16_t glyph, bool* found = nullptr)
+    {
+        RecordingSink sink;
+        bool result = DecodeTrueTypeOutline(face, glyph, sink);
+        if (found) *found = result;
+        return sink;
+    }
+
+    // Outline as a face without a glyf table decodes it
+    class OutlineFont : public TestFont
+    {
+    public:
+        using TestFont::TestFont;
+
+        bool GetGlyphOutline(uint16_t glyphIndex, GlyphOutlineSink& sink) const override
+        {
+            sink.MoveTo(0, 0);
+            sink.CubicTo(0, glyphIndex, 100, glyphIndex, 100, 0);
+            sink.Close();
+            return true;
+        }
+    };
+
+    using V = OutlineVerb;
+
+    // 0 empty, 1 square, 2 all off-curve, 3 starts off-curve, 4 long and negative deltas,
+    // 5 and 6 composites, 7 composite of a composite, 8 refers to itself
+    std::vector<GlyfGlyphSpec> MakeGlyphs()
+    {
+        std::vector<GlyfGlyphSpec> glyphs(9);
+        glyphs[1].contours = { { { 0, 0 }, { 0, 700 }, { 500, 700 }, { 500, 0 } } };
+        glyphs[2].contours = { { { 0, 100, false }, { 100, 0, false }, { 0, -100, false }, { -100, 0, false } } };
+        glyphs[3].contours =
+        {
+            { { 100, 0, false }, { 100, 100 }, { 0, 100, false }, { 0, 0, false }, { 50, -50 } },
+            { { 300, 300 }, { 310, 300 } },
+            { { 900, 900 } },
+        };
+        glyphs[4].contours = { { { -2000, 30 }, { 1200, -1500 }, { 1200, 0, false }, { 1199, 255 } } };
+        glyphs[5].components = { { 1, 500, -20 }, { 2, 10, 10, 0.5f, 0, 0, 0.5f } };
+        glyphs[6].components = { { 4, -300, 1000, 0, 1, -1, 0 }, { 1, 0, 0, 1.5f, 0, 0, -1 } };
+        glyphs[7].components = { { 5, 40, 0 }, { 6, 0, 0, 0.25f, 0, 0, 0.25f } };
+        glyphs[8].components = { { 1, 0, 0 }, { 8, 100, 0 } };
+        return glyphs;
+    }
+
+    void TestSimpleGlyphs()
+    {
+        TableFont face;
+        TableWriter::WriteGlyf(face.tables, MakeGlyphs(), false);
+
+        bool found = false;
+        RecordingSink empty = Decode(face, 0, &found);
+        CHECK(found && empty.verbs.empty());
+
+        RecordingSink square = Decode(face, 1);
+        CHECK((square.verbs == std::vector<V> { V::MoveTo, V::LineTo, V::LineTo, V::LineTo, V::Close }));
+        CHECK((square.coordinates == std::vector<float> { 0, 0, 0, 700, 500, 700, 500, 0 }));
+
+        // no point on the curve: start between the last and the first, midpoints between the rest
+        RecordingSink diamond = Decode(face, 2);
+        CHECK((diamond.verbs == std::vector<V> { V::MoveTo, V::QuadTo, V::QuadTo, V::QuadTo, V::QuadTo, V::Close }));
+        CHECK((diamond.coordinates == std::vector<float> { -50, 50, 0, 100, 50, 50, 100, 0, 50, -50, 0, -100, -50, -50, -100, 0, -50, 50 }));
+
+        // starts at the last point, on the curve; a two point contour is a line; single points are skipped
+        RecordingSink mixed = Decode(face, 3);
+        CHECK((mixed.verbs == std::vector<V> { V::MoveTo, V::QuadTo, V::QuadTo, V::QuadTo, V::Close, V::MoveTo, V::LineTo, V::Close }));
+        CHECK((mixed.coordinates == std::vector<float> { 50, -50, 100, 0, 100, 100, 0, 100, 0, 50, 0, 0, 50, -50, 300, 300, 310, 300 }));
+
+        RecordingSink wide = Decode(face, 4);
+        CHECK((wide.verbs == std::vector<V> { V::MoveTo, V::LineTo, V::QuadTo, V::Close }));
+        CHECK((wide.coordinates == std::vector<float> { -2000, 30, 1200, -1500, 1200, 0, 1199, 255 }));
+
+        // past the end of loca
+        RecordingSink missing = Decode(face, 9, &found);
+        CHECK(found && missing.verbs.empty());
+    }
+
+    // Components are their glyphs moved through the component matrices, nested ones through both
+    void TestCompositeGlyphs()
+    {
+        TableFont face;
+        TableWriter::WriteGlyf(face.tables, MakeGlyphs(), false);
+
+        auto transformed = [&](uint16_t glyph, float xx, float xy, float yx, float yy, float dx, float dy)
+        {
+            RecordingSink sink = Decode(face, glyph);
+            for (size_t i = 0; i < sink.coordinates.size(); i += 2)
+            {
+                float x = sink.coordinates[i], y = sink.coordinates[i + 1];
+                sink.coordinates[i] = xx * x + yx * y + dx;
+                sink.coordinates[i + 1] = xy * x + yy * y + dy;
+            }
+
+            return sink;
+        };
+
+        auto join = [](RecordingSink a, const RecordingSink& b)
+        {
+            a.verbs.insert(a.verbs.end(), b.verbs.begin(), b.verbs.end());
+            a.coordinates.insert(a.coordinates.end(), b.coordinates.begin(), b.coordinates.end());
+            return a;
+        };
+
+        RecordingSink expected5 = join(transformed(1, 1, 0, 0, 1, 500, -20), transformed(2, 0.5f, 0, 0, 0.5f, 10, 10));
+        RecordingSink composite5 = Decode(face, 5);
+        CHECK(composite5.verbs == expected5.verbs);
+        CHECK(Near(composite5.coordinates, expected5.coordinates, 0));
+
+        // a quarter turn, and a mirrored stretch
+        RecordingSink expected6 = join(transformed(4, 0, 1, -1, 0, -300, 1000), transformed(1, 1.5f, 0, 0, -1, 0, 0));
+        RecordingSink composite6 = Decode(face, 6);
+        CHECK(composite6.verbs == expected6.verbs);
+        CHECK(Near(composite6.coordinates, expected6.coordinates, 0));
+
+        RecordingSink expected7 = join(transformed(5, 1, 0, 0, 1, 40, 0), transformed(6, 0.25f, 0, 0, 0.25f, 0, 0));
+        RecordingSink composite7 = Decode(face, 7);
+        CHECK(composite7.verbs == expected7.verbs);
+        CHECK(Near(composite7.coordinates, expected7.coordinates, 1e-3f));
+
+        // the cycle ends at the depth limit, with a square from each level
+        RecordingSink cycle = Decode(face, 8);
+        CHECK(cycle.verbs.size() == 8 * 5);
+        CHECK(cycle.coordinates[cycle.coordinates.size() - 8] == 700);
+    }
+
+    void TestLongOffsetsDecodeTheSame()
+    {
+        TableFont shortFace, longFace;
+        TableWriter::WriteGlyf(shortFace.tables, MakeGlyphs(), false);
+        TableWriter::WriteGlyf(longFace.tables, MakeGlyphs(), true);
+        CHECK(longFace.tables[MakeFontTableTag('l', 'o', 'c', 'a')].size() == 2 * shortFace.tables[MakeFontTableTag('l', 'o', 'c', 'a')].size());
+
+        for (uint16_t glyph = 0; glyph < 10; glyph++)
+        {
+            RecordingSink a = Decode(shortFace, glyph);
+            RecordingSink b = Decode(longFace, glyph);
+            CHECK(a.verbs == b.verbs && a.coordinates == b.coordinates);
+        }
+    }
+
+    // Every truncation of the glyf table and every corrupted byte must stay in bounds; a simple
+    // glyph cut short draws nothing rather than part of itself
+    void TestCorruptTables()
+    {
+        TableFont face;
+        TableWriter::WriteGlyf(face.tables, MakeGlyphs(), false);
+        std::vector<uint8_t> glyf = face.tables[GlyfTag];
+
+        std::vector<RecordingSink> complete;
+        for (uint16_t glyph = 0; glyph < 9; glyph++)
+            complete.push_back(Decode(face, glyph));
+
+        for (size_t size = 0; size < glyf.size(); size++)
+        {
+            face.tables[GlyfTag].assign(glyf.begin(), glyf.begin() + size);
+            for (uint16_t glyph = 0; glyph < 9; glyph++)
+            {
+                RecordingSink sink = Decode(face, glyph);
+                if (glyph <= 4) CHECK(sink.verbs.empty() || sink.coordinates == complete[glyph].coordinates);
+            }
+        }
+
+        // a glyph whose loca range ends in its flags
+        std::vector<uint8_t>& loca = face.tables[MakeFontTableTag('l', 'o', 'c', 'a')];
+        face.tables[GlyfTag] = glyf;
+        TableWriter::Patch16(loca, 4, ((size_t)loca[2] << 8 | loca[3]) + 8);
+        CHECK(Decode(face, 1).verbs.empty());
+
+        for (size_t i = 0; i < glyf.size(); i++)
+        {
+            face.tables[GlyfTag] = glyf;
+            face.tables[GlyfTag][i] ^= 0xA5;
+            for (uint16_t glyph = 0; glyph < 9; glyph++)
+                Decode(face, glyph);
+        }
+    }
+
+    void TestCacheSources()
+    {
+        GlyphOutlineCache cache;
+
+        TableFont tables(1);
+        TableWriter::WriteGlyf(tables.tables, MakeGlyphs(), false);
+        GlyphOutline square = cache.GetOutline(tables, 1);
+        CHECK(square && square.GetPointCount() == 4 && square.GetVerbCount() == 5);
+        CHECK(square.GetDesignUnitsPerEm() == 1000);
+        CHECK(square.GetPoints()[2].x == 500 && square.GetPoints()[2].y == 700);
+
+        // the space has an outline, without contours
+        GlyphOutline space = cache.GetOutline(tables, 0);
+        CHECK(space && space.GetVerbCount() == 0);
+
+        // faces without glyf decode themselves
+        OutlineFont own(2);
+        GlyphOutline cubic = cache.GetOutline(own, 7);
+        CHECK(cubic && cubic.GetVerbs()[1] == OutlineVerb::CubicTo && cubic.GetPoints()[1].y == 7);
+
+        TestFont none(3);
+        CHECK(!cache.GetOutline(none, 1));
+        CHECK(!cache.GetOutline(none, 2));
+
+        GlyphOutlineCacheStats stats = cache.GetStats();
+        CHECK(stats.misses == 4 && stats.hits == 0 && stats.glyphCount == 3);
+
+        GlyphOutline again = cache.GetOutline(tables, 1);
+        CHECK(again.GetPoints() == square.GetPoints());
+        CHECK(cache.GetStats().hits == 1);
+    }
+
+    // One decode serves every size: Emit scales the design units and flips y
+    void TestEmitScales()
+    {
+        GlyphOutlineCache cache;
+        TableFont face;
+        TableWriter::WriteGlyf(face.tables, MakeGlyphs(), false);
+
+        RecordingSink design = Decode(face, 3);
+        GlyphOutline outline = cache.GetOutline(face, 3);
+
+        for (float fontSize : { 12.0f, 16.5f, 48.0f })
+        {
+            RecordingSink sink;
+            outline.Emit(fontSize, 10, 20, sink);
+            CHECK(sink.verbs == design.verbs);
+
+            std::vector<float> expected = design.coordinates;
+            for (size_t i = 0; i < expected.size(); i += 2)
+            {
+                expected[i] = 10 + expected[i] * fontSize / 1000;
+                expected[i + 1] = 20 - expected[i + 1] * fontSize / 1000;
+            }
+
+            CHECK(Near(sink.coordinates, expected, 1e-4f));
+        }
+
+        CHECK(cache.GetStats().misses == 1);
+    }
+
+    // Oldest chunks go first; outlines handed out before keep their data
+    void TestEviction()
+    {
+        std::vector<GlyfGlyphSpec> glyphs(400);
+        for (size_t g = 0; g < glyphs.size(); g++)
+        {
+            std::vector<GlyfPoint> contour;
+            for (int i = 0; i < 2000; i++)
+                contour.push_back({ (int16_t)(i % 100 * 7 + g), (int16_t)(i / 100 * 30), i % 3 != 0 });
+            glyphs[g].contours = { contour };
+        }
+
+        TableFont face;
+        TableWriter::WriteGlyf(face.tables, glyphs, true);
+
+        GlyphOutlineCache cache(4 * GlyphOutlineCache::ChunkSize);
+        GlyphOutline first = cache.GetOutline(face, 0);
+        std::vector<OutlinePoint> firstPoints(first.GetPoints(), first.GetPoints() + first.GetPointCount());
+
+        for (uint16_t g = 1; g < glyphs.size(); g++)
+            cache.GetOutline(face, g);
+
+        GlyphOutlineCacheStats stats = cache.GetStats();
+        CHECK(stats.evictions > 0);
+        CHECK(stats.bytes <= 4 * GlyphOutlineCache::ChunkSize);
+        CHECK(stats.glyphCount + stats.evictions == glyphs.size());
+
+        CHECK(std::equal(firstPoints.begin(), firstPoints.end(), first.GetPoints(), [](const OutlinePoint& a, const OutlinePoint& b)
+        {
+            return a.x == b.x && a.y == b.y;
+        }));
+
+        cache.GetOutline(face, 0);
+        CHECK(cache.GetStats().misses == glyphs.size() + 1);
+    }
+}
+
+int main()
+{
+    TestSimpleGlyphs();
+    TestCompositeGlyphs();
+    TestLongOffsetsDecodeTheSame();
+    TestCorruptTables();
+    TestCacheSources();
+    TestEmitScales();
+    TestEviction();
+    return 0;
+}
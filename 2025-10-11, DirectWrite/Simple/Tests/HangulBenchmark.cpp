@@ -0,0 +1,37 @@
+﻿#include <cstdio>
+#include <string>
+
+#include "Benchmark.h"
+#include "Hangul.h"
+
+// NFD and NFC throughput on Korean prose with ASCII spaces and punctuation
+int main()
+{
+    const std::u16string sentence = u"안녕하세요, 한국어 문장입니다. ";
+
+    std::u16string composed;
+    while (composed.size() < 4 * 1024 * 1024)
+        composed += sentence;
+
+    std::u16string decomposed;
+    Hangul::DecomposeText(composed, decomposed);
+
+    std::u16string out;
+    out.reserve(decomposed.size());
+
+    double decomposeSeconds = MeasureSeconds(5, [&]()
+    {
+        out.clear();
+        Hangul::DecomposeText(composed, out);
+    });
+
+    double composeSeconds = MeasureSeconds(5, [&]()
+    {
+        out.clear();
+        Hangul::ComposeText(decomposed, out);
+    });
+
+    std::printf("decompose: %7.1f M code units/s in\n", composed.size() / decomposeSeconds * 1e-6);
+    std::printf("compose:   %7.1f M code units/s in\n", decomposed.size() / composeSeconds * 1e-6);
+    return out == composed ? 0 : 1;
+}
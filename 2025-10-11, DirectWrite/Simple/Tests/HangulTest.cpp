@@ -0,0 +1,185 @@
+﻿#include <string>
+
+#include "Check.h"
+#include "Hangul.h"
+#include "Shaper.h"
+
+namespace
+{
+    // Decompositions from UnicodeData.txt, to pin the arithmetic to the reference data
+    struct Reference
+    {
+        char32_t syllable;
+        char32_t jamo[3];
+    };
+
+    const Reference References[] =
+    {
+        { 0xAC00, { 0x1100, 0x1161, 0 } },      // 가
+        { 0xAC01, { 0x1100, 0x1161, 0x11A8 } }, // 각
+        { 0xC548, { 0x110B, 0x1161, 0x11AB } }, // 안
+        { 0xB155, { 0x1102, 0x1167, 0x11BC } }, // 녕
+        { 0xD558, { 0x1112, 0x1161, 0 } },      // 하
+        { 0xC138, { 0x1109, 0x1166, 0 } },      // 세
+        { 0xC694, { 0x110B, 0x116D, 0 } },      // 요
+        { 0xB192, { 0x1102, 0x1169, 0x11C1 } }, // 높
+        { 0xD7A3, { 0x1112, 0x1175, 0x11C2 } }, // 힣, the last syllable
+    };
+
+    void TestReferenceDecompositions()
+    {
+        for (const Reference& reference : References)
+        {
+            char32_t jamo[3];
+            size_t count = Hangul::Decompose(reference.syllable, jamo);
+            CHECK(count == (reference.jamo[2] ? 3u : 2u));
+
+            for (size_t i = 0; i < count; i++)
+                CHECK(jamo[i] == reference.jamo[i]);
+        }
+    }
+
+    // Every syllable decomposes into valid jamo, composes back, and round-trips through the text
+    // functions, both alone and between other text
+    void TestAllSyllablesRoundTrip()
+    {
+        size_t lvCount = 0;
+        size_t lvtCount = 0;
+
+        for (char32_t s = Hangul::SBase; s < Hangul::SBase + Hangul::SCount; s++)
+        {
+            CHECK(Hangul::IsSyllable(s));
+
+            char32_t jamo[3];
+            size_t count = Hangul::Decompose(s, jamo);
+            CHECK(count == 2 || count == 3);
+            CHECK(Hangul::IsLeadingJamo(jamo[0]));
+            CHECK(Hangul::IsVowelJamo(jamo[1]));
+            CHECK(Hangul::IsLVSyllable(s) == (count == 2));
+
+            char32_t composed = Hangul::Compose(jamo[0], jamo[1]);
+            CHECK(Hangul::IsLVSyllable(composed));
+            if (count == 3)
+            {
+                CHECK(Hangul::IsTrailingJamo(jamo[2]));
+                composed = Hangul::Compose(composed, jamo[2]);
+                lvtCount++;
+            }
+            else
+                lvCount++;
+            CHECK(composed == s);
+
+            std::u16string text = u"a";
+            text += (char16_t)s;
+            text += u"1";
+
+            std::u16string decomposed;
+            Hangul::DecomposeText(text, decomposed);
+            CHECK(decomposed.size() == count + 2);
+            CHECK(decomposed.front() == u'a' && decomposed.back() == u'1');
+            for (size_t i = 0; i < count; i++)
+                CHECK(decomposed[i + 1] == jamo[i]);
+
+            std::u16string recomposed;
+            Hangul::ComposeText(decomposed, recomposed);
+            CHECK(recomposed == text);
+        }
+
+        CHECK(lvCount == Hangul::LCount * Hangul::VCount);
+        CHECK(lvtCount == Hangul::LCount * Hangul::VCount * (Hangul::TCount - 1));
+    }
+
+    void TestNonComposingSequences()
+    {
+        std::u16string out;
+
+        // a vowel or trailing consonant with nothing to attach to stays as it is
+        Hangul::ComposeText(u"\u1161\u11A8", out);
+        CHECK(out == u"\u1161\u11A8");
+
+        // LVT + T does not compose further, nor does L + T
+        out.clear();
+        Hangul::ComposeText(u"\uAC01\u11A8\u1100\u11A8", out);
+        CHECK(out == u"\uAC01\u11A8\u1100\u11A8");
+
+        // TBase itself is not a trailing consonant
+        out.clear();
+        Hangul::ComposeText(u"\uAC00\u11A7", out);
+        CHECK(out == u"\uAC00\u11A7");
+
+        // an LV syllable takes a following T, and a full L V T sequence composes in one pass
+        out.clear();
+        Hangul::ComposeText(u"\uAC00\u11A8 \u1100\u1161\u11A8", out);
+        CHECK(out == u"\uAC01 \uAC01");
+
+        // output is appended, and composition does not reach back into what was already there
+        out = u"\u1100";
+        Hangul::ComposeText(u"\u1161", out);
+        CHECK(out == u"\u1100\u1161");
+
+        // non-Hangul, including surrogate pairs, is copied through
+        std::u16string mixed = u"Hi \U0001F600 \uC548\uB155\uD558\uC138\uC694 \U00020000!";
+        std::u16string decomposed;
+        Hangul::DecomposeText(mixed, decomposed);
+        CHECK(decomposed.size() == mixed.size() + 5 + 2);
+
+        out.clear();
+        Hangul::ComposeText(decomposed, out);
+        CHECK(out == mixed);
+    }
+
+    // Hangul glyphs only for some syllables and all conjoining jamo, 1 + code point otherwise
+    class HangulFont : public FontFace
+    {
+    public:
+        uint32_t GetId() const override { return 1; }
+        FontMetrics GetMetrics() const override { return { 1000, 800, 200, 0 }; }
+
+        uint16_t GetGlyphIndex(char32_t codePoint) const override
+        {
+            if (Hangul::IsSyllable(codePoint))
+                return codePoint % 2 ? 0 : (uint16_t)(codePoint - 0x8000);
+
+            return (uint16_t)(codePoint + 1);
+        }
+
+        int32_t GetGlyphAdvance(uint16_t) const override { return 1000; }
+        int32_t GetKerning(uint16_t, uint16_t) const override { return 0; }
+    };
+
+    void TestShaping()
+    {
+        HangulFont face;
+        ShapedRun run;
+
+        // NFD input shapes to the syllable glyphs when the face has them; 녕 is odd and falls back
+        // to its jamo glyphs in both forms
+        std::u16string composed = u"\uC548\uB155\uD558\uC138\uC694"; // 안녕하세요
+        std::u16string decomposed;
+        Hangul::DecomposeText(composed, decomposed);
+
+        ShapeText(face, 10.0f, composed, ShapingFeatureNone, run);
+        ShapedRun fromDecomposed;
+        ShapeText(face, 10.0f, decomposed, ShapingFeatureNone, fromDecomposed);
+
+        CHECK(run.glyphs.size() == 1 + 3 + 1 + 1 + 1);
+        CHECK(fromDecomposed.glyphs.size() == run.glyphs.size());
+        for (size_t i = 0; i < run.glyphs.size(); i++)
+            CHECK(run.glyphs[i].glyphIndex == fromDecomposed.glyphs[i].glyphIndex);
+
+        // 하 from jamo is one glyph in the cluster of its leading consonant
+        ShapeText(face, 10.0f, u"\u1112\u1161", ShapingFeatureNone, run);
+        CHECK(run.glyphs.size() == 1);
+        CHECK(run.glyphs[0].glyphIndex == (uint16_t)(0xD558 - 0x8000));
+        CHECK(run.glyphs[0].cluster == 0);
+    }
+}
+
+int main()
+{
+    TestReferenceDecompositions();
+    TestAllSyllablesRoundTrip();
+    TestNonComposingSequences();
+    TestShaping();
+    return 0;
+}
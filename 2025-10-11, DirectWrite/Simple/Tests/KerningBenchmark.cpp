@@ -0,0 +1,136 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "KerningTable.h"
+#include "Shaper.h"
+#include "TableFont.h"
+
+namespace
+{
+    // GPOS shaped like a Korean UI font's: Latin pairs and classes, plus class kerning of every
+    // Hangul syllable by its final consonant against its right neighbour's initial
+    std::vector<uint8_t> MakeGpos(const FontFace& face)
+    {
+        PairPosSpec latinPairs;
+        for (char32_t left = 0x21; left <= 0x7E; left++)
+        {
+            for (char32_t right = 0x21; right <= 0x7E; right++)
+            {
+                if ((left * 7 + right * 13) % 9 == 0)
+                    latinPairs.pairs.push_back({ face.GetGlyphIndex(left), face.GetGlyphIndex(right), (int16_t)(-(int)(left % 60)) });
+            }
+        }
+
+        PairPosSpec latinClasses;
+        latinClasses.class1Count = 24;
+        latinClasses.class2Count = 24;
+        for (char32_t c = 0x21; c <= 0x7E; c++)
+        {
+            uint16_t glyph = face.GetGlyphIndex(c);
+            latinClasses.coverage.push_back(glyph);
+            latinClasses.leftClasses[glyph] = (uint16_t)(c % 24);
+            latinClasses.rightClasses[glyph] = (uint16_t)(c * 5 % 24);
+        }
+
+        for (int i = 0; i < 24 * 24; i++)
+            latinClasses.classValues.push_back((int16_t)(i % 7 == 0 ? -(i % 50) : 0));
+
+        PairPosSpec hangulClasses;
+        hangulClasses.class1Count = 28;
+        hangulClasses.class2Count = 20;
+        for (char32_t syllable = 0xAC00; syllable <= 0xD7A3; syllable++)
+        {
+            uint16_t glyph = face.GetGlyphIndex(syllable);
+            hangulClasses.coverage.push_back(glyph);
+            hangulClasses.leftClasses[glyph] = (uint16_t)((syllable - 0xAC00) % 28);
+            hangulClasses.rightClasses[glyph] = (uint16_t)(1 + (syllable - 0xAC00) / 588);
+        }
+
+        for (int i = 0; i < 28 * 20; i++)
+            hangulClasses.classValues.push_back((int16_t)(i % 20 != 0 && i % 3 == 0 ? -(i % 30) : 0));
+
+        std::vector<PairLookupSpec> lookups(1);
+        lookups[0].subtables = { latinPairs, latinClasses, hangulClasses };
+        lookups[0].extension = true;
+        return TableWriter::WriteGpos(lookups);
+    }
+
+    // A face that only answers GetKerning, from the tables, like a face that does not expose them
+    class LookupFace : public TestFont
+    {
+        const KerningTable& table;
+
+    public:
+        explicit LookupFace(const KerningTable& table) : table(table) {}
+
+        int32_t GetKerning(uint16_t leftGlyph, uint16_t rightGlyph) const override { return table.LookupKerning(leftGlyph, rightGlyph); }
+    };
+}
+
+// Building the flattened table from GPOS against querying every pair, and pair lookups and
+// shaping with and without it, on Korean and Latin text
+int main()
+{
+    const std::u16string samples[] = {
+        u"설정을 저장했습니다. 네트워크 연결을 확인하세요. 알림이 3개 있습니다. 다시 시도하시겠습니까? ",
+        u"Settings saved. Check your network connection. You have 3 new notifications. Try again? ",
+    };
+    const char* names[] = { "Korean", "Latin" };
+
+    TableFont face;
+    face.tables[MakeFontTableTag('G', 'P', 'O', 'S')] = MakeGpos(face);
+
+    std::u16string corpus;
+    for (int i = 0; i < 20; i++)
+        corpus += samples[0];
+
+    std::vector<uint16_t> common = CollectCommonGlyphs(face, corpus, 512);
+
+    KerningTable unflattened(face, {});
+    LookupFace lookupFace(unflattened);
+
+    double tableSeconds = MeasureSeconds(5, [&]() { KeepResult(KerningTable(face, common)); });
+    double pairSeconds = MeasureSeconds(1, [&]() { KeepResult(KerningTable(lookupFace, common)); });
+
+    KerningTable flattened(face, common);
+    std::printf("%u glyphs flattened, %zu bytes\n", flattened.GetFlattenedGlyphCount(), flattened.GetMemoryUsage());
+    std::printf("build from GPOS:       %8.2f ms\n", tableSeconds * 1e3);
+    std::printf("build from GetKerning: %8.2f ms\n", pairSeconds * 1e3);
+
+    KernedFontFace kernedFlat(face, common);
+    KernedFontFace kernedLookup(face, {});
+
+    for (int s = 0; s < 2; s++)
+    {
+        std::u16string text;
+        while (text.size() < 64 * 1024)
+            text += samples[s];
+
+        std::vector<uint16_t> glyphs;
+        for (size_t i = 0; i < text.size();)
+            glyphs.push_back(face.GetGlyphIndex(DecodeUtf16(text, i)));
+
+        auto sumPairs = [&](const KerningTable& table)
+        {
+            int32_t sum = 0;
+            for (size_t i = 1; i < glyphs.size(); i++)
+                sum += table.GetKerning(glyphs[i - 1], glyphs[i]);
+            KeepResult(sum);
+        };
+
+        double lookupSeconds = MeasureSeconds(20, [&]() { sumPairs(unflattened); });
+        double flatSeconds = MeasureSeconds(20, [&]() { sumPairs(flattened); });
+
+        ShapedRun run;
+        double shapeLookupSeconds = MeasureSeconds(20, [&]() { ShapeText(kernedLookup, 16, text, ShapingFeatureKerning, run); });
+        double shapeFlatSeconds = MeasureSeconds(20, [&]() { ShapeText(kernedFlat, 16, text, ShapingFeatureKerning, run); });
+
+        std::printf("%-7s pairs: %6.1f M/s table, %6.1f M/s flattened; shaping: %6.1f M/s table, %6.1f M/s flattened\n",
+            names[s], glyphs.size() / lookupSeconds * 1e-6, glyphs.size() / flatSeconds * 1e-6,
+            text.size() / shapeLookupSeconds * 1e-6, text.size() / shapeFlatSeconds * 1e-6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "KerningTable.h"
+#include "TableFont.h"
+
+namespace
+{
+    const uint32_t GposTag = MakeFontTableTag('G', 'P', 'O', 'S');
+    const uint32_t KernTag = MakeFontTableTag('k', 'e', 'r', 'n');
+    const uint16_t GlyphRange = 300;
+
+    // The adjustment the specs describe, read straight from them
+    int32_t ExpectedGpos(const std::vector<PairLookupSpec>& lookups, uint16_t left, uint16_t right)
+    {
+        int32_t total = 0;
+        for (const PairLookupSpec& lookup : lookups)
+        {
+            if (lookup.feature != MakeFontTableTag('k', 'e', 'r', 'n') || lookup.type != 2) continue;
+
+            for (const PairPosSpec& subtable : lookup.subtables)
+            {
+                if (!subtable.pairs.empty())
+                {
+                    // the last duplicate wins, as in the writer
+                    const KernPair* found = nullptr;
+                    for (const KernPair& pair : subtable.pairs)
+                    {
+                        if (pair.left == left && pair.right == right) found = &pair;
+                    }
+
+                    if (!found) continue;
+                    total += found->value;
+                    break;
+                }
+
+                if (std::find(subtable.coverage.begin(), subtable.coverage.end(), left) == subtable.coverage.end()) continue;
+
+                auto leftClass = subtable.leftClasses.find(left);
+                auto rightClass = subtable.rightClasses.find(right);
+                uint16_t class1 = leftClass == subtable.leftClasses.end() ? 0 : leftClass->second;
+                uint16_t class2 = rightClass == subtable.rightClasses.end() ? 0 : rightClass->second;
+                if (class1 >= subtable.class1Count || class2 >= subtable.class2Count) continue;
+
+                total += subtable.classValues[class1 * subtable.class2Count + class2];
+                break;
+            }
+        }
+
+        return total;
+    }
+
+    int32_t ExpectedKern(const std::vector<KernSubtableSpec>& subtables, uint16_t left, uint16_t right)
+    {
+        int32_t total = 0;
+        for (const KernSubtableSpec& subtable : subtables)
+        {
+            if ((subtable.coverage & 0x7) != 0x1) continue;
+
+            for (const KernPair& pair : subtable.pairs)
+            {
+                if (pair.left == left && pair.right == right)
+                    total = subtable.coverage & 0x8 ? pair.value : total + pair.value;
+            }
+        }
+
+        return total;
+    }
+
+    std::vector<uint16_t> EveryOtherGlyph()
+    {
+        std::vector<uint16_t> glyphs;
+        for (uint16_t glyph = 0; glyph < GlyphRange; glyph += 2)
+            glyphs.push_back(glyph);
+        return glyphs;
+    }
+
+    template<typename Func>
+    void CheckAllPairs(const KerningTable& table, Func&& expected)
+    {
+        for (uint16_t left = 0; left < GlyphRange; left++)
+        {
+            for (uint16_t right = 0; right < GlyphRange; right++)
+            {
+                CHECK(table.GetKerning(left, right) == expected(left, right));
+                CHECK(table.LookupKerning(left, right) == expected(left, right));
+            }
+        }
+    }
+
+    void TestWithoutTables()
+    {
+        TestFont face;
+        KerningTable table(face, EveryOtherGlyph());
+        CHECK(table.GetSource() == KerningSource::FontFace);
+        CheckAllPairs(table, [&](uint16_t left, uint16_t right) { return face.GetKerning(left, right); });
+    }
+
+    void TestKern()
+    {
+        std::vector<KernSubtableSpec> subtables(4);
+        subtables[0].pairs = { { 10, 20, -50 }, { 10, 21, -60 }, { 11, 20, 30 }, { 250, 3, -7 } };
+        subtables[1].pairs = { { 10, 20, -5 }, { 12, 12, -12 } };
+        subtables[2].pairs = { { 10, 20, -999 } };
+        subtables[2].coverage = 0x5; // cross-stream, ignored
+        subtables[3].pairs = { { 12, 12, 40 } };
+        subtables[3].coverage = 0x9; // override
+
+        TableFont face;
+        face.tables[KernTag] = TableWriter::WriteKern(subtables);
+
+        KerningTable table(face, EveryOtherGlyph());
+        CHECK(table.GetSource() == KerningSource::Kern);
+        CHECK(table.GetKerning(10, 20) == -55);
+        CHECK(table.GetKerning(12, 12) == 40);
+        CheckAllPairs(table, [&](uint16_t left, uint16_t right) { return ExpectedKern(subtables, left, right); });
+    }
+
+    void TestGpos()
+    {
+        std::vector<PairLookupSpec> lookups(4);
+
+        // a pair subtable in front of a class subtable that also covers its pairs
+        PairPosSpec pairs;
+        pairs.pairs = { { 10, 20, -50 }, { 10, 22, -20 }, { 40, 41, 15 } };
+        pairs.valueFormat1 = 0x5; // XPlacement before XAdvance
+        pairs.valueFormat2 = 0x4;
+
+        PairPosSpec classes;
+        classes.coverage = { 10, 11, 12, 13, 40, 200 };
+        classes.leftClasses = { { 10, 1 }, { 11, 1 }, { 12, 2 }, { 200, 3 } };
+        classes.rightClasses = { { 20, 1 }, { 21, 1 }, { 22, 2 }, { 150, 3 } };
+        classes.class1Count = 3;
+        classes.class2Count = 3;
+        classes.classValues = { -1, -2, -3, -10, -11, -12, -20, -21, -22 };
+        classes.valueFormat1 = 0xF;
+
+        lookups[0].subtables = { pairs, classes };
+
+        // a second kern lookup adds to the first, through extension subtables
+        PairPosSpec more;
+        more.pairs = { { 10, 20, -7 }, { 12, 150, -20000 } };
+        lookups[1].subtables = { more };
+        lookups[1].extension = true;
+
+        PairPosSpec extreme;
+        extreme.pairs = { { 12, 150, -20000 } };
+        lookups[2].subtables = { extreme };
+
+        // not kerning: another feature
+        PairPosSpec other;
+        other.pairs = { { 10, 20, -1000 } };
+        lookups[3].subtables = { other };
+        lookups[3].feature = MakeFontTableTag('d', 'i', 's', 't');
+
+        TableFont face;
+        face.tables[GposTag] = TableWriter::WriteGpos(lookups);
+
+        // GPOS kerning takes precedence over the kern table
+        face.tables[KernTag] = TableWriter::WriteKern({ { { { 10, 20, -999 } } } });
+
+        KerningTable table(face, EveryOtherGlyph());
+        CHECK(table.GetSource() == KerningSource::Gpos);
+        CHECK(table.GetKerning(10, 20) == -57);
+
+        // the pair subtable covers 10 but has no entry for these, so the class subtable decides
+        CHECK(table.GetKerning(10, 21) == -11);
+        CHECK(table.GetKerning(13, 22) == -3);
+
+        // -40000 does not fit a row entry and goes to the table lookup
+        CHECK(table.GetKerning(12, 150) == -40000);
+
+        CheckAllPairs(table, [&](uint16_t left, uint16_t right) { return ExpectedGpos(lookups, left, right); });
+
+        KerningTable unflattened(face, {});
+        CHECK(unflattened.GetFlattenedGlyphCount() == 0);
+        CheckAllPairs(unflattened, [&](uint16_t left, uint16_t right) { return ExpectedGpos(lookups, left, right); });
+    }
+
+    PairPosSpec RandomPairPos(std::mt19937& random)
+    {
+        PairPosSpec spec;
+        spec.valueFormat1 = (uint16_t)(random() % 16 | 0x4);
+        spec.valueFormat2 = (uint16_t)(random() % 16);
+
+        auto glyph = [&]() { return (uint16_t)(random() % GlyphRange); };
+        auto value = [&]() { return (int16_t)((int)(random() % 400) - 200); };
+
+        if (random() % 2)
+        {
+            for (int n = 1 + random() % 200; n > 0; n--)
+                spec.pairs.push_back({ glyph(), glyph(), value() });
+            return spec;
+        }
+
+        spec.class1Count = (uint16_t)(1 + random() % 6);
+        spec.class2Count = (uint16_t)(1 + random() % 6);
+        for (int n = random() % 80; n > 0; n--)
+        {
+            spec.coverage.push_back(glyph());
+            spec.leftClasses[glyph()] = (uint16_t)(random() % (spec.class1Count + 1));
+            spec.rightClasses[glyph()] = (uint16_t)(random() % (spec.class2Count + 1));
+        }
+
+        for (int i = 0; i < spec.class1Count * spec.class2Count; i++)
+            spec.classValues.push_back(value());
+
+        return spec;
+    }
+
+    // Random tables read through both the flattened rows and the table lookup
+    void TestRandomGpos()
+    {
+        std::mt19937 random(5);
+        for (int round = 0; round < 20; round++)
+        {
+            std::vector<PairLookupSpec> lookups(1 + random() % 3);
+            for (PairLookupSpec& lookup : lookups)
+            {
+                for (int n = 1 + random() % 3; n > 0; n--)
+                    lookup.subtables.push_back(RandomPairPos(random));
+                lookup.extension = random() % 2;
+            }
+
+            TableFont face;
+            face.tables[GposTag] = TableWriter::WriteGpos(lookups);
+
+            std::vector<uint16_t> glyphs;
+            for (int n = random() % GlyphRange; n > 0; n--)
+                glyphs.push_back((uint16_t)(random() % GlyphRange));
+
+            KerningTable table(face, glyphs);
+            CheckAllPairs(table, [&](uint16_t left, uint16_t right) { return ExpectedGpos(lookups, left, right); });
+        }
+    }
+
+    // Truncated and corrupted tables must read as some kerning, never out of bounds
+    void TestCorruptTables()
+    {
+        std::vector<PairLookupSpec> lookups(2);
+        std::mt19937 random(9);
+        lookups[0].subtables = { RandomPairPos(random), RandomPairPos(random) };
+        lookups[1].subtables = { RandomPairPos(random) };
+        lookups[1].extension = true;
+
+        std::vector<uint8_t> gpos = TableWriter::WriteGpos(lookups);
+        std::vector<uint8_t> kern = TableWriter::WriteKern({ { { { 10, 20, -5 }, { 11, 3, 7 } } } });
+
+        for (int round = 0; round < 300; round++)
+        {
+            TableFont face;
+            std::vector<uint8_t>& table = face.tables[round % 3 ? GposTag : KernTag];
+            table = round % 3 ? gpos : kern;
+
+            if (round % 2)
+                table.resize(random() % table.size());
+            for (int n = random() % 8; n > 0 && !table.empty(); n--)
+                table[random() % table.size()] = (uint8_t)random();
+
+            KerningTable kerning(face, EveryOtherGlyph());
+            for (int n = 0; n < 2000; n++)
+                kerning.GetKerning((uint16_t)random(), (uint16_t)random());
+        }
+    }
+}
+
+int main()
+{
+    TestWithoutTables();
+    TestKern();
+    TestGpos();
+    TestRandomGpos();
+    TestCorruptTables();
+    return 0;
+}
@@ -0,0 +1,61 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "ShapingCache.h"
+#include "TestFont.h"
+
+// UI relabel: every frame re-shapes all labels of a screen, of which a few change (counters,
+// timers). Reports shaped runs per second with the cache on and off.
+int main()
+{
+    const size_t LabelCount = 400;
+    const size_t ChangingLabels = 8;
+    const size_t Frames = 500;
+
+    std::vector<std::u16string> labels;
+    for (size_t i = 0; i < LabelCount; i++)
+    {
+        std::u16string label = i % 2 ? u"설정 항목 " : u"Settings item ";
+        label += std::u16string(1, (char16_t)(u'A' + i % 26)) + u" - " + std::u16string(i % 17, u'x');
+        labels.push_back(label);
+    }
+
+    TestFont face;
+    ShapingCache cache(4 * 1024 * 1024);
+
+    auto runFrames = [&]()
+    {
+        for (size_t frame = 0; frame < Frames; frame++)
+        {
+            for (size_t i = 0; i < LabelCount; i++)
+            {
+                if (i < ChangingLabels)
+                {
+                    std::u16string label = u"Score: ";
+                    for (size_t n = frame * LabelCount + i; n > 0; n /= 10)
+                        label += (char16_t)(u'0' + n % 10);
+                    KeepResult(cache.Shape(face, 14.0f, label, ShapingFeatureKerning).width);
+                }
+                else
+                    KeepResult(cache.Shape(face, 14.0f, labels[i], ShapingFeatureKerning).width);
+            }
+        }
+    };
+
+    size_t runs = LabelCount * Frames;
+
+    for (bool enabled : { false, true })
+    {
+        cache.SetEnabled(enabled);
+        cache.ResetStats();
+        double seconds = MeasureSeconds(3, runFrames);
+
+        ShapingCacheStats stats = cache.GetStats();
+        std::printf("cache %-3s: %6.2f M runs/s (%.1f%% hits, %zu entries, %zu bytes)\n", enabled ? "on" : "off",
+            runs / seconds * 1e-6, 100.0 * stats.hits / (stats.hits + stats.misses), stats.entryCount, stats.bytes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "Check.h"
+#include "ShapingCache.h"
+#include "SharedShapingCache.h"
+#include "TestFont.h"
+
+// Every allocation of the process is counted, so the test sees what the cache really holds
+// rather than what it reports
+namespace
+{
+    std::atomic<size_t> liveBytes { 0 };
+
+    struct alignas(std::max_align_t) AllocationHeader
+    {
+        size_t size;
+    };
+}
+
+void* operator new(size_t size)
+{
+    auto* header = (AllocationHeader*)std::malloc(sizeof(AllocationHeader) + size);
+    if (!header) throw std::bad_alloc();
+
+    header->size = size;
+    liveBytes += size;
+    return header + 1;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (!p) return;
+
+    auto* header = (AllocationHeader*)p - 1;
+    liveBytes -= header->size;
+    std::free(header);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+namespace
+{
+    // Mixes texts that fit the string's inline buffer with ones that need the heap, which is
+    // what moved heap buffers between entries when eviction move-assigned them
+    std::u16string MakeLabel(size_t i)
+    {
+        std::u16string text = u"#" + std::u16string(1, (char16_t)(0xAC00 + i % 11172));
+        for (size_t n = i; n > 0; n /= 10)
+            text += (char16_t)(u'0' + n % 10);
+
+        if (i % 3 == 0)
+            text += std::u16string(40 + i % 200, u'x');
+
+        return text;
+    }
+
+    bool SameRun(const ShapedRun& a, const ShapedRun& b)
+    {
+        if (a.width != b.width || a.glyphs.size() != b.glyphs.size()) return false;
+
+        for (size_t i = 0; i < a.glyphs.size(); i++)
+        {
+            if (a.glyphs[i].glyphIndex != b.glyphs[i].glyphIndex || a.glyphs[i].cluster != b.glyphs[i].cluster ||
+                a.glyphs[i].advance != b.glyphs[i].advance)
+                return false;
+        }
+
+        return true;
+    }
+
+    void TestResults()
+    {
+        TestFont face;
+        ShapingCache cache(1 << 20);
+        ShapedRun expected;
+
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (size_t i = 0; i < 500; i++)
+            {
+                std::u16string text = MakeLabel(i);
+                ShapeText(face, 12.0f, text, ShapingFeatureKerning, expected);
+                CHECK(SameRun(cache.Shape(face, 12.0f, text, ShapingFeatureKerning), expected));
+            }
+        }
+
+        ShapingCacheStats stats = cache.GetStats();
+        CHECK(stats.misses == 500);
+        CHECK(stats.hits == 500);
+        CHECK(stats.evictions == 0);
+
+        // size, features and face are part of the key
+        TestFont other(2);
+        cache.Shape(face, 13.0f, MakeLabel(1), ShapingFeatureKerning);
+        cache.Shape(face, 12.0f, MakeLabel(1), ShapingFeatureNone);
+        cache.Shape(other, 12.0f, MakeLabel(1), ShapingFeatureKerning);
+        CHECK(cache.GetStats().misses == 503);
+    }
+
+    void TestMemoryStaysBounded(size_t byteBudget)
+    {
+        TestFont face;
+        size_t before = liveBytes;
+        size_t peak = 0;
+        {
+            ShapingCache cache(byteBudget);
+            for (size_t i = 0; i < 50000; i++)
+            {
+                cache.Shape(face, 12.0f, MakeLabel(i), ShapingFeatureKerning);
+
+                ShapingCacheStats stats = cache.GetStats();
+                CHECK(stats.bytes <= byteBudget || stats.entryCount == 1);
+
+                if (liveBytes - before > peak) peak = liveBytes - before;
+            }
+
+            CHECK(cache.GetStats().evictions > 0);
+        }
+
+        // the budget counts entries, their share of a half-full slot table and their own buffers;
+        // on top of it the entry vector may have grown to twice its size, plus the largest
+        // single entry, which is always kept
+        size_t largestEntry = 8 * 1024;
+        std::fprintf(stderr, "budget %zu: peak %zu bytes\n", byteBudget, peak);
+        CHECK(peak <= 2 * byteBudget + largestEntry);
+        CHECK(liveBytes == before);
+    }
+
+    // A full shared tier starts over instead of refusing every later run, so text shaped after
+    // the first budget's worth is still shared
+    void TestSharedTierKeepsSharing()
+    {
+        TestFont face;
+        SharedShapingCache tier(16 * 1024);
+        ShapedRun run, found;
+
+        for (size_t i = 0; i < 5000; i++)
+        {
+            std::u16string text = MakeLabel(i);
+            ShapeText(face, 12.0f, text, ShapingFeatureKerning, run);
+            uint64_t hash = ShapingCache::Hash(face.GetId(), 12.0f, ShapingFeatureKerning, text);
+            tier.Publish(hash, face.GetId(), 12.0f, ShapingFeatureKerning, text, run);
+
+            CHECK(tier.Find(hash, face.GetId(), 12.0f, ShapingFeatureKerning, text, found));
+            CHECK(SameRun(found, run));
+            CHECK(tier.GetStats().bytes <= 16 * 1024);
+        }
+
+        SharedShapingCacheStats stats = tier.GetStats();
+        CHECK(stats.published == 5000 && stats.dropped == 0 && stats.resets > 0);
+
+        // publishing a run the tier holds changes nothing
+        tier.Publish(ShapingCache::Hash(face.GetId(), 12.0f, ShapingFeatureKerning, MakeLabel(4999)), face.GetId(), 12.0f, ShapingFeatureKerning, MakeLabel(4999), run);
+        CHECK(tier.GetStats().published == 5000 && tier.GetStats().bytes == stats.bytes);
+
+        // a run larger than the whole budget is the only one never shared
+        std::u16string huge(4000, u'x');
+        ShapeText(face, 12.0f, huge, ShapingFeatureKerning, run);
+        tier.Publish(ShapingCache::Hash(face.GetId(), 12.0f, ShapingFeatureKerning, huge), face.GetId(), 12.0f, ShapingFeatureKerning, huge, run);
+        CHECK(tier.GetStats().dropped == 1 && tier.GetStats().bytes == stats.bytes);
+    }
+}
+
+int main()
+{
+    TestResults();
+    TestSharedTierKeepsSharing();
+    TestMemoryStaysBounded(4000);
+    TestMemoryStaysBounded(64 * 1024);
+    TestMemoryStaysBounded(1024 * 1024);
+    return 0;
+}
@@ -0,0 +1,500 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "TestFont.h"
+
+// TestFont with sfnt tables built in memory, and writers for the tables the text pipeline reads
+class TableFont : public TestFont
+{
+public:
+    std::map<uint32_t, std::vector<uint8_t>> tables;
+
+    explicit TableFont(uint32_t id = 1) : TestFont(id) {}
+
+    FontTable GetFontTable(uint32_t tag) const override
+    {
+        auto it = tables.find(tag);
+        if (it == tables.end()) return { nullptr, 0 };
+        return { it->second.data(), it->second.size() };
+    }
+};
+
+struct KernPair
+{
+    uint16_t left;
+    uint16_t right;
+    int16_t value;
+};
+
+struct KernSubtableSpec
+{
+    std::vector<KernPair> pairs;
+    uint16_t coverage = 0x1;    // horizontal; 0x4 cross-stream, 0x8 override
+};
+
+// One PairPos subtable: format 1 from 'pairs' if it is not empty, else format 2 from the classes
+struct PairPosSpec
+{
+    std::vector<KernPair> pairs;
+
+    std::vector<uint16_t> coverage;             // left glyphs
+    std::map<uint16_t, uint16_t> leftClasses;   // glyphs not listed are class 0
+    std::map<uint16_t, uint16_t> rightClasses;
+    uint16_t class1Count = 0;
+    uint16_t class2Count = 0;
+    std::vector<int16_t> classValues;           // class1Count * class2Count
+
+    // XAdvance is always written; other fields get filler values
+    uint16_t valueFormat1 = 0x4;
+    uint16_t valueFormat2 = 0;
+};
+
+struct PairLookupSpec
+{
+    std::vector<PairPosSpec> subtables;
+    uint32_t feature = MakeFontTableTag('k', 'e', 'r', 'n');
+    uint16_t type = 2;          // other types must be skipped
+    bool extension = false;     // wrapped in extension subtables with 32-bit offsets
+};
+
+struct GlyfPoint
+{
+    int16_t x;
+    int16_t y;
+    bool onCurve = true;
+};
+
+// Placed by offset, with a 2x2 matrix as in the glyf table: x' = xx * x + yx * y + dx
+struct GlyfComponent
+{
+    uint16_t glyph;
+    int16_t dx = 0;
+    int16_t dy = 0;
+    float xx = 1, xy = 0, yx = 0, yy = 1;
+};
+
+// A simple glyph from 'contours', or a composite one if it has components
+struct GlyfGlyphSpec
+{
+    std::vector<std::vector<GlyfPoint>> contours;
+    std::vector<GlyfComponent> components;
+};
+
+namespace TableWriter
+{
+    inline void Put16(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back((uint8_t)(value >> 8));
+        out.push_back((uint8_t)value);
+    }
+
+    inline void Put32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        Put16(out, value >> 16);
+        Put16(out, value & 0xFFFF);
+    }
+
+    inline void Patch16(std::vector<uint8_t>& out, size_t at, size_t value)
+    {
+        out[at] = (uint8_t)(value >> 8);
+        out[at + 1] = (uint8_t)value;
+    }
+
+    inline void PutValueRecord(std::vector<uint8_t>& out, uint16_t format, int16_t xAdvance)
+    {
+        for (uint16_t bit = 1; bit < 0x100; bit <<= 1)
+        {
+            if (format & bit) Put16(out, bit == 0x4 ? (uint16_t)xAdvance : 0x5A5A);
+        }
+    }
+
+    // Format 2 (ranges) for format 2 subtables, so both formats get used
+    inline void PutCoverage(std::vector<uint8_t>& out, std::vector<uint16_t> glyphs, uint16_t format)
+    {
+        std::sort(glyphs.begin(), glyphs.end());
+        glyphs.erase(std::unique(glyphs.begin(), glyphs.end()), glyphs.end());
+
+        Put16(out, format);
+        if (format == 1)
+        {
+            Put16(out, (uint32_t)glyphs.size());
+            for (uint16_t glyph : glyphs) Put16(out, glyph);
+            return;
+        }
+
+        std::vector<uint16_t> starts;
+        for (size_t i = 0; i < glyphs.size(); i++)
+        {
+            if (i == 0 || glyphs[i] != glyphs[i - 1] + 1) starts.push_back((uint16_t)i);
+        }
+
+        Put16(out, (uint32_t)starts.size());
+        for (size_t k = 0; k < starts.size(); k++)
+        {
+            size_t end = k + 1 < starts.size() ? starts[k + 1] : glyphs.size();
+            Put16(out, glyphs[starts[k]]);
+            Put16(out, glyphs[end - 1]);
+            Put16(out, starts[k]);
+        }
+    }
+
+    inline std::vector<uint8_t> WritePairPos(const PairPosSpec& spec)
+    {
+        std::vector<uint8_t> out;
+
+        if (!spec.pairs.empty())
+        {
+            std::map<uint16_t, std::map<uint16_t, int16_t>> sets;
+            for (const KernPair& pair : spec.pairs)
+                sets[pair.left][pair.right] = pair.value;
+
+            Put16(out, 1);
+            Put16(out, 0); // coverage, patched
+            Put16(out, spec.valueFormat1);
+            Put16(out, spec.valueFormat2);
+            Put16(out, (uint32_t)sets.size());
+            size_t setOffsets = out.size();
+            for (size_t i = 0; i < sets.size(); i++) Put16(out, 0);
+
+            std::vector<uint16_t> lefts;
+            size_t i = 0;
+            for (auto& [left, set] : sets)
+            {
+                lefts.push_back(left);
+                Patch16(out, setOffsets + i++ * 2, out.size());
+                Put16(out, (uint32_t)set.size());
+                for (auto& [right, value] : set)
+                {
+                    Put16(out, right);
+                    PutValueRecord(out, spec.valueFormat1, value);
+                    PutValueRecord(out, spec.valueFormat2, 0);
+                }
+            }
+
+            Patch16(out, 2, out.size());
+            PutCoverage(out, lefts, 1);
+            return out;
+        }
+
+        Put16(out, 2);
+        Put16(out, 0); // coverage, patched
+        Put16(out, spec.valueFormat1);
+        Put16(out, spec.valueFormat2);
+        Put16(out, 0); // class defs, patched
+        Put16(out, 0);
+        Put16(out, spec.class1Count);
+        Put16(out, spec.class2Count);
+        for (int16_t value : spec.classValues)
+        {
+            PutValueRecord(out, spec.valueFormat1, value);
+            PutValueRecord(out, spec.valueFormat2, 0);
+        }
+
+        Patch16(out, 2, out.size());
+        PutCoverage(out, spec.coverage, 2);
+
+        // class def 1 as an array from the first to the last listed glyph, class def 2 as ranges
+        Patch16(out, 8, out.size());
+        Put16(out, 1);
+        uint16_t first = spec.leftClasses.empty() ? 0 : spec.leftClasses.begin()->first;
+        uint16_t last = spec.leftClasses.empty() ? 0 : spec.leftClasses.rbegin()->first;
+        Put16(out, first);
+        Put16(out, spec.leftClasses.empty() ? 0 : last - first + 1);
+        for (uint32_t glyph = first; !spec.leftClasses.empty() && glyph <= last; glyph++)
+        {
+            auto it = spec.leftClasses.find((uint16_t)glyph);
+            Put16(out, it == spec.leftClasses.end() ? 0 : it->second);
+        }
+
+        Patch16(out, 10, out.size());
+        Put16(out, 2);
+        Put16(out, (uint32_t)spec.rightClasses.size());
+        for (auto& [glyph, glyphClass] : spec.rightClasses)
+        {
+            Put16(out, glyph);
+            Put16(out, glyph);
+            Put16(out, glyphClass);
+        }
+
+        return out;
+    }
+
+    // GPOS with an empty script list; every lookup gets a feature record of its own. Lookup headers
+    // and extension records come first and the subtables after them, as in real fonts, so that
+    // extension lookups can hold more than 64 KB of subtables.
+    inline std::vector<uint8_t> WriteGpos(const std::vector<PairLookupSpec>& lookups)
+    {
+        std::vector<uint8_t> out;
+        Put16(out, 1);
+        Put16(out, 0);
+        Put16(out, 10); // script list
+        Put16(out, 12); // feature list
+        Put16(out, 0);  // lookup list, patched
+        Put16(out, 0);  // no scripts
+
+        Put16(out, (uint32_t)lookups.size());
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            Put32(out, lookups[i].feature);
+            Put16(out, (uint32_t)(2 + lookups.size() * 6 + i * 6));
+        }
+
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            Put16(out, 0);
+            Put16(out, 1);
+            Put16(out, (uint32_t)i);
+        }
+
+        size_t lookupList = out.size();
+        Patch16(out, 8, lookupList);
+        Put16(out, (uint32_t)lookups.size());
+        for (size_t i = 0; i < lookups.size(); i++) Put16(out, 0);
+
+        // where each subtable's offset goes: (position, base) of a 16-bit or an extension's 32-bit offset
+        struct Reference { size_t at; size_t base; bool wide; };
+        std::vector<std::vector<Reference>> references(lookups.size());
+
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            const PairLookupSpec& spec = lookups[i];
+            size_t lookup = out.size();
+            Patch16(out, lookupList + 2 + i * 2, lookup - lookupList);
+
+            Put16(out, spec.extension ? 9 : spec.type);
+            Put16(out, 0);
+            Put16(out, (uint32_t)spec.subtables.size());
+            size_t subtableOffsets = out.size();
+            for (size_t k = 0; k < spec.subtables.size(); k++)
+            {
+                Put16(out, 0);
+                references[i].push_back({ subtableOffsets + k * 2, lookup, false });
+            }
+
+            for (size_t k = 0; spec.extension && k < spec.subtables.size(); k++)
+            {
+                Patch16(out, subtableOffsets + k * 2, out.size() - lookup);
+                references[i][k] = { out.size() + 4, out.size(), true };
+                Put16(out, 1);
+                Put16(out, spec.type);
+                Put32(out, 0);
+            }
+        }
+
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            for (size_t k = 0; k < lookups[i].subtables.size(); k++)
+            {
+                const Reference& reference = references[i][k];
+                size_t offset = out.size() - reference.base;
+                if (reference.wide)
+                {
+                    Patch16(out, reference.at, offset >> 16);
+                    Patch16(out, reference.at + 2, offset & 0xFFFF);
+                }
+                else
+                {
+                    Patch16(out, reference.at, offset);
+                }
+
+                std::vector<uint8_t> subtable = WritePairPos(lookups[i].subtables[k]);
+                out.insert(out.end(), subtable.begin(), subtable.end());
+            }
+        }
+
+        return out;
+    }
+
+    inline void PutF2Dot14(std::vector<uint8_t>& out, float value)
+    {
+        Put16(out, (uint16_t)(int16_t)std::lround(value * 16384));
+    }
+
+    // Flags are run-length coded and coordinates take the short forms where they fit, so the
+    // decoder sees every encoding
+    inline void PutSimpleGlyph(std::vector<uint8_t>& out, const GlyfGlyphSpec& spec)
+    {
+        std::vector<GlyfPoint> points;
+        Put16(out, (uint32_t)spec.contours.size());
+        for (int i = 0; i < 4; i++) Put16(out, 0); // bounding box, unused
+        for (const std::vector<GlyfPoint>& contour : spec.contours)
+        {
+            points.insert(points.end(), contour.begin(), contour.end());
+            Put16(out, (uint32_t)(points.size() - 1));
+        }
+
+        Put16(out, 0); // no instructions
+
+        std::vector<uint8_t> flags;
+        std::vector<uint8_t> xs, ys;
+        int16_t lastX = 0, lastY = 0;
+        for (const GlyfPoint& point : points)
+        {
+            uint8_t flag = point.onCurve ? 0x01 : 0;
+            auto put = [&](std::vector<uint8_t>& coordinates, int delta, uint8_t shortFlag, uint8_t sameFlag)
+            {
+                if (delta == 0)
+                {
+                    flag |= sameFlag;
+                }
+                else if (delta > -256 && delta < 256)
+                {
+                    flag |= shortFlag | (delta > 0 ? sameFlag : 0);
+                    coordinates.push_back((uint8_t)std::abs(delta));
+                }
+                else
+                {
+                    Put16(coordinates, (uint16_t)(int16_t)delta);
+                }
+            };
+
+            put(xs, point.x - lastX, 0x02, 0x10);
+            put(ys, point.y - lastY, 0x04, 0x20);
+            lastX = point.x;
+            lastY = point.y;
+
+            flags.push_back(flag);
+        }
+
+        // run-length code the flags
+        for (size_t i = 0; i < flags.size(); )
+        {
+            size_t run = 1;
+            while (i + run < flags.size() && flags[i + run] == flags[i] && run < 256) run++;
+            if (run > 1)
+            {
+                out.push_back(flags[i] | 0x08);
+                out.push_back((uint8_t)(run - 1));
+            }
+            else
+            {
+                out.push_back(flags[i]);
+            }
+
+            i += run;
+        }
+
+        out.insert(out.end(), xs.begin(), xs.end());
+        out.insert(out.end(), ys.begin(), ys.end());
+    }
+
+    // Byte offsets where they fit in a byte, word offsets otherwise; the smallest matrix form
+    inline void PutCompositeGlyph(std::vector<uint8_t>& out, const GlyfGlyphSpec& spec)
+    {
+        Put16(out, 0xFFFF);
+        for (int i = 0; i < 4; i++) Put16(out, 0);
+
+        for (size_t i = 0; i < spec.components.size(); i++)
+        {
+            const GlyfComponent& component = spec.components[i];
+            bool words = component.dx < -128 || component.dx > 127 || component.dy < -128 || component.dy > 127;
+
+            uint16_t flags = 0x0002;
+            if (words) flags |= 0x0001;
+            if (i + 1 < spec.components.size()) flags |= 0x0020;
+            if (component.xy != 0 || component.yx != 0) flags |= 0x0080;
+            else if (component.xx != component.yy) flags |= 0x0040;
+            else if (component.xx != 1) flags |= 0x0008;
+
+            Put16(out, flags);
+            Put16(out, component.glyph);
+            if (words)
+            {
+                Put16(out, (uint16_t)component.dx);
+                Put16(out, (uint16_t)component.dy);
+            }
+            else
+            {
+                out.push_back((uint8_t)component.dx);
+                out.push_back((uint8_t)component.dy);
+            }
+
+            if (flags & 0x0080)
+            {
+                PutF2Dot14(out, component.xx);
+                PutF2Dot14(out, component.xy);
+                PutF2Dot14(out, component.yx);
+                PutF2Dot14(out, component.yy);
+            }
+            else if (flags & 0x0040)
+            {
+                PutF2Dot14(out, component.xx);
+                PutF2Dot14(out, component.yy);
+            }
+            else if (flags & 0x0008)
+            {
+                PutF2Dot14(out, component.xx);
+            }
+        }
+    }
+
+    // head, loca and glyf tables of the glyphs, with 16-bit or 32-bit loca offsets
+    inline void WriteGlyf(std::map<uint32_t, std::vector<uint8_t>>& tables, const std::vector<GlyfGlyphSpec>& glyphs, bool longOffsets)
+    {
+        std::vector<uint8_t> glyf;
+        std::vector<size_t> offsets;
+        for (const GlyfGlyphSpec& glyph : glyphs)
+        {
+            offsets.push_back(glyf.size());
+            if (!glyph.components.empty()) PutCompositeGlyph(glyf, glyph);
+            else if (!glyph.contours.empty()) PutSimpleGlyph(glyf, glyph);
+            while (glyf.size() % 4 != 0) glyf.push_back(0);
+        }
+
+        offsets.push_back(glyf.size());
+
+        std::vector<uint8_t> loca;
+        for (size_t offset : offsets)
+        {
+            if (longOffsets) Put32(loca, (uint32_t)offset);
+            else Put16(loca, (uint32_t)(offset / 2));
+        }
+
+        std::vector<uint8_t> head(54, 0);
+        Patch16(head, 18, 1000);
+        Patch16(head, 50, longOffsets ? 1 : 0);
+
+        tables[MakeFontTableTag('h', 'e', 'a', 'd')] = head;
+        tables[MakeFontTableTag('l', 'o', 'c', 'a')] = loca;
+        tables[MakeFontTableTag('g', 'l', 'y', 'f')] = glyf;
+    }
+
+    // Version 0 kern table of format 0 subtables
+    inline std::vector<uint8_t> WriteKern(const std::vector<KernSubtableSpec>& subtables)
+    {
+        std::vector<uint8_t> out;
+        Put16(out, 0);
+        Put16(out, (uint32_t)subtables.size());
+
+        for (const KernSubtableSpec& spec : subtables)
+        {
+            std::vector<KernPair> pairs = spec.pairs;
+            std::sort(pairs.begin(), pairs.end(), [](const KernPair& a, const KernPair& b)
+            {
+                return a.left != b.left ? a.left < b.left : a.right < b.right;
+            });
+
+            Put16(out, 0);
+            Put16(out, (uint32_t)(14 + pairs.size() * 6));
+            Put16(out, spec.coverage);
+            Put16(out, (uint32_t)pairs.size());
+            Put16(out, 0);
+            Put16(out, 0);
+            Put16(out, 0);
+            for (const KernPair& pair : pairs)
+            {
+                Put16(out, pair.left);
+                Put16(out, pair.right);
+                Put16(out, (uint16_t)pair.value);
+            }
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FontFace.h"
+
+// Synthetic face for tests and benchmarks: every code point below U+10000 except U+FFFF has a glyph,
+// advances vary per glyph and a fixed share of pairs is kerned, so caches and the shaper see
+// realistic lookups without a font file.
+class TestFont : public FontFace
+{
+    uint32_t id;
+
+public:
+    explicit TestFont(uint32_t id = 1) : id(id) {}
+
+    uint32_t GetId() const override { return id; }
+
+    FontMetrics GetMetrics() const override { return { 1000, 800, 200, 90 }; }
+
+    uint16_t GetGlyphIndex(char32_t codePoint) const override
+    {
+        return codePoint < 0xFFFF ? (uint16_t)(codePoint + 1) : 0;
+    }
+
+    int32_t GetGlyphAdvance(uint16_t glyphIndex) const override
+    {
+        if (glyphIndex == ' ' + 1) return 250;
+        return glyphIndex >= 0x1100 ? 1000 : 450 + glyphIndex % 8 * 25;
+    }
+
+    int32_t GetKerning(uint16_t leftGlyph, uint16_t rightGlyph) const override
+    {
+        return (leftGlyph * 31 + rightGlyph) % 11 == 0 ? -40 : 0;
+    }
+};
+
+// Face that has glyphs for one code point range and, optionally, the space, like the faces of a
+// fallback chain (Korean, Latin, emoji, CJK)
+class RangeFont : public TestFont
+{
+    char32_t first;
+    char32_t last;
+    bool hasSpace;
+
+public:
+    RangeFont(uint32_t id, char32_t first, char32_t last, bool hasSpace) : TestFont(id), first(first), last(last), hasSpace(hasSpace) {}
+
+    uint16_t GetGlyphIndex(char32_t codePoint) const override
+    {
+        bool covered = (first <= codePoint && codePoint <= last) || (hasSpace && codePoint == ' ');
+        return covered ? (uint16_t)(codePoint % 0xFFFE + 1) : 0;
+    }
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cmath>
+
+#include "GlyphAtlas.h"
+
+// Renders every glyph as a filled box as wide as its advance and as tall as the ascent, shifted
+// right by the subpixel offset with partly covered edge columns, so variants differ in pixels
+// and size like real glyphs do
+class TestRasterizer : public GlyphRasterizer
+{
+public:
+    int calls = 0;
+
+    bool Rasterize(const FontFace& face, uint16_t glyphIndex, float fontSize, float subpixelOffset, GlyphBitmap& bitmap) override
+    {
+        calls++;
+
+        FontMetrics metrics = face.GetMetrics();
+        float scale = fontSize / metrics.designUnitsPerEm;
+        float boxWidth = face.GetGlyphAdvance(glyphIndex) * scale * 0.8f;
+
+        bitmap.width = (int)std::ceil(subpixelOffset + boxWidth);
+        bitmap.height = (int)std::ceil(metrics.ascent * scale);
+        bitmap.bearingX = 0;
+        bitmap.bearingY = -bitmap.height;
+        bitmap.coverage.assign((size_t)bitmap.width * bitmap.height, 0);
+
+        for (int x = 0; x < bitmap.width; x++)
+        {
+            float covered = std::fmin(x + 1.0f, subpixelOffset + boxWidth) - std::fmax((float)x, subpixelOffset);
+            uint8_t value = (uint8_t)std::lround(std::fmax(covered, 0.0f) * 255);
+            for (int y = 0; y < bitmap.height; y++)
+                bitmap.coverage[(size_t)y * bitmap.width + x] = value;
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TextAttributeTree.h"
+
+// A long rich text document: 100k formatting spans of up to 200 units over 5M code units, a third
+// of them bold, the rest color only. Cost of styling one 500-unit paragraph for layout, against
+// scanning every span for the ones that overlap it, and of one keystroke-sized edit.
+int main()
+{
+    const uint32_t textLength = 5000000;
+    const int spanCount = 100000;
+    const int queries = 10000;
+    const TextStyle base = { 12, 400, false, false, 0 };
+
+    std::mt19937 random(5);
+    TextAttributeTree tree;
+    std::vector<AttributeSpan> allSpans;
+
+    for (int i = 0; i < spanCount; i++)
+    {
+        uint32_t start = random() % textLength;
+        TextAttributes attributes = { (uint8_t)(TextAttributeColor | (i % 3 == 0 ? TextAttributeWeight : 0)), { 12, 700, false, false, (uint32_t)random() } };
+        uint32_t end = start + 1 + random() % 200;
+        tree.AddSpan(start, end, attributes);
+        allSpans.push_back({ start, end, attributes });
+    }
+
+    std::vector<uint32_t> paragraphs(queries);
+    for (uint32_t& start : paragraphs)
+        start = random() % textLength;
+
+    std::vector<StyledRun> styledRuns;
+    size_t runCount = 0;
+    double styledSeconds = MeasureSeconds(5, [&]()
+    {
+        runCount = 0;
+        for (uint32_t start : paragraphs)
+        {
+            styledRuns.clear();
+            tree.GetStyledRuns(start, start + 500, base, styledRuns);
+            runCount += styledRuns.size();
+        }
+    });
+
+    std::vector<ShapingRun> shapingRuns;
+    double shapingSeconds = MeasureSeconds(5, [&]()
+    {
+        for (uint32_t start : paragraphs)
+        {
+            shapingRuns.clear();
+            tree.GetShapingRuns(start, start + 500, base, shapingRuns);
+        }
+    });
+
+    std::vector<AttributeSpan> found;
+    double scanSeconds = MeasureSeconds(1, [&]()
+    {
+        for (size_t i = 0; i < paragraphs.size(); i += 100)
+        {
+            found.clear();
+            for (const AttributeSpan& span : allSpans)
+            {
+                if (span.start < paragraphs[i] + 500 && span.end > paragraphs[i]) found.push_back(span);
+            }
+        }
+    });
+
+    KeepResult(found.size());
+
+    size_t treeSpans = tree.GetSpanCount();
+
+    // Typing and deleting a few units at a time; over the run the text keeps its length on average
+    double editSeconds = MeasureSeconds(1, [&]()
+    {
+        for (int i = 0; i < queries; i++)
+            tree.AdjustForEdit(random() % textLength, random() % 5, random() % 5);
+    });
+
+    std::printf("%zu spans over %u code units, %.1f styled runs per paragraph\n", treeSpans, textLength, (double)runCount / queries);
+    std::printf("styled runs of a 500-unit paragraph:   %6.2f us\n", styledSeconds / queries * 1e6);
+    std::printf("shaping runs of a 500-unit paragraph:  %6.2f us\n", shapingSeconds / queries * 1e6);
+    std::printf("scanning every span for the same:      %6.2f us\n", scanSeconds / (queries / 100) * 1e6);
+    std::printf("edit:                                  %6.2f us\n", editSeconds / queries * 1e6);
+    return 0;
+}
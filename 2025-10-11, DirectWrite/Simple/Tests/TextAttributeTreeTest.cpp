@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "TextAttributeTree.h"
+
+namespace
+{
+    const TextStyle Base = { 12, 400, false, false, 0 };
+
+    // The tree's behaviour spelled out over a plain list of spans, every query a scan of all of them
+    class SpanModel
+    {
+        struct Span
+        {
+            uint32_t start;
+            uint32_t end;
+            TextAttributes attributes;
+            uint32_t order;
+        };
+
+        std::vector<Span> spans;
+        uint32_t nextOrder = 0;
+
+    public:
+        size_t GetSpanCount() const { return spans.size(); }
+
+        void AddSpan(uint32_t start, uint32_t end, const TextAttributes& attributes)
+        {
+            if (start < end && attributes.mask != TextAttributeNone) spans.push_back({ start, end, attributes, nextOrder++ });
+        }
+
+        void ClearAttributes(uint32_t start, uint32_t end, uint8_t mask)
+        {
+            if (start >= end) return;
+
+            std::vector<Span> kept;
+            for (const Span& span : spans)
+            {
+                if (span.end <= start || span.start >= end || !(span.attributes.mask & mask))
+                {
+                    kept.push_back(span);
+                    continue;
+                }
+
+                if (span.start < start) kept.push_back({ span.start, start, span.attributes, span.order });
+                if (span.end > end) kept.push_back({ end, span.end, span.attributes, span.order });
+
+                Span inside = { std::max(span.start, start), std::min(span.end, end), span.attributes, span.order };
+                inside.attributes.mask &= ~mask;
+                if (inside.attributes.mask) kept.push_back(inside);
+            }
+
+            spans = kept;
+        }
+
+        // A start inside the replaced text moves to its start, an end inside it or at its end moves
+        // with the text after it; a pure insertion only moves what is strictly after it
+        void AdjustForEdit(uint32_t offset, uint32_t removedLength, uint32_t insertedLength)
+        {
+            int64_t shift = (int64_t)insertedLength - removedLength;
+            uint32_t removedEnd = offset + removedLength;
+
+            std::vector<Span> kept;
+            for (Span span : spans)
+            {
+                span.start = span.start < offset ? span.start : span.start >= removedEnd ? (uint32_t)(span.start + shift) : offset;
+                span.end = span.end <= offset ? span.end : span.end >= removedEnd ? (uint32_t)(span.end + shift) : offset;
+                if (span.start < span.end) kept.push_back(span);
+            }
+
+            spans = kept;
+        }
+
+        size_t CountOverlapping(uint32_t start, uint32_t end) const
+        {
+            return std::count_if(spans.begin(), spans.end(), [&](const Span& span) { return span.start < end && span.end > start; });
+        }
+
+        TextStyle GetStyle(uint32_t position) const
+        {
+            TextStyle style = Base;
+            for (uint8_t attribute = 1; attribute < TextAttributeAll; attribute <<= 1)
+            {
+                const Span* latest = nullptr;
+                for (const Span& span : spans)
+                {
+                    if (span.start <= position && position < span.end && (span.attributes.mask & attribute) && (!latest || span.order > latest->order))
+                        latest = &span;
+                }
+
+                if (!latest) continue;
+
+                const TextStyle& values = latest->attributes.values;
+                if (attribute == TextAttributeFontSize) style.fontSize = values.fontSize;
+                if (attribute == TextAttributeWeight) style.weight = values.weight;
+                if (attribute == TextAttributeItalic) style.italic = values.italic;
+                if (attribute == TextAttributeUnderline) style.underline = values.underline;
+                if (attribute == TextAttributeColor) style.color = values.color;
+            }
+
+            return style;
+        }
+    };
+
+    TextAttributes RandomAttributes(std::mt19937& random)
+    {
+        TextAttributes attributes = {};
+        attributes.mask = random() % 32;
+        attributes.values = { (float)(10 + random() % 4), (uint16_t)(random() % 2 ? 700 : 400), random() % 2 == 0, random() % 2 == 0, (uint32_t)(random() % 3) };
+        return attributes;
+    }
+
+    // Random adds, clears and edits, with a random paragraph queried after each one: span counts,
+    // FindSpans and the style of every code unit in the styled and shaping runs have to match
+    void TestAgainstModel()
+    {
+        std::mt19937 random(5);
+        std::vector<AttributeSpan> spans;
+        std::vector<StyledRun> styledRuns;
+        std::vector<ShapingRun> shapingRuns;
+
+        for (int round = 0; round < 100; round++)
+        {
+            TextAttributeTree tree;
+            SpanModel model;
+            uint32_t length = 200;
+
+            for (int operation = 0; operation < 200; operation++)
+            {
+                int kind = random() % 10;
+                if (kind < 5)
+                {
+                    uint32_t start = random() % length;
+                    uint32_t end = start + random() % 40;
+                    TextAttributes attributes = RandomAttributes(random);
+                    tree.AddSpan(start, end, attributes);
+                    model.AddSpan(start, end, attributes);
+                }
+                else if (kind < 7)
+                {
+                    uint32_t start = random() % length;
+                    uint32_t end = start + random() % 30;
+                    uint8_t mask = random() % 32;
+                    tree.ClearAttributes(start, end, mask);
+                    model.ClearAttributes(start, end, mask);
+                }
+                else
+                {
+                    uint32_t offset = random() % length;
+                    uint32_t removed = std::min<uint32_t>(random() % 2 ? 0 : random() % 10, length - offset);
+                    uint32_t inserted = random() % 2 ? 0 : random() % 10;
+                    tree.AdjustForEdit(offset, removed, inserted);
+                    model.AdjustForEdit(offset, removed, inserted);
+                    length = length - removed + inserted;
+                }
+
+                CHECK(tree.GetSpanCount() == model.GetSpanCount());
+
+                uint32_t start = random() % length;
+                uint32_t end = start + 1 + random() % 60;
+
+                spans.clear();
+                tree.FindSpans(start, end, spans);
+                CHECK(spans.size() == model.CountOverlapping(start, end));
+                for (size_t i = 1; i < spans.size(); i++)
+                    CHECK(spans[i - 1].start <= spans[i].start);
+
+                styledRuns.clear();
+                tree.GetStyledRuns(start, end, Base, styledRuns);
+                uint32_t position = start;
+                for (size_t i = 0; i < styledRuns.size(); i++)
+                {
+                    const StyledRun& run = styledRuns[i];
+                    CHECK(run.textStart == position && run.textLength > 0);
+                    CHECK(i == 0 || !(styledRuns[i - 1].style == run.style));
+                    for (uint32_t p = run.textStart; p < run.textStart + run.textLength; p++)
+                        CHECK(model.GetStyle(p) == run.style);
+
+                    position += run.textLength;
+                }
+
+                CHECK(position == end);
+
+                shapingRuns.clear();
+                tree.GetShapingRuns(start, end, Base, shapingRuns);
+                position = start;
+                for (const ShapingRun& run : shapingRuns)
+                {
+                    CHECK(run.textStart == position && run.textLength > 0);
+                    for (uint32_t p = run.textStart; p < run.textStart + run.textLength; p++)
+                    {
+                        TextStyle style = model.GetStyle(p);
+                        CHECK(style.fontSize == run.fontSize && style.weight == run.weight && style.italic == run.italic);
+                    }
+
+                    position += run.textLength;
+                }
+
+                CHECK(position == end);
+            }
+        }
+    }
+
+    void TestLastAddedWins()
+    {
+        TextAttributeTree tree;
+        TextAttributes bold = { TextAttributeWeight, { 0, 700, false, false, 0 } };
+        TextAttributes regular = { TextAttributeWeight, { 0, 400, false, false, 0 } };
+        TextAttributes red = { TextAttributeColor, { 0, 0, false, false, 0xFF0000 } };
+
+        tree.AddSpan(0, 10, bold);
+        tree.AddSpan(5, 8, regular);
+        tree.AddSpan(2, 6, red);
+
+        std::vector<StyledRun> runs;
+        tree.GetStyledRuns(0, 10, Base, runs);
+        CHECK(runs.size() == 5);
+        CHECK(runs[0].textStart == 0 && runs[0].textLength == 2 && runs[0].style.weight == 700 && runs[0].style.color == 0);
+        CHECK(runs[1].textStart == 2 && runs[1].textLength == 3 && runs[1].style.weight == 700 && runs[1].style.color == 0xFF0000);
+        CHECK(runs[2].textStart == 5 && runs[2].textLength == 1 && runs[2].style.weight == 400 && runs[2].style.color == 0xFF0000);
+        CHECK(runs[3].textStart == 6 && runs[3].textLength == 2 && runs[3].style.weight == 400 && runs[3].style.color == 0);
+        CHECK(runs[4].textStart == 8 && runs[4].textLength == 2 && runs[4].style.weight == 700);
+
+        // color does not split shaping units, weight does
+        std::vector<ShapingRun> shaping;
+        tree.GetShapingRuns(0, 10, Base, shaping);
+        CHECK(shaping.size() == 3);
+        CHECK(shaping[0].textStart == 0 && shaping[0].textLength == 5 && shaping[0].weight == 700);
+        CHECK(shaping[1].textStart == 5 && shaping[1].textLength == 3 && shaping[1].weight == 400);
+        CHECK(shaping[2].textStart == 8 && shaping[2].textLength == 2 && shaping[2].weight == 700);
+
+        // the pieces left after clearing keep their precedence: on [6, 8) regular still beats the
+        // part of bold after the cleared range
+        tree.ClearAttributes(3, 6, TextAttributeWeight);
+        runs.clear();
+        tree.GetStyledRuns(0, 10, Base, runs);
+        CHECK(runs.size() == 5);
+        CHECK(runs[2].textStart == 3 && runs[2].textLength == 3 && runs[2].style.weight == Base.weight && runs[2].style.color == 0xFF0000);
+        CHECK(runs[3].textStart == 6 && runs[3].textLength == 2 && runs[3].style.weight == 400);
+        CHECK(runs[4].textStart == 8 && runs[4].style.weight == 700);
+    }
+
+    void TestEdits()
+    {
+        TextAttributes italic = { TextAttributeItalic, { 0, 0, true, false, 0 } };
+        std::vector<AttributeSpan> spans;
+
+        // typing inside a span extends it, at either boundary it does not
+        TextAttributeTree tree;
+        tree.AddSpan(10, 20, italic);
+        tree.AdjustForEdit(15, 0, 3);
+        tree.AdjustForEdit(10, 0, 2);
+        tree.AdjustForEdit(25, 0, 4);
+        tree.FindSpans(0, 100, spans);
+        CHECK(spans.size() == 1 && spans[0].start == 12 && spans[0].end == 25);
+
+        // replacing text that reaches the end of a span keeps the new text in it
+        tree.AdjustForEdit(20, 5, 1);
+        spans.clear();
+        tree.FindSpans(0, 100, spans);
+        CHECK(spans.size() == 1 && spans[0].start == 12 && spans[0].end == 21);
+
+        // deleting all of it removes the span, and its node is reused by the next one
+        tree.AdjustForEdit(10, 15, 0);
+        CHECK(tree.GetSpanCount() == 0);
+        tree.AddSpan(0, 5, italic);
+        CHECK(tree.GetSpanCount() == 1);
+
+        tree.Clear();
+        CHECK(tree.GetSpanCount() == 0);
+        tree.AddSpan(5, 5, italic);
+        tree.AddSpan(6, 3, italic);
+        tree.AddSpan(0, 5, { TextAttributeNone, italic.values });
+        CHECK(tree.GetSpanCount() == 0);
+    }
+}
+
+int main()
+{
+    TestAgainstModel();
+    TestLastAddedWins();
+    TestEdits();
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "TextBlend.h"
+
+namespace
+{
+    int ChannelDifference(uint32_t a, uint32_t b, int shift)
+    {
+        return std::abs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF));
+    }
+
+    // The SSE2 kernel, its tail and the scalar code agree bit for bit
+    void TestSimdMatchesScalar()
+    {
+        TextBlender blender;
+        std::mt19937 random(3);
+
+        for (int round = 0; round < 20000; round++)
+        {
+            uint32_t color = random();
+            size_t count = random() % 37;
+
+            // mostly empty and full coverage, as inside a glyph box
+            std::vector<uint8_t> coverage(count);
+            for (uint8_t& c : coverage)
+            {
+                int kind = random() % 4;
+                c = kind == 0 ? 0 : kind == 1 ? 255 : (uint8_t)random();
+            }
+
+            std::vector<uint32_t> simd(count);
+            for (uint32_t& pixel : simd) pixel = random();
+            std::vector<uint32_t> scalar = simd;
+            std::vector<uint32_t> before = simd;
+
+            blender.BlendSpan(color, coverage.data(), simd.data(), count);
+            blender.BlendSpanScalar(color, coverage.data(), scalar.data(), count);
+            CHECK(simd == scalar);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                if (coverage[i] == 0) CHECK(simd[i] == before[i]);
+                if (coverage[i] == 255) CHECK(simd[i] == (color | 0xFF000000));
+            }
+        }
+    }
+
+    void TestMaskMatchesSpans()
+    {
+        TextBlender blender;
+        std::mt19937 random(4);
+
+        const int width = 13, height = 7;
+        const size_t coverageStride = 16, dstStride = 20;
+
+        std::vector<uint8_t> coverage(coverageStride * height);
+        for (uint8_t& c : coverage) c = (uint8_t)random();
+
+        std::vector<uint32_t> mask(dstStride * height);
+        for (uint32_t& pixel : mask) pixel = random();
+        std::vector<uint32_t> spans = mask;
+
+        blender.BlendMask(0x336699, coverage.data(), coverageStride, width, height, mask.data(), dstStride);
+        for (int y = 0; y < height; y++)
+            blender.BlendSpan(0x336699, &coverage[y * coverageStride], &spans[y * dstStride], width);
+
+        CHECK(mask == spans);
+    }
+
+    // Every coverage of every gray and of random colors, on white, black and random backgrounds
+    void TestAgainstReference()
+    {
+        TextBlender blender;
+        std::mt19937 random(1);
+
+        std::vector<uint8_t> coverage(256);
+        for (int i = 0; i < 256; i++) coverage[i] = (uint8_t)i;
+
+        int maxDifference = 0;
+        size_t overOne = 0;
+        size_t channels = 0;
+
+        for (int round = 0; round < 20000; round++)
+        {
+            uint32_t color = round < 256 ? round * 0x010101u : random();
+            uint32_t background = round % 3 == 0 ? 0xFFFFFFFF : round % 3 == 1 ? 0xFF000000 : random();
+
+            std::vector<uint32_t> blended(256, background);
+            std::vector<uint32_t> reference(256, background);
+            blender.BlendSpan(color, coverage.data(), blended.data(), 256);
+            BlendSpanReference(blender.GetGamma(), blender.GetEnhancedContrast(), color, coverage.data(), reference.data(), 256);
+
+            for (int i = 0; i < 256; i++)
+            {
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    int difference = ChannelDifference(blended[i], reference[i], shift);
+                    maxDifference = std::max(maxDifference, difference);
+                    overOne += difference > 1;
+                    channels++;
+                }
+            }
+        }
+
+        CHECK(maxDifference <= 2);
+        CHECK(overOne * 100000 < channels);
+    }
+
+    // More coverage never gives less alpha
+    void TestAlphaTables()
+    {
+        TextBlender blender;
+        for (uint32_t gray = 0; gray < 256; gray++)
+        {
+            const uint8_t* table = blender.GetAlphaTable(gray * 0x010101u);
+            CHECK(table[0] == 0 && table[255] == 255);
+            for (int c = 1; c < 256; c++)
+                CHECK(table[c] >= table[c - 1]);
+        }
+    }
+}
+
+int main()
+{
+    TestSimdMatchesScalar();
+    TestMaskMatchesSpans();
+    TestAgainstReference();
+    TestAlphaTables();
+    return 0;
+}
@@ -0,0 +1,46 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TextBreak.h"
+
+// Code points per second of each segmenter, and of both together as layout runs them
+int main()
+{
+    struct Corpus
+    {
+        const char* name;
+        std::u16string sample;
+    };
+
+    const Corpus corpora[] =
+    {
+        { "English", u"The quick brown fox (jumps) over the lazy dog; it's 3:45 p.m. already!\n" },
+        { "Korean", u"안녕하세요, 오늘 회의는 오후 3시에 2층 회의실에서 진행합니다.\n" },
+        { "Japanese", u"「吾輩は猫である。」名前はまだ無い。どこで生れたかとんと見当がつかぬ。\n" },
+        { "Mixed emoji", u"Build passed 🎉 배포 완료 ✅ next: 🚀 release 👩‍👩‍👧 🇰🇷\n" },
+    };
+
+    for (const Corpus& corpus : corpora)
+    {
+        std::u16string text;
+        while (text.size() < 64 * 1024)
+            text += corpus.sample;
+
+        size_t codePoints = 0;
+        for (size_t i = 0; i < text.size(); i++)
+            codePoints += text[i] < 0xDC00 || text[i] >= 0xE000;
+
+        std::vector<uint8_t> flags(text.size() + 1);
+        double graphemeSeconds = MeasureSeconds(50, [&]() { FindGraphemeBoundaries(text, flags.data()); });
+        double lineSeconds = MeasureSeconds(50, [&]() { FindLineBreaks(text, flags.data()); });
+        double bothSeconds = MeasureSeconds(50, [&]() { AnalyzeTextBreaks(text, flags); });
+
+        double millions = codePoints * 1e-6;
+        std::printf("%-12s graphemes %5.1f M/s   lines %5.1f M/s   both %5.1f M/s\n", corpus.name,
+            millions / graphemeSeconds, millions / lineSeconds, millions / bothSeconds);
+    }
+
+    return 0;
+}
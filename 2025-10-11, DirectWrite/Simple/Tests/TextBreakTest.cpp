@@ -0,0 +1,314 @@
+﻿#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "TextBreak.h"
+
+namespace
+{
+    // In the notation of LineBreakTest.txt (UAX #14, Unicode 14.0): code points in hex, with ÷
+    // where a line may break and × where it may not, including the start and the end of the text.
+    // The tree uses the pair form of LB25, so the cases stay away from number sequences where
+    // LineBreakTest's regex form of LB25 decides differently.
+    const char* LineBreakCases[] =
+    {
+        // LB2, LB13, LB18: leading spaces break before what follows, unless LB11-LB13 keep them together
+        "× 0020 × 0020 × 0029 ÷",
+        "× 0020 × 0021 ÷",
+        "× 0020 × 0029 ÷",
+        "× 0020 × 005D ÷",
+        "× 0020 × 002C ÷",
+        "× 0020 × 002F ÷",
+        "× 0020 ÷ 0061 ÷",
+        "× 0020 × 2060 × 0061 ÷",
+        "× 0020 ÷ 0308 ÷",
+        "× 0061 × 0020 × 0029 ÷",
+
+        // LB4-LB7: hard breaks and spaces
+        "× 000D × 000A ÷ 0061 ÷",
+        "× 000D ÷ 0061 ÷",
+        "× 000A ÷ 000A ÷",
+        "× 0061 × 000B ÷ 0062 ÷",
+        "× 0061 × 0085 ÷ 0062 ÷",
+        "× 0061 × 2028 ÷ 0062 ÷",
+        "× 0061 × 0020 × 0020 ÷ 0062 ÷",
+
+        // LB8: after ZW and the spaces that follow it; a CM there takes AL (LB10)
+        "× 0061 × 200B ÷ 0062 ÷",
+        "× 0061 × 200B × 0020 × 0020 ÷ 0062 ÷",
+        "× 0061 × 200B ÷ 0308 × 0028 ÷",
+
+        // LB8a, LB9, LB10: ZWJ and combining marks
+        "× 200D × 2764 ÷",
+        "× 0061 × 200D × 0062 ÷",
+        "× 0061 × 0308 × 0308 × 0062 ÷",
+        "× 0061 × 0020 ÷ 0308 × 0062 ÷",
+
+        // LB11, LB12, LB12a: WJ and GL
+        "× 0061 × 2060 × 0020 ÷ 0062 ÷",
+        "× 0061 × 0020 × 2060 × 0062 ÷",
+        "× 2060 × 0020 ÷ 0061 ÷",
+        "× 0061 × 00A0 × 0062 ÷",
+        "× 0061 × 0020 ÷ 00A0 × 0062 ÷",
+        "× 002D ÷ 00A0 × 0061 ÷",
+        "× 2010 ÷ 00A0 × 0061 ÷",
+
+        // LB13
+        "× 0061 × 0020 × 0029 ÷",
+        "× 0061 × 0021 ÷",
+        "× 0061 × 0020 × 0021 ÷",
+        "× 0061 × 002C × 0062 ÷",
+        "× 0061 × 002F ÷ 0062 ÷",
+
+        // LB14-LB17, across spaces
+        "× 0028 × 0020 × 0020 × 0061 ÷",
+        "× 0028 × 0061 ÷",
+        "× 0022 × 0020 × 0028 ÷",
+        "× 0022 × 0020 × 0020 × 0028 × 0061 ÷",
+        "× 0029 × 0020 × 3005 ÷",
+        "× 005D × 0020 × 3005 ÷",
+        "× 2014 × 0020 × 2014 ÷",
+        "× 2014 × 2014 ÷",
+
+        // LB19, LB20, LB21
+        "× 0061 × 0020 ÷ 0022 × 0062 ÷",
+        "× 0022 × 0061 ÷",
+        "× 0061 × 0022 ÷",
+        "× 0061 ÷ FFFC ÷ 0062 ÷",
+        "× 0061 × 2010 ÷ 0062 ÷",
+        "× 0061 × 00AD ÷ 0062 ÷",
+
+        // LB21, LB22
+        "× 00B4 × 0061 ÷",
+        "× 0061 × 3005 ÷",
+        "× 0061 × 2024 ÷",
+        "× 4E00 × 2024 ÷",
+        "× 0031 × 2024 ÷",
+
+        // LB23-LB25, the pairs on which the full LB25 number rule agrees
+        "× 0061 × 0031 ÷",
+        "× 0031 × 0061 ÷",
+        "× 0024 × 4E00 ÷",
+        "× 4E00 × 0025 ÷",
+        "× 0024 × 0061 ÷",
+        "× 0061 × 0025 ÷",
+        "× 0031 × 0025 ÷",
+        "× 0024 × 0031 ÷",
+        "× 0031 × 0031 ÷",
+        "× 0031 × 002C × 0031 ÷",
+        "× 0028 × 0031 × 0029 ÷",
+
+        // LB26, LB27: Korean syllable blocks
+        "× 1100 × 1161 ÷",
+        "× 1100 × AC00 ÷",
+        "× AC00 × 1161 × 11A8 ÷",
+        "× AC01 × 11A8 ÷",
+        "× AC00 × 0025 ÷",
+        "× 0024 × AC00 ÷",
+        "× AC00 ÷ AC00 ÷",
+
+        // LB28-LB30; LB30 leaves out OP of East_Asian_Width F, W or H, and fullwidth closing brackets are CL
+        "× 0061 × 0062 ÷",
+        "× 002C × 0061 ÷",
+        "× 0061 × 0028 ÷",
+        "× 0031 × 0028 ÷",
+        "× 0029 × 0061 ÷",
+        "× 0029 × 0031 ÷",
+        "× 0061 ÷ FF08 ÷",
+        "× 0061 ÷ 300C ÷",
+        "× 0031 ÷ 3008 ÷",
+        "× 0061 ÷ 2329 ÷",
+        "× 4E00 ÷ 0028 ÷",
+        "× 0061 × FF09 ÷",
+
+        // LB30a: regional indicators pair up, and a mark between them does not count
+        "× 1F1E6 × 1F1E7 ÷ 1F1E8 × 1F1E9 ÷ 1F1EA ÷",
+        "× 1F1E6 × 0308 × 1F1E7 ÷ 1F1E8 ÷",
+
+        // LB30b, LB31
+        "× 261D × 1F3FB ÷",
+        "× 261D × 0020 ÷ 1F3FB ÷",
+        "× 4E00 ÷ 4E00 ÷",
+        "× 0061 × 0020 ÷ 0062 × 0020 ÷ 0063 ÷",
+    };
+
+    // Grapheme clusters in the notation of GraphemeBreakTest.txt (UAX #29, Unicode 14.0), where
+    // the start and the end of the text are always ÷ (GB1, GB2)
+    const char* GraphemeBreakCases[] =
+    {
+        // GB3-GB5: CR LF stays together, controls stand alone even before a mark
+        "÷ 000D × 000A ÷",
+        "÷ 000A ÷ 000D ÷",
+        "÷ 0061 ÷ 000D ÷ 0061 ÷",
+        "÷ 000D ÷ 0308 ÷",
+        "÷ 0001 ÷ 0308 ÷",
+        "÷ 0061 ÷ 0001 ÷",
+        "÷ 0061 ÷ 200B ÷ 0062 ÷",
+
+        // GB6-GB8: Hangul L, V, T, LV and LVT
+        "÷ 1100 × 1100 ÷",
+        "÷ 1100 × 1161 ÷",
+        "÷ 1100 × AC00 ÷",
+        "÷ 1100 × AC01 ÷",
+        "÷ 1100 ÷ 11A8 ÷",
+        "÷ 1100 × 1161 × 11A8 ÷",
+        "÷ 1161 × 1161 × 11A8 ÷",
+        "÷ AC00 × 1161 × 11A8 ÷",
+        "÷ AC00 × 11A8 × 11A8 ÷",
+        "÷ AC01 × 11A8 ÷",
+        "÷ AC01 ÷ 1161 ÷",
+        "÷ 11A8 ÷ 1161 ÷",
+        "÷ 1161 ÷ 1100 ÷",
+        "÷ 11A8 ÷ 1100 ÷",
+        "÷ AC00 ÷ AC00 ÷",
+        "÷ AC01 ÷ AC00 ÷",
+
+        // GB9, GB9a, GB9b: marks, ZWJ and spacing marks attach, prepends attach to what follows
+        "÷ 0061 × 0308 × 0308 ÷ 0062 ÷",
+        "÷ 0061 × 200D ÷ 0062 ÷",
+        "÷ 0020 × 0903 ÷",
+        "÷ 0903 ÷ 0061 ÷",
+        "÷ 0915 × 093F ÷ 0915 ÷",
+        "÷ 0600 × 0061 ÷",
+        "÷ 0600 × 0600 × 0661 ÷",
+        "÷ 0600 × 0308 ÷",
+        "÷ 0600 × 1100 × 1161 ÷",
+        "÷ 0600 ÷ 000A ÷",
+        "÷ 0600 ÷ 0001 ÷",
+        "÷ 0061 ÷ 0600 ÷",
+
+        // GB11: emoji ZWJ sequences, only after a pictograph and its extenders
+        "÷ 1F466 × 200D × 1F466 ÷",
+        "÷ 1F468 × 200D × 1F469 × 200D × 1F467 ÷",
+        "÷ 2764 × FE0F × 200D × 1F525 ÷",
+        "÷ 1F468 × 1F3FB × 200D × 1F469 × 1F3FF ÷",
+        "÷ 1F466 × 0308 × 0308 × 200D × 1F466 ÷",
+        "÷ 1F466 × 200D × 200D ÷ 1F466 ÷",
+        "÷ 0061 × 200D ÷ 1F466 ÷",
+        "÷ 0061 × 0308 × 200D ÷ 2764 ÷",
+        "÷ 1F466 × 200D ÷ 0061 ÷",
+        "÷ 1F466 ÷ 1F466 ÷",
+        "÷ 1F466 × 200D × 2764 × 200D × 1F466 ÷ 1F466 ÷",
+
+        // GB12, GB13: regional indicators pair up from the last break
+        "÷ 1F1E6 × 1F1E7 ÷",
+        "÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷",
+        "÷ 1F1E6 × 1F1E7 ÷ 1F1E8 × 1F1E9 ÷ 1F1EA ÷",
+        "÷ 0061 ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 × 1F1E9 ÷",
+        "÷ 1F1E6 × 1F1E7 × 200D ÷ 1F1E8 ÷",
+        "÷ 1F1E6 × 0308 ÷ 1F1E7 × 1F1E8 ÷",
+        "÷ 1F1E6 × 1F1E7 × 0308 ÷ 1F1E8 × 1F1E9 ÷",
+        "÷ 0061 × 200D ÷ 1F1E6 × 1F1E7 ÷ 1F1E8 ÷",
+
+        // GB999
+        "÷ 0061 ÷ 0062 ÷",
+        "÷ 4E00 ÷ 0061 ÷ 0020 ÷ 0020 ÷",
+        "÷ 0308 ÷ 0061 ÷",
+    };
+
+    // Reads a case line into text and the expected flag of each marker, at the code unit offset
+    // it stands in front of
+    void ParseCase(const char* line, std::u16string& text, std::vector<size_t>& boundaries, std::vector<bool>& expected)
+    {
+        std::istringstream tokens(line);
+        std::string token;
+
+        while (tokens >> token)
+        {
+            if (std::strcmp(token.c_str(), "÷") == 0 || std::strcmp(token.c_str(), "×") == 0)
+            {
+                boundaries.push_back(text.size());
+                expected.push_back(std::strcmp(token.c_str(), "÷") == 0);
+                continue;
+            }
+
+            char32_t c = (char32_t)std::strtoul(token.c_str(), nullptr, 16);
+            if (c >= 0x10000)
+            {
+                text += (char16_t)(0xD800 + ((c - 0x10000) >> 10));
+                text += (char16_t)(0xDC00 + ((c - 0x10000) & 0x3FF));
+            }
+            else
+            {
+                text += (char16_t)c;
+            }
+        }
+    }
+
+    template<size_t Count>
+    void CheckCases(const char* (&cases)[Count], void (*find)(std::u16string_view, uint8_t*), uint8_t flag)
+    {
+        for (const char* line : cases)
+        {
+            std::u16string text;
+            std::vector<size_t> boundaries;
+            std::vector<bool> expected;
+            ParseCase(line, text, boundaries, expected);
+
+            std::vector<uint8_t> flags(text.size() + 1, TextBreakNone);
+            find(text, flags.data());
+
+            for (size_t i = 0; i < boundaries.size(); i++)
+            {
+                bool found = (flags[boundaries[i]] & flag) != 0;
+                if (found != expected[i]) std::fprintf(stderr, "%s: boundary %zu\n", line, i);
+                CHECK(found == expected[i]);
+            }
+
+            // never inside a surrogate pair
+            for (size_t i = 1; i < text.size(); i++)
+            {
+                if (text[i] >= 0xDC00 && text[i] < 0xE000) CHECK(!(flags[i] & flag));
+            }
+        }
+    }
+
+    void TestLineBreakCases()
+    {
+        CheckCases(LineBreakCases, FindLineBreaks, TextBreakLine);
+    }
+
+    void TestGraphemeBreakCases()
+    {
+        CheckCases(GraphemeBreakCases, FindGraphemeBoundaries, TextBreakGrapheme);
+    }
+
+    void TestMandatoryBreaks()
+    {
+        std::u16string text = u"a\r\nb\nc\u2028d\re";
+        std::vector<uint8_t> flags;
+        AnalyzeTextBreaks(text, flags);
+
+        std::vector<size_t> mandatory;
+        for (size_t i = 0; i < flags.size(); i++)
+        {
+            if (flags[i] & TextBreakLineMandatory) mandatory.push_back(i);
+        }
+
+        CHECK((mandatory == std::vector<size_t> { 3, 5, 7, 9 }));
+        CHECK(!(flags[2] & TextBreakLine) && !(flags[2] & TextBreakGrapheme));
+        CHECK(flags[text.size()] & TextBreakLine);
+    }
+
+    void TestEastAsianOpeningPunctuation()
+    {
+        CHECK(GetLineBreakClass(U'(') == LineBreakClass::OP);
+        CHECK(GetLineBreakClass(U'\uFF08') == LineBreakClass::OPEastAsian);
+        CHECK(GetLineBreakClass(U'\u300C') == LineBreakClass::OPEastAsian);
+        CHECK(GetLineBreakClass(U'\uFF09') == LineBreakClass::CL);
+        CHECK(GetLineBreakClass(U')') == LineBreakClass::CP);
+    }
+}
+
+int main()
+{
+    TestLineBreakCases();
+    TestGraphemeBreakCases();
+    TestMandatoryBreaks();
+    TestEastAsianOpeningPunctuation();
+    return 0;
+}
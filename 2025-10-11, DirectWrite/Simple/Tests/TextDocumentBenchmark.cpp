@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <string>
+
+#include "Benchmark.h"
+#include "TestFont.h"
+#include "TextDocument.h"
+
+// Cost of one keystroke in a multi-megabyte log: load time of the whole document against the
+// time GetLastEditStats reports for typing into and deleting from the middle of it
+int main()
+{
+    std::u16string text;
+    for (int i = 0; text.size() < 8 * 1024 * 1024; i++)
+    {
+        text += u"2025-10-11 12:00:00 INFO request handled in ";
+        text += (char16_t)(u'0' + i % 10);
+        text += u" ms\n";
+    }
+
+    TestFont face;
+    TextDocument document(face, 10, 300);
+
+    double loadSeconds = MeasureSeconds(3, [&]() { document.SetText(text); });
+
+    const int keystrokes = 1000;
+    double typeMicroseconds = 0;
+    double deleteMicroseconds = 0;
+    uint32_t laidOut = 0;
+
+    size_t offset = text.size() / 2;
+    for (int i = 0; i < keystrokes; i++)
+    {
+        document.Insert(offset + i, u"x");
+        typeMicroseconds += document.GetLastEditStats().microseconds;
+        laidOut += document.GetLastEditStats().paragraphsLaidOut;
+    }
+
+    for (int i = keystrokes; i > 0; i--)
+    {
+        document.Erase(offset + i - 1, 1);
+        deleteMicroseconds += document.GetLastEditStats().microseconds;
+        laidOut += document.GetLastEditStats().paragraphsLaidOut;
+    }
+
+    std::printf("document:  %zu code units, %zu paragraphs\n", text.size(), document.GetParagraphCount());
+    std::printf("load:      %8.1f ms\n", loadSeconds * 1e3);
+    std::printf("type:      %8.2f us per keystroke\n", typeMicroseconds / keystrokes);
+    std::printf("backspace: %8.2f us per keystroke\n", deleteMicroseconds / keystrokes);
+    std::printf("laid out:  %8.2f paragraphs per keystroke\n", (double)laidOut / (2 * keystrokes));
+    return document.GetLength() == text.size() ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "Check.h"
+#include "TestFont.h"
+#include "TextDocument.h"
+
+namespace
+{
+    bool SameLayout(const ParagraphLayout& a, const ParagraphLayout& b)
+    {
+        if (a.height != b.height || a.lines.size() != b.lines.size() || a.glyphs.size() != b.glyphs.size()) return false;
+
+        for (size_t i = 0; i < a.lines.size(); i++)
+        {
+            if (a.lines[i].textStart != b.lines[i].textStart || a.lines[i].textLength != b.lines[i].textLength ||
+                a.lines[i].glyphCount != b.lines[i].glyphCount || a.lines[i].width != b.lines[i].width)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Random edits against a plain string: text, paragraph splits, cached layouts and every lookup
+    // have to agree with the document rebuilt from scratch
+    void TestRandomEdits()
+    {
+        TestFont face;
+        TextDocument document(face, 10, 80);
+        ShapingCache cache(1 << 20);
+
+        std::u16string reference;
+        std::mt19937 random(3);
+
+        for (int edit = 0; edit < 3000; edit++)
+        {
+            size_t offset = random() % (reference.size() + 1);
+            size_t length = std::min<size_t>(random() % 5, reference.size() - offset);
+
+            std::u16string text;
+            for (int n = random() % 6; n > 0; n--)
+            {
+                int kind = random() % 5;
+                text += kind == 0 ? u'\n' : kind == 1 ? u' ' : (char16_t)(u'a' + random() % 26);
+            }
+
+            document.Replace(offset, length, text);
+            reference.replace(offset, length, text);
+            CHECK(document.GetText() == reference);
+            CHECK(document.GetLength() == reference.size());
+
+            size_t paragraphCount = 1 + std::count(reference.begin(), reference.end(), u'\n');
+            CHECK(document.GetParagraphCount() == paragraphCount);
+
+            size_t index = random() % paragraphCount;
+            size_t start = document.GetParagraphStart(index);
+            std::u16string_view paragraph = document.GetParagraphText(index);
+            CHECK(reference.compare(start, paragraph.size(), paragraph) == 0);
+            CHECK(start + paragraph.size() == reference.size() || reference[start + paragraph.size()] == u'\n');
+            CHECK(document.FindParagraph(start) == index);
+            CHECK(document.FindParagraph(start + paragraph.size()) == index);
+
+            ParagraphLayout expected;
+            LayoutParagraph(cache, document.GetFormat(), paragraph, expected);
+            CHECK(SameLayout(document.GetParagraphLayout(index), expected));
+
+            const ParagraphLayout& layout = document.GetParagraphLayout(index);
+            if (layout.height > 0)
+                CHECK(document.FindParagraphAtY(document.GetParagraphTop(index) + layout.height * 0.5f) == index);
+        }
+
+        // the tree adds heights in its own order, so sums can differ in the last bits
+        double height = 0;
+        for (size_t i = 0; i < document.GetParagraphCount(); i++)
+        {
+            CHECK(std::fabs(document.GetParagraphTop(i) - height) < 1e-3);
+            height += document.GetParagraphLayout(i).height;
+        }
+
+        CHECK(std::fabs(document.GetHeight() - height) < 1e-3);
+    }
+
+    // A keystroke inside a large document re-lays out only the paragraph it lands in, and Enter
+    // only the two halves
+    void TestEditStats()
+    {
+        std::u16string text;
+        for (int i = 0; i < 10000; i++)
+            text += u"line of log text\n";
+
+        TestFont face;
+        TextDocument document(face, 10, 300);
+        document.SetText(text);
+        CHECK(document.GetParagraphCount() == 10001);
+
+        document.Insert(text.size() / 2, u"x");
+        CHECK(document.GetLastEditStats().paragraphsRemoved == 1);
+        CHECK(document.GetLastEditStats().paragraphsLaidOut == 1);
+
+        document.Insert(text.size() / 2, u"\n");
+        CHECK(document.GetLastEditStats().paragraphsRemoved == 1);
+        CHECK(document.GetLastEditStats().paragraphsLaidOut == 2);
+        CHECK(document.GetParagraphCount() == 10002);
+
+        document.Erase(text.size() / 2, 1);
+        CHECK(document.GetLastEditStats().paragraphsRemoved == 2);
+        CHECK(document.GetLastEditStats().paragraphsLaidOut == 1);
+        CHECK(document.GetParagraphCount() == 10001);
+
+        text.insert(text.size() / 2, u"x");
+        CHECK(document.GetText() == text);
+    }
+}
+
+int main()
+{
+    TestRandomEdits();
+    TestEditStats();
+    return 0;
+}
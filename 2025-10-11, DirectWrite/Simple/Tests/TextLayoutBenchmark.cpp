@@ -0,0 +1,48 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "Benchmark.h"
+#include "TestFont.h"
+#include "TextLayout.h"
+
+// Layout of a 100k-paragraph document with 1 to 8 workers. Each run starts from a new TextLayout,
+// so every worker cache and the shared tier start cold.
+int main()
+{
+    std::u16string text;
+    for (int i = 0; i < 100000; i++)
+    {
+        text += u"paragraph of text with some words ";
+        text += (char16_t)(u'a' + i % 26);
+        text += (char16_t)(u'a' + i / 26 % 26);
+        text += u'\n';
+    }
+
+    TestFont face;
+    double sequentialSeconds = 0;
+
+    for (size_t workers : { 1, 2, 4, 8 })
+    {
+        std::unique_ptr<ThreadPool> pool;
+        if (workers > 1) pool = std::make_unique<ThreadPool>(workers - 1);
+
+        SharedShapingCacheStats shared = {};
+        double seconds = MeasureSeconds(3, [&]()
+        {
+            TextLayout layout(face, 10, 100);
+            layout.SetThreadPool(pool.get());
+            layout.SetText(text);
+            KeepResult(layout.GetParagraphs());
+            shared = layout.GetSharedShapingCache().GetStats();
+        });
+
+        if (workers == 1) sequentialSeconds = seconds;
+
+        std::printf("%zu workers: %7.1f ms, %.2fx, shared tier %llu hits %llu published %llu dropped %llu resets\n", workers,
+            seconds * 1e3, sequentialSeconds / seconds, (unsigned long long)shared.hits,
+            (unsigned long long)shared.published, (unsigned long long)shared.dropped, (unsigned long long)shared.resets);
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+﻿#include <string>
+
+#include "Check.h"
+#include "TestFont.h"
+#include "TextLayout.h"
+
+namespace
+{
+    std::u16string MakeCorpus(size_t paragraphs)
+    {
+        std::u16string text;
+        for (size_t i = 0; i < paragraphs; i++)
+        {
+            text += i % 3 == 0 ? u"한국어 문단과 some Latin words " : u"paragraph of text with some words ";
+            text += (char16_t)(u'a' + i % 26);
+            text += (char16_t)(u'a' + i / 26 % 26);
+            text += u'\n';
+        }
+
+        return text;
+    }
+
+    bool SameLayout(const ParagraphLayout& a, const ParagraphLayout& b)
+    {
+        if (a.textStart != b.textStart || a.textLength != b.textLength || a.height != b.height) return false;
+        if (a.lines.size() != b.lines.size() || a.glyphs.size() != b.glyphs.size()) return false;
+
+        for (size_t i = 0; i < a.lines.size(); i++)
+        {
+            if (a.lines[i].textStart != b.lines[i].textStart || a.lines[i].textLength != b.lines[i].textLength ||
+                a.lines[i].glyphStart != b.lines[i].glyphStart || a.lines[i].width != b.lines[i].width)
+                return false;
+        }
+
+        for (size_t i = 0; i < a.glyphs.size(); i++)
+        {
+            if (a.glyphs[i].glyphIndex != b.glyphs[i].glyphIndex || a.glyphs[i].advance != b.glyphs[i].advance)
+                return false;
+        }
+
+        return true;
+    }
+
+    // The parallel layout has to match the sequential one paragraph for paragraph, with any
+    // number of workers and also on a second pass, when the shared tier already holds the runs
+    void TestParallelMatchesSequential()
+    {
+        TestFont face;
+        std::u16string text = MakeCorpus(20000);
+
+        TextLayout sequential(face, 10, 100);
+        sequential.SetText(text);
+        const std::vector<ParagraphLayout>& expected = sequential.GetParagraphs();
+        CHECK(expected.size() == 20001);
+
+        for (size_t threads : { 1, 3, 7 })
+        {
+            ThreadPool pool(threads);
+            TextLayout parallel(face, 10, 100);
+            parallel.SetThreadPool(&pool);
+
+            for (int pass = 0; pass < 2; pass++)
+            {
+                parallel.SetText(text);
+                const std::vector<ParagraphLayout>& paragraphs = parallel.GetParagraphs();
+
+                CHECK(paragraphs.size() == expected.size());
+                for (size_t i = 0; i < paragraphs.size(); i++)
+                    CHECK(SameLayout(paragraphs[i], expected[i]));
+
+                CHECK(parallel.GetHeight() == sequential.GetHeight());
+            }
+
+            CHECK(parallel.GetSharedShapingCache().GetStats().hits > 0);
+        }
+    }
+
+    // A long word after a short one wraps to its own line and is then broken between letters;
+    // no line may get wider than the box, including the one holding what the wrap carried over.
+    // The short word is narrower than one letter of the long one (U+1E00 and up are a full em in
+    // TestFont), so the carried letters plus the next one can overflow on their own.
+    void TestLongWordStaysInside()
+    {
+        TestFont face;
+        std::u16string text = u"a ";
+        for (int i = 0; i < 60; i++)
+            text += (char16_t)(0x1E00 + i * 7 % 200);
+
+        ShapingCache cache(1 << 20);
+        for (float maxWidth = 20; maxWidth < 120; maxWidth += 0.25f)
+        {
+            LayoutFormat format = { &face, 10, maxWidth, ShapingFeatureKerning };
+            ParagraphLayout layout;
+            LayoutParagraph(cache, format, text, layout);
+
+            CHECK(layout.lines.size() >= 2);
+            CHECK(layout.lines[0].textLength == 2);
+
+            uint32_t glyphs = 0;
+            for (const TextLine& line : layout.lines)
+            {
+                CHECK(line.glyphStart == glyphs && line.glyphCount > 0);
+                CHECK(line.width <= maxWidth);
+                glyphs += line.glyphCount;
+            }
+
+            CHECK(glyphs == layout.glyphs.size());
+
+            // and the lines are full: the next letter would not have fit
+            for (size_t i = 1; i + 1 < layout.lines.size(); i++)
+                CHECK(layout.lines[i].width + layout.glyphs[layout.lines[i + 1].glyphStart].advance > maxWidth);
+        }
+    }
+}
+
+int main()
+{
+    TestParallelMatchesSequential();
+    TestLongWordStaysInside();
+    return 0;
+}
@@ -0,0 +1,83 @@
+﻿#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TestFont.h"
+#include "TextLayout.h"
+#include "TextMeasure.h"
+
+namespace
+{
+    // Calls per second of each way to size every label once; all shape through warm caches
+    void Run(const char* name, const std::vector<std::u16string>& labels)
+    {
+        TestFont face;
+        LayoutFormat format = { &face, 13, 180, ShapingFeatureKerning };
+        double count = (double)labels.size();
+
+        TextMeasurer measurer;
+        double measureSeconds = MeasureSeconds(20, [&]()
+        {
+            for (const std::u16string& label : labels)
+                KeepResult(measurer.Measure(format, label));
+        });
+
+        std::vector<LineMetrics> lines;
+        double linesSeconds = MeasureSeconds(20, [&]()
+        {
+            for (const std::u16string& label : labels)
+            {
+                lines.clear();
+                KeepResult(measurer.Measure(format, label, TextAlignment::Center, lines));
+            }
+        });
+
+        TextLayout layout(face, format.fontSize, format.maxWidth, format.features);
+        double layoutSeconds = MeasureSeconds(20, [&]()
+        {
+            for (const std::u16string& label : labels)
+            {
+                layout.SetText(label);
+                KeepResult(layout.GetHeight());
+            }
+        });
+
+        double newLayoutSeconds = MeasureSeconds(5, [&]()
+        {
+            for (const std::u16string& label : labels)
+            {
+                TextLayout labelLayout(face, format.fontSize, format.maxWidth, format.features);
+                labelLayout.SetText(label);
+                KeepResult(labelLayout.GetHeight());
+            }
+        });
+
+        std::printf("%s, M calls/s:\n", name);
+        std::printf("  Measure:              %6.2f\n", count / measureSeconds * 1e-6);
+        std::printf("  Measure with lines:   %6.2f\n", count / linesSeconds * 1e-6);
+        std::printf("  TextLayout, reused:   %6.2f\n", count / layoutSeconds * 1e-6);
+        std::printf("  TextLayout per label: %6.2f\n", count / newLayoutSeconds * 1e-6);
+    }
+}
+
+// Sizing a UI's labels each frame: TextMeasurer against a full TextLayout per label, which is
+// what creating an IDWriteTextLayout for every string amounts to
+int main()
+{
+    std::vector<std::u16string> shortLabels;
+    std::vector<std::u16string> wrappingLabels;
+    for (int i = 0; i < 1000; i++)
+    {
+        std::u16string name = (i % 2 ? u"설정 항목 " : u"Settings item ") + std::u16string(1, (char16_t)(u'A' + i % 26));
+        shortLabels.push_back(name);
+
+        std::u16string description = name + u" with a description that wraps onto a second line";
+        if (i % 5 == 0) description += u"\nand a second paragraph";
+        wrappingLabels.push_back(description);
+    }
+
+    Run("One-line labels", shortLabels);
+    Run("Wrapping labels", wrappingLabels);
+    return 0;
+}
@@ -0,0 +1,118 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "TestFont.h"
+#include "TextLayout.h"
+#include "TextMeasure.h"
+
+namespace
+{
+    std::u16string RandomText(std::mt19937& random)
+    {
+        const char16_t* pieces[] = { u"hello", u"world", u" ", u"  ", u"\n", u"한국어", u"x", u"abcdefghijk" };
+
+        std::u16string text;
+        for (int n = random() % 12; n > 0; n--)
+            text += pieces[random() % std::size(pieces)];
+        return text;
+    }
+
+    // Measuring has to agree with a full layout of the same text
+    void TestAgainstLayout()
+    {
+        TestFont face;
+        TextMeasurer measurer;
+        std::mt19937 random(17);
+
+        for (int round = 0; round < 2000; round++)
+        {
+            std::u16string text = RandomText(random);
+            float maxWidth = 20.0f + random() % 200;
+
+            TextLayout layout(face, 10, maxWidth);
+            layout.SetText(text);
+
+            size_t lineCount = 0;
+            float width = 0;
+            std::vector<TextLine> expected;
+            std::vector<uint32_t> expectedStarts;
+            for (const ParagraphLayout& paragraph : layout.GetParagraphs())
+            {
+                lineCount += paragraph.lines.size();
+                for (const TextLine& line : paragraph.lines)
+                {
+                    width = std::max(width, line.width);
+                    expected.push_back(line);
+                    expectedStarts.push_back(paragraph.textStart + line.textStart);
+                }
+            }
+
+            LayoutFormat format = layout.GetFormat();
+            TextMetrics metrics = measurer.Measure(format, text);
+            CHECK(metrics.lineCount == lineCount);
+            // the single-line shortcut takes the run's width, which adds kerning in another order
+            CHECK(std::fabs(metrics.width - width) <= width * 1e-6f);
+            CHECK(std::fabs(metrics.height - layout.GetHeight()) < 1e-3f);
+
+            std::vector<LineMetrics> lines;
+            TextMetrics withLines = measurer.Measure(format, text, TextAlignment::Trailing, lines);
+            CHECK(withLines.lineCount == metrics.lineCount);
+            CHECK(lines.size() == expected.size());
+
+            float top = 0;
+            for (size_t i = 0; i < lines.size(); i++)
+            {
+                CHECK(lines[i].textStart == expectedStarts[i]);
+                CHECK(lines[i].textLength == expected[i].textLength);
+                CHECK(lines[i].width == expected[i].width);
+                CHECK(lines[i].left == GetLineOriginX(expected[i], maxWidth, TextAlignment::Trailing));
+                CHECK(std::fabs(lines[i].top - top) < 1e-3f);
+                top += lines[i].height;
+            }
+        }
+    }
+
+    // The caret of every position hit-tests back to that position
+    void TestCaretRoundTrip()
+    {
+        TestFont face;
+        TextMeasurer measurer;
+        LayoutFormat format = { &face, 10, 52, ShapingFeatureKerning };
+        const std::u16string text = u"hello world foo\n\nabcdefghijklmnop 한국어";
+
+        for (TextAlignment alignment : { TextAlignment::Leading, TextAlignment::Center, TextAlignment::Trailing })
+        {
+            std::vector<LineMetrics> lines;
+            measurer.Measure(format, text, alignment, lines);
+
+            for (uint32_t position = 0; position <= text.size(); position++)
+            {
+                float x, y;
+                measurer.GetCaretPosition(format, text, alignment, position, x, y);
+
+                HitTestResult hit = measurer.HitTestPoint(format, text, alignment, x + 0.1f, y + 1);
+                const LineMetrics& line = lines[hit.lineIndex];
+                CHECK(line.top == y);
+
+                // a position at a wrap is both the end of one line and the start of the next
+                bool lineEnd = position == line.textStart + line.textLength;
+                CHECK(hit.textPosition == position || (lineEnd && hit.textPosition == position - 1));
+            }
+        }
+
+        HitTestResult outside = measurer.HitTestPoint(format, text, TextAlignment::Leading, 1000, -5);
+        CHECK(!outside.isInside);
+        CHECK(outside.lineIndex == 0);
+    }
+}
+
+int main()
+{
+    TestAgainstLayout();
+    TestCaretRoundTrip();
+    return 0;
+}
@@ -0,0 +1,50 @@
+﻿#include <cstdio>
+#include <string>
+
+#include "Benchmark.h"
+#include "Utf.h"
+
+// Transcoding throughput in GB/s of UTF-8, SIMD against scalar, in both directions
+int main()
+{
+    struct Corpus
+    {
+        const char* name;
+        std::u16string sample;
+    };
+
+    const Corpus corpora[] =
+    {
+        { "ASCII", u"The quick brown fox jumps over the lazy dog. 0123456789\n" },
+        { "Korean", u"안녕하세요, 오늘 회의는 오후 3시에 2층 회의실에서 진행합니다.\n" },
+        { "Hangul only", u"가나다라마바사아자차카타파하각난닫랄맘밥삿앙잦찿칼탓팦핳" },
+        { "Latin-1", u"Ça été déjà très agréable à Zürich, señor Müller.\n" },
+        { "Mixed emoji", u"Build passed 🎉 배포 완료 ✅ next: 🚀 release\n" },
+    };
+
+    for (const Corpus& corpus : corpora)
+    {
+        std::u16string utf16;
+        while (utf16.size() < 64 * 1024)
+            utf16 += corpus.sample;
+
+        std::string utf8;
+        Utf16ToUtf8Scalar(utf16, utf8);
+
+        std::u16string out16;
+        out16.reserve(utf8.size());
+        std::string out8;
+        out8.reserve(utf16.size() * 3);
+
+        double decodeFast = MeasureSeconds(200, [&]() { out16.clear(); Utf8ToUtf16(utf8, out16); });
+        double decodeScalar = MeasureSeconds(200, [&]() { out16.clear(); Utf8ToUtf16Scalar(utf8, out16); });
+        double encodeFast = MeasureSeconds(200, [&]() { out8.clear(); Utf16ToUtf8(utf16, out8); });
+        double encodeScalar = MeasureSeconds(200, [&]() { out8.clear(); Utf16ToUtf8Scalar(utf16, out8); });
+
+        double gigabytes = utf8.size() * 1e-9;
+        std::printf("%-12s 8->16 %5.2f GB/s (scalar %5.2f)   16->8 %5.2f GB/s (scalar %5.2f)\n", corpus.name,
+            gigabytes / decodeFast, gigabytes / decodeScalar, gigabytes / encodeFast, gigabytes / encodeScalar);
+    }
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <random>
+#include <string>
+
+#include "Check.h"
+#include "Utf.h"
+
+namespace
+{
+    void AppendUtf8(std::string& s, char32_t c)
+    {
+        if (c < 0x80)
+            s += (char)c;
+        else if (c < 0x800)
+        {
+            s += (char)(0xC0 | c >> 6);
+            s += (char)(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            s += (char)(0xE0 | c >> 12);
+            s += (char)(0x80 | (c >> 6 & 0x3F));
+            s += (char)(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            s += (char)(0xF0 | c >> 18);
+            s += (char)(0x80 | (c >> 12 & 0x3F));
+            s += (char)(0x80 | (c >> 6 & 0x3F));
+            s += (char)(0x80 | (c & 0x3F));
+        }
+    }
+
+    // Runs of one kind of character, as in real text, so both the SIMD blocks and their edges
+    // see every mix of sequence lengths
+    char32_t RandomCodePoint(std::mt19937& rng, int kind)
+    {
+        switch (kind)
+        {
+        case 0: return 0x20 + rng() % 0x5F;                 // ASCII
+        case 1: return 0x80 + rng() % 0x780;                // 2 bytes
+        case 2: return 0xAC00 + rng() % 11172;              // Hangul, 3 bytes
+        case 3: return 0x800 + rng() % (0xD800 - 0x800);    // 3 bytes below the surrogates
+        case 4: return 0xE000 + rng() % 0x2000;             // 3 bytes above the surrogates
+        default: return 0x10000 + rng() % 0x100000;         // 4 bytes
+        }
+    }
+
+    std::string RandomText(std::mt19937& rng, size_t length)
+    {
+        std::string s;
+        int kind = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (rng() % 6 == 0) kind = rng() % 6;
+            AppendUtf8(s, RandomCodePoint(rng, kind));
+        }
+        return s;
+    }
+
+    void CheckSameAsScalar(const std::string& in)
+    {
+        std::u16string fast = u"prefix", scalar = u"prefix";
+        size_t fastError = SIZE_MAX, scalarError = SIZE_MAX;
+        bool fastValid = Utf8ToUtf16(in, fast, &fastError);
+        bool scalarValid = Utf8ToUtf16Scalar(in, scalar, &scalarError);
+
+        CHECK(fastValid == scalarValid);
+        CHECK(fast == scalar);
+        CHECK(fastError == scalarError);
+
+        if (!fastValid)
+        {
+            CHECK(fast == u"prefix");
+            return;
+        }
+
+        std::u16string utf16 = fast.substr(6);
+        std::string back = "prefix", backScalar = "prefix";
+        CHECK(Utf16ToUtf8(utf16, back));
+        CHECK(Utf16ToUtf8Scalar(utf16, backScalar));
+        CHECK(back == "prefix" + in);
+        CHECK(backScalar == back);
+    }
+
+    void TestRandomValidText()
+    {
+        std::mt19937 rng(1);
+        for (size_t i = 0; i < 20000; i++)
+            CheckSameAsScalar(RandomText(rng, rng() % 120));
+    }
+
+    // Single byte corruptions of valid text, compared against the scalar decoder's verdict and
+    // error offset
+    void TestRandomCorruptions()
+    {
+        std::mt19937 rng(2);
+        const uint8_t interesting[] = { 0x80, 0xBF, 0xC0, 0xC1, 0xC2, 0xDF, 0xE0, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF, 0x00, 0x41 };
+
+        for (size_t i = 0; i < 50000; i++)
+        {
+            std::string s = RandomText(rng, 1 + rng() % 80);
+            size_t at = rng() % s.size();
+            s[at] = (char)(rng() % 2 ? interesting[rng() % sizeof(interesting)] : rng() % 256);
+            if (rng() % 4 == 0) s.resize(at + 1);
+
+            CheckSameAsScalar(s);
+        }
+    }
+
+    void TestSpecificErrors()
+    {
+        struct Case
+        {
+            const char* text;
+            size_t errorOffset;
+        };
+
+        // each padded so the SIMD blocks see it
+        const Case cases[] =
+        {
+            { "0123456789abcdef\xC0\xAF", 16 },                     // overlong 2 byte
+            { "0123456789abcdef\xE0\x80\xAF", 16 },                 // overlong 3 byte
+            { "0123456789abcdef\xF0\x80\x80\xAF", 16 },             // overlong 4 byte
+            { "0123456789abcdef\xED\xA0\x80", 16 },                 // encoded surrogate
+            { "0123456789abcdef\xF4\x90\x80\x80", 16 },             // above U+10FFFF
+            { "\xEA\xB0\x80\xEA\xB0\x80\xEA\xB0\x80\x80 0123456789abcdef", 9 }, // stray continuation
+            { "\xEA\xB0\xEA\xB0\x80 0123456789abcdef0123456789", 0 }, // truncated sequence
+            { "0123456789abcdef\xEA\xB0", 16 },                     // truncated at the end
+        };
+
+        for (const Case& c : cases)
+        {
+            std::u16string out;
+            size_t errorOffset = SIZE_MAX;
+            CHECK(!Utf8ToUtf16(c.text, out, &errorOffset));
+            CHECK(errorOffset == c.errorOffset);
+            CHECK(out.empty());
+        }
+
+        std::u16string unpaired = u"0123456789abcdef0123456789abcdef";
+        for (size_t at : { 0, 5, 17, 31 })
+        {
+            for (char16_t surrogate : { (char16_t)0xD800, (char16_t)0xDFFF })
+            {
+                std::u16string s = unpaired;
+                s[at] = surrogate;
+
+                std::string out;
+                size_t errorOffset = SIZE_MAX;
+                CHECK(!Utf16ToUtf8(s, out, &errorOffset));
+                CHECK(errorOffset == at);
+                CHECK(out.empty());
+            }
+        }
+    }
+}
+
+int main()
+{
+    TestRandomValidText();
+    TestRandomCorruptions();
+    TestSpecificErrors();
+    return 0;
+}
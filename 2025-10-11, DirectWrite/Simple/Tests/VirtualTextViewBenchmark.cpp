@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TestFont.h"
+#include "VirtualTextView.h"
+
+namespace
+{
+    // Frame times of GetVisibleLines, as GetStats reports them, over one scrolling pattern
+    template<typename ScrollFunc>
+    void Run(const char* name, VirtualTextView& view, int frames, ScrollFunc&& scroll)
+    {
+        std::vector<VisibleLine> lines;
+        std::vector<double> times;
+        uint64_t laidOut = 0;
+
+        for (int frame = 0; frame < frames; frame++)
+        {
+            scroll(view);
+            view.GetVisibleLines(lines);
+            times.push_back(view.GetStats().microseconds);
+            laidOut += view.GetStats().paragraphsLaidOut;
+        }
+
+        std::sort(times.begin(), times.end());
+        double sum = 0;
+        for (double time : times) sum += time;
+
+        std::printf("%-14s mean %7.1f us  p99 %7.1f us  max %7.1f us  %5.2f paragraphs laid out per frame\n", name,
+            sum / frames, times[frames * 99 / 100], times.back(), (double)laidOut / frames);
+    }
+}
+
+// A log of 1M lines in a 600 px viewport: load time, then frame times for smooth scrolling,
+// paging and dragging the scroll bar to random positions
+int main()
+{
+    std::mt19937 random(1);
+    std::u16string text;
+    for (int i = 0; i < 1000000; i++)
+    {
+        text += u"2025-10-11 12:00:00 ";
+        for (int n = random() % 100; n > 0; n--)
+            text += random() % 6 == 0 ? u' ' : (char16_t)(u'a' + random() % 26);
+        text += u'\n';
+    }
+
+    TestFont face;
+    VirtualTextView view(face, 16, 400, 600);
+
+    double loadSeconds = MeasureSeconds(1, [&]() { view.SetText(text); });
+    std::printf("%zu paragraphs, %.1f MB of text, SetText %.1f ms\n", view.GetParagraphCount(), text.size() * 2 / 1e6, loadSeconds * 1e3);
+
+    Run("smooth 4 px", view, 5000, [](VirtualTextView& v) { v.ScrollBy(4); });
+    Run("page down", view, 2000, [](VirtualTextView& v) { v.ScrollBy(600); });
+    Run("random jumps", view, 2000, [&](VirtualTextView& v) { v.SetScrollY(v.GetContentHeight() * (random() % 10000) / 10000.0f); });
+
+    Run("last 2000 px", view, 2000, [&](VirtualTextView& v) { v.SetScrollY(v.GetContentHeight()); v.ScrollBy(-(float)(random() % 2000)); });
+    return 0;
+}
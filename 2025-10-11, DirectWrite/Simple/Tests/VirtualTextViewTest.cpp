@@ -0,0 +1,159 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "TestFont.h"
+#include "TextLayout.h"
+#include "VirtualTextView.h"
+
+namespace
+{
+    struct DocumentLine
+    {
+        uint32_t paragraphIndex;
+        uint32_t textStart;     // relative to the paragraph
+        uint32_t textLength;
+    };
+
+    std::u16string MakeDocument(size_t paragraphs, uint32_t seed)
+    {
+        std::mt19937 random(seed);
+        std::u16string text;
+        for (size_t i = 0; i < paragraphs; i++)
+        {
+            for (int n = random() % 200; n > 0; n--)
+                text += random() % 6 == 0 ? u' ' : (char16_t)(u'a' + random() % 26);
+            if (i % 3 == 0) text += u'\r';
+            text += u'\n';
+        }
+
+        return text;
+    }
+
+    std::vector<DocumentLine> LayoutDocument(const FontFace& face, float width, const std::u16string& text)
+    {
+        TextLayout layout(face, 16, width);
+        layout.SetText(text);
+
+        std::vector<DocumentLine> lines;
+        const std::vector<ParagraphLayout>& paragraphs = layout.GetParagraphs();
+        for (size_t i = 0; i < paragraphs.size(); i++)
+        {
+            for (const TextLine& line : paragraphs[i].lines)
+                lines.push_back({ (uint32_t)i, line.textStart, line.textLength });
+        }
+
+        return lines;
+    }
+
+    // Visible lines have to be a consecutive stretch of the full layout, one line height apart,
+    // filling the viewport from a first line cut at most one line height above it
+    size_t CheckVisibleLines(const std::vector<VisibleLine>& visible, const std::vector<DocumentLine>& document, float lineHeight, float viewportHeight)
+    {
+        CHECK(!visible.empty());
+        CHECK(visible[0].y <= 0 && visible[0].y > -lineHeight);
+
+        size_t first = 0;
+        while (first < document.size() && !(document[first].paragraphIndex == visible[0].paragraphIndex && document[first].textStart == visible[0].line->textStart))
+            first++;
+        CHECK(first < document.size());
+
+        for (size_t i = 0; i < visible.size(); i++)
+        {
+            CHECK(first + i < document.size());
+            CHECK(visible[i].paragraphIndex == document[first + i].paragraphIndex);
+            CHECK(visible[i].line->textStart == document[first + i].textStart);
+            CHECK(visible[i].line->textLength == document[first + i].textLength);
+            CHECK(std::fabs(visible[i].y - (visible[0].y + i * lineHeight)) < 1e-3f);
+        }
+
+        bool filled = visible.back().y + lineHeight >= viewportHeight;
+        CHECK(filled || first + visible.size() == document.size());
+        return first;
+    }
+
+    void TestScrolling()
+    {
+        TestFont face;
+        std::u16string text = MakeDocument(3000, 1);
+        std::vector<DocumentLine> document = LayoutDocument(face, 300, text);
+
+        const float viewportHeight = 600;
+        VirtualTextView view(face, 16, 300, viewportHeight, 500);
+        view.SetText(text);
+        CHECK(view.GetParagraphCount() == 3001);
+
+        float lineHeight = GetLineHeight({ &face, 16, 300, ShapingFeatureKerning });
+        std::vector<VisibleLine> lines;
+        std::mt19937 random(2);
+
+        for (int frame = 0; frame < 2000; frame++)
+        {
+            int move = random() % 4;
+            if (move == 0) view.ScrollBy((float)(random() % 5000));
+            else if (move == 1) view.ScrollBy(-(float)(random() % 5000));
+            else if (move == 2) view.SetScrollY((float)(random() % 200000));
+            else view.ScrollBy(lineHeight);
+
+            view.GetVisibleLines(lines);
+            size_t first = CheckVisibleLines(lines, document, lineHeight, viewportHeight);
+
+            // a second call shows the same lines: corrected estimates do not move the content
+            std::vector<VisibleLine> again;
+            view.GetVisibleLines(again);
+            CHECK(again.size() == lines.size() && again[0].paragraphIndex == lines[0].paragraphIndex && again[0].y == lines[0].y);
+            CHECK(view.GetStats().paragraphsLaidOut == 0);
+
+            // one line height down moves the content up by exactly one line
+            if (first + lines.size() < document.size())
+            {
+                view.ScrollBy(lineHeight);
+                view.GetVisibleLines(again);
+                size_t shifted = CheckVisibleLines(again, document, lineHeight, viewportHeight);
+
+                // rounding may leave a sliver of the line above in view
+                auto sliver = [&](const std::vector<VisibleLine>& visible) { return visible[0].y <= -lineHeight + 1e-3f ? 1 : 0; };
+                CHECK(shifted + sliver(again) == first + sliver(lines) + 1);
+                CHECK(std::fabs(again[sliver(again)].y - lines[sliver(lines)].y) < 1e-3f);
+            }
+
+            CHECK(view.GetStats().cachedLines <= 500 + viewportHeight / lineHeight + 2);
+        }
+
+        view.SetScrollY(1e12f);
+        view.GetVisibleLines(lines);
+        CHECK(CheckVisibleLines(lines, document, lineHeight, viewportHeight) + lines.size() == document.size());
+
+        view.SetScrollY(0);
+        view.GetVisibleLines(lines);
+        CHECK(lines[0].paragraphIndex == 0 && lines[0].y == 0);
+
+        // a narrower view lays everything out again
+        std::vector<DocumentLine> narrow = LayoutDocument(face, 100, text);
+        view.SetWidth(100);
+        view.SetScrollY(50000);
+        view.GetVisibleLines(lines);
+        CheckVisibleLines(lines, narrow, lineHeight, viewportHeight);
+    }
+
+    void TestEmpty()
+    {
+        TestFont face;
+        VirtualTextView view(face, 16, 300, 600);
+
+        std::vector<VisibleLine> lines;
+        view.GetVisibleLines(lines);
+        CHECK(lines.size() == 1);
+        CHECK(lines[0].line->textLength == 0);
+        CHECK(view.GetParagraphCount() == 1);
+    }
+}
+
+int main()
+{
+    TestScrolling();
+    TestEmpty();
+    return 0;
+}
@@ -0,0 +1,410 @@
+#include "TextAttributeTree.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr uint8_t AttributeCount = 5;
+
+    void ApplyAttribute(TextStyle& style, const TextStyle& values, uint8_t attribute)
+    {
+        switch (attribute)
+        {
+        case TextAttributeFontSize: style.fontSize = values.fontSize; break;
+        case TextAttributeWeight: style.weight = values.weight; break;
+        case TextAttributeItalic: style.italic = values.italic; break;
+        case TextAttributeUnderline: style.underline = values.underline; break;
+        case TextAttributeColor: style.color = values.color; break;
+        }
+    }
+
+    uint32_t Offset(uint32_t position, int64_t shift) { return (uint32_t)(position + shift); }
+}
+
+TextAttributeTree::TextAttributeTree()
+    : nodes(1)
+    , root(Nil)
+    , seed(0x9E3779B9)
+    , nextOrder(0)
+    , spanCount(0)
+{
+}
+
+uint32_t TextAttributeTree::NewNode(uint32_t start, uint32_t end, uint32_t order, const TextAttributes& attributes)
+{
+    uint32_t node;
+    if (!freeNodes.empty())
+    {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else
+    {
+        node = (uint32_t)nodes.size();
+        nodes.emplace_back();
+    }
+
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    Node& n = nodes[node];
+    n.left = Nil;
+    n.right = Nil;
+    n.priority = seed;
+    n.start = start;
+    n.end = end;
+    n.maxEnd = end;
+    n.shift = 0;
+    n.order = order;
+    n.attributes = attributes;
+
+    spanCount++;
+    return node;
+}
+
+void TextAttributeTree::FreeNode(uint32_t node)
+{
+    freeNodes.push_back(node);
+    spanCount--;
+}
+
+void TextAttributeTree::Update(uint32_t node)
+{
+    Node& n = nodes[node];
+    n.maxEnd = std::max({ n.end, nodes[n.left].maxEnd, nodes[n.right].maxEnd });
+}
+
+// Moves a whole subtree; the children get it on the next Push
+void TextAttributeTree::Shift(uint32_t tree, int64_t shift)
+{
+    if (tree == Nil || shift == 0) return;
+
+    Node& n = nodes[tree];
+    n.start = Offset(n.start, shift);
+    n.end = Offset(n.end, shift);
+    n.maxEnd = Offset(n.maxEnd, shift);
+    n.shift += shift;
+}
+
+void TextAttributeTree::Push(uint32_t node)
+{
+    Node& n = nodes[node];
+    if (n.shift == 0) return;
+
+    Shift(n.left, n.shift);
+    Shift(n.right, n.shift);
+    n.shift = 0;
+}
+
+uint32_t TextAttributeTree::Merge(uint32_t left, uint32_t right)
+{
+    if (left == Nil) return right;
+    if (right == Nil) return left;
+
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        Push(left);
+        uint32_t merged = Merge(nodes[left].right, right);
+        nodes[left].right = merged;
+        Update(left);
+        return left;
+    }
+    else
+    {
+        Push(right);
+        uint32_t merged = Merge(left, nodes[right].left);
+        nodes[right].left = merged;
+        Update(right);
+        return right;
+    }
+}
+
+// Spans are keyed by (start, node); left gets the keys below (start, id)
+void TextAttributeTree::Split(uint32_t tree, uint32_t start, uint32_t id, uint32_t& left, uint32_t& right)
+{
+    if (tree == Nil)
+    {
+        left = right = Nil;
+        return;
+    }
+
+    Push(tree);
+
+    const Node& n = nodes[tree];
+    if (n.start < start || (n.start == start && tree < id))
+    {
+        uint32_t l, r;
+        Split(n.right, start, id, l, r);
+        nodes[tree].right = l;
+        Update(tree);
+        left = tree;
+        right = r;
+    }
+    else
+    {
+        uint32_t l, r;
+        Split(n.left, start, id, l, r);
+        nodes[tree].left = r;
+        Update(tree);
+        left = l;
+        right = tree;
+    }
+}
+
+void TextAttributeTree::Insert(uint32_t node)
+{
+    uint32_t left, right;
+    Split(root, nodes[node].start, node, left, right);
+    root = Merge(Merge(left, node), right);
+}
+
+void TextAttributeTree::Erase(uint32_t start, uint32_t id)
+{
+    uint32_t left, middle, right;
+    Split(root, start, id, left, middle);
+    Split(middle, start, id + 1, middle, right);
+
+    if (middle != Nil) FreeNode(middle);
+    root = Merge(left, right);
+}
+
+void TextAttributeTree::AddSpan(uint32_t start, uint32_t end, const TextAttributes& attributes)
+{
+    if (start >= end || attributes.mask == TextAttributeNone) return;
+
+    Insert(NewNode(start, end, nextOrder++, attributes));
+}
+
+void TextAttributeTree::ClearAttributes(uint32_t start, uint32_t end, uint8_t mask)
+{
+    if (start >= end) return;
+
+    std::vector<FoundSpan> found;
+    CollectSpans(root, 0, start, end, found);
+
+    for (const FoundSpan& span : found)
+    {
+        const Node& n = nodes[span.node];
+        if ((n.attributes.mask & mask) == 0) continue;
+
+        uint32_t order = n.order;
+        TextAttributes attributes = n.attributes;
+        Erase(span.start, span.node);
+
+        // the cut pieces keep their place in the override order
+        if (span.start < start)
+            Insert(NewNode(span.start, start, order, attributes));
+
+        if (span.end > end)
+            Insert(NewNode(end, span.end, order, attributes));
+
+        TextAttributes inside = attributes;
+        inside.mask &= ~mask;
+        if (inside.mask != TextAttributeNone)
+            Insert(NewNode(std::max(span.start, start), std::min(span.end, end), order, inside));
+    }
+}
+
+void TextAttributeTree::Clear()
+{
+    nodes.resize(1);
+    freeNodes.clear();
+    root = Nil;
+    spanCount = 0;
+}
+
+// Maps the ends of the spans in 'tree' that reach past the edit offset
+void TextAttributeTree::MapEnds(uint32_t tree, uint32_t offset, uint32_t removedLength, int64_t shift)
+{
+    if (tree == Nil || nodes[tree].maxEnd <= offset) return;
+
+    Push(tree);
+
+    Node& n = nodes[tree];
+    if (n.end > offset)
+        n.end = n.end >= offset + removedLength ? Offset(n.end, shift) : offset;
+
+    MapEnds(n.left, offset, removedLength, shift);
+    MapEnds(n.right, offset, removedLength, shift);
+    Update(tree);
+}
+
+void TextAttributeTree::AdjustForEdit(uint32_t offset, uint32_t removedLength, uint32_t insertedLength)
+{
+    int64_t shift = (int64_t)insertedLength - removedLength;
+    uint32_t editEnd = offset + removedLength;
+
+    // before the edit, inside the replaced text, after it
+    uint32_t before, inside, after;
+    Split(root, offset, Nil, before, inside);
+    Split(inside, editEnd, Nil, inside, after);
+
+    MapEnds(before, offset, removedLength, shift);
+    Shift(after, shift);
+    root = Merge(before, after);
+
+    // spans starting in the replaced text now start at the inserted text, or are gone
+    std::vector<uint32_t> moved;
+    auto collect = [&](auto& self, uint32_t node) -> void
+    {
+        if (node == Nil) return;
+
+        Push(node);
+        self(self, nodes[node].left);
+        moved.push_back(node);
+        self(self, nodes[node].right);
+    };
+    collect(collect, inside);
+
+    for (uint32_t node : moved)
+    {
+        Node& n = nodes[node];
+        uint32_t end = n.end >= editEnd ? Offset(n.end, shift) : offset;
+
+        if (end <= offset)
+        {
+            FreeNode(node);
+            continue;
+        }
+
+        n.left = Nil;
+        n.right = Nil;
+        n.start = offset;
+        n.end = end;
+        n.maxEnd = end;
+        Insert(node);
+    }
+}
+
+void TextAttributeTree::CollectSpans(uint32_t tree, int64_t shift, uint32_t start, uint32_t end, std::vector<FoundSpan>& found) const
+{
+    // 'shift' is what the ancestors have not pushed down yet
+    if (tree == Nil) return;
+
+    const Node& n = nodes[tree];
+    if (Offset(n.maxEnd, shift) <= start) return;
+
+    CollectSpans(n.left, shift + n.shift, start, end, found);
+
+    uint32_t spanStart = Offset(n.start, shift);
+    if (spanStart >= end) return;
+
+    uint32_t spanEnd = Offset(n.end, shift);
+    if (spanEnd > start) found.push_back({ tree, spanStart, spanEnd });
+
+    CollectSpans(n.right, shift + n.shift, start, end, found);
+}
+
+void TextAttributeTree::FindSpans(uint32_t start, uint32_t end, std::vector<AttributeSpan>& spans) const
+{
+    if (start >= end) return;
+
+    std::vector<FoundSpan> found;
+    CollectSpans(root, 0, start, end, found);
+
+    for (const FoundSpan& span : found)
+        spans.push_back({ span.start, span.end, nodes[span.node].attributes });
+}
+
+void TextAttributeTree::GetStyledRuns(uint32_t start, uint32_t end, const TextStyle& base, std::vector<StyledRun>& runs) const
+{
+    if (start >= end) return;
+
+    std::vector<FoundSpan> found;
+    CollectSpans(root, 0, start, end, found);
+
+    struct Event
+    {
+        uint32_t position;
+        uint32_t span;      // index into 'found'
+        bool opens;
+    };
+
+    std::vector<Event> events;
+    events.reserve(found.size() * 2);
+    for (uint32_t i = 0; i < found.size(); i++)
+    {
+        events.push_back({ std::max(found[i].start, start), i, true });
+        events.push_back({ std::min(found[i].end, end), i, false });
+    }
+
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.position < b.position; });
+
+    // per attribute, a max-heap of the spans setting it by order; closed spans are dropped lazily
+    // when they reach the top
+    std::vector<bool> open(found.size());
+    std::vector<uint32_t> heaps[AttributeCount];
+    auto later = [&](uint32_t a, uint32_t b) { return nodes[found[a].node].order < nodes[found[b].node].order; };
+
+    size_t first = runs.size();
+    size_t next = 0;
+    uint32_t position = start;
+
+    while (position < end)
+    {
+        for (; next < events.size() && events[next].position == position; next++)
+        {
+            const Event& event = events[next];
+            open[event.span] = event.opens;
+            if (!event.opens) continue;
+
+            uint8_t mask = nodes[found[event.span].node].attributes.mask;
+            for (uint8_t a = 0; a < AttributeCount; a++)
+            {
+                if ((mask & (1 << a)) == 0) continue;
+
+                heaps[a].push_back(event.span);
+                std::push_heap(heaps[a].begin(), heaps[a].end(), later);
+            }
+        }
+
+        uint32_t runEnd = next < events.size() ? events[next].position : end;
+
+        TextStyle style = base;
+        for (uint8_t a = 0; a < AttributeCount; a++)
+        {
+            std::vector<uint32_t>& heap = heaps[a];
+            while (!heap.empty() && !open[heap.front()])
+            {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                heap.pop_back();
+            }
+
+            if (!heap.empty())
+                ApplyAttribute(style, nodes[found[heap.front()].node].attributes.values, (uint8_t)(1 << a));
+        }
+
+        if (runs.size() > first && runs.back().style == style)
+            runs.back().textLength += runEnd - position;
+        else
+            runs.push_back({ position, runEnd - position, style });
+
+        position = runEnd;
+    }
+}
+
+void TextAttributeTree::GetShapingRuns(uint32_t start, uint32_t end, const TextStyle& base, std::vector<ShapingRun>& runs) const
+{
+    std::vector<StyledRun> styled;
+    GetStyledRuns(start, end, base, styled);
+
+    size_t first = runs.size();
+    for (const StyledRun& run : styled)
+    {
+        const TextStyle& s = run.style;
+
+        if (runs.size() > first)
+        {
+            ShapingRun& last = runs.back();
+            if (last.fontSize == s.fontSize && last.weight == s.weight && last.italic == s.italic)
+            {
+                last.textLength += run.textLength;
+                continue;
+            }
+        }
+
+        runs.push_back({ run.textStart, run.textLength, s.fontSize, s.weight, s.italic });
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Resolved formatting of a piece of text
+struct TextStyle
+{
+    float fontSize;
+    uint16_t weight;        // 400 regular, 700 bold
+    bool italic;
+    bool underline;
+    uint32_t color;         // 0x00RRGGBB, as TextBlender takes it
+
+    bool operator==(const TextStyle& other) const = default;
+};
+
+// Fields of TextAttributes::values a span sets
+enum TextAttribute : uint8_t
+{
+    TextAttributeNone = 0,
+    TextAttributeFontSize = 1 << 0,
+    TextAttributeWeight = 1 << 1,
+    TextAttributeItalic = 1 << 2,
+    TextAttributeUnderline = 1 << 3,
+    TextAttributeColor = 1 << 4,
+    TextAttributeAll = 0x1F,
+};
+
+struct TextAttributes
+{
+    uint8_t mask;           // TextAttribute flags
+    TextStyle values;       // only the fields in 'mask' are used
+};
+
+struct AttributeSpan
+{
+    uint32_t start;
+    uint32_t end;
+    TextAttributes attributes;
+};
+
+// Text with one style throughout
+struct StyledRun
+{
+    uint32_t textStart;
+    uint32_t textLength;
+    TextStyle style;
+};
+
+// Text that can be shaped in one call: the fields that change glyphs or advances are the same
+// throughout, color and underline may change inside
+struct ShapingRun
+{
+    uint32_t textStart;
+    uint32_t textLength;
+    float fontSize;
+    uint16_t weight;
+    bool italic;
+};
+
+// Formatting spans of a rich text, in an interval treap.
+// Spans are ordered by start and every subtree keeps the largest end below it, so the spans
+// overlapping a range are found in O(log n + k) instead of scanning all of them. Spans may
+// overlap freely; where they set the same attribute, the one added last wins.
+//
+// Text edits are O(log n) plus the spans touching the edit: the spans after it are moved with a
+// lazy offset on their subtree. Offsets are in UTF-16 code units.
+class TextAttributeTree
+{
+    struct Node
+    {
+        uint32_t left;
+        uint32_t right;
+        uint32_t priority;
+        uint32_t start;
+        uint32_t end;
+        uint32_t maxEnd;        // largest end in the subtree
+        int64_t shift;          // not yet applied to the children
+        uint32_t order;         // later spans override earlier ones
+        TextAttributes attributes;
+    };
+
+    struct FoundSpan
+    {
+        uint32_t node;
+        uint32_t start;
+        uint32_t end;
+    };
+
+    static constexpr uint32_t Nil = 0; // nodes[0] is a sentinel
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    uint32_t root;
+    uint32_t seed;
+    uint32_t nextOrder;
+    size_t spanCount;
+
+public:
+    TextAttributeTree();
+
+    // Empty and inverted ranges are ignored
+    void AddSpan(uint32_t start, uint32_t end, const TextAttributes& attributes);
+
+    // Takes the attributes in 'mask' off [start, end). Spans are cut at the range ends and keep
+    // their precedence; spans left without attributes are removed.
+    void ClearAttributes(uint32_t start, uint32_t end, uint8_t mask = TextAttributeAll);
+
+    void Clear();
+
+    // Moves the spans for a replacement of [offset, offset + removedLength) with insertedLength
+    // units. The inserted text belongs to the spans that overlap the replaced text and reach its
+    // end, or for a pure insertion, to the spans around it; text inserted at a span boundary
+    // belongs to neither side. Spans that lose all their text are removed.
+    void AdjustForEdit(uint32_t offset, uint32_t removedLength, uint32_t insertedLength);
+
+    size_t GetSpanCount() const { return spanCount; }
+
+    // Appends the spans overlapping [start, end), in start order
+    void FindSpans(uint32_t start, uint32_t end, std::vector<AttributeSpan>& spans) const;
+
+    // Appends [start, end) as runs of one style each, with 'base' where no span sets an attribute.
+    // Neighbouring runs always differ in style. O((k + 1) log k) for k overlapping spans.
+    void GetStyledRuns(uint32_t start, uint32_t end, const TextStyle& base, std::vector<StyledRun>& runs) const;
+
+    // Appends [start, end) merged into shaping units: styled runs that only differ in color or
+    // underline are joined
+    void GetShapingRuns(uint32_t start, uint32_t end, const TextStyle& base, std::vector<ShapingRun>& runs) const;
+
+private:
+    uint32_t NewNode(uint32_t start, uint32_t end, uint32_t order, const TextAttributes& attributes);
+    void FreeNode(uint32_t node);
+    void Update(uint32_t node);
+    void Shift(uint32_t tree, int64_t shift);
+    void Push(uint32_t node);
+
+    uint32_t Merge(uint32_t left, uint32_t right);
+    void Split(uint32_t tree, uint32_t start, uint32_t id, uint32_t& left, uint32_t& right);
+    void Insert(uint32_t node);
+    void Erase(uint32_t start, uint32_t id);
+    void MapEnds(uint32_t tree, uint32_t offset, uint32_t removedLength, int64_t shift);
+    void CollectSpans(uint32_t tree, int64_t shift, uint32_t start, uint32_t end, std::vector<FoundSpan>& found) const;
+};
@@ -0,0 +1,187 @@
+#include "TextBlend.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define TEXTBLEND_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    // Gamma encoded text luminance, 0..1
+    double GetEncodedLuminance(uint32_t color, double gamma)
+    {
+        double r = std::pow(((color >> 16) & 0xFF) / 255.0, gamma);
+        double g = std::pow(((color >> 8) & 0xFF) / 255.0, gamma);
+        double b = std::pow((color & 0xFF) / 255.0, gamma);
+
+        return std::pow(0.2126 * r + 0.7152 * g + 0.0722 * b, 1.0 / gamma);
+    }
+
+    // Corrected alpha for a coverage, see TextBlender
+    double CorrectAlpha(double coverage, double encodedLuminance, double gamma, double enhancedContrast)
+    {
+        // contrast matters for dark text only, light text already looks heavier
+        double k = enhancedContrast * (1.0 - encodedLuminance);
+        double a = coverage * (k + 1.0) / (coverage * k + 1.0);
+
+        // black and white are the same in linear and encoded form
+        double background = encodedLuminance < 0.5 ? 1.0 : 0.0;
+        double range = encodedLuminance - background;
+
+        double linear = background + (std::pow(encodedLuminance, gamma) - background) * a;
+        return std::clamp((std::pow(linear, 1.0 / gamma) - background) / range, 0.0, 1.0);
+    }
+
+    // round((d * (255 - a) + s * a) / 255) for 8-bit d, s, a
+    uint32_t Lerp255(uint32_t d, uint32_t s, uint32_t a)
+    {
+        uint32_t v = d * (255 - a) + s * a + 128;
+        return (v + (v >> 8)) >> 8;
+    }
+
+    uint32_t BlendPixel(uint32_t dst, uint32_t color, uint32_t a)
+    {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            result |= Lerp255((dst >> shift) & 0xFF, (color >> shift) & 0xFF, a) << shift;
+        return result;
+    }
+
+    void BlendScalar(const uint8_t* table, uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t a = table[coverage[i]];
+            if (a == 0) continue;
+            dst[i] = a == 255 ? color : BlendPixel(dst[i], color, a);
+        }
+    }
+
+#ifdef TEXTBLEND_SSE2
+    void BlendSse2(const uint8_t* table, uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i c255 = _mm_set1_epi16(255);
+        const __m128i c128 = _mm_set1_epi16(128);
+        const __m128i solid = _mm_set1_epi32((int)color);
+        const __m128i source = _mm_unpacklo_epi8(solid, zero);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32_t a = table[coverage[i]] | (table[coverage[i + 1]] << 8) | (table[coverage[i + 2]] << 16) | ((uint32_t)table[coverage[i + 3]] << 24);
+
+            // most of a glyph box is either empty or fully covered
+            if (a == 0) continue;
+            if (a == 0xFFFFFFFF)
+            {
+                _mm_storeu_si128((__m128i*)(dst + i), solid);
+                continue;
+            }
+
+            // spread each pixel's alpha over its four channels
+            __m128i alpha = _mm_cvtsi32_si128((int)a);
+            alpha = _mm_unpacklo_epi8(alpha, alpha);
+            alpha = _mm_unpacklo_epi16(alpha, alpha);
+
+            __m128i alphaLo = _mm_unpacklo_epi8(alpha, zero);
+            __m128i alphaHi = _mm_unpackhi_epi8(alpha, zero);
+
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(dst + i));
+            __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+            __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+
+            // d * (255 - a) + s * a + 128 stays below 65536, so 16-bit lanes do not overflow
+            lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, _mm_sub_epi16(c255, alphaLo)), _mm_mullo_epi16(source, alphaLo)), c128);
+            hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, _mm_sub_epi16(c255, alphaHi)), _mm_mullo_epi16(source, alphaHi)), c128);
+
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+            _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+        }
+
+        BlendScalar(table, color, coverage + i, dst + i, count - i);
+    }
+#endif
+}
+
+TextBlender::TextBlender(float gamma, float enhancedContrast)
+    : gamma(gamma)
+    , enhancedContrast(enhancedContrast)
+{
+    for (int level = 0; level < LuminanceLevels; level++)
+    {
+        double luminance = level / (double)(LuminanceLevels - 1);
+        for (int coverage = 0; coverage < 256; coverage++)
+        {
+            double alpha = CorrectAlpha(coverage / 255.0, luminance, gamma, enhancedContrast);
+            tables[level][coverage] = (uint8_t)std::lround(alpha * 255.0);
+        }
+
+        // empty and full coverage must stay exact for the fast paths
+        tables[level][0] = 0;
+        tables[level][255] = 255;
+    }
+}
+
+const uint8_t* TextBlender::GetAlphaTable(uint32_t color) const
+{
+    double luminance = GetEncodedLuminance(color, gamma);
+    return tables[std::lround(luminance * (LuminanceLevels - 1))];
+}
+
+void TextBlender::BlendSpan(uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count) const
+{
+    color |= 0xFF000000;
+
+#ifdef TEXTBLEND_SSE2
+    BlendSse2(GetAlphaTable(color), color, coverage, dst, count);
+#else
+    BlendScalar(GetAlphaTable(color), color, coverage, dst, count);
+#endif
+}
+
+void TextBlender::BlendMask(uint32_t color, const uint8_t* coverage, size_t coverageStride, int width, int height, uint32_t* dst, size_t dstStride) const
+{
+    color |= 0xFF000000;
+    const uint8_t* table = GetAlphaTable(color);
+
+    for (int y = 0; y < height; y++)
+    {
+#ifdef TEXTBLEND_SSE2
+        BlendSse2(table, color, coverage + y * coverageStride, dst + y * dstStride, width);
+#else
+        BlendScalar(table, color, coverage + y * coverageStride, dst + y * dstStride, width);
+#endif
+    }
+}
+
+void TextBlender::BlendSpanScalar(uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count) const
+{
+    color |= 0xFF000000;
+    BlendScalar(GetAlphaTable(color), color, coverage, dst, count);
+}
+
+void BlendSpanReference(float gamma, float enhancedContrast, uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count)
+{
+    color |= 0xFF000000;
+    double luminance = GetEncodedLuminance(color, gamma);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        double a = CorrectAlpha(coverage[i] / 255.0, luminance, gamma, enhancedContrast);
+
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            double d = (dst[i] >> shift) & 0xFF;
+            double s = (color >> shift) & 0xFF;
+            result |= (uint32_t)std::lround(d + (s - d) * a) << shift;
+        }
+        dst[i] = result;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Composites grayscale glyph coverage in an opaque text color onto 32-bit BGRA pixels
+// (0xAARRGGBB in memory order B, G, R, A), the same layout as the D2D bitmap targets.
+//
+// Blending 8-bit sRGB values linearly makes dark-on-light text thin and light-on-dark text
+// bold. Converting every pixel to linear light and back would fix that but costs two transfer
+// function evaluations per channel. Instead the coverage is corrected, ClearType grayscale style:
+// for each text luminance a 256-entry table maps coverage to the alpha that, blended in sRGB,
+// gives the result linear blending would give against the opposite background (white behind
+// dark text, black behind light text). An enhanced contrast term thickens dark text further.
+// The tables are built once, so the per-pixel work is a table lookup and an integer lerp, done
+// four pixels at a time with SSE2 where available.
+class TextBlender
+{
+public:
+    static constexpr int LuminanceLevels = 64;
+
+private:
+    float gamma;
+    float enhancedContrast;
+    uint8_t tables[LuminanceLevels][256];
+
+public:
+    // gamma 1.8 and contrast 0.5 match the DirectWrite grayscale defaults closely enough
+    explicit TextBlender(float gamma = 1.8f, float enhancedContrast = 0.5f);
+
+    float GetGamma() const { return gamma; }
+    float GetEnhancedContrast() const { return enhancedContrast; }
+
+    // Coverage -> alpha table used for the color (alpha byte ignored)
+    const uint8_t* GetAlphaTable(uint32_t color) const;
+
+    void BlendSpan(uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count) const;
+
+    // Blends a width x height block, e.g. a GlyphAtlas entry. Strides are in elements; no clipping.
+    void BlendMask(uint32_t color, const uint8_t* coverage, size_t coverageStride, int width, int height, uint32_t* dst, size_t dstStride) const;
+
+    // Same result as BlendSpan without SIMD
+    void BlendSpanScalar(uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count) const;
+};
+
+// Reference for TextBlender: evaluates the same correction in floating point for every pixel,
+// with the exact text luminance instead of one of LuminanceLevels tables. TextBlender differs
+// from it by at most two steps per channel, and by more than one only for colors whose luminance
+// falls between two tables, about one channel in 200,000: the tables round alpha to 8 bits on
+// top of the luminance step, and the blend rounds again.
+void BlendSpanReference(float gamma, float enhancedContrast, uint32_t color, const uint8_t* coverage, uint32_t* dst, size_t count);
@@ -0,0 +1,883 @@
+#include "TextBreak.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+#include "Hangul.h"
+#include "Shaper.h"
+#include "UnicodeTable.h"
+
+namespace
+{
+    using G = GraphemeBreakProperty;
+    using LB = LineBreakClass;
+
+    // Generated from the Unicode 14.0 UCD (GraphemeBreakProperty.txt, emoji-data.txt,
+    // LineBreak.txt and EastAsianWidth.txt) with the LB1 resolution applied. Other, AL and the precomposed Hangul
+    // syllables are left out; the default value and Hangul arithmetic cover them.
+    const PropertyRange<G> GraphemeRanges[] =
+    {
+        { 0x0000, 0x0009, G::Control }, { 0x000A, 0x000A, G::LF }, { 0x000B, 0x000C, G::Control },
+        { 0x000D, 0x000D, G::CR }, { 0x000E, 0x001F, G::Control }, { 0x007F, 0x009F, G::Control },
+        { 0x00A9, 0x00A9, G::ExtendedPictographic }, { 0x00AD, 0x00AD, G::Control }, { 0x00AE, 0x00AE, G::ExtendedPictographic },
+        { 0x0300, 0x036F, G::Extend }, { 0x0483, 0x0489, G::Extend }, { 0x0591, 0x05BD, G::Extend },
+        { 0x05BF, 0x05BF, G::Extend }, { 0x05C1, 0x05C2, G::Extend }, { 0x05C4, 0x05C5, G::Extend },
+        { 0x05C7, 0x05C7, G::Extend }, { 0x0600, 0x0605, G::Prepend }, { 0x0610, 0x061A, G::Extend },
+        { 0x061C, 0x061C, G::Control }, { 0x064B, 0x065F, G::Extend }, { 0x0670, 0x0670, G::Extend },
+        { 0x06D6, 0x06DC, G::Extend }, { 0x06DD, 0x06DD, G::Prepend }, { 0x06DF, 0x06E4, G::Extend },
+        { 0x06E7, 0x06E8, G::Extend }, { 0x06EA, 0x06ED, G::Extend }, { 0x070F, 0x070F, G::Prepend },
+        { 0x0711, 0x0711, G::Extend }, { 0x0730, 0x074A, G::Extend }, { 0x07A6, 0x07B0, G::Extend },
+        { 0x07EB, 0x07F3, G::Extend }, { 0x07FD, 0x07FD, G::Extend }, { 0x0816, 0x0819, G::Extend },
+        { 0x081B, 0x0823, G::Extend }, { 0x0825, 0x0827, G::Extend }, { 0x0829, 0x082D, G::Extend },
+        { 0x0859, 0x085B, G::Extend }, { 0x0890, 0x0891, G::Prepend }, { 0x0898, 0x089F, G::Extend },
+        { 0x08CA, 0x08E1, G::Extend }, { 0x08E2, 0x08E2, G::Prepend }, { 0x08E3, 0x0902, G::Extend },
+        { 0x0903, 0x0903, G::SpacingMark }, { 0x093A, 0x093A, G::Extend }, { 0x093B, 0x093B, G::SpacingMark },
+        { 0x093C, 0x093C, G::Extend }, { 0x093E, 0x0940, G::SpacingMark }, { 0x0941, 0x0948, G::Extend },
+        { 0x0949, 0x094C, G::SpacingMark }, { 0x094D, 0x094D, G::Extend }, { 0x094E, 0x094F, G::SpacingMark },
+        { 0x0951, 0x0957, G::Extend }, { 0x0962, 0x0963, G::Extend }, { 0x0981, 0x0981, G::Extend },
+        { 0x0982, 0x0983, G::SpacingMark }, { 0x09BC, 0x09BC, G::Extend }, { 0x09BE, 0x09BE, G::Extend },
+        { 0x09BF, 0x09C0, G::SpacingMark }, { 0x09C1, 0x09C4, G::Extend }, { 0x09C7, 0x09C8, G::SpacingMark },
+        { 0x09CB, 0x09CC, G::SpacingMark }, { 0x09CD, 0x09CD, G::Extend }, { 0x09D7, 0x09D7, G::Extend },
+        { 0x09E2, 0x09E3, G::Extend }, { 0x09FE, 0x09FE, G::Extend }, { 0x0A01, 0x0A02, G::Extend },
+        { 0x0A03, 0x0A03, G::SpacingMark }, { 0x0A3C, 0x0A3C, G::Extend }, { 0x0A3E, 0x0A40, G::SpacingMark },
+        { 0x0A41, 0x0A42, G::Extend }, { 0x0A47, 0x0A48, G::Extend }, { 0x0A4B, 0x0A4D, G::Extend },
+        { 0x0A51, 0x0A51, G::Extend }, { 0x0A70, 0x0A71, G::Extend }, { 0x0A75, 0x0A75, G::Extend },
+        { 0x0A81, 0x0A82, G::Extend }, { 0x0A83, 0x0A83, G::SpacingMark }, { 0x0ABC, 0x0ABC, G::Extend },
+        { 0x0ABE, 0x0AC0, G::SpacingMark }, { 0x0AC1, 0x0AC5, G::Extend }, { 0x0AC7, 0x0AC8, G::Extend },
+        { 0x0AC9, 0x0AC9, G::SpacingMark }, { 0x0ACB, 0x0ACC, G::SpacingMark }, { 0x0ACD, 0x0ACD, G::Extend },
+        { 0x0AE2, 0x0AE3, G::Extend }, { 0x0AFA, 0x0AFF, G::Extend }, { 0x0B01, 0x0B01, G::Extend },
+        { 0x0B02, 0x0B03, G::SpacingMark }, { 0x0B3C, 0x0B3C, G::Extend }, { 0x0B3E, 0x0B3F, G::Extend },
+        { 0x0B40, 0x0B40, G::SpacingMark }, { 0x0B41, 0x0B44, G::Extend }, { 0x0B47, 0x0B48, G::SpacingMark },
+        { 0x0B4B, 0x0B4C, G::SpacingMark }, { 0x0B4D, 0x0B4D, G::Extend }, { 0x0B55, 0x0B57, G::Extend },
+        { 0x0B62, 0x0B63, G::Extend }, { 0x0B82, 0x0B82, G::Extend }, { 0x0BBE, 0x0BBE, G::Extend },
+        { 0x0BBF, 0x0BBF, G::SpacingMark }, { 0x0BC0, 0x0BC0, G::Extend }, { 0x0BC1, 0x0BC2, G::SpacingMark },
+        { 0x0BC6, 0x0BC8, G::SpacingMark }, { 0x0BCA, 0x0BCC, G::SpacingMark }, { 0x0BCD, 0x0BCD, G::Extend },
+        { 0x0BD7, 0x0BD7, G::Extend }, { 0x0C00, 0x0C00, G::Extend }, { 0x0C01, 0x0C03, G::SpacingMark },
+        { 0x0C04, 0x0C04, G::Extend }, { 0x0C3C, 0x0C3C, G::Extend }, { 0x0C3E, 0x0C40, G::Extend },
+        { 0x0C41, 0x0C44, G::SpacingMark }, { 0x0C46, 0x0C48, G::Extend }, { 0x0C4A, 0x0C4D, G::Extend },
+        { 0x0C55, 0x0C56, G::Extend }, { 0x0C62, 0x0C63, G::Extend }, { 0x0C81, 0x0C81, G::Extend },
+        { 0x0C82, 0x0C83, G::SpacingMark }, { 0x0CBC, 0x0CBC, G::Extend }, { 0x0CBE, 0x0CBE, G::SpacingMark },
+        { 0x0CBF, 0x0CBF, G::Extend }, { 0x0CC0, 0x0CC1, G::SpacingMark }, { 0x0CC2, 0x0CC2, G::Extend },
+        { 0x0CC3, 0x0CC4, G::SpacingMark }, { 0x0CC6, 0x0CC6, G::Extend }, { 0x0CC7, 0x0CC8, G::SpacingMark },
+        { 0x0CCA, 0x0CCB, G::SpacingMark }, { 0x0CCC, 0x0CCD, G::Extend }, { 0x0CD5, 0x0CD6, G::Extend },
+        { 0x0CE2, 0x0CE3, G::Extend }, { 0x0D00, 0x0D01, G::Extend }, { 0x0D02, 0x0D03, G::SpacingMark },
+        { 0x0D3B, 0x0D3C, G::Extend }, { 0x0D3E, 0x0D3E, G::Extend }, { 0x0D3F, 0x0D40, G::SpacingMark },
+        { 0x0D41, 0x0D44, G::Extend }, { 0x0D46, 0x0D48, G::SpacingMark }, { 0x0D4A, 0x0D4C, G::SpacingMark },
+        { 0x0D4D, 0x0D4D, G::Extend }, { 0x0D4E, 0x0D4E, G::Prepend }, { 0x0D57, 0x0D57, G::Extend },
+        { 0x0D62, 0x0D63, G::Extend }, { 0x0D81, 0x0D81, G::Extend }, { 0x0D82, 0x0D83, G::SpacingMark },
+        { 0x0DCA, 0x0DCA, G::Extend }, { 0x0DCF, 0x0DCF, G::Extend }, { 0x0DD0, 0x0DD1, G::SpacingMark },
+        { 0x0DD2, 0x0DD4, G::Extend }, { 0x0DD6, 0x0DD6, G::Extend }, { 0x0DD8, 0x0DDE, G::SpacingMark },
+        { 0x0DDF, 0x0DDF, G::Extend }, { 0x0DF2, 0x0DF3, G::SpacingMark }, { 0x0E31, 0x0E31, G::Extend },
+        { 0x0E33, 0x0E33, G::SpacingMark }, { 0x0E34, 0x0E3A, G::Extend }, { 0x0E47, 0x0E4E, G::Extend },
+        { 0x0EB1, 0x0EB1, G::Extend }, { 0x0EB3, 0x0EB3, G::SpacingMark }, { 0x0EB4, 0x0EBC, G::Extend },
+        { 0x0EC8, 0x0ECD, G::Extend }, { 0x0F18, 0x0F19, G::Extend }, { 0x0F35, 0x0F35, G::Extend },
+        { 0x0F37, 0x0F37, G::Extend }, { 0x0F39, 0x0F39, G::Extend }, { 0x0F3E, 0x0F3F, G::SpacingMark },
+        { 0x0F71, 0x0F7E, G::Extend }, { 0x0F7F, 0x0F7F, G::SpacingMark }, { 0x0F80, 0x0F84, G::Extend },
+        { 0x0F86, 0x0F87, G::Extend }, { 0x0F8D, 0x0F97, G::Extend }, { 0x0F99, 0x0FBC, G::Extend },
+        { 0x0FC6, 0x0FC6, G::Extend }, { 0x102D, 0x1030, G::Extend }, { 0x1031, 0x1031, G::SpacingMark },
+        { 0x1032, 0x1037, G::Extend }, { 0x1039, 0x103A, G::Extend }, { 0x103B, 0x103C, G::SpacingMark },
+        { 0x103D, 0x103E, G::Extend }, { 0x1056, 0x1057, G::SpacingMark }, { 0x1058, 0x1059, G::Extend },
+        { 0x105E, 0x1060, G::Extend }, { 0x1071, 0x1074, G::Extend }, { 0x1082, 0x1082, G::Extend },
+        { 0x1084, 0x1084, G::SpacingMark }, { 0x1085, 0x1086, G::Extend }, { 0x108D, 0x108D, G::Extend },
+        { 0x109D, 0x109D, G::Extend }, { 0x1100, 0x115F, G::L }, { 0x1160, 0x11A7, G::V },
+        { 0x11A8, 0x11FF, G::T }, { 0x135D, 0x135F, G::Extend }, { 0x1712, 0x1714, G::Extend },
+        { 0x1715, 0x1715, G::SpacingMark }, { 0x1732, 0x1733, G::Extend }, { 0x1734, 0x1734, G::SpacingMark },
+        { 0x1752, 0x1753, G::Extend }, { 0x1772, 0x1773, G::Extend }, { 0x17B4, 0x17B5, G::Extend },
+        { 0x17B6, 0x17B6, G::SpacingMark }, { 0x17B7, 0x17BD, G::Extend }, { 0x17BE, 0x17C5, G::SpacingMark },
+        { 0x17C6, 0x17C6, G::Extend }, { 0x17C7, 0x17C8, G::SpacingMark }, { 0x17C9, 0x17D3, G::Extend },
+        { 0x17DD, 0x17DD, G::Extend }, { 0x180B, 0x180D, G::Extend }, { 0x180E, 0x180E, G::Control },
+        { 0x180F, 0x180F, G::Extend }, { 0x1885, 0x1886, G::Extend }, { 0x18A9, 0x18A9, G::Extend },
+        { 0x1920, 0x1922, G::Extend }, { 0x1923, 0x1926, G::SpacingMark }, { 0x1927, 0x1928, G::Extend },
+        { 0x1929, 0x192B, G::SpacingMark }, { 0x1930, 0x1931, G::SpacingMark }, { 0x1932, 0x1932, G::Extend },
+        { 0x1933, 0x1938, G::SpacingMark }, { 0x1939, 0x193B, G::Extend }, { 0x1A17, 0x1A18, G::Extend },
+        { 0x1A19, 0x1A1A, G::SpacingMark }, { 0x1A1B, 0x1A1B, G::Extend }, { 0x1A55, 0x1A55, G::SpacingMark },
+        { 0x1A56, 0x1A56, G::Extend }, { 0x1A57, 0x1A57, G::SpacingMark }, { 0x1A58, 0x1A5E, G::Extend },
+        { 0x1A60, 0x1A60, G::Extend }, { 0x1A62, 0x1A62, G::Extend }, { 0x1A65, 0x1A6C, G::Extend },
+        { 0x1A6D, 0x1A72, G::SpacingMark }, { 0x1A73, 0x1A7C, G::Extend }, { 0x1A7F, 0x1A7F, G::Extend },
+        { 0x1AB0, 0x1ACE, G::Extend }, { 0x1B00, 0x1B03, G::Extend }, { 0x1B04, 0x1B04, G::SpacingMark },
+        { 0x1B34, 0x1B3A, G::Extend }, { 0x1B3B, 0x1B3B, G::SpacingMark }, { 0x1B3C, 0x1B3C, G::Extend },
+        { 0x1B3D, 0x1B41, G::SpacingMark }, { 0x1B42, 0x1B42, G::Extend }, { 0x1B43, 0x1B44, G::SpacingMark },
+        { 0x1B6B, 0x1B73, G::Extend }, { 0x1B80, 0x1B81, G::Extend }, { 0x1B82, 0x1B82, G::SpacingMark },
+        { 0x1BA1, 0x1BA1, G::SpacingMark }, { 0x1BA2, 0x1BA5, G::Extend }, { 0x1BA6, 0x1BA7, G::SpacingMark },
+        { 0x1BA8, 0x1BA9, G::Extend }, { 0x1BAA, 0x1BAA, G::SpacingMark }, { 0x1BAB, 0x1BAD, G::Extend },
+        { 0x1BE6, 0x1BE6, G::Extend }, { 0x1BE7, 0x1BE7, G::SpacingMark }, { 0x1BE8, 0x1BE9, G::Extend },
+        { 0x1BEA, 0x1BEC, G::SpacingMark }, { 0x1BED, 0x1BED, G::Extend }, { 0x1BEE, 0x1BEE, G::SpacingMark },
+        { 0x1BEF, 0x1BF1, G::Extend }, { 0x1BF2, 0x1BF3, G::SpacingMark }, { 0x1C24, 0x1C2B, G::SpacingMark },
+        { 0x1C2C, 0x1C33, G::Extend }, { 0x1C34, 0x1C35, G::SpacingMark }, { 0x1C36, 0x1C37, G::Extend },
+        { 0x1CD0, 0x1CD2, G::Extend }, { 0x1CD4, 0x1CE0, G::Extend }, { 0x1CE1, 0x1CE1, G::SpacingMark },
+        { 0x1CE2, 0x1CE8, G::Extend }, { 0x1CED, 0x1CED, G::Extend }, { 0x1CF4, 0x1CF4, G::Extend },
+        { 0x1CF7, 0x1CF7, G::SpacingMark }, { 0x1CF8, 0x1CF9, G::Extend }, { 0x1DC0, 0x1DFF, G::Extend },
+        { 0x200B, 0x200B, G::Control }, { 0x200C, 0x200C, G::Extend }, { 0x200D, 0x200D, G::ZWJ },
+        { 0x200E, 0x200F, G::Control }, { 0x2028, 0x202E, G::Control }, { 0x203C, 0x203C, G::ExtendedPictographic },
+        { 0x2049, 0x2049, G::ExtendedPictographic }, { 0x2060, 0x206F, G::Control }, { 0x20D0, 0x20F0, G::Extend },
+        { 0x2122, 0x2122, G::ExtendedPictographic }, { 0x2139, 0x2139, G::ExtendedPictographic }, { 0x2194, 0x2199, G::ExtendedPictographic },
+        { 0x21A9, 0x21AA, G::ExtendedPictographic }, { 0x231A, 0x231B, G::ExtendedPictographic }, { 0x2328, 0x2328, G::ExtendedPictographic },
+        { 0x2388, 0x2388, G::ExtendedPictographic }, { 0x23CF, 0x23CF, G::ExtendedPictographic }, { 0x23E9, 0x23F3, G::ExtendedPictographic },
+        { 0x23F8, 0x23FA, G::ExtendedPictographic }, { 0x24C2, 0x24C2, G::ExtendedPictographic }, { 0x25AA, 0x25AB, G::ExtendedPictographic },
+        { 0x25B6, 0x25B6, G::ExtendedPictographic }, { 0x25C0, 0x25C0, G::ExtendedPictographic }, { 0x25FB, 0x25FE, G::ExtendedPictographic },
+        { 0x2600, 0x2605, G::ExtendedPictographic }, { 0x2607, 0x2612, G::ExtendedPictographic }, { 0x2614, 0x2685, G::ExtendedPictographic },
+        { 0x2690, 0x2705, G::ExtendedPictographic }, { 0x2708, 0x2712, G::ExtendedPictographic }, { 0x2714, 0x2714, G::ExtendedPictographic },
+        { 0x2716, 0x2716, G::ExtendedPictographic }, { 0x271D, 0x271D, G::ExtendedPictographic }, { 0x2721, 0x2721, G::ExtendedPictographic },
+        { 0x2728, 0x2728, G::ExtendedPictographic }, { 0x2733, 0x2734, G::ExtendedPictographic }, { 0x2744, 0x2744, G::ExtendedPictographic },
+        { 0x2747, 0x2747, G::ExtendedPictographic }, { 0x274C, 0x274C, G::ExtendedPictographic }, { 0x274E, 0x274E, G::ExtendedPictographic },
+        { 0x2753, 0x2755, G::ExtendedPictographic }, { 0x2757, 0x2757, G::ExtendedPictographic }, { 0x2763, 0x2767, G::ExtendedPictographic },
+        { 0x2795, 0x2797, G::ExtendedPictographic }, { 0x27A1, 0x27A1, G::ExtendedPictographic }, { 0x27B0, 0x27B0, G::ExtendedPictographic },
+        { 0x27BF, 0x27BF, G::ExtendedPictographic }, { 0x2934, 0x2935, G::ExtendedPictographic }, { 0x2B05, 0x2B07, G::ExtendedPictographic },
+        { 0x2B1B, 0x2B1C, G::ExtendedPictographic }, { 0x2B50, 0x2B50, G::ExtendedPictographic }, { 0x2B55, 0x2B55, G::ExtendedPictographic },
+        { 0x2CEF, 0x2CF1, G::Extend }, { 0x2D7F, 0x2D7F, G::Extend }, { 0x2DE0, 0x2DFF, G::Extend },
+        { 0x302A, 0x302F, G::Extend }, { 0x3030, 0x3030, G::ExtendedPictographic }, { 0x303D, 0x303D, G::ExtendedPictographic },
+        { 0x3099, 0x309A, G::Extend }, { 0x3297, 0x3297, G::ExtendedPictographic }, { 0x3299, 0x3299, G::ExtendedPictographic },
+        { 0xA66F, 0xA672, G::Extend }, { 0xA674, 0xA67D, G::Extend }, { 0xA69E, 0xA69F, G::Extend },
+        { 0xA6F0, 0xA6F1, G::Extend }, { 0xA802, 0xA802, G::Extend }, { 0xA806, 0xA806, G::Extend },
+        { 0xA80B, 0xA80B, G::Extend }, { 0xA823, 0xA824, G::SpacingMark }, { 0xA825, 0xA826, G::Extend },
+        { 0xA827, 0xA827, G::SpacingMark }, { 0xA82C, 0xA82C, G::Extend }, { 0xA880, 0xA881, G::SpacingMark },
+        { 0xA8B4, 0xA8C3, G::SpacingMark }, { 0xA8C4, 0xA8C5, G::Extend }, { 0xA8E0, 0xA8F1, G::Extend },
+        { 0xA8FF, 0xA8FF, G::Extend }, { 0xA926, 0xA92D, G::Extend }, { 0xA947, 0xA951, G::Extend },
+        { 0xA952, 0xA953, G::SpacingMark }, { 0xA960, 0xA97C, G::L }, { 0xA980, 0xA982, G::Extend },
+        { 0xA983, 0xA983, G::SpacingMark }, { 0xA9B3, 0xA9B3, G::Extend }, { 0xA9B4, 0xA9B5, G::SpacingMark },
+        { 0xA9B6, 0xA9B9, G::Extend }, { 0xA9BA, 0xA9BB, G::SpacingMark }, { 0xA9BC, 0xA9BD, G::Extend },
+        { 0xA9BE, 0xA9C0, G::SpacingMark }, { 0xA9E5, 0xA9E5, G::Extend }, { 0xAA29, 0xAA2E, G::Extend },
+        { 0xAA2F, 0xAA30, G::SpacingMark }, { 0xAA31, 0xAA32, G::Extend }, { 0xAA33, 0xAA34, G::SpacingMark },
+        { 0xAA35, 0xAA36, G::Extend }, { 0xAA43, 0xAA43, G::Extend }, { 0xAA4C, 0xAA4C, G::Extend },
+        { 0xAA4D, 0xAA4D, G::SpacingMark }, { 0xAA7C, 0xAA7C, G::Extend }, { 0xAAB0, 0xAAB0, G::Extend },
+        { 0xAAB2, 0xAAB4, G::Extend }, { 0xAAB7, 0xAAB8, G::Extend }, { 0xAABE, 0xAABF, G::Extend },
+        { 0xAAC1, 0xAAC1, G::Extend }, { 0xAAEB, 0xAAEB, G::SpacingMark }, { 0xAAEC, 0xAAED, G::Extend },
+        { 0xAAEE, 0xAAEF, G::SpacingMark }, { 0xAAF5, 0xAAF5, G::SpacingMark }, { 0xAAF6, 0xAAF6, G::Extend },
+        { 0xABE3, 0xABE4, G::SpacingMark }, { 0xABE5, 0xABE5, G::Extend }, { 0xABE6, 0xABE7, G::SpacingMark },
+        { 0xABE8, 0xABE8, G::Extend }, { 0xABE9, 0xABEA, G::SpacingMark }, { 0xABEC, 0xABEC, G::SpacingMark },
+        { 0xABED, 0xABED, G::Extend }, { 0xD7B0, 0xD7C6, G::V }, { 0xD7CB, 0xD7FB, G::T },
+        { 0xFB1E, 0xFB1E, G::Extend }, { 0xFE00, 0xFE0F, G::Extend }, { 0xFE20, 0xFE2F, G::Extend },
+        { 0xFEFF, 0xFEFF, G::Control }, { 0xFF9E, 0xFF9F, G::Extend }, { 0xFFF0, 0xFFFB, G::Control },
+        { 0x101FD, 0x101FD, G::Extend }, { 0x102E0, 0x102E0, G::Extend }, { 0x10376, 0x1037A, G::Extend },
+        { 0x10A01, 0x10A03, G::Extend }, { 0x10A05, 0x10A06, G::Extend }, { 0x10A0C, 0x10A0F, G::Extend },
+        { 0x10A38, 0x10A3A, G::Extend }, { 0x10A3F, 0x10A3F, G::Extend }, { 0x10AE5, 0x10AE6, G::Extend },
+        { 0x10D24, 0x10D27, G::Extend }, { 0x10EAB, 0x10EAC, G::Extend }, { 0x10F46, 0x10F50, G::Extend },
+        { 0x10F82, 0x10F85, G::Extend }, { 0x11000, 0x11000, G::SpacingMark }, { 0x11001, 0x11001, G::Extend },
+        { 0x11002, 0x11002, G::SpacingMark }, { 0x11038, 0x11046, G::Extend }, { 0x11070, 0x11070, G::Extend },
+        { 0x11073, 0x11074, G::Extend }, { 0x1107F, 0x11081, G::Extend }, { 0x11082, 0x11082, G::SpacingMark },
+        { 0x110B0, 0x110B2, G::SpacingMark }, { 0x110B3, 0x110B6, G::Extend }, { 0x110B7, 0x110B8, G::SpacingMark },
+        { 0x110B9, 0x110BA, G::Extend }, { 0x110BD, 0x110BD, G::Prepend }, { 0x110C2, 0x110C2, G::Extend },
+        { 0x110CD, 0x110CD, G::Prepend }, { 0x11100, 0x11102, G::Extend }, { 0x11127, 0x1112B, G::Extend },
+        { 0x1112C, 0x1112C, G::SpacingMark }, { 0x1112D, 0x11134, G::Extend }, { 0x11145, 0x11146, G::SpacingMark },
+        { 0x11173, 0x11173, G::Extend }, { 0x11180, 0x11181, G::Extend }, { 0x11182, 0x11182, G::SpacingMark },
+        { 0x111B3, 0x111B5, G::SpacingMark }, { 0x111B6, 0x111BE, G::Extend }, { 0x111BF, 0x111C0, G::SpacingMark },
+        { 0x111C2, 0x111C3, G::Prepend }, { 0x111C9, 0x111CC, G::Extend }, { 0x111CE, 0x111CE, G::SpacingMark },
+        { 0x111CF, 0x111CF, G::Extend }, { 0x1122C, 0x1122E, G::SpacingMark }, { 0x1122F, 0x11231, G::Extend },
+        { 0x11232, 0x11233, G::SpacingMark }, { 0x11234, 0x11234, G::Extend }, { 0x11235, 0x11235, G::SpacingMark },
+        { 0x11236, 0x11237, G::Extend }, { 0x1123E, 0x1123E, G::Extend }, { 0x112DF, 0x112DF, G::Extend },
+        { 0x112E0, 0x112E2, G::SpacingMark }, { 0x112E3, 0x112EA, G::Extend }, { 0x11300, 0x11301, G::Extend },
+        { 0x11302, 0x11303, G::SpacingMark }, { 0x1133B, 0x1133C, G::Extend }, { 0x1133E, 0x1133E, G::Extend },
+        { 0x1133F, 0x1133F, G::SpacingMark }, { 0x11340, 0x11340, G::Extend }, { 0x11341, 0x11344, G::SpacingMark },
+        { 0x11347, 0x11348, G::SpacingMark }, { 0x1134B, 0x1134D, G::SpacingMark }, { 0x11357, 0x11357, G::Extend },
+        { 0x11362, 0x11363, G::SpacingMark }, { 0x11366, 0x1136C, G::Extend }, { 0x11370, 0x11374, G::Extend },
+        { 0x11435, 0x11437, G::SpacingMark }, { 0x11438, 0x1143F, G::Extend }, { 0x11440, 0x11441, G::SpacingMark },
+        { 0x11442, 0x11444, G::Extend }, { 0x11445, 0x11445, G::SpacingMark }, { 0x11446, 0x11446, G::Extend },
+        { 0x1145E, 0x1145E, G::Extend }, { 0x114B0, 0x114B0, G::Extend }, { 0x114B1, 0x114B2, G::SpacingMark },
+        { 0x114B3, 0x114B8, G::Extend }, { 0x114B9, 0x114B9, G::SpacingMark }, { 0x114BA, 0x114BA, G::Extend },
+        { 0x114BB, 0x114BC, G::SpacingMark }, { 0x114BD, 0x114BD, G::Extend }, { 0x114BE, 0x114BE, G::SpacingMark },
+        { 0x114BF, 0x114C0, G::Extend }, { 0x114C1, 0x114C1, G::SpacingMark }, { 0x114C2, 0x114C3, G::Extend },
+        { 0x115AF, 0x115AF, G::Extend }, { 0x115B0, 0x115B1, G::SpacingMark }, { 0x115B2, 0x115B5, G::Extend },
+        { 0x115B8, 0x115BB, G::SpacingMark }, { 0x115BC, 0x115BD, G::Extend }, { 0x115BE, 0x115BE, G::SpacingMark },
+        { 0x115BF, 0x115C0, G::Extend }, { 0x115DC, 0x115DD, G::Extend }, { 0x11630, 0x11632, G::SpacingMark },
+        { 0x11633, 0x1163A, G::Extend }, { 0x1163B, 0x1163C, G::SpacingMark }, { 0x1163D, 0x1163D, G::Extend },
+        { 0x1163E, 0x1163E, G::SpacingMark }, { 0x1163F, 0x11640, G::Extend }, { 0x116AB, 0x116AB, G::Extend },
+        { 0x116AC, 0x116AC, G::SpacingMark }, { 0x116AD, 0x116AD, G::Extend }, { 0x116AE, 0x116AF, G::SpacingMark },
+        { 0x116B0, 0x116B5, G::Extend }, { 0x116B6, 0x116B6, G::SpacingMark }, { 0x116B7, 0x116B7, G::Extend },
+        { 0x1171D, 0x1171F, G::Extend }, { 0x11722, 0x11725, G::Extend }, { 0x11726, 0x11726, G::SpacingMark },
+        { 0x11727, 0x1172B, G::Extend }, { 0x1182C, 0x1182E, G::SpacingMark }, { 0x1182F, 0x11837, G::Extend },
+        { 0x11838, 0x11838, G::SpacingMark }, { 0x11839, 0x1183A, G::Extend }, { 0x11930, 0x11930, G::Extend },
+        { 0x11931, 0x11935, G::SpacingMark }, { 0x11937, 0x11938, G::SpacingMark }, { 0x1193B, 0x1193C, G::Extend },
+        { 0x1193D, 0x1193D, G::SpacingMark }, { 0x1193E, 0x1193E, G::Extend }, { 0x1193F, 0x1193F, G::Prepend },
+        { 0x11940, 0x11940, G::SpacingMark }, { 0x11941, 0x11941, G::Prepend }, { 0x11942, 0x11942, G::SpacingMark },
+        { 0x11943, 0x11943, G::Extend }, { 0x119D1, 0x119D3, G::SpacingMark }, { 0x119D4, 0x119D7, G::Extend },
+        { 0x119DA, 0x119DB, G::Extend }, { 0x119DC, 0x119DF, G::SpacingMark }, { 0x119E0, 0x119E0, G::Extend },
+        { 0x119E4, 0x119E4, G::SpacingMark }, { 0x11A01, 0x11A0A, G::Extend }, { 0x11A33, 0x11A38, G::Extend },
+        { 0x11A39, 0x11A39, G::SpacingMark }, { 0x11A3A, 0x11A3A, G::Prepend }, { 0x11A3B, 0x11A3E, G::Extend },
+        { 0x11A47, 0x11A47, G::Extend }, { 0x11A51, 0x11A56, G::Extend }, { 0x11A57, 0x11A58, G::SpacingMark },
+        { 0x11A59, 0x11A5B, G::Extend }, { 0x11A84, 0x11A89, G::Prepend }, { 0x11A8A, 0x11A96, G::Extend },
+        { 0x11A97, 0x11A97, G::SpacingMark }, { 0x11A98, 0x11A99, G::Extend }, { 0x11C2F, 0x11C2F, G::SpacingMark },
+        { 0x11C30, 0x11C36, G::Extend }, { 0x11C38, 0x11C3D, G::Extend }, { 0x11C3E, 0x11C3E, G::SpacingMark },
+        { 0x11C3F, 0x11C3F, G::Extend }, { 0x11C92, 0x11CA7, G::Extend }, { 0x11CA9, 0x11CA9, G::SpacingMark },
+        { 0x11CAA, 0x11CB0, G::Extend }, { 0x11CB1, 0x11CB1, G::SpacingMark }, { 0x11CB2, 0x11CB3, G::Extend },
+        { 0x11CB4, 0x11CB4, G::SpacingMark }, { 0x11CB5, 0x11CB6, G::Extend }, { 0x11D31, 0x11D36, G::Extend },
+        { 0x11D3A, 0x11D3A, G::Extend }, { 0x11D3C, 0x11D3D, G::Extend }, { 0x11D3F, 0x11D45, G::Extend },
+        { 0x11D46, 0x11D46, G::Prepend }, { 0x11D47, 0x11D47, G::Extend }, { 0x11D8A, 0x11D8E, G::SpacingMark },
+        { 0x11D90, 0x11D91, G::Extend }, { 0x11D93, 0x11D94, G::SpacingMark }, { 0x11D95, 0x11D95, G::Extend },
+        { 0x11D96, 0x11D96, G::SpacingMark }, { 0x11D97, 0x11D97, G::Extend }, { 0x11EF3, 0x11EF4, G::Extend },
+        { 0x11EF5, 0x11EF6, G::SpacingMark }, { 0x13430, 0x13438, G::Control }, { 0x16AF0, 0x16AF4, G::Extend },
+        { 0x16B30, 0x16B36, G::Extend }, { 0x16F4F, 0x16F4F, G::Extend }, { 0x16F51, 0x16F87, G::SpacingMark },
+        { 0x16F8F, 0x16F92, G::Extend }, { 0x16FE4, 0x16FE4, G::Extend }, { 0x16FF0, 0x16FF1, G::SpacingMark },
+        { 0x1BC9D, 0x1BC9E, G::Extend }, { 0x1BCA0, 0x1BCA3, G::Control }, { 0x1CF00, 0x1CF2D, G::Extend },
+        { 0x1CF30, 0x1CF46, G::Extend }, { 0x1D165, 0x1D165, G::Extend }, { 0x1D166, 0x1D166, G::SpacingMark },
+        { 0x1D167, 0x1D169, G::Extend }, { 0x1D16D, 0x1D16D, G::SpacingMark }, { 0x1D16E, 0x1D172, G::Extend },
+        { 0x1D173, 0x1D17A, G::Control }, { 0x1D17B, 0x1D182, G::Extend }, { 0x1D185, 0x1D18B, G::Extend },
+        { 0x1D1AA, 0x1D1AD, G::Extend }, { 0x1D242, 0x1D244, G::Extend }, { 0x1DA00, 0x1DA36, G::Extend },
+        { 0x1DA3B, 0x1DA6C, G::Extend }, { 0x1DA75, 0x1DA75, G::Extend }, { 0x1DA84, 0x1DA84, G::Extend },
+        { 0x1DA9B, 0x1DA9F, G::Extend }, { 0x1DAA1, 0x1DAAF, G::Extend }, { 0x1E000, 0x1E006, G::Extend },
+        { 0x1E008, 0x1E018, G::Extend }, { 0x1E01B, 0x1E021, G::Extend }, { 0x1E023, 0x1E024, G::Extend },
+        { 0x1E026, 0x1E02A, G::Extend }, { 0x1E130, 0x1E136, G::Extend }, { 0x1E2AE, 0x1E2AE, G::Extend },
+        { 0x1E2EC, 0x1E2EF, G::Extend }, { 0x1E8D0, 0x1E8D6, G::Extend }, { 0x1E944, 0x1E94A, G::Extend },
+        { 0x1F000, 0x1F0FF, G::ExtendedPictographic }, { 0x1F10D, 0x1F10F, G::ExtendedPictographic }, { 0x1F12F, 0x1F12F, G::ExtendedPictographic },
+        { 0x1F16C, 0x1F171, G::ExtendedPictographic }, { 0x1F17E, 0x1F17F, G::ExtendedPictographic }, { 0x1F18E, 0x1F18E, G::ExtendedPictographic },
+        { 0x1F191, 0x1F19A, G::ExtendedPictographic }, { 0x1F1AD, 0x1F1E5, G::ExtendedPictographic }, { 0x1F1E6, 0x1F1FF, G::RegionalIndicator },
+        { 0x1F201, 0x1F20F, G::ExtendedPictographic }, { 0x1F21A, 0x1F21A, G::ExtendedPictographic }, { 0x1F22F, 0x1F22F, G::ExtendedPictographic },
+        { 0x1F232, 0x1F23A, G::ExtendedPictographic }, { 0x1F23C, 0x1F23F, G::ExtendedPictographic }, { 0x1F249, 0x1F3FA, G::ExtendedPictographic },
+        { 0x1F3FB, 0x1F3FF, G::Extend }, { 0x1F400, 0x1F53D, G::ExtendedPictographic }, { 0x1F546, 0x1F64F, G::ExtendedPictographic },
+        { 0x1F680, 0x1F6FF, G::ExtendedPictographic }, { 0x1F774, 0x1F77F, G::ExtendedPictographic }, { 0x1F7D5, 0x1F7FF, G::ExtendedPictographic },
+        { 0x1F80C, 0x1F80F, G::ExtendedPictographic }, { 0x1F848, 0x1F84F, G::ExtendedPictographic }, { 0x1F85A, 0x1F85F, G::ExtendedPictographic },
+        { 0x1F888, 0x1F88F, G::ExtendedPictographic }, { 0x1F8AE, 0x1F8FF, G::ExtendedPictographic }, { 0x1F90C, 0x1F93A, G::ExtendedPictographic },
+        { 0x1F93C, 0x1F945, G::ExtendedPictographic }, { 0x1F947, 0x1FAFF, G::ExtendedPictographic }, { 0x1FC00, 0x1FFFD, G::ExtendedPictographic },
+        { 0xE0000, 0xE001F, G::Control }, { 0xE0020, 0xE007F, G::Extend }, { 0xE0080, 0xE00FF, G::Control },
+        { 0xE0100, 0xE01EF, G::Extend }, { 0xE01F0, 0xE0FFF, G::Control },
+    };
+
+    const PropertyRange<LB> LineBreakRanges[] =
+    {
+        { 0x0000, 0x0008, LB::CM }, { 0x0009, 0x0009, LB::BA }, { 0x000A, 0x000A, LB::LF },
+        { 0x000B, 0x000C, LB::BK }, { 0x000D, 0x000D, LB::CR }, { 0x000E, 0x001F, LB::CM },
+        { 0x0020, 0x0020, LB::SP }, { 0x0021, 0x0021, LB::EX }, { 0x0022, 0x0022, LB::QU },
+        { 0x0024, 0x0024, LB::PR }, { 0x0025, 0x0025, LB::PO }, { 0x0027, 0x0027, LB::QU },
+        { 0x0028, 0x0028, LB::OP }, { 0x0029, 0x0029, LB::CP }, { 0x002B, 0x002B, LB::PR },
+        { 0x002C, 0x002C, LB::IS }, { 0x002D, 0x002D, LB::HY }, { 0x002E, 0x002E, LB::IS },
+        { 0x002F, 0x002F, LB::SY }, { 0x0030, 0x0039, LB::NU }, { 0x003A, 0x003B, LB::IS },
+        { 0x003F, 0x003F, LB::EX }, { 0x005B, 0x005B, LB::OP }, { 0x005C, 0x005C, LB::PR },
+        { 0x005D, 0x005D, LB::CP }, { 0x007B, 0x007B, LB::OP }, { 0x007C, 0x007C, LB::BA },
+        { 0x007D, 0x007D, LB::CL }, { 0x007F, 0x0084, LB::CM }, { 0x0085, 0x0085, LB::NL },
+        { 0x0086, 0x009F, LB::CM }, { 0x00A0, 0x00A0, LB::GL }, { 0x00A1, 0x00A1, LB::OP },
+        { 0x00A2, 0x00A2, LB::PO }, { 0x00A3, 0x00A5, LB::PR }, { 0x00AB, 0x00AB, LB::QU },
+        { 0x00AD, 0x00AD, LB::BA }, { 0x00B0, 0x00B0, LB::PO }, { 0x00B1, 0x00B1, LB::PR },
+        { 0x00B4, 0x00B4, LB::BB }, { 0x00BB, 0x00BB, LB::QU }, { 0x00BF, 0x00BF, LB::OP },
+        { 0x02C8, 0x02C8, LB::BB }, { 0x02CC, 0x02CC, LB::BB }, { 0x02DF, 0x02DF, LB::BB },
+        { 0x0300, 0x034E, LB::CM }, { 0x034F, 0x034F, LB::GL }, { 0x0350, 0x035B, LB::CM },
+        { 0x035C, 0x0362, LB::GL }, { 0x0363, 0x036F, LB::CM }, { 0x037E, 0x037E, LB::IS },
+        { 0x0483, 0x0489, LB::CM }, { 0x0589, 0x0589, LB::IS }, { 0x058A, 0x058A, LB::BA },
+        { 0x058F, 0x058F, LB::PR }, { 0x0591, 0x05BD, LB::CM }, { 0x05BE, 0x05BE, LB::BA },
+        { 0x05BF, 0x05BF, LB::CM }, { 0x05C1, 0x05C2, LB::CM }, { 0x05C4, 0x05C5, LB::CM },
+        { 0x05C6, 0x05C6, LB::EX }, { 0x05C7, 0x05C7, LB::CM }, { 0x0609, 0x060B, LB::PO },
+        { 0x060C, 0x060D, LB::IS }, { 0x0610, 0x061A, LB::CM }, { 0x061B, 0x061B, LB::EX },
+        { 0x061C, 0x061C, LB::CM }, { 0x061D, 0x061F, LB::EX }, { 0x064B, 0x065F, LB::CM },
+        { 0x0660, 0x0669, LB::NU }, { 0x066A, 0x066A, LB::PO }, { 0x066B, 0x066C, LB::NU },
+        { 0x0670, 0x0670, LB::CM }, { 0x06D4, 0x06D4, LB::EX }, { 0x06D6, 0x06DC, LB::CM },
+        { 0x06DF, 0x06E4, LB::CM }, { 0x06E7, 0x06E8, LB::CM }, { 0x06EA, 0x06ED, LB::CM },
+        { 0x06F0, 0x06F9, LB::NU }, { 0x0711, 0x0711, LB::CM }, { 0x0730, 0x074A, LB::CM },
+        { 0x07A6, 0x07B0, LB::CM }, { 0x07C0, 0x07C9, LB::NU }, { 0x07EB, 0x07F3, LB::CM },
+        { 0x07F8, 0x07F8, LB::IS }, { 0x07F9, 0x07F9, LB::EX }, { 0x07FD, 0x07FD, LB::CM },
+        { 0x07FE, 0x07FF, LB::PR }, { 0x0816, 0x0819, LB::CM }, { 0x081B, 0x0823, LB::CM },
+        { 0x0825, 0x0827, LB::CM }, { 0x0829, 0x082D, LB::CM }, { 0x0859, 0x085B, LB::CM },
+        { 0x0898, 0x089F, LB::CM }, { 0x08CA, 0x08E1, LB::CM }, { 0x08E3, 0x0903, LB::CM },
+        { 0x093A, 0x093C, LB::CM }, { 0x093E, 0x094F, LB::CM }, { 0x0951, 0x0957, LB::CM },
+        { 0x0962, 0x0963, LB::CM }, { 0x0964, 0x0965, LB::BA }, { 0x0966, 0x096F, LB::NU },
+        { 0x0981, 0x0983, LB::CM }, { 0x09BC, 0x09BC, LB::CM }, { 0x09BE, 0x09C4, LB::CM },
+        { 0x09C7, 0x09C8, LB::CM }, { 0x09CB, 0x09CD, LB::CM }, { 0x09D7, 0x09D7, LB::CM },
+        { 0x09E2, 0x09E3, LB::CM }, { 0x09E6, 0x09EF, LB::NU }, { 0x09F2, 0x09F3, LB::PO },
+        { 0x09F9, 0x09F9, LB::PO }, { 0x09FB, 0x09FB, LB::PR }, { 0x09FE, 0x09FE, LB::CM },
+        { 0x0A01, 0x0A03, LB::CM }, { 0x0A3C, 0x0A3C, LB::CM }, { 0x0A3E, 0x0A42, LB::CM },
+        { 0x0A47, 0x0A48, LB::CM }, { 0x0A4B, 0x0A4D, LB::CM }, { 0x0A51, 0x0A51, LB::CM },
+        { 0x0A66, 0x0A6F, LB::NU }, { 0x0A70, 0x0A71, LB::CM }, { 0x0A75, 0x0A75, LB::CM },
+        { 0x0A81, 0x0A83, LB::CM }, { 0x0ABC, 0x0ABC, LB::CM }, { 0x0ABE, 0x0AC5, LB::CM },
+        { 0x0AC7, 0x0AC9, LB::CM }, { 0x0ACB, 0x0ACD, LB::CM }, { 0x0AE2, 0x0AE3, LB::CM },
+        { 0x0AE6, 0x0AEF, LB::NU }, { 0x0AF1, 0x0AF1, LB::PR }, { 0x0AFA, 0x0AFF, LB::CM },
+        { 0x0B01, 0x0B03, LB::CM }, { 0x0B3C, 0x0B3C, LB::CM }, { 0x0B3E, 0x0B44, LB::CM },
+        { 0x0B47, 0x0B48, LB::CM }, { 0x0B4B, 0x0B4D, LB::CM }, { 0x0B55, 0x0B57, LB::CM },
+        { 0x0B62, 0x0B63, LB::CM }, { 0x0B66, 0x0B6F, LB::NU }, { 0x0B82, 0x0B82, LB::CM },
+        { 0x0BBE, 0x0BC2, LB::CM }, { 0x0BC6, 0x0BC8, LB::CM }, { 0x0BCA, 0x0BCD, LB::CM },
+        { 0x0BD7, 0x0BD7, LB::CM }, { 0x0BE6, 0x0BEF, LB::NU }, { 0x0BF9, 0x0BF9, LB::PR },
+        { 0x0C00, 0x0C04, LB::CM }, { 0x0C3C, 0x0C3C, LB::CM }, { 0x0C3E, 0x0C44, LB::CM },
+        { 0x0C46, 0x0C48, LB::CM }, { 0x0C4A, 0x0C4D, LB::CM }, { 0x0C55, 0x0C56, LB::CM },
+        { 0x0C62, 0x0C63, LB::CM }, { 0x0C66, 0x0C6F, LB::NU }, { 0x0C77, 0x0C77, LB::BB },
+        { 0x0C81, 0x0C83, LB::CM }, { 0x0C84, 0x0C84, LB::BB }, { 0x0CBC, 0x0CBC, LB::CM },
+        { 0x0CBE, 0x0CC4, LB::CM }, { 0x0CC6, 0x0CC8, LB::CM }, { 0x0CCA, 0x0CCD, LB::CM },
+        { 0x0CD5, 0x0CD6, LB::CM }, { 0x0CE2, 0x0CE3, LB::CM }, { 0x0CE6, 0x0CEF, LB::NU },
+        { 0x0D00, 0x0D03, LB::CM }, { 0x0D3B, 0x0D3C, LB::CM }, { 0x0D3E, 0x0D44, LB::CM },
+        { 0x0D46, 0x0D48, LB::CM }, { 0x0D4A, 0x0D4D, LB::CM }, { 0x0D57, 0x0D57, LB::CM },
+        { 0x0D62, 0x0D63, LB::CM }, { 0x0D66, 0x0D6F, LB::NU }, { 0x0D79, 0x0D79, LB::PO },
+        { 0x0D81, 0x0D83, LB::CM }, { 0x0DCA, 0x0DCA, LB::CM }, { 0x0DCF, 0x0DD4, LB::CM },
+        { 0x0DD6, 0x0DD6, LB::CM }, { 0x0DD8, 0x0DDF, LB::CM }, { 0x0DE6, 0x0DEF, LB::NU },
+        { 0x0DF2, 0x0DF3, LB::CM }, { 0x0E31, 0x0E31, LB::CM }, { 0x0E33, 0x0E3A, LB::CM },
+        { 0x0E3F, 0x0E3F, LB::PR }, { 0x0E47, 0x0E4E, LB::CM }, { 0x0E50, 0x0E59, LB::NU },
+        { 0x0E5A, 0x0E5B, LB::BA }, { 0x0EB1, 0x0EB1, LB::CM }, { 0x0EB3, 0x0EBC, LB::CM },
+        { 0x0EC8, 0x0ECD, LB::CM }, { 0x0ED0, 0x0ED9, LB::NU }, { 0x0F01, 0x0F04, LB::BB },
+        { 0x0F06, 0x0F07, LB::BB }, { 0x0F08, 0x0F08, LB::GL }, { 0x0F09, 0x0F0A, LB::BB },
+        { 0x0F0B, 0x0F0B, LB::BA }, { 0x0F0C, 0x0F0C, LB::GL }, { 0x0F0D, 0x0F11, LB::EX },
+        { 0x0F12, 0x0F12, LB::GL }, { 0x0F14, 0x0F14, LB::EX }, { 0x0F18, 0x0F19, LB::CM },
+        { 0x0F20, 0x0F29, LB::NU }, { 0x0F34, 0x0F34, LB::BA }, { 0x0F35, 0x0F35, LB::CM },
+        { 0x0F37, 0x0F37, LB::CM }, { 0x0F39, 0x0F39, LB::CM }, { 0x0F3A, 0x0F3A, LB::OP },
+        { 0x0F3B, 0x0F3B, LB::CL }, { 0x0F3C, 0x0F3C, LB::OP }, { 0x0F3D, 0x0F3D, LB::CL },
+        { 0x0F3E, 0x0F3F, LB::CM }, { 0x0F71, 0x0F7E, LB::CM }, { 0x0F7F, 0x0F7F, LB::BA },
+        { 0x0F80, 0x0F84, LB::CM }, { 0x0F85, 0x0F85, LB::BA }, { 0x0F86, 0x0F87, LB::CM },
+        { 0x0F8D, 0x0F97, LB::CM }, { 0x0F99, 0x0FBC, LB::CM }, { 0x0FBE, 0x0FBF, LB::BA },
+        { 0x0FC6, 0x0FC6, LB::CM }, { 0x0FD0, 0x0FD1, LB::BB }, { 0x0FD2, 0x0FD2, LB::BA },
+        { 0x0FD3, 0x0FD3, LB::BB }, { 0x0FD9, 0x0FDA, LB::GL }, { 0x102D, 0x1037, LB::CM },
+        { 0x1039, 0x103E, LB::CM }, { 0x1040, 0x1049, LB::NU }, { 0x104A, 0x104B, LB::BA },
+        { 0x1056, 0x1059, LB::CM }, { 0x105E, 0x1060, LB::CM }, { 0x1071, 0x1074, LB::CM },
+        { 0x1082, 0x1082, LB::CM }, { 0x1084, 0x1086, LB::CM }, { 0x108D, 0x108D, LB::CM },
+        { 0x1090, 0x1099, LB::NU }, { 0x109D, 0x109D, LB::CM }, { 0x1100, 0x115F, LB::JL },
+        { 0x1160, 0x11A7, LB::JV }, { 0x11A8, 0x11FF, LB::JT }, { 0x135D, 0x135F, LB::CM },
+        { 0x1361, 0x1361, LB::BA }, { 0x1400, 0x1400, LB::BA }, { 0x1680, 0x1680, LB::BA },
+        { 0x169B, 0x169B, LB::OP }, { 0x169C, 0x169C, LB::CL }, { 0x16EB, 0x16ED, LB::BA },
+        { 0x1712, 0x1715, LB::CM }, { 0x1732, 0x1734, LB::CM }, { 0x1735, 0x1736, LB::BA },
+        { 0x1752, 0x1753, LB::CM }, { 0x1772, 0x1773, LB::CM }, { 0x17B4, 0x17D3, LB::CM },
+        { 0x17D4, 0x17D5, LB::BA }, { 0x17D6, 0x17D6, LB::NS }, { 0x17D8, 0x17D8, LB::BA },
+        { 0x17DA, 0x17DA, LB::BA }, { 0x17DB, 0x17DB, LB::PR }, { 0x17DD, 0x17DD, LB::CM },
+        { 0x17E0, 0x17E9, LB::NU }, { 0x1802, 0x1803, LB::EX }, { 0x1804, 0x1805, LB::BA },
+        { 0x1806, 0x1806, LB::BB }, { 0x1808, 0x1809, LB::EX }, { 0x180B, 0x180D, LB::CM },
+        { 0x180E, 0x180E, LB::GL }, { 0x180F, 0x180F, LB::CM }, { 0x1810, 0x1819, LB::NU },
+        { 0x1885, 0x1886, LB::CM }, { 0x18A9, 0x18A9, LB::CM }, { 0x1920, 0x192B, LB::CM },
+        { 0x1930, 0x193B, LB::CM }, { 0x1944, 0x1945, LB::EX }, { 0x1946, 0x194F, LB::NU },
+        { 0x19D0, 0x19D9, LB::NU }, { 0x1A17, 0x1A1B, LB::CM }, { 0x1A55, 0x1A5E, LB::CM },
+        { 0x1A60, 0x1A60, LB::CM }, { 0x1A62, 0x1A62, LB::CM }, { 0x1A65, 0x1A7C, LB::CM },
+        { 0x1A7F, 0x1A7F, LB::CM }, { 0x1A80, 0x1A89, LB::NU }, { 0x1A90, 0x1A99, LB::NU },
+        { 0x1AB0, 0x1ACE, LB::CM }, { 0x1B00, 0x1B04, LB::CM }, { 0x1B34, 0x1B44, LB::CM },
+        { 0x1B50, 0x1B59, LB::NU }, { 0x1B5A, 0x1B5B, LB::BA }, { 0x1B5D, 0x1B60, LB::BA },
+        { 0x1B6B, 0x1B73, LB::CM }, { 0x1B7D, 0x1B7E, LB::BA }, { 0x1B80, 0x1B82, LB::CM },
+        { 0x1BA1, 0x1BAD, LB::CM }, { 0x1BB0, 0x1BB9, LB::NU }, { 0x1BE6, 0x1BF3, LB::CM },
+        { 0x1C24, 0x1C37, LB::CM }, { 0x1C3B, 0x1C3F, LB::BA }, { 0x1C40, 0x1C49, LB::NU },
+        { 0x1C50, 0x1C59, LB::NU }, { 0x1C7E, 0x1C7F, LB::BA }, { 0x1CD0, 0x1CD2, LB::CM },
+        { 0x1CD4, 0x1CE8, LB::CM }, { 0x1CED, 0x1CED, LB::CM }, { 0x1CF4, 0x1CF4, LB::CM },
+        { 0x1CF7, 0x1CF9, LB::CM }, { 0x1DC0, 0x1DFF, LB::CM }, { 0x1FFD, 0x1FFD, LB::BB },
+        { 0x2000, 0x2006, LB::BA }, { 0x2007, 0x2007, LB::GL }, { 0x2008, 0x200A, LB::BA },
+        { 0x200B, 0x200B, LB::ZW }, { 0x200C, 0x200C, LB::CM }, { 0x200D, 0x200D, LB::ZWJ },
+        { 0x200E, 0x200F, LB::CM }, { 0x2010, 0x2010, LB::BA }, { 0x2011, 0x2011, LB::GL },
+        { 0x2012, 0x2013, LB::BA }, { 0x2014, 0x2014, LB::B2 }, { 0x2018, 0x2019, LB::QU },
+        { 0x201A, 0x201A, LB::OP }, { 0x201B, 0x201D, LB::QU }, { 0x201E, 0x201E, LB::OP },
+        { 0x201F, 0x201F, LB::QU }, { 0x2024, 0x2026, LB::IN }, { 0x2027, 0x2027, LB::BA },
+        { 0x2028, 0x2029, LB::BK }, { 0x202A, 0x202E, LB::CM }, { 0x202F, 0x202F, LB::GL },
+        { 0x2030, 0x2037, LB::PO }, { 0x2039, 0x203A, LB::QU }, { 0x203C, 0x203D, LB::NS },
+        { 0x2044, 0x2044, LB::IS }, { 0x2045, 0x2045, LB::OP }, { 0x2046, 0x2046, LB::CL },
+        { 0x2047, 0x2049, LB::NS }, { 0x2056, 0x2056, LB::BA }, { 0x2058, 0x205B, LB::BA },
+        { 0x205D, 0x205F, LB::BA }, { 0x2060, 0x2060, LB::WJ }, { 0x2066, 0x206F, LB::CM },
+        { 0x207D, 0x207D, LB::OP }, { 0x207E, 0x207E, LB::CL }, { 0x208D, 0x208D, LB::OP },
+        { 0x208E, 0x208E, LB::CL }, { 0x20A0, 0x20A6, LB::PR }, { 0x20A7, 0x20A7, LB::PO },
+        { 0x20A8, 0x20B5, LB::PR }, { 0x20B6, 0x20B6, LB::PO }, { 0x20B7, 0x20BA, LB::PR },
+        { 0x20BB, 0x20BB, LB::PO }, { 0x20BC, 0x20BD, LB::PR }, { 0x20BE, 0x20BE, LB::PO },
+        { 0x20BF, 0x20BF, LB::PR }, { 0x20C0, 0x20C0, LB::PO }, { 0x20C1, 0x20CF, LB::PR },
+        { 0x20D0, 0x20F0, LB::CM }, { 0x2103, 0x2103, LB::PO }, { 0x2109, 0x2109, LB::PO },
+        { 0x2116, 0x2116, LB::PR }, { 0x2212, 0x2213, LB::PR }, { 0x22EF, 0x22EF, LB::IN },
+        { 0x2308, 0x2308, LB::OP }, { 0x2309, 0x2309, LB::CL }, { 0x230A, 0x230A, LB::OP },
+        { 0x230B, 0x230B, LB::CL }, { 0x231A, 0x231B, LB::ID }, { 0x2329, 0x2329, LB::OPEastAsian },
+        { 0x232A, 0x232A, LB::CL }, { 0x23F0, 0x23F3, LB::ID }, { 0x2600, 0x2603, LB::ID },
+        { 0x2614, 0x2615, LB::ID }, { 0x2618, 0x2618, LB::ID }, { 0x261A, 0x261C, LB::ID },
+        { 0x261D, 0x261D, LB::EB }, { 0x261E, 0x261F, LB::ID }, { 0x2639, 0x263B, LB::ID },
+        { 0x2668, 0x2668, LB::ID }, { 0x267F, 0x267F, LB::ID }, { 0x26BD, 0x26C8, LB::ID },
+        { 0x26CD, 0x26CD, LB::ID }, { 0x26CF, 0x26D1, LB::ID }, { 0x26D3, 0x26D4, LB::ID },
+        { 0x26D8, 0x26D9, LB::ID }, { 0x26DC, 0x26DC, LB::ID }, { 0x26DF, 0x26E1, LB::ID },
+        { 0x26EA, 0x26EA, LB::ID }, { 0x26F1, 0x26F5, LB::ID }, { 0x26F7, 0x26F8, LB::ID },
+        { 0x26F9, 0x26F9, LB::EB }, { 0x26FA, 0x26FA, LB::ID }, { 0x26FD, 0x2704, LB::ID },
+        { 0x2708, 0x2709, LB::ID }, { 0x270A, 0x270D, LB::EB }, { 0x275B, 0x2760, LB::QU },
+        { 0x2762, 0x2763, LB::EX }, { 0x2764, 0x2764, LB::ID }, { 0x2768, 0x2768, LB::OP },
+        { 0x2769, 0x2769, LB::CL }, { 0x276A, 0x276A, LB::OP }, { 0x276B, 0x276B, LB::CL },
+        { 0x276C, 0x276C, LB::OP }, { 0x276D, 0x276D, LB::CL }, { 0x276E, 0x276E, LB::OP },
+        { 0x276F, 0x276F, LB::CL }, { 0x2770, 0x2770, LB::OP }, { 0x2771, 0x2771, LB::CL },
+        { 0x2772, 0x2772, LB::OP }, { 0x2773, 0x2773, LB::CL }, { 0x2774, 0x2774, LB::OP },
+        { 0x2775, 0x2775, LB::CL }, { 0x27C5, 0x27C5, LB::OP }, { 0x27C6, 0x27C6, LB::CL },
+        { 0x27E6, 0x27E6, LB::OP }, { 0x27E7, 0x27E7, LB::CL }, { 0x27E8, 0x27E8, LB::OP },
+        { 0x27E9, 0x27E9, LB::CL }, { 0x27EA, 0x27EA, LB::OP }, { 0x27EB, 0x27EB, LB::CL },
+        { 0x27EC, 0x27EC, LB::OP }, { 0x27ED, 0x27ED, LB::CL }, { 0x27EE, 0x27EE, LB::OP },
+        { 0x27EF, 0x27EF, LB::CL }, { 0x2983, 0x2983, LB::OP }, { 0x2984, 0x2984, LB::CL },
+        { 0x2985, 0x2985, LB::OP }, { 0x2986, 0x2986, LB::CL }, { 0x2987, 0x2987, LB::OP },
+        { 0x2988, 0x2988, LB::CL }, { 0x2989, 0x2989, LB::OP }, { 0x298A, 0x298A, LB::CL },
+        { 0x298B, 0x298B, LB::OP }, { 0x298C, 0x298C, LB::CL }, { 0x298D, 0x298D, LB::OP },
+        { 0x298E, 0x298E, LB::CL }, { 0x298F, 0x298F, LB::OP }, { 0x2990, 0x2990, LB::CL },
+        { 0x2991, 0x2991, LB::OP }, { 0x2992, 0x2992, LB::CL }, { 0x2993, 0x2993, LB::OP },
+        { 0x2994, 0x2994, LB::CL }, { 0x2995, 0x2995, LB::OP }, { 0x2996, 0x2996, LB::CL },
+        { 0x2997, 0x2997, LB::OP }, { 0x2998, 0x2998, LB::CL }, { 0x29D8, 0x29D8, LB::OP },
+        { 0x29D9, 0x29D9, LB::CL }, { 0x29DA, 0x29DA, LB::OP }, { 0x29DB, 0x29DB, LB::CL },
+        { 0x29FC, 0x29FC, LB::OP }, { 0x29FD, 0x29FD, LB::CL }, { 0x2CEF, 0x2CF1, LB::CM },
+        { 0x2CF9, 0x2CF9, LB::EX }, { 0x2CFA, 0x2CFC, LB::BA }, { 0x2CFE, 0x2CFE, LB::EX },
+        { 0x2CFF, 0x2CFF, LB::BA }, { 0x2D70, 0x2D70, LB::BA }, { 0x2D7F, 0x2D7F, LB::CM },
+        { 0x2DE0, 0x2DFF, LB::CM }, { 0x2E00, 0x2E0D, LB::QU }, { 0x2E0E, 0x2E15, LB::BA },
+        { 0x2E17, 0x2E17, LB::BA }, { 0x2E18, 0x2E18, LB::OP }, { 0x2E19, 0x2E19, LB::BA },
+        { 0x2E1C, 0x2E1D, LB::QU }, { 0x2E20, 0x2E21, LB::QU }, { 0x2E22, 0x2E22, LB::OP },
+        { 0x2E23, 0x2E23, LB::CL }, { 0x2E24, 0x2E24, LB::OP }, { 0x2E25, 0x2E25, LB::CL },
+        { 0x2E26, 0x2E26, LB::OP }, { 0x2E27, 0x2E27, LB::CL }, { 0x2E28, 0x2E28, LB::OP },
+        { 0x2E29, 0x2E29, LB::CL }, { 0x2E2A, 0x2E2D, LB::BA }, { 0x2E2E, 0x2E2E, LB::EX },
+        { 0x2E30, 0x2E31, LB::BA }, { 0x2E33, 0x2E34, LB::BA }, { 0x2E3A, 0x2E3B, LB::B2 },
+        { 0x2E3C, 0x2E3E, LB::BA }, { 0x2E40, 0x2E41, LB::BA }, { 0x2E42, 0x2E42, LB::OP },
+        { 0x2E43, 0x2E4A, LB::BA }, { 0x2E4C, 0x2E4C, LB::BA }, { 0x2E4E, 0x2E4F, LB::BA },
+        { 0x2E53, 0x2E54, LB::EX }, { 0x2E55, 0x2E55, LB::OP }, { 0x2E56, 0x2E56, LB::CL },
+        { 0x2E57, 0x2E57, LB::OP }, { 0x2E58, 0x2E58, LB::CL }, { 0x2E59, 0x2E59, LB::OP },
+        { 0x2E5A, 0x2E5A, LB::CL }, { 0x2E5B, 0x2E5B, LB::OP }, { 0x2E5C, 0x2E5C, LB::CL },
+        { 0x2E5D, 0x2E5D, LB::BA }, { 0x2E80, 0x2E99, LB::ID }, { 0x2E9B, 0x2EF3, LB::ID },
+        { 0x2F00, 0x2FD5, LB::ID }, { 0x2FF0, 0x2FFB, LB::ID }, { 0x3000, 0x3000, LB::BA },
+        { 0x3001, 0x3002, LB::CL }, { 0x3003, 0x3004, LB::ID }, { 0x3005, 0x3005, LB::NS },
+        { 0x3006, 0x3007, LB::ID }, { 0x3008, 0x3008, LB::OPEastAsian }, { 0x3009, 0x3009, LB::CL },
+        { 0x300A, 0x300A, LB::OPEastAsian }, { 0x300B, 0x300B, LB::CL }, { 0x300C, 0x300C, LB::OPEastAsian },
+        { 0x300D, 0x300D, LB::CL }, { 0x300E, 0x300E, LB::OPEastAsian }, { 0x300F, 0x300F, LB::CL },
+        { 0x3010, 0x3010, LB::OPEastAsian }, { 0x3011, 0x3011, LB::CL }, { 0x3012, 0x3013, LB::ID },
+        { 0x3014, 0x3014, LB::OPEastAsian }, { 0x3015, 0x3015, LB::CL }, { 0x3016, 0x3016, LB::OPEastAsian },
+        { 0x3017, 0x3017, LB::CL }, { 0x3018, 0x3018, LB::OPEastAsian }, { 0x3019, 0x3019, LB::CL },
+        { 0x301A, 0x301A, LB::OPEastAsian }, { 0x301B, 0x301B, LB::CL }, { 0x301C, 0x301C, LB::NS },
+        { 0x301D, 0x301D, LB::OPEastAsian }, { 0x301E, 0x301F, LB::CL }, { 0x3020, 0x3029, LB::ID },
+        { 0x302A, 0x302F, LB::CM }, { 0x3030, 0x3034, LB::ID }, { 0x3035, 0x3035, LB::CM },
+        { 0x3036, 0x303A, LB::ID }, { 0x303B, 0x303C, LB::NS }, { 0x303D, 0x303F, LB::ID },
+        { 0x3041, 0x3041, LB::NS }, { 0x3042, 0x3042, LB::ID }, { 0x3043, 0x3043, LB::NS },
+        { 0x3044, 0x3044, LB::ID }, { 0x3045, 0x3045, LB::NS }, { 0x3046, 0x3046, LB::ID },
+        { 0x3047, 0x3047, LB::NS }, { 0x3048, 0x3048, LB::ID }, { 0x3049, 0x3049, LB::NS },
+        { 0x304A, 0x3062, LB::ID }, { 0x3063, 0x3063, LB::NS }, { 0x3064, 0x3082, LB::ID },
+        { 0x3083, 0x3083, LB::NS }, { 0x3084, 0x3084, LB::ID }, { 0x3085, 0x3085, LB::NS },
+        { 0x3086, 0x3086, LB::ID }, { 0x3087, 0x3087, LB::NS }, { 0x3088, 0x308D, LB::ID },
+        { 0x308E, 0x308E, LB::NS }, { 0x308F, 0x3094, LB::ID }, { 0x3095, 0x3096, LB::NS },
+        { 0x3099, 0x309A, LB::CM }, { 0x309B, 0x309E, LB::NS }, { 0x309F, 0x309F, LB::ID },
+        { 0x30A0, 0x30A1, LB::NS }, { 0x30A2, 0x30A2, LB::ID }, { 0x30A3, 0x30A3, LB::NS },
+        { 0x30A4, 0x30A4, LB::ID }, { 0x30A5, 0x30A5, LB::NS }, { 0x30A6, 0x30A6, LB::ID },
+        { 0x30A7, 0x30A7, LB::NS }, { 0x30A8, 0x30A8, LB::ID }, { 0x30A9, 0x30A9, LB::NS },
+        { 0x30AA, 0x30C2, LB::ID }, { 0x30C3, 0x30C3, LB::NS }, { 0x30C4, 0x30E2, LB::ID },
+        { 0x30E3, 0x30E3, LB::NS }, { 0x30E4, 0x30E4, LB::ID }, { 0x30E5, 0x30E5, LB::NS },
+        { 0x30E6, 0x30E6, LB::ID }, { 0x30E7, 0x30E7, LB::NS }, { 0x30E8, 0x30ED, LB::ID },
+        { 0x30EE, 0x30EE, LB::NS }, { 0x30EF, 0x30F4, LB::ID }, { 0x30F5, 0x30F6, LB::NS },
+        { 0x30F7, 0x30FA, LB::ID }, { 0x30FB, 0x30FE, LB::NS }, { 0x30FF, 0x30FF, LB::ID },
+        { 0x3105, 0x312F, LB::ID }, { 0x3131, 0x318E, LB::ID }, { 0x3190, 0x31E3, LB::ID },
+        { 0x31F0, 0x31FF, LB::NS }, { 0x3200, 0x321E, LB::ID }, { 0x3220, 0x3247, LB::ID },
+        { 0x3250, 0x4DBF, LB::ID }, { 0x4E00, 0xA014, LB::ID }, { 0xA015, 0xA015, LB::NS },
+        { 0xA016, 0xA48C, LB::ID }, { 0xA490, 0xA4C6, LB::ID }, { 0xA4FE, 0xA4FF, LB::BA },
+        { 0xA60D, 0xA60D, LB::BA }, { 0xA60E, 0xA60E, LB::EX }, { 0xA60F, 0xA60F, LB::BA },
+        { 0xA620, 0xA629, LB::NU }, { 0xA66F, 0xA672, LB::CM }, { 0xA674, 0xA67D, LB::CM },
+        { 0xA69E, 0xA69F, LB::CM }, { 0xA6F0, 0xA6F1, LB::CM }, { 0xA6F3, 0xA6F7, LB::BA },
+        { 0xA802, 0xA802, LB::CM }, { 0xA806, 0xA806, LB::CM }, { 0xA80B, 0xA80B, LB::CM },
+        { 0xA823, 0xA827, LB::CM }, { 0xA82C, 0xA82C, LB::CM }, { 0xA838, 0xA838, LB::PO },
+        { 0xA874, 0xA875, LB::BB }, { 0xA876, 0xA877, LB::EX }, { 0xA880, 0xA881, LB::CM },
+        { 0xA8B4, 0xA8C5, LB::CM }, { 0xA8CE, 0xA8CF, LB::BA }, { 0xA8D0, 0xA8D9, LB::NU },
+        { 0xA8E0, 0xA8F1, LB::CM }, { 0xA8FC, 0xA8FC, LB::BB }, { 0xA8FF, 0xA8FF, LB::CM },
+        { 0xA900, 0xA909, LB::NU }, { 0xA926, 0xA92D, LB::CM }, { 0xA92E, 0xA92F, LB::BA },
+        { 0xA947, 0xA953, LB::CM }, { 0xA960, 0xA97C, LB::JL }, { 0xA980, 0xA983, LB::CM },
+        { 0xA9B3, 0xA9C0, LB::CM }, { 0xA9C7, 0xA9C9, LB::BA }, { 0xA9D0, 0xA9D9, LB::NU },
+        { 0xA9E5, 0xA9E5, LB::CM }, { 0xA9F0, 0xA9F9, LB::NU }, { 0xAA29, 0xAA36, LB::CM },
+        { 0xAA43, 0xAA43, LB::CM }, { 0xAA4C, 0xAA4D, LB::CM }, { 0xAA50, 0xAA59, LB::NU },
+        { 0xAA5D, 0xAA5F, LB::BA }, { 0xAA7C, 0xAA7C, LB::CM }, { 0xAAB0, 0xAAB0, LB::CM },
+        { 0xAAB2, 0xAAB4, LB::CM }, { 0xAAB7, 0xAAB8, LB::CM }, { 0xAABE, 0xAABF, LB::CM },
+        { 0xAAC1, 0xAAC1, LB::CM }, { 0xAAEB, 0xAAEF, LB::CM }, { 0xAAF0, 0xAAF1, LB::BA },
+        { 0xAAF5, 0xAAF6, LB::CM }, { 0xABE3, 0xABEA, LB::CM }, { 0xABEB, 0xABEB, LB::BA },
+        { 0xABEC, 0xABED, LB::CM }, { 0xABF0, 0xABF9, LB::NU }, { 0xD7B0, 0xD7C6, LB::JV },
+        { 0xD7CB, 0xD7FB, LB::JT }, { 0xF900, 0xFAFF, LB::ID }, { 0xFB1E, 0xFB1E, LB::CM },
+        { 0xFD3E, 0xFD3E, LB::CL }, { 0xFD3F, 0xFD3F, LB::OP }, { 0xFDFC, 0xFDFC, LB::PO },
+        { 0xFE00, 0xFE0F, LB::CM }, { 0xFE10, 0xFE10, LB::IS }, { 0xFE11, 0xFE12, LB::CL },
+        { 0xFE13, 0xFE14, LB::IS }, { 0xFE15, 0xFE16, LB::EX }, { 0xFE17, 0xFE17, LB::OPEastAsian },
+        { 0xFE18, 0xFE18, LB::CL }, { 0xFE19, 0xFE19, LB::IN }, { 0xFE20, 0xFE2F, LB::CM },
+        { 0xFE30, 0xFE34, LB::ID }, { 0xFE35, 0xFE35, LB::OPEastAsian }, { 0xFE36, 0xFE36, LB::CL },
+        { 0xFE37, 0xFE37, LB::OPEastAsian }, { 0xFE38, 0xFE38, LB::CL }, { 0xFE39, 0xFE39, LB::OPEastAsian },
+        { 0xFE3A, 0xFE3A, LB::CL }, { 0xFE3B, 0xFE3B, LB::OPEastAsian }, { 0xFE3C, 0xFE3C, LB::CL },
+        { 0xFE3D, 0xFE3D, LB::OPEastAsian }, { 0xFE3E, 0xFE3E, LB::CL }, { 0xFE3F, 0xFE3F, LB::OPEastAsian },
+        { 0xFE40, 0xFE40, LB::CL }, { 0xFE41, 0xFE41, LB::OPEastAsian }, { 0xFE42, 0xFE42, LB::CL },
+        { 0xFE43, 0xFE43, LB::OPEastAsian }, { 0xFE44, 0xFE44, LB::CL }, { 0xFE45, 0xFE46, LB::ID },
+        { 0xFE47, 0xFE47, LB::OPEastAsian }, { 0xFE48, 0xFE48, LB::CL }, { 0xFE49, 0xFE4F, LB::ID },
+        { 0xFE50, 0xFE50, LB::CL }, { 0xFE51, 0xFE51, LB::ID }, { 0xFE52, 0xFE52, LB::CL },
+        { 0xFE54, 0xFE55, LB::NS }, { 0xFE56, 0xFE57, LB::EX }, { 0xFE58, 0xFE58, LB::ID },
+        { 0xFE59, 0xFE59, LB::OPEastAsian }, { 0xFE5A, 0xFE5A, LB::CL }, { 0xFE5B, 0xFE5B, LB::OPEastAsian },
+        { 0xFE5C, 0xFE5C, LB::CL }, { 0xFE5D, 0xFE5D, LB::OPEastAsian }, { 0xFE5E, 0xFE5E, LB::CL },
+        { 0xFE5F, 0xFE66, LB::ID }, { 0xFE68, 0xFE68, LB::ID }, { 0xFE69, 0xFE69, LB::PR },
+        { 0xFE6A, 0xFE6A, LB::PO }, { 0xFE6B, 0xFE6B, LB::ID }, { 0xFEFF, 0xFEFF, LB::WJ },
+        { 0xFF01, 0xFF01, LB::EX }, { 0xFF02, 0xFF03, LB::ID }, { 0xFF04, 0xFF04, LB::PR },
+        { 0xFF05, 0xFF05, LB::PO }, { 0xFF06, 0xFF07, LB::ID }, { 0xFF08, 0xFF08, LB::OPEastAsian },
+        { 0xFF09, 0xFF09, LB::CL }, { 0xFF0A, 0xFF0B, LB::ID }, { 0xFF0C, 0xFF0C, LB::CL },
+        { 0xFF0D, 0xFF0D, LB::ID }, { 0xFF0E, 0xFF0E, LB::CL }, { 0xFF0F, 0xFF19, LB::ID },
+        { 0xFF1A, 0xFF1B, LB::NS }, { 0xFF1C, 0xFF1E, LB::ID }, { 0xFF1F, 0xFF1F, LB::EX },
+        { 0xFF20, 0xFF3A, LB::ID }, { 0xFF3B, 0xFF3B, LB::OPEastAsian }, { 0xFF3C, 0xFF3C, LB::ID },
+        { 0xFF3D, 0xFF3D, LB::CL }, { 0xFF3E, 0xFF5A, LB::ID }, { 0xFF5B, 0xFF5B, LB::OPEastAsian },
+        { 0xFF5C, 0xFF5C, LB::ID }, { 0xFF5D, 0xFF5D, LB::CL }, { 0xFF5E, 0xFF5E, LB::ID },
+        { 0xFF5F, 0xFF5F, LB::OPEastAsian }, { 0xFF60, 0xFF61, LB::CL }, { 0xFF62, 0xFF62, LB::OPEastAsian },
+        { 0xFF63, 0xFF64, LB::CL }, { 0xFF65, 0xFF65, LB::NS }, { 0xFF66, 0xFF66, LB::ID },
+        { 0xFF67, 0xFF70, LB::NS }, { 0xFF71, 0xFF9D, LB::ID }, { 0xFF9E, 0xFF9F, LB::NS },
+        { 0xFFA0, 0xFFBE, LB::ID }, { 0xFFC2, 0xFFC7, LB::ID }, { 0xFFCA, 0xFFCF, LB::ID },
+        { 0xFFD2, 0xFFD7, LB::ID }, { 0xFFDA, 0xFFDC, LB::ID }, { 0xFFE0, 0xFFE0, LB::PO },
+        { 0xFFE1, 0xFFE1, LB::PR }, { 0xFFE2, 0xFFE4, LB::ID }, { 0xFFE5, 0xFFE6, LB::PR },
+        { 0xFFF9, 0xFFFB, LB::CM }, { 0xFFFC, 0xFFFC, LB::CB }, { 0x10100, 0x10102, LB::BA },
+        { 0x101FD, 0x101FD, LB::CM }, { 0x102E0, 0x102E0, LB::CM }, { 0x10376, 0x1037A, LB::CM },
+        { 0x1039F, 0x1039F, LB::BA }, { 0x103D0, 0x103D0, LB::BA }, { 0x104A0, 0x104A9, LB::NU },
+        { 0x10857, 0x10857, LB::BA }, { 0x1091F, 0x1091F, LB::BA }, { 0x10A01, 0x10A03, LB::CM },
+        { 0x10A05, 0x10A06, LB::CM }, { 0x10A0C, 0x10A0F, LB::CM }, { 0x10A38, 0x10A3A, LB::CM },
+        { 0x10A3F, 0x10A3F, LB::CM }, { 0x10A50, 0x10A57, LB::BA }, { 0x10AE5, 0x10AE6, LB::CM },
+        { 0x10AF0, 0x10AF5, LB::BA }, { 0x10AF6, 0x10AF6, LB::IN }, { 0x10B39, 0x10B3F, LB::BA },
+        { 0x10D24, 0x10D27, LB::CM }, { 0x10D30, 0x10D39, LB::NU }, { 0x10EAB, 0x10EAC, LB::CM },
+        { 0x10EAD, 0x10EAD, LB::BA }, { 0x10F46, 0x10F50, LB::CM }, { 0x10F82, 0x10F85, LB::CM },
+        { 0x11000, 0x11002, LB::CM }, { 0x11038, 0x11046, LB::CM }, { 0x11047, 0x11048, LB::BA },
+        { 0x11066, 0x1106F, LB::NU }, { 0x11070, 0x11070, LB::CM }, { 0x11073, 0x11074, LB::CM },
+        { 0x1107F, 0x11082, LB::CM }, { 0x110B0, 0x110BA, LB::CM }, { 0x110BE, 0x110C1, LB::BA },
+        { 0x110C2, 0x110C2, LB::CM }, { 0x110F0, 0x110F9, LB::NU }, { 0x11100, 0x11102, LB::CM },
+        { 0x11127, 0x11134, LB::CM }, { 0x11136, 0x1113F, LB::NU }, { 0x11140, 0x11143, LB::BA },
+        { 0x11145, 0x11146, LB::CM }, { 0x11173, 0x11173, LB::CM }, { 0x11175, 0x11175, LB::BB },
+        { 0x11180, 0x11182, LB::CM }, { 0x111B3, 0x111C0, LB::CM }, { 0x111C5, 0x111C6, LB::BA },
+        { 0x111C8, 0x111C8, LB::BA }, { 0x111C9, 0x111CC, LB::CM }, { 0x111CE, 0x111CF, LB::CM },
+        { 0x111D0, 0x111D9, LB::NU }, { 0x111DB, 0x111DB, LB::BB }, { 0x111DD, 0x111DF, LB::BA },
+        { 0x1122C, 0x11237, LB::CM }, { 0x11238, 0x11239, LB::BA }, { 0x1123B, 0x1123C, LB::BA },
+        { 0x1123E, 0x1123E, LB::CM }, { 0x112A9, 0x112A9, LB::BA }, { 0x112DF, 0x112EA, LB::CM },
+        { 0x112F0, 0x112F9, LB::NU }, { 0x11300, 0x11303, LB::CM }, { 0x1133B, 0x1133C, LB::CM },
+        { 0x1133E, 0x11344, LB::CM }, { 0x11347, 0x11348, LB::CM }, { 0x1134B, 0x1134D, LB::CM },
+        { 0x11357, 0x11357, LB::CM }, { 0x11362, 0x11363, LB::CM }, { 0x11366, 0x1136C, LB::CM },
+        { 0x11370, 0x11374, LB::CM }, { 0x11435, 0x11446, LB::CM }, { 0x1144B, 0x1144E, LB::BA },
+        { 0x11450, 0x11459, LB::NU }, { 0x1145A, 0x1145B, LB::BA }, { 0x1145E, 0x1145E, LB::CM },
+        { 0x114B0, 0x114C3, LB::CM }, { 0x114D0, 0x114D9, LB::NU }, { 0x115AF, 0x115B5, LB::CM },
+        { 0x115B8, 0x115C0, LB::CM }, { 0x115C1, 0x115C1, LB::BB }, { 0x115C2, 0x115C3, LB::BA },
+        { 0x115C4, 0x115C5, LB::EX }, { 0x115C9, 0x115D7, LB::BA }, { 0x115DC, 0x115DD, LB::CM },
+        { 0x11630, 0x11640, LB::CM }, { 0x11641, 0x11642, LB::BA }, { 0x11650, 0x11659, LB::NU },
+        { 0x11660, 0x1166C, LB::BB }, { 0x116AB, 0x116B7, LB::CM }, { 0x116C0, 0x116C9, LB::NU },
+        { 0x1171D, 0x1171F, LB::CM }, { 0x11722, 0x1172B, LB::CM }, { 0x11730, 0x11739, LB::NU },
+        { 0x1173C, 0x1173E, LB::BA }, { 0x1182C, 0x1183A, LB::CM }, { 0x118E0, 0x118E9, LB::NU },
+        { 0x11930, 0x11935, LB::CM }, { 0x11937, 0x11938, LB::CM }, { 0x1193B, 0x1193E, LB::CM },
+        { 0x11940, 0x11940, LB::CM }, { 0x11942, 0x11943, LB::CM }, { 0x11944, 0x11946, LB::BA },
+        { 0x11950, 0x11959, LB::NU }, { 0x119D1, 0x119D7, LB::CM }, { 0x119DA, 0x119E0, LB::CM },
+        { 0x119E2, 0x119E2, LB::BB }, { 0x119E4, 0x119E4, LB::CM }, { 0x11A01, 0x11A0A, LB::CM },
+        { 0x11A33, 0x11A39, LB::CM }, { 0x11A3B, 0x11A3E, LB::CM }, { 0x11A3F, 0x11A3F, LB::BB },
+        { 0x11A41, 0x11A44, LB::BA }, { 0x11A45, 0x11A45, LB::BB }, { 0x11A47, 0x11A47, LB::CM },
+        { 0x11A51, 0x11A5B, LB::CM }, { 0x11A8A, 0x11A99, LB::CM }, { 0x11A9A, 0x11A9C, LB::BA },
+        { 0x11A9E, 0x11AA0, LB::BB }, { 0x11AA1, 0x11AA2, LB::BA }, { 0x11C2F, 0x11C36, LB::CM },
+        { 0x11C38, 0x11C3F, LB::CM }, { 0x11C41, 0x11C45, LB::BA }, { 0x11C50, 0x11C59, LB::NU },
+        { 0x11C70, 0x11C70, LB::BB }, { 0x11C71, 0x11C71, LB::EX }, { 0x11C92, 0x11CA7, LB::CM },
+        { 0x11CA9, 0x11CB6, LB::CM }, { 0x11D31, 0x11D36, LB::CM }, { 0x11D3A, 0x11D3A, LB::CM },
+        { 0x11D3C, 0x11D3D, LB::CM }, { 0x11D3F, 0x11D45, LB::CM }, { 0x11D47, 0x11D47, LB::CM },
+        { 0x11D50, 0x11D59, LB::NU }, { 0x11D8A, 0x11D8E, LB::CM }, { 0x11D90, 0x11D91, LB::CM },
+        { 0x11D93, 0x11D97, LB::CM }, { 0x11DA0, 0x11DA9, LB::NU }, { 0x11EF3, 0x11EF6, LB::CM },
+        { 0x11FDD, 0x11FE0, LB::PO }, { 0x11FFF, 0x11FFF, LB::BA }, { 0x12470, 0x12474, LB::BA },
+        { 0x13258, 0x1325A, LB::OP }, { 0x1325B, 0x1325D, LB::CL }, { 0x13282, 0x13282, LB::CL },
+        { 0x13286, 0x13286, LB::OP }, { 0x13287, 0x13287, LB::CL }, { 0x13288, 0x13288, LB::OP },
+        { 0x13289, 0x13289, LB::CL }, { 0x13379, 0x13379, LB::OP }, { 0x1337A, 0x1337B, LB::CL },
+        { 0x13430, 0x13436, LB::GL }, { 0x13437, 0x13437, LB::OP }, { 0x13438, 0x13438, LB::CL },
+        { 0x145CE, 0x145CE, LB::OP }, { 0x145CF, 0x145CF, LB::CL }, { 0x16A60, 0x16A69, LB::NU },
+        { 0x16A6E, 0x16A6F, LB::BA }, { 0x16AC0, 0x16AC9, LB::NU }, { 0x16AF0, 0x16AF4, LB::CM },
+        { 0x16AF5, 0x16AF5, LB::BA }, { 0x16B30, 0x16B36, LB::CM }, { 0x16B37, 0x16B39, LB::BA },
+        { 0x16B44, 0x16B44, LB::BA }, { 0x16B50, 0x16B59, LB::NU }, { 0x16E97, 0x16E98, LB::BA },
+        { 0x16F4F, 0x16F4F, LB::CM }, { 0x16F51, 0x16F87, LB::CM }, { 0x16F8F, 0x16F92, LB::CM },
+        { 0x16FE0, 0x16FE3, LB::NS }, { 0x16FE4, 0x16FE4, LB::GL }, { 0x16FF0, 0x16FF1, LB::CM },
+        { 0x17000, 0x187F7, LB::ID }, { 0x18800, 0x18AFF, LB::ID }, { 0x18D00, 0x18D08, LB::ID },
+        { 0x1B000, 0x1B122, LB::ID }, { 0x1B150, 0x1B152, LB::NS }, { 0x1B164, 0x1B167, LB::NS },
+        { 0x1B170, 0x1B2FB, LB::ID }, { 0x1BC9D, 0x1BC9E, LB::CM }, { 0x1BC9F, 0x1BC9F, LB::BA },
+        { 0x1BCA0, 0x1BCA3, LB::CM }, { 0x1CF00, 0x1CF2D, LB::CM }, { 0x1CF30, 0x1CF46, LB::CM },
+        { 0x1D165, 0x1D169, LB::CM }, { 0x1D16D, 0x1D182, LB::CM }, { 0x1D185, 0x1D18B, LB::CM },
+        { 0x1D1AA, 0x1D1AD, LB::CM }, { 0x1D242, 0x1D244, LB::CM }, { 0x1D7CE, 0x1D7FF, LB::NU },
+        { 0x1DA00, 0x1DA36, LB::CM }, { 0x1DA3B, 0x1DA6C, LB::CM }, { 0x1DA75, 0x1DA75, LB::CM },
+        { 0x1DA84, 0x1DA84, LB::CM }, { 0x1DA87, 0x1DA8A, LB::BA }, { 0x1DA9B, 0x1DA9F, LB::CM },
+        { 0x1DAA1, 0x1DAAF, LB::CM }, { 0x1E000, 0x1E006, LB::CM }, { 0x1E008, 0x1E018, LB::CM },
+        { 0x1E01B, 0x1E021, LB::CM }, { 0x1E023, 0x1E024, LB::CM }, { 0x1E026, 0x1E02A, LB::CM },
+        { 0x1E130, 0x1E136, LB::CM }, { 0x1E140, 0x1E149, LB::NU }, { 0x1E2AE, 0x1E2AE, LB::CM },
+        { 0x1E2EC, 0x1E2EF, LB::CM }, { 0x1E2F0, 0x1E2F9, LB::NU }, { 0x1E2FF, 0x1E2FF, LB::PR },
+        { 0x1E8D0, 0x1E8D6, LB::CM }, { 0x1E944, 0x1E94A, LB::CM }, { 0x1E950, 0x1E959, LB::NU },
+        { 0x1E95E, 0x1E95F, LB::OP }, { 0x1ECAC, 0x1ECAC, LB::PO }, { 0x1ECB0, 0x1ECB0, LB::PO },
+        { 0x1F000, 0x1F0FF, LB::ID }, { 0x1F10D, 0x1F10F, LB::ID }, { 0x1F16D, 0x1F16F, LB::ID },
+        { 0x1F1AD, 0x1F1E5, LB::ID }, { 0x1F1E6, 0x1F1FF, LB::RI }, { 0x1F200, 0x1F384, LB::ID },
+        { 0x1F385, 0x1F385, LB::EB }, { 0x1F386, 0x1F39B, LB::ID }, { 0x1F39E, 0x1F3B4, LB::ID },
+        { 0x1F3B7, 0x1F3BB, LB::ID }, { 0x1F3BD, 0x1F3C1, LB::ID }, { 0x1F3C2, 0x1F3C4, LB::EB },
+        { 0x1F3C5, 0x1F3C6, LB::ID }, { 0x1F3C7, 0x1F3C7, LB::EB }, { 0x1F3C8, 0x1F3C9, LB::ID },
+        { 0x1F3CA, 0x1F3CC, LB::EB }, { 0x1F3CD, 0x1F3FA, LB::ID }, { 0x1F3FB, 0x1F3FF, LB::EM },
+        { 0x1F400, 0x1F441, LB::ID }, { 0x1F442, 0x1F443, LB::EB }, { 0x1F444, 0x1F445, LB::ID },
+        { 0x1F446, 0x1F450, LB::EB }, { 0x1F451, 0x1F465, LB::ID }, { 0x1F466, 0x1F478, LB::EB },
+        { 0x1F479, 0x1F47B, LB::ID }, { 0x1F47C, 0x1F47C, LB::EB }, { 0x1F47D, 0x1F480, LB::ID },
+        { 0x1F481, 0x1F483, LB::EB }, { 0x1F484, 0x1F484, LB::ID }, { 0x1F485, 0x1F487, LB::EB },
+        { 0x1F488, 0x1F48E, LB::ID }, { 0x1F48F, 0x1F48F, LB::EB }, { 0x1F490, 0x1F490, LB::ID },
+        { 0x1F491, 0x1F491, LB::EB }, { 0x1F492, 0x1F49F, LB::ID }, { 0x1F4A1, 0x1F4A1, LB::ID },
+        { 0x1F4A3, 0x1F4A3, LB::ID }, { 0x1F4A5, 0x1F4A9, LB::ID }, { 0x1F4AA, 0x1F4AA, LB::EB },
+        { 0x1F4AB, 0x1F4AE, LB::ID }, { 0x1F4B0, 0x1F4B0, LB::ID }, { 0x1F4B3, 0x1F4FF, LB::ID },
+        { 0x1F507, 0x1F516, LB::ID }, { 0x1F525, 0x1F531, LB::ID }, { 0x1F54A, 0x1F573, LB::ID },
+        { 0x1F574, 0x1F575, LB::EB }, { 0x1F576, 0x1F579, LB::ID }, { 0x1F57A, 0x1F57A, LB::EB },
+        { 0x1F57B, 0x1F58F, LB::ID }, { 0x1F590, 0x1F590, LB::EB }, { 0x1F591, 0x1F594, LB::ID },
+        { 0x1F595, 0x1F596, LB::EB }, { 0x1F597, 0x1F5D3, LB::ID }, { 0x1F5DC, 0x1F5F3, LB::ID },
+        { 0x1F5FA, 0x1F644, LB::ID }, { 0x1F645, 0x1F647, LB::EB }, { 0x1F648, 0x1F64A, LB::ID },
+        { 0x1F64B, 0x1F64F, LB::EB }, { 0x1F676, 0x1F678, LB::QU }, { 0x1F679, 0x1F67B, LB::NS },
+        { 0x1F680, 0x1F6A2, LB::ID }, { 0x1F6A3, 0x1F6A3, LB::EB }, { 0x1F6A4, 0x1F6B3, LB::ID },
+        { 0x1F6B4, 0x1F6B6, LB::EB }, { 0x1F6B7, 0x1F6BF, LB::ID }, { 0x1F6C0, 0x1F6C0, LB::EB },
+        { 0x1F6C1, 0x1F6CB, LB::ID }, { 0x1F6CC, 0x1F6CC, LB::EB }, { 0x1F6CD, 0x1F6FF, LB::ID },
+        { 0x1F774, 0x1F77F, LB::ID }, { 0x1F7D5, 0x1F7FF, LB::ID }, { 0x1F80C, 0x1F80F, LB::ID },
+        { 0x1F848, 0x1F84F, LB::ID }, { 0x1F85A, 0x1F85F, LB::ID }, { 0x1F888, 0x1F88F, LB::ID },
+        { 0x1F8AE, 0x1F8FF, LB::ID }, { 0x1F90C, 0x1F90C, LB::EB }, { 0x1F90D, 0x1F90E, LB::ID },
+        { 0x1F90F, 0x1F90F, LB::EB }, { 0x1F910, 0x1F917, LB::ID }, { 0x1F918, 0x1F91F, LB::EB },
+        { 0x1F920, 0x1F925, LB::ID }, { 0x1F926, 0x1F926, LB::EB }, { 0x1F927, 0x1F92F, LB::ID },
+        { 0x1F930, 0x1F939, LB::EB }, { 0x1F93A, 0x1F93B, LB::ID }, { 0x1F93C, 0x1F93E, LB::EB },
+        { 0x1F93F, 0x1F976, LB::ID }, { 0x1F977, 0x1F977, LB::EB }, { 0x1F978, 0x1F9B4, LB::ID },
+        { 0x1F9B5, 0x1F9B6, LB::EB }, { 0x1F9B7, 0x1F9B7, LB::ID }, { 0x1F9B8, 0x1F9B9, LB::EB },
+        { 0x1F9BA, 0x1F9BA, LB::ID }, { 0x1F9BB, 0x1F9BB, LB::EB }, { 0x1F9BC, 0x1F9CC, LB::ID },
+        { 0x1F9CD, 0x1F9CF, LB::EB }, { 0x1F9D0, 0x1F9D0, LB::ID }, { 0x1F9D1, 0x1F9DD, LB::EB },
+        { 0x1F9DE, 0x1F9FF, LB::ID }, { 0x1FA54, 0x1FAC2, LB::ID }, { 0x1FAC3, 0x1FAC5, LB::EB },
+        { 0x1FAC6, 0x1FAEF, LB::ID }, { 0x1FAF0, 0x1FAF6, LB::EB }, { 0x1FAF7, 0x1FAFF, LB::ID },
+        { 0x1FBF0, 0x1FBF9, LB::NU }, { 0x1FC00, 0x1FFFD, LB::ID }, { 0x20000, 0x2FFFD, LB::ID },
+        { 0x30000, 0x3FFFD, LB::ID }, { 0xE0001, 0xE0001, LB::CM }, { 0xE0020, 0xE007F, LB::CM },
+        { 0xE0100, 0xE01EF, LB::CM },
+    };
+
+    const TwoStageTable& GetGraphemeTable()
+    {
+        static const TwoStageTable table = []
+        {
+            std::vector<uint8_t> full(TwoStageTable::CodePointCount, (uint8_t)G::Other);
+            FillRanges(full, GraphemeRanges);
+
+            for (char32_t c = Hangul::SBase; c < Hangul::SBase + Hangul::SCount; c++)
+                full[c] = (uint8_t)(Hangul::IsLVSyllable(c) ? G::LV : G::LVT);
+
+            return TwoStageTable(full);
+        }();
+
+        return table;
+    }
+
+    const TwoStageTable& GetLineBreakTable()
+    {
+        static const TwoStageTable table = []
+        {
+            std::vector<uint8_t> full(TwoStageTable::CodePointCount, (uint8_t)LB::AL);
+            FillRanges(full, LineBreakRanges);
+
+            for (char32_t c = Hangul::SBase; c < Hangul::SBase + Hangul::SCount; c++)
+                full[c] = (uint8_t)(Hangul::IsLVSyllable(c) ? LB::H2 : LB::H3);
+
+            return TwoStageTable(full);
+        }();
+
+        return table;
+    }
+
+    // Grapheme pair rules. The two stateful rules are resolved by the segmenter.
+    enum class GraphemeAction : uint8_t
+    {
+        Break,
+        Join,
+        Emoji,          // GB11: joins if the ZWJ follows ExtPict Extend*
+        RegionalPair,   // GB12/13: joins an odd regional indicator with the next one
+    };
+
+    GraphemeAction GetGraphemeRule(G before, G after)
+    {
+        auto isAnyOf = [](G p, std::initializer_list<G> set) { return std::find(set.begin(), set.end(), p) != set.end(); };
+
+        if (before == G::CR && after == G::LF) return GraphemeAction::Join;                                    // GB3
+        if (isAnyOf(before, { G::Control, G::CR, G::LF })) return GraphemeAction::Break;                      // GB4
+        if (isAnyOf(after, { G::Control, G::CR, G::LF })) return GraphemeAction::Break;                       // GB5
+        if (before == G::L && isAnyOf(after, { G::L, G::V, G::LV, G::LVT })) return GraphemeAction::Join;      // GB6
+        if (isAnyOf(before, { G::LV, G::V }) && isAnyOf(after, { G::V, G::T })) return GraphemeAction::Join;   // GB7
+        if (isAnyOf(before, { G::LVT, G::T }) && after == G::T) return GraphemeAction::Join;                   // GB8
+        if (isAnyOf(after, { G::Extend, G::ZWJ })) return GraphemeAction::Join;                                // GB9
+        if (after == G::SpacingMark) return GraphemeAction::Join;                                              // GB9a
+        if (before == G::Prepend) return GraphemeAction::Join;                                                 // GB9b
+        if (before == G::ZWJ && after == G::ExtendedPictographic) return GraphemeAction::Emoji;               // GB11
+        if (before == G::RegionalIndicator && after == G::RegionalIndicator) return GraphemeAction::RegionalPair;
+        return GraphemeAction::Break;                                                                          // GB999
+    }
+
+    struct GraphemeRules
+    {
+        GraphemeAction actions[(size_t)G::Count][(size_t)G::Count];
+
+        GraphemeRules()
+        {
+            for (size_t before = 0; before < (size_t)G::Count; before++)
+                for (size_t after = 0; after < (size_t)G::Count; after++)
+                    actions[before][after] = GetGraphemeRule((G)before, (G)after);
+        }
+    };
+
+    // Whether a break is allowed between 'before' and 'after' by LB11-LB31, with 'spaces' telling
+    // whether SP came in between. 'before' is SP only for spaces at the start of the text, which
+    // no rule up to LB18 looks at. Hard breaks, SP, ZW, CM and ZWJ (LB4-LB10) and the regional
+    // indicator count are handled by the segmenter.
+    bool IsLineBreakAllowed(LB before, LB after, bool spaces)
+    {
+        auto isAnyOf = [](LB c, std::initializer_list<LB> set) { return std::find(set.begin(), set.end(), c) != set.end(); };
+
+        // LB30 is the only rule that tells the East Asian OP apart
+        bool afterOpen = isAnyOf(after, { LB::OP, LB::OPEastAsian });
+
+        if (after == LB::WJ || (before == LB::WJ && !spaces)) return false;                                // LB11
+        if (before == LB::GL && !spaces) return false;                                                     // LB12
+        if (after == LB::GL && !spaces && !isAnyOf(before, { LB::BA, LB::HY })) return false;             // LB12a
+        if (isAnyOf(after, { LB::CL, LB::CP, LB::EX, LB::IS, LB::SY })) return false;                      // LB13
+        if (isAnyOf(before, { LB::OP, LB::OPEastAsian })) return false;                                    // LB14
+        if (before == LB::QU && afterOpen) return false;                                                   // LB15
+        if (isAnyOf(before, { LB::CL, LB::CP }) && after == LB::NS) return false;                          // LB16
+        if (before == LB::B2 && after == LB::B2) return false;                                             // LB17
+        if (spaces) return true;                                                                           // LB18
+        if (before == LB::QU || after == LB::QU) return false;                                             // LB19
+        if (before == LB::CB || after == LB::CB) return true;                                              // LB20
+        if (isAnyOf(after, { LB::BA, LB::HY, LB::NS }) || before == LB::BB) return false;                  // LB21
+        if (after == LB::IN) return false;                                                                 // LB22
+        if ((before == LB::AL && after == LB::NU) || (before == LB::NU && after == LB::AL)) return false;  // LB23
+        if (before == LB::PR && isAnyOf(after, { LB::ID, LB::EB, LB::EM })) return false;                  // LB23a
+        if (isAnyOf(before, { LB::ID, LB::EB, LB::EM }) && after == LB::PO) return false;
+        if (isAnyOf(before, { LB::PR, LB::PO }) && after == LB::AL) return false;                          // LB24
+        if (before == LB::AL && isAnyOf(after, { LB::PR, LB::PO })) return false;
+
+        // LB25, the simplified pair form
+        if (isAnyOf(before, { LB::CL, LB::CP, LB::NU }) && isAnyOf(after, { LB::PO, LB::PR })) return false;
+        if (isAnyOf(before, { LB::PO, LB::PR }) && (afterOpen || after == LB::NU)) return false;
+        if (isAnyOf(before, { LB::HY, LB::IS, LB::NU, LB::SY }) && after == LB::NU) return false;
+
+        if (before == LB::JL && isAnyOf(after, { LB::JL, LB::JV, LB::H2, LB::H3 })) return false;          // LB26
+        if (isAnyOf(before, { LB::JV, LB::H2 }) && isAnyOf(after, { LB::JV, LB::JT })) return false;
+        if (isAnyOf(before, { LB::JT, LB::H3 }) && after == LB::JT) return false;
+        if (isAnyOf(before, { LB::JL, LB::JV, LB::JT, LB::H2, LB::H3 }) && after == LB::PO) return false;  // LB27
+        if (before == LB::PR && isAnyOf(after, { LB::JL, LB::JV, LB::JT, LB::H2, LB::H3 })) return false;
+        if (before == LB::AL && after == LB::AL) return false;                                             // LB28
+        if (before == LB::IS && after == LB::AL) return false;                                             // LB29
+        if (isAnyOf(before, { LB::AL, LB::NU }) && after == LB::OP) return false;                          // LB30
+        if (before == LB::CP && isAnyOf(after, { LB::AL, LB::NU })) return false;
+        if (before == LB::RI && after == LB::RI) return false;                                             // LB30a
+        if (before == LB::EB && after == LB::EM) return false;                                             // LB30b
+        return true;                                                                                       // LB31
+    }
+
+    struct LineBreakRules
+    {
+        bool allowed[2][(size_t)LB::Count][(size_t)LB::Count];
+
+        LineBreakRules()
+        {
+            for (int spaces = 0; spaces < 2; spaces++)
+                for (size_t before = 0; before < (size_t)LB::Count; before++)
+                    for (size_t after = 0; after < (size_t)LB::Count; after++)
+                        allowed[spaces][before][after] = IsLineBreakAllowed((LB)before, (LB)after, spaces != 0);
+        }
+    };
+
+    bool IsHardBreak(LB c)
+    {
+        return c == LB::BK || c == LB::CR || c == LB::LF || c == LB::NL;
+    }
+}
+
+GraphemeBreakProperty GetGraphemeBreakProperty(char32_t c)
+{
+    return (G)GetGraphemeTable().Get(c);
+}
+
+LineBreakClass GetLineBreakClass(char32_t c)
+{
+    return (LB)GetLineBreakTable().Get(c);
+}
+
+void FindGraphemeBoundaries(std::u16string_view text, uint8_t* flags)
+{
+    static const GraphemeRules rules;
+    const TwoStageTable& table = GetGraphemeTable();
+
+    flags[text.size()] |= TextBreakGrapheme;
+    if (text.empty()) return;
+
+    enum class EmojiState { None, Pictographic, PictographicZwj };
+    EmojiState emoji = EmojiState::None;
+    size_t regionalCount = 0;   // regional indicators right before the current code point
+
+    G before = G::Other;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        size_t start = i;
+        G after = (G)table.Get(DecodeUtf16(text, i));
+
+        bool boundary = true;
+        if (start > 0)
+        {
+            switch (rules.actions[(size_t)before][(size_t)after])
+            {
+            case GraphemeAction::Break: boundary = true; break;
+            case GraphemeAction::Join: boundary = false; break;
+            case GraphemeAction::Emoji: boundary = emoji != EmojiState::PictographicZwj; break;
+            case GraphemeAction::RegionalPair: boundary = regionalCount % 2 == 0; break;
+            }
+        }
+
+        if (boundary) flags[start] |= TextBreakGrapheme;
+
+        switch (after)
+        {
+        case G::ExtendedPictographic: emoji = EmojiState::Pictographic; break;
+        case G::Extend: if (emoji != EmojiState::Pictographic) emoji = EmojiState::None; break;
+        case G::ZWJ: emoji = emoji == EmojiState::Pictographic ? EmojiState::PictographicZwj : EmojiState::None; break;
+        default: emoji = EmojiState::None; break;
+        }
+
+        regionalCount = after == G::RegionalIndicator ? regionalCount + 1 : 0;
+        before = after;
+    }
+}
+
+void FindLineBreaks(std::u16string_view text, uint8_t* flags)
+{
+    static const LineBreakRules rules;
+    const TwoStageTable& table = GetLineBreakTable();
+
+    // LB3: always break at the end
+    flags[text.size()] |= TextBreakLine;
+
+    LB previous = LB::WJ;       // class of the previous code point as it appeared
+    LB before = LB::WJ;         // class of the last code point that is not SP, after LB9/LB10
+    bool atStart = true;        // LB2: only spaces so far
+    bool spaces = false;
+    bool afterZeroWidthSpace = false;
+    size_t regionalCount = 0;
+
+    size_t i = 0;
+    while (i < text.size())
+    {
+        size_t start = i;
+        LB after = (LB)table.Get(DecodeUtf16(text, i));
+        LB original = after;
+
+        bool breakAllowed;
+        bool absorbed = false;
+
+        if (IsHardBreak(previous) && !(previous == LB::CR && after == LB::LF))
+        {
+            // LB4, LB5: the next line starts like the text does
+            flags[start] |= TextBreakLine | TextBreakLineMandatory;
+            previous = original;
+            before = after == LB::CM || after == LB::ZWJ ? LB::AL : after;
+            atStart = after == LB::SP;
+            spaces = after == LB::SP;
+            afterZeroWidthSpace = after == LB::ZW;
+            regionalCount = after == LB::RI ? 1 : 0;
+            continue;
+        }
+
+        if (IsHardBreak(after) || after == LB::SP || after == LB::ZW)
+        {
+            breakAllowed = false;                                       // LB6, LB7
+        }
+        else if (afterZeroWidthSpace)
+        {
+            breakAllowed = true;                                        // LB8
+            if (after == LB::CM || after == LB::ZWJ) after = LB::AL;    // LB10
+        }
+        else if (previous == LB::ZWJ)
+        {
+            breakAllowed = false;                                       // LB8a
+            absorbed = after == LB::CM || after == LB::ZWJ;
+        }
+        else if ((after == LB::CM || after == LB::ZWJ) && !atStart && !spaces)
+        {
+            breakAllowed = false;                                       // LB9: takes the class of its base
+            absorbed = true;
+        }
+        else
+        {
+            if (after == LB::CM || after == LB::ZWJ) after = LB::AL;    // LB10
+
+            // LB2; after leading spaces there is no class before them, and of the rules up to
+            // LB18 only those on 'after' alone can keep them together with what follows
+            if (atStart)
+                breakAllowed = spaces && rules.allowed[true][(size_t)LB::SP][(size_t)after];
+            else if (before == LB::RI && after == LB::RI && !spaces)
+                breakAllowed = regionalCount % 2 == 0;                  // LB30a
+            else
+                breakAllowed = rules.allowed[spaces][(size_t)before][(size_t)after];
+        }
+
+        if (breakAllowed && start > 0) flags[start] |= TextBreakLine;
+
+        previous = original;
+        if (after == LB::SP)
+        {
+            spaces = true;
+        }
+        else if (!absorbed)
+        {
+            before = after;
+            atStart = false;
+            spaces = false;
+            afterZeroWidthSpace = after == LB::ZW;
+            regionalCount = after == LB::RI ? regionalCount + 1 : 0;
+        }
+    }
+}
+
+void AnalyzeTextBreaks(std::u16string_view text, std::vector<uint8_t>& flags)
+{
+    flags.assign(text.size() + 1, TextBreakNone);
+    FindGraphemeBoundaries(text, flags.data());
+    FindLineBreaks(text, flags.data());
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Grapheme_Cluster_Break values (UAX #29), with Extended_Pictographic folded in as one more value
+enum class GraphemeBreakProperty : uint8_t
+{
+    Other,
+    CR,
+    LF,
+    Control,
+    Extend,
+    ZWJ,
+    RegionalIndicator,
+    Prepend,
+    SpacingMark,
+    L,
+    V,
+    T,
+    LV,
+    LVT,
+    ExtendedPictographic,
+    Count,
+};
+
+// Line_Break classes (UAX #14) after the LB1 resolution: AI, SG, XX and non-mark SA resolve to
+// AL, marks of SA scripts to CM, CJ to NS. HL is treated as AL. Names follow the UAX, except for
+// OPEastAsian: OP of East_Asian_Width F, W or H, which LB30 leaves out. No CP has those widths.
+enum class LineBreakClass : uint8_t
+{
+    AL, BK, CR, LF, NL, SP, ZW, WJ, GL, CM, ZWJ,
+    OP, CL, CP, QU, EX, IS, SY, NU, PR, PO, NS, ID, IN,
+    HY, BA, BB, B2, CB, H2, H3, JL, JV, JT, RI, EB, EM,
+    OPEastAsian,
+    Count,
+};
+
+// Per code unit flags, set on the unit a boundary is in front of
+enum TextBreak : uint8_t
+{
+    TextBreakNone = 0,
+    TextBreakGrapheme = 1 << 0,         // starts a grapheme cluster (caret stop)
+    TextBreakLine = 1 << 1,             // a line may break before this unit
+    TextBreakLineMandatory = 1 << 2,    // a line must break before this unit (after BK, CR, LF, NL)
+};
+
+// Property lookups go through two-stage tables: the high bits of the code point select a
+// 256-entry block, identical blocks are stored once. The tables are built on first use from range
+// lists generated from the Unicode 14.0 data files.
+GraphemeBreakProperty GetGraphemeBreakProperty(char32_t c);
+LineBreakClass GetLineBreakClass(char32_t c);
+
+// Segmenters over a whole run. Both run one state machine over the code points, with the pair
+// rules precomputed into a table, and OR their flags into flags[0 .. text.size()], so 'flags'
+// must hold text.size() + 1 entries; index text.size() stands for the end of the text.
+//
+// Grapheme clusters follow the extended cluster rules GB1-GB13 (no GB9c).
+// Line breaks follow LB1-LB31, without dictionary breaking for SA scripts and with the
+// simplified LB25 number rule; the start of the text is never a break, the end always is.
+void FindGraphemeBoundaries(std::u16string_view text, uint8_t* flags);
+void FindLineBreaks(std::u16string_view text, uint8_t* flags);
+
+// Resizes flags to text.size() + 1 and fills in both kinds of boundaries
+void AnalyzeTextBreaks(std::u16string_view text, std::vector<uint8_t>& flags);
@@ -0,0 +1,388 @@
+#include "TextDocument.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Utf.h"
+
+namespace
+{
+    constexpr size_t ShapingCacheBudget = 4 * 1024 * 1024;
+}
+
+TextDocument::TextDocument(const FontFace& face, float fontSize, float maxWidth, uint32_t features)
+    : format { &face, fontSize, maxWidth, features }
+    , shapingCache(ShapingCacheBudget)
+    , nodes(1)
+    , root(Nil)
+    , seed(0x9E3779B9)
+    , lastEdit {}
+{
+    SetText({});
+}
+
+uint32_t TextDocument::NewNode(std::u16string_view text)
+{
+    uint32_t node;
+    if (!freeNodes.empty())
+    {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else
+    {
+        node = (uint32_t)nodes.size();
+        nodes.emplace_back();
+    }
+
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    Node& n = nodes[node];
+    n.left = Nil;
+    n.right = Nil;
+    n.priority = seed;
+    n.text.assign(text);
+
+    LayoutNode(node);
+    return node;
+}
+
+void TextDocument::FreeTree(uint32_t tree)
+{
+    if (tree == Nil) return;
+
+    FreeTree(nodes[tree].left);
+    FreeTree(nodes[tree].right);
+
+    Node& n = nodes[tree];
+    std::u16string().swap(n.text);
+    n.layout = {};
+    freeNodes.push_back(tree);
+}
+
+void TextDocument::Update(uint32_t node)
+{
+    Node& n = nodes[node];
+    const Node& l = nodes[n.left];
+    const Node& r = nodes[n.right];
+
+    n.count = l.count + 1 + r.count;
+    n.length = l.length + n.text.size() + 1 + r.length;
+    n.height = l.height + n.layout.height + r.height;
+}
+
+void TextDocument::LayoutNode(uint32_t node)
+{
+    Node& n = nodes[node];
+    LayoutParagraph(shapingCache, format, n.text, n.layout);
+    n.layout.textStart = 0;
+    Update(node);
+}
+
+uint32_t TextDocument::Merge(uint32_t left, uint32_t right)
+{
+    if (left == Nil) return right;
+    if (right == Nil) return left;
+
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        uint32_t merged = Merge(nodes[left].right, right);
+        nodes[left].right = merged;
+        Update(left);
+        return left;
+    }
+    else
+    {
+        uint32_t merged = Merge(left, nodes[right].left);
+        nodes[right].left = merged;
+        Update(right);
+        return right;
+    }
+}
+
+// left gets the first 'count' paragraphs of the tree, right gets the rest
+void TextDocument::Split(uint32_t tree, size_t count, uint32_t& left, uint32_t& right)
+{
+    if (tree == Nil)
+    {
+        left = right = Nil;
+        return;
+    }
+
+    size_t leftCount = nodes[nodes[tree].left].count;
+    if (count <= leftCount)
+    {
+        uint32_t l, r;
+        Split(nodes[tree].left, count, l, r);
+        nodes[tree].left = r;
+        Update(tree);
+        left = l;
+        right = tree;
+    }
+    else
+    {
+        uint32_t l, r;
+        Split(nodes[tree].right, count - leftCount - 1, l, r);
+        nodes[tree].right = l;
+        Update(tree);
+        left = tree;
+        right = r;
+    }
+}
+
+uint32_t TextDocument::BuildTree(std::u16string_view text, uint32_t& paragraphCount)
+{
+    uint32_t tree = Nil;
+    paragraphCount = 0;
+
+    ForEachParagraph(text, [&](size_t start, size_t length)
+    {
+        uint32_t node = NewNode(text.substr(start, length));
+        tree = Merge(tree, node);
+        paragraphCount++;
+    });
+
+    return tree;
+}
+
+uint32_t TextDocument::FindNode(size_t index) const
+{
+    uint32_t node = root;
+    while (true)
+    {
+        const Node& n = nodes[node];
+        size_t leftCount = nodes[n.left].count;
+
+        if (index < leftCount)
+        {
+            node = n.left;
+        }
+        else if (index == leftCount || n.right == Nil)
+        {
+            return node;
+        }
+        else
+        {
+            index -= leftCount + 1;
+            node = n.right;
+        }
+    }
+}
+
+void TextDocument::SetText(std::u16string_view text)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    uint32_t removed = nodes[root].count;
+    FreeTree(root);
+
+    uint32_t count;
+    root = BuildTree(text, count);
+
+    auto end = std::chrono::steady_clock::now();
+    lastEdit = { removed, count, std::chrono::duration<double, std::micro>(end - start).count() };
+}
+
+bool TextDocument::SetTextUtf8(std::string_view text, size_t* errorOffset)
+{
+    std::u16string converted;
+    if (!Utf8ToUtf16(text, converted, errorOffset)) return false;
+
+    SetText(converted);
+    return true;
+}
+
+void TextDocument::Replace(size_t offset, size_t length, std::u16string_view text)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    size_t total = GetLength();
+    offset = std::min(offset, total);
+    length = std::min(length, total - offset);
+
+    size_t first = FindParagraph(offset);
+    size_t last = FindParagraph(offset + length);
+
+    // the touched paragraphs are rebuilt from their untouched head and tail plus the new text
+    std::u16string combined;
+    {
+        const std::u16string& firstText = nodes[FindNode(first)].text;
+        const std::u16string& lastText = nodes[FindNode(last)].text;
+        size_t head = offset - GetParagraphStart(first);
+        size_t tail = offset + length - GetParagraphStart(last);
+
+        combined.reserve(head + text.size() + lastText.size() - tail);
+        combined.append(firstText, 0, head);
+        combined.append(text);
+        combined.append(lastText, tail);
+    }
+
+    uint32_t before, touched, after;
+    Split(root, first, before, touched);
+    Split(touched, last - first + 1, touched, after);
+
+    uint32_t removed = nodes[touched].count;
+    FreeTree(touched);
+
+    uint32_t count;
+    uint32_t middle = BuildTree(combined, count);
+    root = Merge(Merge(before, middle), after);
+
+    auto end = std::chrono::steady_clock::now();
+    lastEdit = { removed, count, std::chrono::duration<double, std::micro>(end - start).count() };
+}
+
+void TextDocument::SetMaxWidth(float maxWidth)
+{
+    if (format.maxWidth == maxWidth) return;
+    format.maxWidth = maxWidth;
+
+    // children first, so the sums are right when the parent updates
+    auto relayout = [this](auto& self, uint32_t node) -> void
+    {
+        if (node == Nil) return;
+
+        self(self, nodes[node].left);
+        self(self, nodes[node].right);
+        LayoutNode(node);
+    };
+    relayout(relayout, root);
+}
+
+size_t TextDocument::GetLength() const
+{
+    // no separator after the last paragraph
+    return (size_t)nodes[root].length - 1;
+}
+
+std::u16string TextDocument::GetText() const
+{
+    std::u16string text;
+    text.reserve(GetLength());
+
+    auto append = [&](auto& self, uint32_t node) -> void
+    {
+        if (node == Nil) return;
+
+        self(self, nodes[node].left);
+        text.append(nodes[node].text);
+        text.push_back(u'\n');
+        self(self, nodes[node].right);
+    };
+    append(append, root);
+
+    text.pop_back();
+    return text;
+}
+
+size_t TextDocument::GetParagraphStart(size_t index) const
+{
+    size_t start = 0;
+    uint32_t node = root;
+    while (node != Nil)
+    {
+        const Node& n = nodes[node];
+        size_t leftCount = nodes[n.left].count;
+
+        if (index < leftCount)
+        {
+            node = n.left;
+        }
+        else
+        {
+            start += nodes[n.left].length;
+            if (index == leftCount) break;
+
+            start += n.text.size() + 1;
+            index -= leftCount + 1;
+            node = n.right;
+        }
+    }
+
+    return start;
+}
+
+float TextDocument::GetParagraphTop(size_t index) const
+{
+    double top = 0.0;
+    uint32_t node = root;
+    while (node != Nil)
+    {
+        const Node& n = nodes[node];
+        size_t leftCount = nodes[n.left].count;
+
+        if (index < leftCount)
+        {
+            node = n.left;
+        }
+        else
+        {
+            top += nodes[n.left].height;
+            if (index == leftCount) break;
+
+            top += n.layout.height;
+            index -= leftCount + 1;
+            node = n.right;
+        }
+    }
+
+    return (float)top;
+}
+
+size_t TextDocument::FindParagraph(size_t offset) const
+{
+    size_t index = 0;
+    uint32_t node = root;
+    while (true)
+    {
+        const Node& n = nodes[node];
+        const Node& l = nodes[n.left];
+
+        if (offset < l.length)
+        {
+            node = n.left;
+            continue;
+        }
+
+        offset -= (size_t)l.length;
+        index += l.count;
+
+        if (offset <= n.text.size() || n.right == Nil)
+            return index;
+
+        offset -= n.text.size() + 1;
+        index++;
+        node = n.right;
+    }
+}
+
+size_t TextDocument::FindParagraphAtY(float y) const
+{
+    double remaining = y;
+    size_t index = 0;
+    uint32_t node = root;
+    while (true)
+    {
+        const Node& n = nodes[node];
+        const Node& l = nodes[n.left];
+
+        if (remaining < l.height)
+        {
+            node = n.left;
+            continue;
+        }
+
+        remaining -= l.height;
+        index += l.count;
+
+        if (remaining < n.layout.height || n.right == Nil)
+            return index;
+
+        remaining -= n.layout.height;
+        index++;
+        node = n.right;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "TextLayout.h"
+
+struct TextEditStats
+{
+    uint32_t paragraphsRemoved;
+    uint32_t paragraphsLaidOut;
+    double microseconds;        // whole edit, including shaping and line breaking
+};
+
+// Editable text store for large documents.
+// Paragraphs are the leaves of a rope (an implicit treap ordered by position), and each keeps its
+// own ParagraphLayout. Subtrees carry text length and height sums, so offset and y lookups are
+// O(log n), and an edit only re-shapes and re-breaks the paragraphs it touches.
+//
+// Offsets are in UTF-16 code units and count one unit for each '\n' between paragraphs.
+// ParagraphLayout::textStart is left at 0; use GetParagraphStart for the document offset.
+class TextDocument
+{
+    struct Node
+    {
+        uint32_t left;
+        uint32_t right;
+        uint32_t priority;
+        uint32_t count;         // paragraphs in the subtree
+        uint64_t length;        // text + one separator per paragraph in the subtree
+        double height;          // subtree height
+        std::u16string text;
+        ParagraphLayout layout;
+    };
+
+    static constexpr uint32_t Nil = 0; // nodes[0] is a sentinel
+
+    LayoutFormat format;
+    ShapingCache shapingCache;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    uint32_t root;
+    uint32_t seed;
+
+    TextEditStats lastEdit;
+
+public:
+    TextDocument(const FontFace& face, float fontSize, float maxWidth, uint32_t features = ShapingFeatureKerning);
+
+    void SetText(std::u16string_view text);
+    bool SetTextUtf8(std::string_view text, size_t* errorOffset = nullptr);
+
+    // Replaces [offset, offset + length) with text. Out of range values are clamped.
+    void Replace(size_t offset, size_t length, std::u16string_view text);
+    void Insert(size_t offset, std::u16string_view text) { Replace(offset, 0, text); }
+    void Erase(size_t offset, size_t length) { Replace(offset, length, {}); }
+
+    // Re-lays out every paragraph, for format changes
+    void SetMaxWidth(float maxWidth);
+
+    size_t GetLength() const;
+    size_t GetParagraphCount() const { return nodes[root].count; }
+    float GetHeight() const { return (float)nodes[root].height; }
+    std::u16string GetText() const;
+
+    std::u16string_view GetParagraphText(size_t index) const { return nodes[FindNode(index)].text; }
+    const ParagraphLayout& GetParagraphLayout(size_t index) const { return nodes[FindNode(index)].layout; }
+
+    size_t GetParagraphStart(size_t index) const;
+    float GetParagraphTop(size_t index) const;
+
+    // Index of the paragraph containing the offset (a separator belongs to the paragraph before it)
+    size_t FindParagraph(size_t offset) const;
+
+    // Index of the paragraph at y; y past the end maps to the last paragraph
+    size_t FindParagraphAtY(float y) const;
+
+    const TextEditStats& GetLastEditStats() const { return lastEdit; }
+    ShapingCache& GetShapingCache() { return shapingCache; }
+    const LayoutFormat& GetFormat() const { return format; }
+
+private:
+    uint32_t NewNode(std::u16string_view text);
+    void FreeTree(uint32_t tree);
+    void Update(uint32_t node);
+    void LayoutNode(uint32_t node);
+
+    uint32_t Merge(uint32_t left, uint32_t right);
+    void Split(uint32_t tree, size_t count, uint32_t& left, uint32_t& right);
+    uint32_t BuildTree(std::u16string_view text, uint32_t& paragraphCount);
+
+    uint32_t FindNode(size_t index) const;
+};
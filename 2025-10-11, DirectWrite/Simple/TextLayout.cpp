@@ -0,0 +1,222 @@
+#include "TextLayout.h"
+
+#include "TextBreak.h"
+#include "Utf.h"
+
+namespace
+{
+    // the shaping cache only needs to hold the paragraphs of a few frames
+    constexpr size_t ShapingCacheBudget = 4 * 1024 * 1024;
+    constexpr size_t SharedShapingCacheBudget = 16 * 1024 * 1024;
+
+    // paragraphs per chunk handed to a worker
+    constexpr size_t ParallelGrain = 64;
+
+    bool IsSpace(char16_t c)
+    {
+        return c == u' ' || c == u'\t' || c == 0x3000;
+    }
+}
+
+float GetLineHeight(const LayoutFormat& format)
+{
+    FontMetrics metrics = format.face->GetMetrics();
+    return (metrics.ascent + metrics.descent + metrics.lineGap) * format.fontSize / metrics.designUnitsPerEm;
+}
+
+void LayoutParagraph(ShapingCache& cache, const LayoutFormat& format, std::u16string_view text, ParagraphLayout& out)
+{
+    const ShapedRun& run = cache.Shape(*format.face, format.fontSize, text, format.features);
+
+    std::vector<ShapedGlyph>& glyphs = out.glyphs;
+    glyphs.assign(run.glyphs.begin(), run.glyphs.end());
+    out.lines.clear();
+    out.textLength = (uint32_t)text.size();
+
+    // break flags of the paragraph, reused across calls on the same thread
+    thread_local std::vector<uint8_t> breaks;
+    AnalyzeTextBreaks(text, breaks);
+
+    uint32_t glyphCount = (uint32_t)glyphs.size();
+    uint32_t lineStart = 0;
+    uint32_t breakAt = 0; // last glyph a line can break before
+    float lineWidth = 0.0f;
+
+    auto isSpace = [&](uint32_t glyph) { return IsSpace(text[glyphs[glyph].cluster]); };
+
+    // only the first glyph of a cluster carries the cluster's flags
+    auto canBreakBefore = [&](uint32_t glyph, uint8_t flag)
+    {
+        return glyph == glyphCount
+            || ((breaks[glyphs[glyph].cluster] & flag) != 0 && (glyph == 0 || glyphs[glyph - 1].cluster != glyphs[glyph].cluster));
+    };
+
+    auto endLine = [&](uint32_t end)
+    {
+        uint32_t visibleEnd = end;
+        while (visibleEnd > lineStart && isSpace(visibleEnd - 1))
+            visibleEnd--;
+
+        float width = 0.0f;
+        for (uint32_t i = lineStart; i < visibleEnd; i++)
+            width += glyphs[i].advance;
+
+        uint32_t textStart = lineStart < glyphCount ? glyphs[lineStart].cluster : (uint32_t)text.size();
+        uint32_t textEnd = end < glyphCount ? glyphs[end].cluster : (uint32_t)text.size();
+
+        out.lines.push_back({ textStart, textEnd - textStart, lineStart, end - lineStart, width });
+        lineStart = end;
+    };
+
+    for (uint32_t i = 0; i < glyphCount; i++)
+    {
+        float advance = glyphs[i].advance;
+        if (i > lineStart && canBreakBefore(i, TextBreakLine)) breakAt = i;
+
+        // spaces hang past the edge instead of wrapping
+        if (!isSpace(i) && i > lineStart && lineWidth + advance > format.maxWidth)
+        {
+            uint32_t end = breakAt > lineStart ? breakAt : i;
+
+            // never split a grapheme cluster
+            while (end > lineStart + 1 && !canBreakBefore(end, TextBreakGrapheme))
+                end--;
+
+            endLine(end);
+
+            lineWidth = 0.0f;
+            for (uint32_t j = lineStart; j < i; j++)
+                lineWidth += glyphs[j].advance;
+
+            // the word carried over may itself be wider than the line; it has no break
+            // opportunity left, so it is broken after the last grapheme cluster that fits
+            while (i > lineStart && lineWidth + advance > format.maxWidth)
+            {
+                uint32_t fit = 0;
+                float width = 0.0f;
+                for (uint32_t j = lineStart + 1; j <= i; j++)
+                {
+                    width += glyphs[j - 1].advance;
+                    if (width > format.maxWidth) break;
+                    if (canBreakBefore(j, TextBreakGrapheme)) fit = j;
+                }
+
+                // at least one cluster per line
+                if (fit == 0)
+                {
+                    fit = lineStart + 1;
+                    while (fit < i && !canBreakBefore(fit, TextBreakGrapheme))
+                        fit++;
+                }
+
+                endLine(fit);
+
+                lineWidth = 0.0f;
+                for (uint32_t j = lineStart; j < i; j++)
+                    lineWidth += glyphs[j].advance;
+            }
+        }
+
+        lineWidth += advance;
+    }
+
+    if (lineStart < glyphCount || out.lines.empty())
+        endLine(glyphCount);
+
+    out.height = out.lines.size() * GetLineHeight(format);
+}
+
+TextLayout::TextLayout(const FontFace& face, float fontSize, float maxWidth, uint32_t features)
+    : format { &face, fontSize, maxWidth, features }
+    , shapingCache(ShapingCacheBudget)
+    , dirty(true)
+    , threadPool(nullptr)
+    , sharedShapingCache(SharedShapingCacheBudget)
+{
+}
+
+void TextLayout::SetText(std::u16string_view text)
+{
+    this->text.assign(text);
+    dirty = true;
+}
+
+bool TextLayout::SetTextUtf8(std::string_view text, size_t* errorOffset)
+{
+    std::u16string converted;
+    if (!Utf8ToUtf16(text, converted, errorOffset)) return false;
+
+    this->text = std::move(converted);
+    dirty = true;
+    return true;
+}
+
+void TextLayout::SetMaxWidth(float maxWidth)
+{
+    if (format.maxWidth == maxWidth) return;
+
+    format.maxWidth = maxWidth;
+    dirty = true;
+}
+
+void TextLayout::SetThreadPool(ThreadPool* threadPool)
+{
+    this->threadPool = threadPool;
+    if (!threadPool) return;
+
+    while (workerShapingCaches.size() < threadPool->GetWorkerCount())
+    {
+        auto cache = std::make_unique<ShapingCache>(ShapingCacheBudget);
+        cache->SetSharedTier(&sharedShapingCache);
+        workerShapingCaches.push_back(std::move(cache));
+    }
+}
+
+const std::vector<ParagraphLayout>& TextLayout::GetParagraphs()
+{
+    if (dirty) Layout();
+    return paragraphs;
+}
+
+float TextLayout::GetHeight()
+{
+    float height = 0.0f;
+    for (const ParagraphLayout& paragraph : GetParagraphs())
+        height += paragraph.height;
+    return height;
+}
+
+void TextLayout::Layout()
+{
+    std::u16string_view view = text;
+
+    struct Range { size_t start; size_t length; };
+    std::vector<Range> ranges;
+    ForEachParagraph(view, [&](size_t start, size_t length) { ranges.push_back({ start, length }); });
+
+    // existing slots are reused, LayoutParagraph overwrites them completely
+    paragraphs.resize(ranges.size());
+
+    auto layoutRange = [&](size_t begin, size_t end, ShapingCache& cache)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            paragraphs[i].textStart = (uint32_t)ranges[i].start;
+            LayoutParagraph(cache, format, view.substr(ranges[i].start, ranges[i].length), paragraphs[i]);
+        }
+    };
+
+    if (threadPool)
+    {
+        threadPool->ParallelFor(ranges.size(), ParallelGrain, [&](size_t begin, size_t end, size_t worker)
+        {
+            layoutRange(begin, end, *workerShapingCaches[worker]);
+        });
+    }
+    else
+    {
+        layoutRange(0, ranges.size(), shapingCache);
+    }
+
+    dirty = false;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FontFace.h"
+#include "Shaper.h"
+#include "ShapingCache.h"
+#include "SharedShapingCache.h"
+#include "ThreadPool.h"
+
+struct LayoutFormat
+{
+    const FontFace* face;
+    float fontSize;
+    float maxWidth;
+    uint32_t features;
+};
+
+struct TextLine
+{
+    uint32_t textStart;     // relative to the paragraph
+    uint32_t textLength;
+    uint32_t glyphStart;
+    uint32_t glyphCount;
+    float width;            // without trailing spaces
+};
+
+struct ParagraphLayout
+{
+    uint32_t textStart;     // relative to the document
+    uint32_t textLength;    // without the paragraph separator
+    std::vector<ShapedGlyph> glyphs;
+    std::vector<TextLine> lines;
+    float height;
+};
+
+enum class TextAlignment
+{
+    Leading,
+    Center,
+    Trailing,
+};
+
+float GetLineHeight(const LayoutFormat& format);
+
+// x of the first glyph of the line inside a box of 'boxWidth'. Centered lines usually start at a
+// fractional position, see PlaceGlyphs for keeping that without jitter.
+inline float GetLineOriginX(const TextLine& line, float boxWidth, TextAlignment alignment)
+{
+    switch (alignment)
+    {
+    case TextAlignment::Center: return (boxWidth - line.width) * 0.5f;
+    case TextAlignment::Trailing: return boxWidth - line.width;
+    default: return 0.0f;
+    }
+}
+
+// Shapes one paragraph (text without separators) and breaks it into lines no wider than
+// format.maxWidth. Lines break at UAX #14 break opportunities; a word wider than the line is
+// broken between grapheme clusters.
+void LayoutParagraph(ShapingCache& cache, const LayoutFormat& format, std::u16string_view text, ParagraphLayout& out);
+
+// Splits text into paragraphs at '\n' ("\r\n" is accepted) and calls func(start, length) for each
+template<typename Func>
+void ForEachParagraph(std::u16string_view text, Func&& func)
+{
+    size_t start = 0;
+    while (true)
+    {
+        size_t end = text.find(u'\n', start);
+        bool last = end == std::u16string_view::npos;
+        if (last) end = text.size();
+
+        size_t length = end - start;
+        if (length > 0 && text[end - 1] == u'\r') length--;
+
+        func(start, length);
+
+        if (last) break;
+        start = end + 1;
+    }
+}
+
+// Lays out a whole document paragraph by paragraph.
+// Text can be given as UTF-16 or as UTF-8, which is validated and transcoded on the way in.
+//
+// With a thread pool set, paragraphs are sharded across the workers. Every paragraph lands in its
+// own slot, so the result does not depend on scheduling. Each worker shapes through its own
+// ShapingCache, backed by one SharedShapingCache for runs other workers already shaped.
+class TextLayout
+{
+    LayoutFormat format;
+    std::u16string text;
+    std::vector<ParagraphLayout> paragraphs;
+    ShapingCache shapingCache;
+    bool dirty;
+
+    ThreadPool* threadPool;
+    SharedShapingCache sharedShapingCache;
+    std::vector<std::unique_ptr<ShapingCache>> workerShapingCaches;
+
+public:
+    TextLayout(const FontFace& face, float fontSize, float maxWidth, uint32_t features = ShapingFeatureKerning);
+
+    void SetText(std::u16string_view text);
+
+    // Returns false and keeps the current text if 'text' is not valid UTF-8
+    bool SetTextUtf8(std::string_view text, size_t* errorOffset = nullptr);
+
+    void SetMaxWidth(float maxWidth);
+
+    // nullptr lays out on the calling thread only
+    void SetThreadPool(ThreadPool* threadPool);
+
+    const std::u16string& GetText() const { return text; }
+    const LayoutFormat& GetFormat() const { return format; }
+
+    const std::vector<ParagraphLayout>& GetParagraphs();
+    float GetHeight();
+
+    ShapingCache& GetShapingCache() { return shapingCache; }
+    SharedShapingCache& GetSharedShapingCache() { return sharedShapingCache; }
+
+private:
+    void Layout();
+};
@@ -0,0 +1,188 @@
+#include "TextMeasure.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // unbounded layouts align against their own widest line
+    float GetBoxWidth(const LayoutFormat& format, float widestLine)
+    {
+        return std::isfinite(format.maxWidth) ? format.maxWidth : widestLine;
+    }
+
+    // caret x of a position inside the line, relative to the line start
+    float GetCaretOffset(const ParagraphLayout& paragraph, const TextLine& line, uint32_t position)
+    {
+        float x = 0.0f;
+        for (uint32_t i = line.glyphStart; i < line.glyphStart + line.glyphCount; i++)
+        {
+            const ShapedGlyph& glyph = paragraph.glyphs[i];
+            if (glyph.cluster >= position) break;
+            x += glyph.advance;
+        }
+        return x;
+    }
+}
+
+TextMeasurer::TextMeasurer(size_t shapingCacheBudget)
+    : shapingCache(shapingCacheBudget)
+{
+}
+
+// Calls func(paragraphStart, paragraph, line, top) for each line until it returns false
+template<typename LineFunc>
+void TextMeasurer::ForEachLine(const LayoutFormat& format, std::u16string_view text, LineFunc&& func)
+{
+    float top = 0.0f;
+    float lineHeight = GetLineHeight(format);
+    bool running = true;
+
+    ForEachParagraph(text, [&](size_t start, size_t length)
+    {
+        if (!running) return;
+
+        LayoutParagraph(shapingCache, format, text.substr(start, length), scratch);
+        for (const TextLine& line : scratch.lines)
+        {
+            if (!func((uint32_t)start, scratch, line, top))
+            {
+                running = false;
+                return;
+            }
+            top += lineHeight;
+        }
+    });
+}
+
+TextMetrics TextMeasurer::Measure(const LayoutFormat& format, std::u16string_view text)
+{
+    TextMetrics metrics {};
+    float lineHeight = GetLineHeight(format);
+
+    ForEachParagraph(text, [&](size_t start, size_t length)
+    {
+        std::u16string_view paragraph = text.substr(start, length);
+
+        // a paragraph that fits and has no trailing space is one line as wide as its run,
+        // no need to copy glyphs or break lines
+        bool trailingSpace = !paragraph.empty() && (paragraph.back() == u' ' || paragraph.back() == u'\t' || paragraph.back() == 0x3000);
+        if (!trailingSpace)
+        {
+            const ShapedRun& run = shapingCache.Shape(*format.face, format.fontSize, paragraph, format.features);
+            if (run.width <= format.maxWidth)
+            {
+                metrics.width = std::max(metrics.width, run.width);
+                metrics.lineCount++;
+                return;
+            }
+        }
+
+        LayoutParagraph(shapingCache, format, paragraph, scratch);
+        for (const TextLine& line : scratch.lines)
+            metrics.width = std::max(metrics.width, line.width);
+        metrics.lineCount += (uint32_t)scratch.lines.size();
+    });
+
+    metrics.height = metrics.lineCount * lineHeight;
+    return metrics;
+}
+
+TextMetrics TextMeasurer::Measure(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, std::vector<LineMetrics>& lines)
+{
+    TextMetrics metrics {};
+    float lineHeight = GetLineHeight(format);
+    size_t firstLine = lines.size();
+
+    ForEachLine(format, text, [&](uint32_t paragraphStart, const ParagraphLayout&, const TextLine& line, float top)
+    {
+        lines.push_back({ paragraphStart + line.textStart, line.textLength, 0.0f, top, line.width, lineHeight });
+        metrics.width = std::max(metrics.width, line.width);
+        metrics.lineCount++;
+        return true;
+    });
+
+    // alignment needs the widest line when the box is unbounded, so it is applied afterwards
+    float boxWidth = GetBoxWidth(format, metrics.width);
+    for (size_t i = firstLine; i < lines.size(); i++)
+    {
+        TextLine line {};
+        line.width = lines[i].width;
+        lines[i].left = GetLineOriginX(line, boxWidth, alignment);
+    }
+
+    metrics.height = metrics.lineCount * lineHeight;
+    return metrics;
+}
+
+HitTestResult TextMeasurer::HitTestPoint(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, float x, float y)
+{
+    float lineHeight = GetLineHeight(format);
+    float boxWidth = GetBoxWidth(format, alignment == TextAlignment::Leading ? 0.0f : Measure(format, text).width);
+
+    HitTestResult result { (uint32_t)text.size(), 0, false };
+    uint32_t lineIndex = 0;
+
+    ForEachLine(format, text, [&](uint32_t paragraphStart, const ParagraphLayout& paragraph, const TextLine& line, float top)
+    {
+        // points above the text hit the first line, points below it the last one
+        result.lineIndex = lineIndex++;
+        bool isLastLine = paragraphStart + line.textStart + line.textLength >= text.size();
+        if (y >= top + lineHeight && !isLastLine) return true;
+
+        float left = GetLineOriginX(line, boxWidth, alignment);
+        float pen = left;
+
+        result.textPosition = paragraphStart + line.textStart + line.textLength;
+        result.isInside = y >= top && y < top + lineHeight && x >= left && x < left + line.width;
+
+        for (uint32_t i = line.glyphStart; i < line.glyphStart + line.glyphCount; i++)
+        {
+            const ShapedGlyph& glyph = paragraph.glyphs[i];
+
+            // leading half of the glyph puts the caret before it
+            if (x < pen + glyph.advance * 0.5f)
+            {
+                result.textPosition = paragraphStart + glyph.cluster;
+                return false;
+            }
+            pen += glyph.advance;
+        }
+
+        // past the end of a wrapped line the caret goes before the space it wrapped at, since the
+        // line end itself is displayed at the start of the next line
+        uint32_t end = paragraphStart + line.textStart + line.textLength;
+        bool wrapped = line.textStart + line.textLength < paragraph.textLength;
+        if (wrapped && end > paragraphStart + line.textStart && (text[end - 1] == u' ' || text[end - 1] == u'\t'))
+            end--;
+
+        result.textPosition = end;
+        return false;
+    });
+
+    return result;
+}
+
+void TextMeasurer::GetCaretPosition(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, uint32_t textPosition, float& x, float& y)
+{
+    float boxWidth = GetBoxWidth(format, alignment == TextAlignment::Leading ? 0.0f : Measure(format, text).width);
+    textPosition = std::min(textPosition, (uint32_t)text.size());
+
+    x = 0.0f;
+    y = 0.0f;
+
+    ForEachLine(format, text, [&](uint32_t paragraphStart, const ParagraphLayout& paragraph, const TextLine& line, float top)
+    {
+        uint32_t lineStart = paragraphStart + line.textStart;
+        uint32_t lineEnd = lineStart + line.textLength;
+
+        // a position on a wrap belongs to the start of the next line
+        bool paragraphEnd = line.textStart + line.textLength == paragraph.textLength;
+        if (textPosition < lineStart || textPosition > lineEnd || (textPosition == lineEnd && !paragraphEnd))
+            return true;
+
+        x = GetLineOriginX(line, boxWidth, alignment) + GetCaretOffset(paragraph, line, textPosition - paragraphStart);
+        y = top;
+        return false;
+    });
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "ShapingCache.h"
+#include "TextLayout.h"
+
+struct TextMetrics
+{
+    float width;            // widest line, without trailing spaces
+    float height;
+    uint32_t lineCount;
+};
+
+struct LineMetrics
+{
+    uint32_t textStart;     // relative to the measured text
+    uint32_t textLength;
+    float left;             // after alignment inside format.maxWidth
+    float top;
+    float width;
+    float height;
+};
+
+struct HitTestResult
+{
+    uint32_t textPosition;  // caret position closest to the point
+    uint32_t lineIndex;
+    bool isInside;          // the point is over the text of a line
+};
+
+// Answers layout questions ("how wide is this string?") without rasterizing anything.
+// Only shaping (through the cache) and line breaking run, into reused scratch storage, so
+// repeated measurements of the same strings cost a hash lookup per paragraph.
+class TextMeasurer
+{
+    ShapingCache shapingCache;
+    ParagraphLayout scratch;
+
+public:
+    explicit TextMeasurer(size_t shapingCacheBudget = 1024 * 1024);
+
+    TextMetrics Measure(const LayoutFormat& format, std::u16string_view text);
+
+    // Also appends the extents of every line to 'lines'
+    TextMetrics Measure(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, std::vector<LineMetrics>& lines);
+
+    HitTestResult HitTestPoint(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, float x, float y);
+
+    // Caret position of a text offset: x, and the top of its line
+    void GetCaretPosition(const LayoutFormat& format, std::u16string_view text, TextAlignment alignment, uint32_t textPosition, float& x, float& y);
+
+    ShapingCache& GetShapingCache() { return shapingCache; }
+
+private:
+    template<typename LineFunc>
+    void ForEachLine(const LayoutFormat& format, std::u16string_view text, LineFunc&& func);
+};
@@ -0,0 +1,99 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : func(nullptr)
+    , count(0)
+    , grain(1)
+    , next(0)
+    , busyThreads(0)
+    , generation(0)
+    , stopping(false)
+{
+    if (threadCount == 0)
+    {
+        size_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        threads.emplace_back(&ThreadPool::WorkerMain, this, i + 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::RunChunks(size_t worker)
+{
+    while (true)
+    {
+        size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+        if (begin >= count) break;
+
+        (*func)(begin, std::min(begin + grain, count), worker);
+    }
+}
+
+void ThreadPool::WorkerMain(size_t worker)
+{
+    uint64_t seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+
+            seen = generation;
+        }
+
+        RunChunks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busyThreads == 0) done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const RangeFunc& func)
+{
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // not worth waking anyone for a single chunk
+    if (threads.empty() || count <= grain)
+    {
+        func(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->func = &func;
+        this->count = count;
+        this->grain = grain;
+        next.store(0, std::memory_order_relaxed);
+        busyThreads = threads.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    RunChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return busyThreads == 0; });
+    this->func = nullptr;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Building blocks for the Unicode property lookups (TextBreak, Bidi)
+
+template<typename Value>
+struct PropertyRange
+{
+    char32_t first;
+    char32_t last;
+    Value value;
+};
+
+// Two-stage lookup table, built from a full array by storing each distinct block once
+class TwoStageTable
+{
+public:
+    static constexpr char32_t CodePointCount = 0x110000;
+
+private:
+    static constexpr int BlockShift = 8;
+    static constexpr char32_t BlockSize = 1 << BlockShift;
+
+    std::vector<uint16_t> blocks;   // code point >> BlockShift -> offset of its block in 'values'
+    std::vector<uint8_t> values;
+
+public:
+    explicit TwoStageTable(const std::vector<uint8_t>& full)
+    {
+        std::unordered_map<std::string, uint16_t> offsets;
+        blocks.resize(CodePointCount / BlockSize);
+
+        for (size_t block = 0; block < blocks.size(); block++)
+        {
+            std::string key((const char*)full.data() + block * BlockSize, BlockSize);
+            auto [it, inserted] = offsets.try_emplace(key, (uint16_t)(values.size() / BlockSize));
+            if (inserted) values.insert(values.end(), key.begin(), key.end());
+
+            blocks[block] = it->second;
+        }
+    }
+
+    uint8_t Get(char32_t c) const
+    {
+        if (c >= CodePointCount) return 0;
+        return values[((size_t)blocks[c >> BlockShift] << BlockShift) | (c & (BlockSize - 1))];
+    }
+};
+
+// Writes the ranges into a full array of TwoStageTable::CodePointCount entries
+template<typename Value, size_t N>
+void FillRanges(std::vector<uint8_t>& full, const PropertyRange<Value> (&ranges)[N])
+{
+    for (const PropertyRange<Value>& range : ranges)
+    {
+        for (char32_t c = range.first; c <= range.last; c++)
+            full[c] = (uint8_t)range.value;
+    }
+}
@@ -0,0 +1,696 @@
+#include "Utf.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define UTF_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define UTF_TARGET(features)
+#define UTF_INLINE __forceinline
+#else
+#define UTF_TARGET(features) __attribute__((target(features)))
+#define UTF_INLINE inline __attribute__((always_inline))
+#endif
+#endif
+
+namespace
+{
+    // Converts a leading part of the input, as much as the kernel handles, and returns how many code
+    // units it read and wrote. The scalar code takes over where a kernel stops.
+    struct Converted
+    {
+        size_t read;
+        size_t written;
+    };
+
+    using Utf8ToUtf16Fn = Converted (*)(const uint8_t* in, size_t count, char16_t* out);
+    using Utf16ToUtf8Fn = Converted (*)(const char16_t* in, size_t count, uint8_t* out);
+
+#ifdef UTF_X86
+    // UTF-8 sequences of one to three bytes are decoded four at a time. A shuffle spreads each
+    // sequence over a 32-bit lane as (last byte, the byte before it, lead of a 3 byte sequence, 0),
+    // from which the code point follows with shifts and masks. Which bytes go where depends only on
+    // where sequences start, so the shuffles are looked up by the start mask of bytes 1-12.
+    struct Utf8DecodeTables
+    {
+        struct Pattern
+        {
+            alignas(16) uint8_t shuffle[16];
+
+            // per lane: the lead and continuation bits of its length, and its smallest code point
+            alignas(16) uint32_t bitsMask[4];
+            alignas(16) uint32_t bitsValue[4];
+            alignas(16) uint32_t minimum[4];
+
+            uint8_t written;
+        };
+
+        struct Step
+        {
+            uint8_t pattern;    // 0 reads nothing: a sequence longer than three bytes comes first
+            uint8_t read;
+        };
+
+        // one per run of up to four sequence lengths of 1-3
+        Pattern patterns[1 + 3 + 9 + 27 + 81];
+        Step steps[4096];
+
+        Utf8DecodeTables()
+        {
+            const uint32_t bitsMask[] = { 0, 0x80, 0xE0C0, 0xF0C0C0 };
+            const uint32_t bitsValue[] = { 0, 0x00, 0xC080, 0xE08080 };
+            const uint32_t minimum[] = { 0, 0x00, 0x80, 0x800 };
+
+            uint8_t patternOfLengths[256] = {};
+            size_t patternCount = 1;
+            patterns[0] = {};
+
+            for (uint32_t starts = 0; starts < 4096; starts++)
+            {
+                Pattern pattern = {};
+                memset(pattern.shuffle, 0x80, sizeof(pattern.shuffle));
+
+                uint32_t lengths = 0;
+                size_t begin = 0;
+                for (size_t lane = 0; lane < 4; lane++)
+                {
+                    size_t end = begin + 1;
+                    while (end <= 12 && !(starts >> (end - 1) & 1)) end++;
+
+                    size_t length = end - begin;
+                    if (end > 12 || length > 3) break;
+
+                    pattern.shuffle[lane * 4] = (uint8_t)(end - 1);
+                    if (length >= 2) pattern.shuffle[lane * 4 + 1] = (uint8_t)(end - 2);
+                    if (length == 3) pattern.shuffle[lane * 4 + 2] = (uint8_t)begin;
+
+                    pattern.bitsMask[lane] = bitsMask[length];
+                    pattern.bitsValue[lane] = bitsValue[length];
+                    pattern.minimum[lane] = minimum[length];
+
+                    lengths = lengths << 2 | (uint32_t)length;
+                    pattern.written++;
+                    begin = end;
+                }
+
+                if (pattern.written != 0 && patternOfLengths[lengths] == 0)
+                {
+                    patternOfLengths[lengths] = (uint8_t)patternCount;
+                    patterns[patternCount++] = pattern;
+                }
+
+                steps[starts] = { patternOfLengths[lengths], (uint8_t)begin };
+            }
+        }
+    };
+
+    // UTF-16 code units below U+D800 or above U+DFFF are encoded four at a time: each 32-bit lane is
+    // built as its 1, 2 and 3 byte forms, the right one is picked per lane, and a shuffle looked up
+    // by the four lengths packs the bytes together. Units below U+0800 (Latin, Greek, Cyrillic,
+    // Hebrew, Arabic) are encoded eight at a time the same way in 16-bit lanes.
+    struct Utf8EncodeTables
+    {
+        struct Pattern
+        {
+            alignas(16) uint8_t shuffle[16];
+            uint8_t written;
+        };
+
+        // bit j: lane j is at least 0x80, bit 4 + j: at least 0x800
+        Pattern fourUnits[256];
+
+        // bit j: 16-bit lane j is at least 0x80
+        Pattern eightUnits[256];
+
+        Utf8EncodeTables()
+        {
+            for (uint32_t key = 0; key < 256; key++)
+            {
+                Pattern& four = fourUnits[key];
+                memset(four.shuffle, 0x80, sizeof(four.shuffle));
+                four.written = 0;
+
+                for (uint32_t lane = 0; lane < 4; lane++)
+                {
+                    uint32_t length = 1 + (key >> lane & 1) + (key >> (4 + lane) & 1);
+                    for (uint32_t j = 0; j < length; j++)
+                        four.shuffle[four.written++] = (uint8_t)(lane * 4 + j);
+                }
+
+                Pattern& eight = eightUnits[key];
+                memset(eight.shuffle, 0x80, sizeof(eight.shuffle));
+                eight.written = 0;
+
+                for (uint32_t lane = 0; lane < 8; lane++)
+                {
+                    uint32_t length = 1 + (key >> lane & 1);
+                    for (uint32_t j = 0; j < length; j++)
+                        eight.shuffle[eight.written++] = (uint8_t)(lane * 2 + j);
+                }
+            }
+        }
+    };
+
+    const Utf8DecodeTables& GetUtf8DecodeTables()
+    {
+        static const Utf8DecodeTables tables;
+        return tables;
+    }
+
+    const Utf8EncodeTables& GetUtf8EncodeTables()
+    {
+        static const Utf8EncodeTables tables;
+        return tables;
+    }
+
+    // Converts from the 64 bytes at 'in', reading up to 16 bytes past them, 16 ASCII bytes or four
+    // sequences per step. The masks of the whole block are computed up front, so the next step is a
+    // single table load away and steps do not wait on each other's loads. Returns false if it
+    // stopped at an invalid sequence, which the scalar code then reports.
+    //
+    // Always inlined, so the AVX2 kernel runs it VEX encoded without SSE/AVX transitions.
+    UTF_TARGET("sse4.1")
+    UTF_INLINE bool Utf8ToUtf16BlockSse41(const uint8_t* in, char16_t* out, const Utf8DecodeTables& tables, Converted& block)
+    {
+        uint64_t continuation = 0;
+        uint64_t nonAscii = 0;
+        for (size_t i = 0; i < 64; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(in + i));
+            __m128i isContinuation = _mm_cmpeq_epi8(_mm_and_si128(bytes, _mm_set1_epi8((char)0xC0)), _mm_set1_epi8((char)0x80));
+            continuation |= (uint64_t)(uint32_t)_mm_movemask_epi8(isContinuation) << i;
+            nonAscii |= (uint64_t)(uint32_t)_mm_movemask_epi8(bytes) << i;
+        }
+
+        size_t read = 0;
+        size_t written = 0;
+        bool complete = true;
+
+        while (read <= 48)
+        {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)(in + read));
+
+            if ((nonAscii >> read & 0xFFFF) == 0)
+            {
+                _mm_storeu_si128((__m128i*)(out + written), _mm_cvtepu8_epi16(bytes));
+                _mm_storeu_si128((__m128i*)(out + written + 8), _mm_cvtepu8_epi16(_mm_srli_si128(bytes, 8)));
+                read += 16;
+                written += 16;
+                continue;
+            }
+
+            Utf8DecodeTables::Step step = tables.steps[~continuation >> (read + 1) & 0xFFF];
+            const Utf8DecodeTables::Pattern& pattern = tables.patterns[step.pattern];
+
+            // a 4 byte sequence first (emoji, supplementary CJK) becomes a surrogate pair here, so
+            // that text with a few of them stays in the block
+            if (step.pattern == 0)
+            {
+                const uint8_t* sequence = in + read;
+                uint32_t lead = sequence[0];
+                uint32_t second = sequence[1];
+                if (lead < 0xF0 || lead > 0xF4 || (lead == 0xF0 && second < 0x90) || (lead == 0xF4 && second > 0x8F) ||
+                    (continuation >> read & 0xF) != 0xE)
+                {
+                    complete = false;
+                    break;
+                }
+
+                char32_t codePoint = (lead & 0x07) << 18 | (second & 0x3F) << 12 | (sequence[2] & 0x3F) << 6 | (sequence[3] & 0x3F);
+                codePoint -= 0x10000;
+                out[written] = (char16_t)(0xD800 + (codePoint >> 10));
+                out[written + 1] = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+                read += 4;
+                written += 2;
+                continue;
+            }
+
+            __m128i lanes = _mm_shuffle_epi8(bytes, _mm_load_si128((const __m128i*)pattern.shuffle));
+            __m128i codePoints = _mm_or_si128(_mm_or_si128(
+                _mm_and_si128(lanes, _mm_set1_epi32(0x7F)),
+                _mm_and_si128(_mm_srli_epi32(lanes, 2), _mm_set1_epi32(0xFC0))),
+                _mm_and_si128(_mm_srli_epi32(lanes, 4), _mm_set1_epi32(0xF000)));
+
+            // lead bytes that do not match the sequence length, overlong forms and encoded surrogates
+            __m128i wrongBits = _mm_xor_si128(_mm_and_si128(lanes, _mm_load_si128((const __m128i*)pattern.bitsMask)),
+                _mm_load_si128((const __m128i*)pattern.bitsValue));
+            __m128i overlong = _mm_cmplt_epi32(codePoints, _mm_load_si128((const __m128i*)pattern.minimum));
+            __m128i surrogate = _mm_cmpeq_epi32(_mm_and_si128(codePoints, _mm_set1_epi32(0xF800)), _mm_set1_epi32(0xD800));
+            __m128i invalid = _mm_or_si128(wrongBits, _mm_or_si128(overlong, surrogate));
+
+            if (!_mm_testz_si128(invalid, invalid))
+            {
+                complete = false;
+                break;
+            }
+
+            _mm_storel_epi64((__m128i*)(out + written), _mm_packus_epi32(codePoints, codePoints));
+            read += step.read;
+            written += pattern.written;
+        }
+
+        block = { read, written };
+        return complete;
+    }
+
+    UTF_TARGET("sse4.1")
+    Converted Utf8ToUtf16Sse41(const uint8_t* in, size_t count, char16_t* out)
+    {
+        const Utf8DecodeTables& tables = GetUtf8DecodeTables();
+
+        Converted converted = { 0, 0 };
+        while (converted.read + 64 + 16 <= count)
+        {
+            Converted block;
+            bool complete = Utf8ToUtf16BlockSse41(in + converted.read, out + converted.written, tables, block);
+            converted.read += block.read;
+            converted.written += block.written;
+            if (!complete) break;
+        }
+        return converted;
+    }
+
+    UTF_TARGET("avx2")
+    Converted Utf8ToUtf16Avx2(const uint8_t* in, size_t count, char16_t* out)
+    {
+        const Utf8DecodeTables& tables = GetUtf8DecodeTables();
+
+        Converted converted = { 0, 0 };
+        while (converted.read + 64 + 16 <= count)
+        {
+            const uint8_t* src = in + converted.read;
+            char16_t* dst = out + converted.written;
+
+            __m256i bytes = _mm256_loadu_si256((const __m256i*)src);
+            if (_mm256_movemask_epi8(bytes) == 0)
+            {
+                _mm256_storeu_si256((__m256i*)dst, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+                _mm256_storeu_si256((__m256i*)(dst + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+                converted.read += 32;
+                converted.written += 32;
+                continue;
+            }
+
+            Converted block;
+            bool complete = Utf8ToUtf16BlockSse41(src, dst, tables, block);
+            converted.read += block.read;
+            converted.written += block.written;
+            if (!complete) break;
+        }
+        return converted;
+    }
+
+    // Encodes four code units held in 32-bit lanes into up to 16 bytes at 'out'. Returns false
+    // without writing if one of them is a surrogate.
+    UTF_TARGET("sse4.1")
+    UTF_INLINE bool Utf16ToUtf8FourSse41(__m128i units, uint8_t* out, const Utf8EncodeTables& tables, size_t& written)
+    {
+        __m128i surrogates = _mm_cmpeq_epi32(_mm_and_si128(units, _mm_set1_epi32(0xF800)), _mm_set1_epi32(0xD800));
+        if (!_mm_testz_si128(surrogates, surrogates)) return false;
+
+        __m128i twoBytes = _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7F));
+        __m128i threeBytes = _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7FF));
+
+        __m128i low6 = _mm_or_si128(_mm_and_si128(units, _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+        __m128i mid6 = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0x3F)), _mm_set1_epi32(0x80));
+
+        __m128i encoded2 = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(units, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(low6, 8));
+        __m128i encoded3 = _mm_or_si128(_mm_or_si128(_mm_srli_epi32(units, 12), _mm_set1_epi32(0xE0)),
+            _mm_or_si128(_mm_slli_epi32(mid6, 8), _mm_slli_epi32(low6, 16)));
+
+        __m128i lanes = _mm_blendv_epi8(_mm_blendv_epi8(units, encoded2, twoBytes), encoded3, threeBytes);
+
+        uint32_t key = _mm_movemask_ps(_mm_castsi128_ps(twoBytes)) | _mm_movemask_ps(_mm_castsi128_ps(threeBytes)) << 4;
+        const Utf8EncodeTables::Pattern& pattern = tables.fourUnits[key];
+        _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(lanes, _mm_load_si128((const __m128i*)pattern.shuffle)));
+        written = pattern.written;
+        return true;
+    }
+
+    // Encodes eight code units below 0x800 into up to 16 bytes at 'out' and returns how many
+    UTF_TARGET("sse4.1")
+    UTF_INLINE size_t Utf16ToUtf8EightSse41(__m128i units, uint8_t* out, const Utf8EncodeTables& tables)
+    {
+        __m128i twoBytes = _mm_cmpgt_epi16(units, _mm_set1_epi16(0x7F));
+
+        __m128i lead = _mm_or_si128(_mm_srli_epi16(units, 6), _mm_set1_epi16(0xC0));
+        __m128i low6 = _mm_or_si128(_mm_and_si128(units, _mm_set1_epi16(0x3F)), _mm_set1_epi16(0x80));
+        __m128i lanes = _mm_blendv_epi8(units, _mm_or_si128(lead, _mm_slli_epi16(low6, 8)), twoBytes);
+
+        uint32_t key = _mm_movemask_epi8(_mm_packs_epi16(twoBytes, _mm_setzero_si128()));
+        const Utf8EncodeTables::Pattern& pattern = tables.eightUnits[key];
+        _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(lanes, _mm_load_si128((const __m128i*)pattern.shuffle)));
+        return pattern.written;
+    }
+
+    // One step over in[0, 16): all 16 at once if they are ASCII, eight at a time if they are all
+    // below 0x800, else four at a time. Writes up to 52 bytes. Returns false if it stopped early
+    // at a surrogate.
+    UTF_TARGET("sse4.1")
+    UTF_INLINE bool Utf16ToUtf8StepSse41(const char16_t* in, uint8_t* out, const Utf8EncodeTables& tables, Converted& step)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i*)in);
+        __m128i hi = _mm_loadu_si128((const __m128i*)(in + 8));
+        if (_mm_testz_si128(_mm_or_si128(lo, hi), _mm_set1_epi16((short)0xFF80)))
+        {
+            _mm_storeu_si128((__m128i*)out, _mm_packus_epi16(lo, hi));
+            step = { 16, 16 };
+            return true;
+        }
+
+        if (_mm_testz_si128(_mm_or_si128(lo, hi), _mm_set1_epi16((short)0xF800)))
+        {
+            size_t written = Utf16ToUtf8EightSse41(lo, out, tables);
+            written += Utf16ToUtf8EightSse41(hi, out + written, tables);
+            step = { 16, written };
+            return true;
+        }
+
+        const __m128i quarters[] = { _mm_cvtepu16_epi32(lo), _mm_cvtepu16_epi32(_mm_srli_si128(lo, 8)),
+            _mm_cvtepu16_epi32(hi), _mm_cvtepu16_epi32(_mm_srli_si128(hi, 8)) };
+
+        step = { 0, 0 };
+        for (const __m128i& units : quarters)
+        {
+            size_t written;
+            if (!Utf16ToUtf8FourSse41(units, out + step.written, tables, written)) return false;
+
+            step.read += 4;
+            step.written += written;
+        }
+        return true;
+    }
+
+    // The kernels encode surrogate pairs themselves, so that text with a few of them stays in the
+    // SIMD loop. Returns false if in[0] does not start a valid pair; in[1] must be readable.
+    inline bool EncodeSurrogatePair(const char16_t* in, uint8_t* out)
+    {
+        if (in[0] < 0xD800 || in[0] > 0xDBFF || in[1] < 0xDC00 || in[1] > 0xDFFF) return false;
+
+        char32_t codePoint = 0x10000 + (((char32_t)in[0] - 0xD800) << 10) + ((char32_t)in[1] - 0xDC00);
+        out[0] = (uint8_t)(0xF0 | (codePoint >> 18));
+        out[1] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+        out[2] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+        out[3] = (uint8_t)(0x80 | (codePoint & 0x3F));
+        return true;
+    }
+
+    UTF_TARGET("sse4.1")
+    Converted Utf16ToUtf8Sse41(const char16_t* in, size_t count, uint8_t* out)
+    {
+        const Utf8EncodeTables& tables = GetUtf8EncodeTables();
+
+        // 32 units leave room in the output for the 52 bytes a step may write
+        Converted converted = { 0, 0 };
+        while (converted.read + 32 <= count)
+        {
+            Converted step;
+            bool complete = Utf16ToUtf8StepSse41(in + converted.read, out + converted.written, tables, step);
+            converted.read += step.read;
+            converted.written += step.written;
+
+            if (!complete)
+            {
+                if (!EncodeSurrogatePair(in + converted.read, out + converted.written)) break;
+                converted.read += 2;
+                converted.written += 4;
+            }
+        }
+        return converted;
+    }
+
+    UTF_TARGET("avx2")
+    Converted Utf16ToUtf8Avx2(const char16_t* in, size_t count, uint8_t* out)
+    {
+        const Utf8EncodeTables& tables = GetUtf8EncodeTables();
+        const __m256i nonAscii = _mm256_set1_epi16((short)0xFF80);
+
+        Converted converted = { 0, 0 };
+        while (converted.read + 32 <= count)
+        {
+            const char16_t* src = in + converted.read;
+            uint8_t* dst = out + converted.written;
+
+            __m256i lo = _mm256_loadu_si256((const __m256i*)src);
+            __m256i hi = _mm256_loadu_si256((const __m256i*)(src + 16));
+            if (_mm256_testz_si256(_mm256_or_si256(lo, hi), nonAscii))
+            {
+                // packus works per 128 bit lane, so restore the order of the 64 bit quarters
+                __m256i packed = _mm256_packus_epi16(lo, hi);
+                _mm256_storeu_si256((__m256i*)dst, _mm256_permute4x64_epi64(packed, 0xD8));
+                converted.read += 32;
+                converted.written += 32;
+                continue;
+            }
+
+            Converted step;
+            bool complete = Utf16ToUtf8StepSse41(src, dst, tables, step);
+            converted.read += step.read;
+            converted.written += step.written;
+
+            if (!complete)
+            {
+                if (!EncodeSurrogatePair(in + converted.read, out + converted.written)) break;
+                converted.read += 2;
+                converted.written += 4;
+            }
+        }
+        return converted;
+    }
+
+    bool HasSse41()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 19)) != 0;
+#else
+        return __builtin_cpu_supports("sse4.1");
+#endif
+    }
+
+    bool HasAvx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+
+        // the OS must save YMM state
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    struct Kernels
+    {
+        Utf8ToUtf16Fn toUtf16;
+        Utf16ToUtf8Fn toUtf8;
+    };
+
+    const Kernels& GetKernels()
+    {
+        static const Kernels kernels = []() -> Kernels
+        {
+#ifdef UTF_X86
+            if (HasAvx2()) return { Utf8ToUtf16Avx2, Utf16ToUtf8Avx2 };
+            if (HasSse41()) return { Utf8ToUtf16Sse41, Utf16ToUtf8Sse41 };
+#endif
+            return { nullptr, nullptr };
+        }();
+
+        return kernels;
+    }
+
+    // Code units the scalar code converts after a kernel stopped, before the kernel is tried again
+    const size_t KernelRestartDistance = 16;
+
+    bool IsContinuation(uint8_t c) { return (c & 0xC0) == 0x80; }
+
+    bool Utf8ToUtf16Impl(std::string_view in, std::u16string& out, size_t* errorOffset, Utf8ToUtf16Fn kernel)
+    {
+        const uint8_t* src = (const uint8_t*)in.data();
+        size_t count = in.size();
+
+        // a UTF-8 code unit never produces more than one UTF-16 code unit
+        size_t base = out.size();
+        out.resize(base + count);
+        char16_t* dst = out.data() + base;
+
+        // where the kernel stopped, the scalar code goes on for a while, so that text with many
+        // sequences the kernel leaves to it does not pay for restarting the kernel every time
+        size_t i = 0;
+        size_t kernelFrom = 0;
+        while (i < count)
+        {
+            if (kernel && i >= kernelFrom)
+            {
+                Converted converted = kernel(src + i, count - i, dst);
+                i += converted.read;
+                dst += converted.written;
+                if (i == count) break;
+
+                kernelFrom = i + KernelRestartDistance;
+            }
+
+            uint8_t c = src[i];
+
+            if (c < 0x80)
+            {
+                *dst++ = c;
+                i++;
+                continue;
+            }
+
+            char32_t codePoint;
+            size_t length;
+            uint8_t lo = 0x80, hi = 0xBF; // valid range of the second byte
+
+            if (c < 0xC2) goto invalid; // stray continuation or overlong 2 byte form
+            else if (c < 0xE0) { length = 2; codePoint = c & 0x1F; }
+            else if (c < 0xF0)
+            {
+                length = 3; codePoint = c & 0x0F;
+                if (c == 0xE0) lo = 0xA0;      // overlong
+                else if (c == 0xED) hi = 0x9F; // surrogates
+            }
+            else if (c < 0xF5)
+            {
+                length = 4; codePoint = c & 0x07;
+                if (c == 0xF0) lo = 0x90;      // overlong
+                else if (c == 0xF4) hi = 0x8F; // above U+10FFFF
+            }
+            else goto invalid;
+
+            if (count - i < length) goto invalid;
+            if (src[i + 1] < lo || src[i + 1] > hi) goto invalid;
+
+            for (size_t j = 1; j < length; j++)
+            {
+                if (!IsContinuation(src[i + j])) goto invalid;
+                codePoint = (codePoint << 6) | (src[i + j] & 0x3F);
+            }
+
+            if (codePoint < 0x10000)
+            {
+                *dst++ = (char16_t)codePoint;
+            }
+            else
+            {
+                codePoint -= 0x10000;
+                *dst++ = (char16_t)(0xD800 + (codePoint >> 10));
+                *dst++ = (char16_t)(0xDC00 + (codePoint & 0x3FF));
+            }
+
+            i += length;
+            continue;
+
+        invalid:
+            out.resize(base);
+            if (errorOffset) *errorOffset = i;
+            return false;
+        }
+
+        out.resize(dst - out.data());
+        return true;
+    }
+
+    bool Utf16ToUtf8Impl(std::u16string_view in, std::string& out, size_t* errorOffset, Utf16ToUtf8Fn kernel)
+    {
+        const char16_t* src = in.data();
+        size_t count = in.size();
+
+        // at most 3 bytes per UTF-16 code unit (a surrogate pair takes 4 bytes for 2 units)
+        size_t base = out.size();
+        out.resize(base + count * 3);
+        uint8_t* dst = (uint8_t*)out.data() + base;
+
+        // where the kernel stopped, the scalar code goes on for a while, so that text with many
+        // sequences the kernel leaves to it does not pay for restarting the kernel every time
+        size_t i = 0;
+        size_t kernelFrom = 0;
+        while (i < count)
+        {
+            if (kernel && i >= kernelFrom)
+            {
+                Converted converted = kernel(src + i, count - i, dst);
+                i += converted.read;
+                dst += converted.written;
+                if (i == count) break;
+
+                kernelFrom = i + KernelRestartDistance;
+            }
+
+            char16_t c = src[i];
+
+            if (c < 0x80)
+            {
+                *dst++ = (uint8_t)c;
+                i++;
+            }
+            else if (c < 0x800)
+            {
+                *dst++ = (uint8_t)(0xC0 | (c >> 6));
+                *dst++ = (uint8_t)(0x80 | (c & 0x3F));
+                i++;
+            }
+            else if (c < 0xD800 || c > 0xDFFF)
+            {
+                *dst++ = (uint8_t)(0xE0 | (c >> 12));
+                *dst++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+                *dst++ = (uint8_t)(0x80 | (c & 0x3F));
+                i++;
+            }
+            else
+            {
+                if (c > 0xDBFF || i + 1 >= count || src[i + 1] < 0xDC00 || src[i + 1] > 0xDFFF)
+                {
+                    out.resize(base);
+                    if (errorOffset) *errorOffset = i;
+                    return false;
+                }
+
+                char32_t codePoint = 0x10000 + (((char32_t)c - 0xD800) << 10) + ((char32_t)src[i + 1] - 0xDC00);
+                *dst++ = (uint8_t)(0xF0 | (codePoint >> 18));
+                *dst++ = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+                *dst++ = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+                *dst++ = (uint8_t)(0x80 | (codePoint & 0x3F));
+                i += 2;
+            }
+        }
+
+        out.resize(dst - (uint8_t*)out.data());
+        return true;
+    }
+}
+
+bool Utf8ToUtf16(std::string_view in, std::u16string& out, size_t* errorOffset)
+{
+    return Utf8ToUtf16Impl(in, out, errorOffset, GetKernels().toUtf16);
+}
+
+bool Utf16ToUtf8(std::u16string_view in, std::string& out, size_t* errorOffset)
+{
+    return Utf16ToUtf8Impl(in, out, errorOffset, GetKernels().toUtf8);
+}
+
+bool Utf8ToUtf16Scalar(std::string_view in, std::u16string& out, size_t* errorOffset)
+{
+    return Utf8ToUtf16Impl(in, out, errorOffset, nullptr);
+}
+
+bool Utf16ToUtf8Scalar(std::u16string_view in, std::string& out, size_t* errorOffset)
+{
+    return Utf16ToUtf8Impl(in, out, errorOffset, nullptr);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Validating UTF-8 <-> UTF-16 transcoding.
+// With SSE4.1 or AVX2, chosen at runtime, ASCII is converted 16 or 32 code units at a time and
+// other BMP text (Latin, Hangul, CJK, ...) four sequences at a time, eight below U+0800 when encoding;
+// surrogate pairs are handled inline. The scalar code converts what the SIMD blocks leave (inputs
+// and tails under 80 bytes of UTF-8 or 32 UTF-16 units), reports errors, and is the fallback on
+// other CPUs.
+//
+// Both functions append to 'out'. On invalid input they return false, leave 'out' as it was and,
+// if errorOffset is given, store the offset of the first invalid code unit.
+// Invalid input is: truncated or overlong UTF-8 sequences, encoded surrogates, values above
+// U+10FFFF, and unpaired UTF-16 surrogates.
+bool Utf8ToUtf16(std::string_view in, std::u16string& out, size_t* errorOffset = nullptr);
+bool Utf16ToUtf8(std::u16string_view in, std::string& out, size_t* errorOffset = nullptr);
+
+// Scalar-only versions, for reference and for measuring the SIMD paths
+bool Utf8ToUtf16Scalar(std::string_view in, std::u16string& out, size_t* errorOffset = nullptr);
+bool Utf16ToUtf8Scalar(std::u16string_view in, std::string& out, size_t* errorOffset = nullptr);
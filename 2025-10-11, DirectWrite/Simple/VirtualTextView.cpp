@@ -0,0 +1,260 @@
+#include "VirtualTextView.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    constexpr size_t ShapingCacheBudget = 1024 * 1024;
+}
+
+VirtualTextView::VirtualTextView(const FontFace& face, float fontSize, float width, float viewportHeight, size_t maxCachedLines)
+    : format { &face, fontSize, width, ShapingFeatureKerning }
+    , shapingCache(ShapingCacheBudget)
+    , cachedLines(0)
+    , maxCachedLines(maxCachedLines)
+    , anchorParagraph(0)
+    , anchorOffset(0.0f)
+    , viewportHeight(viewportHeight)
+    , measuredWidth(0.0)
+    , measuredChars(0.0)
+    , stats {}
+{
+    Rebuild();
+}
+
+void VirtualTextView::SetText(std::u16string text)
+{
+    this->text = std::move(text);
+    measuredWidth = 0.0;
+    measuredChars = 0.0;
+    anchorParagraph = 0;
+    anchorOffset = 0.0f;
+    Rebuild();
+}
+
+void VirtualTextView::SetWidth(float width)
+{
+    if (format.maxWidth == width) return;
+
+    float scrollY = GetScrollY();
+    format.maxWidth = width;
+    Rebuild();
+    SetScrollY(scrollY);
+}
+
+std::u16string_view VirtualTextView::GetParagraphText(uint32_t index) const
+{
+    size_t start = paragraphStarts[index];
+    size_t end = paragraphStarts[index + 1] - 1; // the separator
+
+    if (end > start && text[end - 1] == u'\r') end--;
+    return std::u16string_view(text).substr(start, end - start);
+}
+
+float VirtualTextView::EstimateHeight(uint32_t index) const
+{
+    // before anything is measured, assume an average advance of half an em
+    double averageAdvance = measuredChars > 0.0 ? measuredWidth / measuredChars : format.fontSize * 0.5;
+    double width = GetParagraphText(index).size() * averageAdvance;
+
+    double lines = std::max(1.0, std::ceil(width / format.maxWidth));
+    return (float)(lines * GetLineHeight(format));
+}
+
+void VirtualTextView::Rebuild()
+{
+    paragraphStarts.clear();
+    ForEachParagraph(text, [&](size_t start, size_t) { paragraphStarts.push_back((uint32_t)start); });
+    paragraphStarts.push_back((uint32_t)text.size() + 1);
+
+    size_t count = paragraphStarts.size() - 1;
+
+    cache.clear();
+    lru.clear();
+    cachedLines = 0;
+
+    measured.assign(count, false);
+    heights.resize(count);
+    tree.assign(count + 1, 0.0);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        heights[i] = EstimateHeight(i);
+        tree[i + 1] = heights[i];
+    }
+
+    // O(n) Fenwick construction
+    for (size_t i = 1; i <= count; i++)
+    {
+        size_t parent = i + (i & (0 - i));
+        if (parent <= count) tree[parent] += tree[i];
+    }
+
+    anchorParagraph = std::min<uint32_t>(anchorParagraph, (uint32_t)count - 1);
+}
+
+double VirtualTextView::Sum(size_t count) const
+{
+    double sum = 0.0;
+    for (size_t i = count; i > 0; i -= i & (0 - i))
+        sum += tree[i];
+    return sum;
+}
+
+void VirtualTextView::Add(size_t index, double delta)
+{
+    for (size_t i = index + 1; i < tree.size(); i += i & (0 - i))
+        tree[i] += delta;
+}
+
+uint32_t VirtualTextView::FindParagraphAtY(double y, double& paragraphTop) const
+{
+    size_t count = tree.size() - 1;
+
+    size_t step = 1;
+    while (step * 2 <= count) step *= 2;
+
+    // descend to the last prefix whose height is <= y
+    size_t position = 0;
+    double remaining = y;
+    for (; step > 0; step /= 2)
+    {
+        if (position + step <= count && tree[position + step] <= remaining)
+        {
+            position += step;
+            remaining -= tree[position];
+        }
+    }
+
+    if (position >= count)
+    {
+        position = count - 1;
+        remaining = y - Sum(position);
+    }
+
+    paragraphTop = y - remaining;
+    return (uint32_t)position;
+}
+
+float VirtualTextView::GetScrollY() const
+{
+    return (float)(Sum(anchorParagraph) + anchorOffset);
+}
+
+void VirtualTextView::ScrollTo(double y)
+{
+    double maxScroll = std::max(0.0, Sum(heights.size()) - viewportHeight);
+    double clamped = std::clamp(y, 0.0, maxScroll);
+
+    double top;
+    anchorParagraph = FindParagraphAtY(clamped, top);
+    anchorOffset = (float)(clamped - top);
+}
+
+void VirtualTextView::Touch(CachedParagraph& entry, uint32_t index)
+{
+    lru.erase(entry.lruPosition);
+    lru.push_front(index);
+    entry.lruPosition = lru.begin();
+}
+
+const ParagraphLayout& VirtualTextView::GetLayout(uint32_t index)
+{
+    auto it = cache.find(index);
+    if (it != cache.end())
+    {
+        Touch(it->second, index);
+        return it->second.layout;
+    }
+
+    lru.push_front(index);
+    CachedParagraph& entry = cache[index];
+    entry.lruPosition = lru.begin();
+
+    std::u16string_view paragraph = GetParagraphText(index);
+    LayoutParagraph(shapingCache, format, paragraph, entry.layout);
+    entry.layout.textStart = paragraphStarts[index];
+
+    cachedLines += entry.layout.lines.size();
+    stats.paragraphsLaidOut++;
+
+    // replace the estimate, once
+    if (!measured[index])
+    {
+        measured[index] = true;
+
+        for (const TextLine& line : entry.layout.lines)
+            measuredWidth += line.width;
+        measuredChars += paragraph.size();
+
+        Add(index, (double)entry.layout.height - heights[index]);
+        heights[index] = entry.layout.height;
+    }
+
+    return entry.layout;
+}
+
+void VirtualTextView::Evict(uint32_t keepFrom, uint32_t keepTo)
+{
+    while (cachedLines > maxCachedLines && !lru.empty())
+    {
+        uint32_t index = lru.back();
+
+        // everything visible was touched this frame, so only visible paragraphs are left
+        if (keepFrom <= index && index < keepTo) break;
+
+        auto it = cache.find(index);
+        cachedLines -= it->second.layout.lines.size();
+        cache.erase(it);
+        lru.pop_back();
+    }
+}
+
+void VirtualTextView::GetVisibleLines(std::vector<VisibleLine>& lines)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    stats.paragraphsLaidOut = 0;
+    lines.clear();
+
+    float lineHeight = GetLineHeight(format);
+    uint32_t count = (uint32_t)heights.size();
+
+    // the anchor may have been shorter than estimated: the rest of the offset carries over into the
+    // paragraphs after it, and only the last paragraph keeps its last line in view
+    while (anchorParagraph + 1 < count && anchorOffset >= GetLayout(anchorParagraph).height)
+    {
+        anchorOffset -= GetLayout(anchorParagraph).height;
+        anchorParagraph++;
+    }
+
+    if (anchorParagraph + 1 == count)
+        anchorOffset = std::min(anchorOffset, std::max(0.0f, GetLayout(anchorParagraph).height - lineHeight));
+
+    uint32_t first = anchorParagraph;
+    uint32_t index = first;
+    float y = -anchorOffset;
+
+    while (index < count && y < viewportHeight)
+    {
+        const ParagraphLayout& paragraph = GetLayout(index);
+
+        for (const TextLine& line : paragraph.lines)
+        {
+            if (y + lineHeight > 0.0f && y < viewportHeight)
+                lines.push_back({ index, &paragraph, &line, y });
+            y += lineHeight;
+        }
+
+        index++;
+    }
+
+    Evict(first, index);
+
+    auto end = std::chrono::steady_clock::now();
+    stats.cachedParagraphs = (uint32_t)cache.size();
+    stats.cachedLines = (uint32_t)cachedLines;
+    stats.microseconds = std::chrono::duration<double, std::micro>(end - start).count();
+}
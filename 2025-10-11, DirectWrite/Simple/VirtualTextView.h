@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ShapingCache.h"
+#include "TextLayout.h"
+
+struct VisibleLine
+{
+    uint32_t paragraphIndex;
+    const ParagraphLayout* paragraph;   // valid until the next call that changes the view
+    const TextLine* line;
+    float y;                            // top of the line relative to the viewport
+};
+
+struct VirtualTextViewStats
+{
+    uint32_t paragraphsLaidOut;     // by the last GetVisibleLines call
+    uint32_t cachedParagraphs;
+    uint32_t cachedLines;
+    double microseconds;            // of the last GetVisibleLines call
+};
+
+// Scrollable view of a document far taller than the window.
+// Only paragraphs that reach the viewport are laid out; the height of every other paragraph is
+// estimated from its length and the average advance seen so far. Paragraph heights live in a
+// Fenwick tree, so y <-> paragraph lookups are O(log n) and an estimate is replaced by the real
+// height in O(log n) once the paragraph has been laid out. Laid out paragraphs are kept in an LRU
+// cache bounded by their total line count.
+//
+// Scrolling is anchored to the first visible paragraph, so corrected estimates above or below it
+// do not make the content jump.
+class VirtualTextView
+{
+    struct CachedParagraph
+    {
+        ParagraphLayout layout;
+        std::list<uint32_t>::iterator lruPosition;
+    };
+
+    LayoutFormat format;
+    ShapingCache shapingCache;
+
+    std::u16string text;
+    std::vector<uint32_t> paragraphStarts;  // one past the end holds text.size() + 1
+    std::vector<float> heights;             // current height of each paragraph, exact or estimated
+    std::vector<double> tree;               // Fenwick tree over 'heights'
+    std::vector<bool> measured;
+
+    std::unordered_map<uint32_t, CachedParagraph> cache;
+    std::list<uint32_t> lru;                // most recently used first
+    size_t cachedLines;
+    size_t maxCachedLines;
+
+    uint32_t anchorParagraph;
+    float anchorOffset;                     // scroll position inside the anchor paragraph
+    float viewportHeight;
+
+    double measuredWidth;                   // advance totals of laid out paragraphs, for estimates
+    double measuredChars;
+
+    VirtualTextViewStats stats;
+
+public:
+    VirtualTextView(const FontFace& face, float fontSize, float width, float viewportHeight, size_t maxCachedLines = 4096);
+
+    void SetText(std::u16string text);
+
+    // A new width drops every layout and re-estimates all heights
+    void SetWidth(float width);
+    void SetViewportHeight(float height) { viewportHeight = height; }
+
+    float GetScrollY() const;
+    void SetScrollY(float y) { ScrollTo(y); }
+
+    // Relative to the anchor in double precision: far down a long document a float scroll
+    // position is too coarse to move by a fraction of a line
+    void ScrollBy(float dy) { ScrollTo(Sum(anchorParagraph) + anchorOffset + dy); }
+
+    // Total height, exact for laid out paragraphs and estimated for the rest
+    float GetContentHeight() const { return (float)Sum(paragraphStarts.size() - 1); }
+    size_t GetParagraphCount() const { return paragraphStarts.size() - 1; }
+
+    // Lays out what the viewport shows and returns its lines, top to bottom
+    void GetVisibleLines(std::vector<VisibleLine>& lines);
+
+    const VirtualTextViewStats& GetStats() const { return stats; }
+
+private:
+    std::u16string_view GetParagraphText(uint32_t index) const;
+    float EstimateHeight(uint32_t index) const;
+    void Rebuild();
+
+    double Sum(size_t count) const;         // height of the first 'count' paragraphs
+    void Add(size_t index, double delta);
+    uint32_t FindParagraphAtY(double y, double& paragraphTop) const;
+    void ScrollTo(double y);
+
+    const ParagraphLayout& GetLayout(uint32_t index);
+    void Touch(CachedParagraph& entry, uint32_t index);
+    void Evict(uint32_t keepFrom, uint32_t keepTo);
+};
@@ -0,0 +1,108 @@
+//
+//  FramePacer.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const double SmoothingFactor = 0.1;
+}
+
+void FramePacer::Smoothed::Add(double value)
+{
+    if (count == 0)
+    {
+        mean = value;
+        deviation = 0;
+    }
+    else
+    {
+        deviation += SmoothingFactor * (std::fabs(value - mean) - deviation);
+        mean += SmoothingFactor * (value - mean);
+    }
+
+    count++;
+}
+
+FramePacer::FramePacer(const FramePacingSettings& settings)
+    : settings(settings)
+    , depth(settings.maxDepth)
+    , pendingDirection(0)
+    , pendingFrames(0)
+    , lastWait(0)
+    , frames(0)
+    , depthChanges(0)
+{
+}
+
+FramePacingStats FramePacer::GetStats() const
+{
+    return { depth, cpu.mean, gpu.mean, wait.mean, latency.mean, lastWait, frames, depthChanges };
+}
+
+void FramePacer::RecordGpuFrame(double gpuSeconds, double latencySeconds)
+{
+    gpu.Add(gpuSeconds);
+    latency.Add(latencySeconds);
+}
+
+int FramePacer::GetWantedDepth() const
+{
+    if (gpu.count < (uint64_t)settings.warmUpFrames || cpu.count == 0) return depth;
+
+    // throughput: serial frames fit, overlapped frames fit, or only a deeper queue helps
+    int wanted;
+    if (cpu.High() + gpu.High() <= settings.frameBudget)
+        wanted = 1;
+    else if (std::max(cpu.High(), gpu.High()) <= settings.frameBudget)
+        wanted = 2;
+    else
+        wanted = 3;
+
+    wanted = std::clamp(wanted, settings.minDepth, settings.maxDepth);
+
+    // latency: each extra frame queued adds one frame period, however long that turns out
+    double period = std::max({ cpu.mean, gpu.mean, settings.frameBudget });
+    while (wanted > depth && latency.mean + (wanted - depth) * period > settings.targetLatency)
+        wanted--;
+
+    if (wanted >= depth && depth > settings.minDepth && latency.mean > settings.targetLatency)
+        wanted = depth - 1;
+
+    return wanted;
+}
+
+void FramePacer::RecordCpuFrame(double cpuSeconds, double waitSeconds)
+{
+    cpu.Add(cpuSeconds);
+    wait.Add(waitSeconds);
+    lastWait = waitSeconds;
+    frames++;
+
+    int wanted = GetWantedDepth();
+    int direction = wanted > depth ? 1 : wanted < depth ? -1 : 0;
+
+    if (direction != pendingDirection)
+    {
+        pendingDirection = direction;
+        pendingFrames = 0;
+    }
+
+    if (direction == 0) return;
+
+    pendingFrames++;
+    if (pendingFrames < (direction > 0 ? settings.raiseAfterFrames : settings.lowerAfterFrames)) return;
+
+    // one step at a time; the latency average has to catch up before the next
+    depth += direction;
+    depthChanges++;
+    pendingDirection = 0;
+    pendingFrames = 0;
+}
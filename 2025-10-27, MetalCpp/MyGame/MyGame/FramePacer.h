@@ -0,0 +1,92 @@
+//
+//  FramePacer.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Chooses how many frames the CPU may run ahead of the GPU (1 to 3).
+//
+// One frame in flight has the lowest latency, but the CPU and the GPU then take turns, so a frame
+// costs cpu + gpu. Two overlap them and a frame costs max(cpu, gpu). A third absorbs spikes,
+// at the cost of one more frame of queueing whenever the GPU or the display is the bottleneck.
+//
+// The pacer picks the smallest depth that keeps up with the frame budget, judged on smoothed
+// times plus two mean deviations, and never raises it past what the target latency allows. It
+// raises quickly and lowers slowly so that a single slow frame does not make it oscillate.
+//
+// Nothing here reads a clock: the renderer feeds measured times in, and synthetic timelines can
+// be fed the same way.
+
+#pragma once
+
+#include <cstdint>
+
+struct FramePacingSettings
+{
+    double frameBudget = 1.0 / 60.0;    // seconds per frame we want to sustain
+    double targetLatency = 0.050;       // seconds from the start of CPU work to GPU completion
+    int minDepth = 1;
+    int maxDepth = 3;
+    int raiseAfterFrames = 4;           // consecutive frames asking for more depth
+    int lowerAfterFrames = 60;          // consecutive frames asking for less
+    int warmUpFrames = 8;               // GPU samples needed before the depth moves
+};
+
+struct FramePacingStats
+{
+    int depth;
+    double cpuTime;             // smoothed, seconds
+    double gpuTime;
+    double waitTime;
+    double latency;
+    double lastWaitTime;
+    uint64_t frames;
+    uint64_t depthChanges;
+};
+
+class FramePacer
+{
+    // Exponential moving average with mean absolute deviation
+    struct Smoothed
+    {
+        double mean = 0;
+        double deviation = 0;
+        uint64_t count = 0;
+
+        void Add(double value);
+        double High() const { return mean + 2 * deviation; }
+    };
+
+    FramePacingSettings settings;
+    int depth;
+    int pendingDirection;       // -1, 0 or 1
+    int pendingFrames;
+
+    Smoothed cpu;
+    Smoothed gpu;
+    Smoothed wait;
+    Smoothed latency;
+    double lastWait;
+    uint64_t frames;
+    uint64_t depthChanges;
+
+public:
+    // Starts at maxDepth until there is enough data
+    explicit FramePacer(const FramePacingSettings& settings = {});
+
+    int GetDepth() const { return depth; }
+    const FramePacingSettings& GetSettings() const { return settings; }
+    FramePacingStats GetStats() const;
+
+    // Once per completed command buffer: GPU execution time, and the time from the start of the
+    // frame's CPU work to GPU completion
+    void RecordGpuFrame(double gpuSeconds, double latencySeconds);
+
+    // Once per CPU frame, after encoding: the time spent encoding and the time blocked waiting
+    // for a free slot. Updates the depth for the next frame.
+    void RecordCpuFrame(double cpuSeconds, double waitSeconds);
+
+    // Depth the measurements currently call for, before hysteresis
+    int GetWantedDepth() const;
+};
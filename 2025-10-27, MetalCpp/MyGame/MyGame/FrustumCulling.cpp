@@ -0,0 +1,362 @@
+//
+//  FrustumCulling.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "FrustumCulling.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Writes every index and only advances past the visible ones, so there is no branch to
+    // mispredict; 'visible[count]' is never past 'first', which the caller has room for
+    inline size_t AppendVisible(unsigned mask, size_t first, int lanes, uint32_t* visible, size_t count)
+    {
+        for (int k = 0; k < lanes; k++)
+        {
+            visible[count] = (uint32_t)(first + k);
+            count += (mask >> k) & 1;
+        }
+
+        return count;
+    }
+
+    size_t CullSpheresRange(const ObjectBounds& bounds, const Float4 planes[6], size_t begin, size_t end, uint32_t* visible, size_t count)
+    {
+        const float* x = bounds.sphereX.data();
+        const float* y = bounds.sphereY.data();
+        const float* z = bounds.sphereZ.data();
+        const float* r = bounds.radius.data();
+
+        for (size_t i = begin; i < end; i++)
+        {
+            bool inside = true;
+            for (int p = 0; p < 6; p++)
+                inside &= planes[p].x * x[i] + planes[p].y * y[i] + planes[p].z * z[i] + (planes[p].w + r[i]) >= 0;
+
+            visible[count] = (uint32_t)i;
+            count += inside;
+        }
+
+        return count;
+    }
+
+    // The box corner farthest along the plane normal decides: center distance plus the extents
+    // projected onto |normal|
+    size_t CullBoxesRange(const ObjectBounds& bounds, const Float4 planes[6], size_t begin, size_t end, uint32_t* visible, size_t count)
+    {
+        const float* x = bounds.boxX.data();
+        const float* y = bounds.boxY.data();
+        const float* z = bounds.boxZ.data();
+        const float* ex = bounds.extentX.data();
+        const float* ey = bounds.extentY.data();
+        const float* ez = bounds.extentZ.data();
+
+        for (size_t i = begin; i < end; i++)
+        {
+            bool inside = true;
+            for (int p = 0; p < 6; p++)
+            {
+                float center = planes[p].x * x[i] + planes[p].y * y[i] + planes[p].z * z[i] + planes[p].w;
+                float extent = std::fabs(planes[p].x) * ex[i] + std::fabs(planes[p].y) * ey[i] + std::fabs(planes[p].z) * ez[i];
+                inside &= center + extent >= 0;
+            }
+
+            visible[count] = (uint32_t)i;
+            count += inside;
+        }
+
+        return count;
+    }
+}
+
+void ObjectBounds::Clear()
+{
+    for (std::vector<float>* v : { &sphereX, &sphereY, &sphereZ, &radius, &boxX, &boxY, &boxZ, &extentX, &extentY, &extentZ })
+        v->clear();
+}
+
+size_t ObjectBounds::Add(const Float3& boxMin, const Float3& boxMax)
+{
+    size_t index = GetCount();
+    for (std::vector<float>* v : { &sphereX, &sphereY, &sphereZ, &radius, &boxX, &boxY, &boxZ, &extentX, &extentY, &extentZ })
+        v->push_back(0);
+
+    SetBox(index, boxMin, boxMax);
+    SetSphere(index, (boxMin + boxMax) * 0.5f, Length(boxMax - boxMin) * 0.5f);
+    return index;
+}
+
+void ObjectBounds::SetSphere(size_t index, const Float3& center, float sphereRadius)
+{
+    sphereX[index] = center.x;
+    sphereY[index] = center.y;
+    sphereZ[index] = center.z;
+    radius[index] = sphereRadius;
+}
+
+void ObjectBounds::SetBox(size_t index, const Float3& boxMin, const Float3& boxMax)
+{
+    Float3 center = (boxMin + boxMax) * 0.5f;
+    Float3 extent = (boxMax - boxMin) * 0.5f;
+
+    boxX[index] = center.x;
+    boxY[index] = center.y;
+    boxZ[index] = center.z;
+    extentX[index] = extent.x;
+    extentY[index] = extent.y;
+    extentZ[index] = extent.z;
+}
+
+void ObjectBounds::SetTransformed(size_t index, const Float3& localMin, const Float3& localMax, const Float4x4& transform)
+{
+    Float3 localCenter = (localMin + localMax) * 0.5f;
+    Float3 localExtent = (localMax - localMin) * 0.5f;
+
+    const Float4* c = transform.columns;
+    Float3 center = c[0].Xyz() * localCenter.x + c[1].Xyz() * localCenter.y + c[2].Xyz() * localCenter.z + c[3].Xyz();
+
+    // each world axis gets the local extents through the absolute values of its matrix row
+    Float3 extent =
+    {
+        std::fabs(c[0].x) * localExtent.x + std::fabs(c[1].x) * localExtent.y + std::fabs(c[2].x) * localExtent.z,
+        std::fabs(c[0].y) * localExtent.x + std::fabs(c[1].y) * localExtent.y + std::fabs(c[2].y) * localExtent.z,
+        std::fabs(c[0].z) * localExtent.x + std::fabs(c[1].z) * localExtent.y + std::fabs(c[2].z) * localExtent.z,
+    };
+
+    SetBox(index, center - extent, center + extent);
+
+    float scale = std::max({ Length(c[0].Xyz()), Length(c[1].Xyz()), Length(c[2].Xyz()) });
+    SetSphere(index, center, Length(localExtent) * scale);
+}
+
+size_t CullSpheresScalar(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible)
+{
+    return CullSpheresRange(bounds, planes, 0, bounds.GetCount(), visible, 0);
+}
+
+size_t CullSpheres(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible)
+{
+    const float* x = bounds.sphereX.data();
+    const float* y = bounds.sphereY.data();
+    const float* z = bounds.sphereZ.data();
+    const float* r = bounds.radius.data();
+
+    size_t objectCount = bounds.GetCount();
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(SIMDMATH_AVX)
+    __m256 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm256_set1_ps(planes[p].x);
+        py[p] = _mm256_set1_ps(planes[p].y);
+        pz[p] = _mm256_set1_ps(planes[p].z);
+        pw[p] = _mm256_set1_ps(planes[p].w);
+    }
+
+    __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= objectCount; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(x + i);
+        __m256 cy = _mm256_loadu_ps(y + i);
+        __m256 cz = _mm256_loadu_ps(z + i);
+        __m256 cr = _mm256_loadu_ps(r + i);
+
+        __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+        for (int p = 0; p < 6; p++)
+        {
+            __m256 d = _mm256_add_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], cx), _mm256_mul_ps(py[p], cy)), _mm256_mul_ps(pz[p], cz)),
+                _mm256_add_ps(pw[p], cr));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, zero, _CMP_GE_OQ));
+        }
+
+        count = AppendVisible((unsigned)_mm256_movemask_ps(inside), i, 8, visible, count);
+    }
+#elif defined(SIMDMATH_SSE)
+    __m128 px[6], py[6], pz[6], pw[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm_set1_ps(planes[p].x);
+        py[p] = _mm_set1_ps(planes[p].y);
+        pz[p] = _mm_set1_ps(planes[p].z);
+        pw[p] = _mm_set1_ps(planes[p].w);
+    }
+
+    __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= objectCount; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 cr = _mm_loadu_ps(r + i);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 d = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)), _mm_mul_ps(pz[p], cz)),
+                _mm_add_ps(pw[p], cr));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, zero));
+        }
+
+        count = AppendVisible((unsigned)_mm_movemask_ps(inside), i, 4, visible, count);
+    }
+#elif defined(SIMDMATH_NEON)
+    const uint32_t laneBitValues[4] = { 1, 2, 4, 8 };
+    uint32x4_t laneBits = vld1q_u32(laneBitValues);
+
+    for (; i + 4 <= objectCount; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(x + i);
+        float32x4_t cy = vld1q_f32(y + i);
+        float32x4_t cz = vld1q_f32(z + i);
+        float32x4_t cr = vld1q_f32(r + i);
+
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+        for (int p = 0; p < 6; p++)
+        {
+            float32x4_t d = vaddq_f32(vdupq_n_f32(planes[p].w), cr);
+            d = vfmaq_n_f32(d, cx, planes[p].x);
+            d = vfmaq_n_f32(d, cy, planes[p].y);
+            d = vfmaq_n_f32(d, cz, planes[p].z);
+            inside = vandq_u32(inside, vcgezq_f32(d));
+        }
+
+        count = AppendVisible(vaddvq_u32(vandq_u32(inside, laneBits)), i, 4, visible, count);
+    }
+#endif
+
+    return CullSpheresRange(bounds, planes, i, objectCount, visible, count);
+}
+
+size_t CullBoxesScalar(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible)
+{
+    return CullBoxesRange(bounds, planes, 0, bounds.GetCount(), visible, 0);
+}
+
+size_t CullBoxes(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible)
+{
+    const float* x = bounds.boxX.data();
+    const float* y = bounds.boxY.data();
+    const float* z = bounds.boxZ.data();
+    const float* ex = bounds.extentX.data();
+    const float* ey = bounds.extentY.data();
+    const float* ez = bounds.extentZ.data();
+
+    size_t objectCount = bounds.GetCount();
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(SIMDMATH_AVX)
+    __m256 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm256_set1_ps(planes[p].x);
+        py[p] = _mm256_set1_ps(planes[p].y);
+        pz[p] = _mm256_set1_ps(planes[p].z);
+        pw[p] = _mm256_set1_ps(planes[p].w);
+        ax[p] = _mm256_set1_ps(std::fabs(planes[p].x));
+        ay[p] = _mm256_set1_ps(std::fabs(planes[p].y));
+        az[p] = _mm256_set1_ps(std::fabs(planes[p].z));
+    }
+
+    __m256 zero = _mm256_setzero_ps();
+    for (; i + 8 <= objectCount; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(x + i);
+        __m256 cy = _mm256_loadu_ps(y + i);
+        __m256 cz = _mm256_loadu_ps(z + i);
+        __m256 hx = _mm256_loadu_ps(ex + i);
+        __m256 hy = _mm256_loadu_ps(ey + i);
+        __m256 hz = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+        for (int p = 0; p < 6; p++)
+        {
+            __m256 center = _mm256_add_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(px[p], cx), _mm256_mul_ps(py[p], cy)), _mm256_mul_ps(pz[p], cz)),
+                pw[p]);
+            __m256 extent = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(ax[p], hx), _mm256_mul_ps(ay[p], hy)),
+                _mm256_mul_ps(az[p], hz));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(center, extent), zero, _CMP_GE_OQ));
+        }
+
+        count = AppendVisible((unsigned)_mm256_movemask_ps(inside), i, 8, visible, count);
+    }
+#elif defined(SIMDMATH_SSE)
+    __m128 px[6], py[6], pz[6], pw[6], ax[6], ay[6], az[6];
+    for (int p = 0; p < 6; p++)
+    {
+        px[p] = _mm_set1_ps(planes[p].x);
+        py[p] = _mm_set1_ps(planes[p].y);
+        pz[p] = _mm_set1_ps(planes[p].z);
+        pw[p] = _mm_set1_ps(planes[p].w);
+        ax[p] = _mm_set1_ps(std::fabs(planes[p].x));
+        ay[p] = _mm_set1_ps(std::fabs(planes[p].y));
+        az[p] = _mm_set1_ps(std::fabs(planes[p].z));
+    }
+
+    __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= objectCount; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 hx = _mm_loadu_ps(ex + i);
+        __m128 hy = _mm_loadu_ps(ey + i);
+        __m128 hz = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (int p = 0; p < 6; p++)
+        {
+            __m128 center = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)), _mm_mul_ps(pz[p], cz)),
+                pw[p]);
+            __m128 extent = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ax[p], hx), _mm_mul_ps(ay[p], hy)),
+                _mm_mul_ps(az[p], hz));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(center, extent), zero));
+        }
+
+        count = AppendVisible((unsigned)_mm_movemask_ps(inside), i, 4, visible, count);
+    }
+#elif defined(SIMDMATH_NEON)
+    const uint32_t laneBitValues[4] = { 1, 2, 4, 8 };
+    uint32x4_t laneBits = vld1q_u32(laneBitValues);
+
+    for (; i + 4 <= objectCount; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(x + i);
+        float32x4_t cy = vld1q_f32(y + i);
+        float32x4_t cz = vld1q_f32(z + i);
+        float32x4_t hx = vld1q_f32(ex + i);
+        float32x4_t hy = vld1q_f32(ey + i);
+        float32x4_t hz = vld1q_f32(ez + i);
+
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFF);
+        for (int p = 0; p < 6; p++)
+        {
+            float32x4_t d = vdupq_n_f32(planes[p].w);
+            d = vfmaq_n_f32(d, cx, planes[p].x);
+            d = vfmaq_n_f32(d, cy, planes[p].y);
+            d = vfmaq_n_f32(d, cz, planes[p].z);
+            d = vfmaq_n_f32(d, hx, std::fabs(planes[p].x));
+            d = vfmaq_n_f32(d, hy, std::fabs(planes[p].y));
+            d = vfmaq_n_f32(d, hz, std::fabs(planes[p].z));
+            inside = vandq_u32(inside, vcgezq_f32(d));
+        }
+
+        count = AppendVisible(vaddvq_u32(vandq_u32(inside, laneBits)), i, 4, visible, count);
+    }
+#endif
+
+    return CullBoxesRange(bounds, planes, i, objectCount, visible, count);
+}
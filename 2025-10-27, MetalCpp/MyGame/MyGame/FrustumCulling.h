@@ -0,0 +1,54 @@
+//
+//  FrustumCulling.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// View frustum culling for scenes of tens of thousands of objects. Bounds live in SoA arrays, one
+// per component, so the SIMD versions load 8 objects per instruction with AVX and 4 with SSE or
+// NEON and test them against all six planes before moving on; survivors are written out as a
+// compact list of object indices. The Scalar versions do the same one object at a time, for
+// comparison, and finish the tail of the SIMD loops.
+//
+// Planes come from ExtractFrustumPlanes(projection * view) and bounds are in world space. Both
+// tests are conservative: an object is culled only if its volume lies entirely outside one plane.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SimdMath.h"
+
+struct ObjectBounds
+{
+    // Bounding sphere
+    std::vector<float> sphereX, sphereY, sphereZ, radius;
+
+    // Axis-aligned box, as center and half size
+    std::vector<float> boxX, boxY, boxZ, extentX, extentY, extentZ;
+
+    size_t GetCount() const { return radius.size(); }
+
+    void Clear();
+
+    // The sphere around the box; returns the object's index
+    size_t Add(const Float3& boxMin, const Float3& boxMax);
+
+    void SetSphere(size_t index, const Float3& center, float radius);
+    void SetBox(size_t index, const Float3& boxMin, const Float3& boxMax);
+
+    // Both volumes of a local box moved by 'transform': the world box around the transformed
+    // box, and the sphere around the local box scaled by the largest axis scale
+    void SetTransformed(size_t index, const Float3& localMin, const Float3& localMax, const Float4x4& transform);
+};
+
+// Each writes the indices of the objects at least partly inside all six planes to 'visible',
+// which must hold GetCount() entries, and returns how many there are
+size_t CullSpheresScalar(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible);
+size_t CullSpheres(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible);
+
+size_t CullBoxesScalar(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible);
+size_t CullBoxes(const ObjectBounds& bounds, const Float4 planes[6], uint32_t* visible);
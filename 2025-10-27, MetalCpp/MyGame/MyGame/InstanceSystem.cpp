@@ -0,0 +1,158 @@
+//
+//  InstanceSystem.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "InstanceSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Instances per job: enough to amortize handing out chunks, and tens of kilobytes of
+    // matrices each, so neighboring jobs share a cache line only at their ends
+    const size_t JobGrain = 512;
+
+    // Instances per block of spins in Update
+    const size_t SpinBlock = 64;
+
+    const float TwoPi = 6.28318531f;
+
+    template<typename Func>
+    void ParallelFor(ThreadPool* pool, size_t count, Func&& func)
+    {
+        if (pool)
+            pool->ParallelFor(count, JobGrain, [&](size_t begin, size_t end, size_t) { func(begin, end); });
+        else
+            func(0, count);
+    }
+}
+
+InstanceSystem::InstanceSystem(const Float3& localMin, const Float3& localMax)
+    : localMin(localMin)
+    , localMax(localMax)
+{
+}
+
+void InstanceSystem::Clear()
+{
+    for (std::vector<float>* v : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ,
+                                   &spinAxisX, &spinAxisY, &spinAxisZ, &spinRate, &spinAngle })
+        v->clear();
+
+    modelMatrices.clear();
+    bounds.Clear();
+}
+
+size_t InstanceSystem::Add(const Float3& position, const Quat& rotation, const Float3& scale)
+{
+    size_t index = GetCount();
+    for (std::vector<float>* v : { &positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ, &rotationW, &scaleX, &scaleY, &scaleZ,
+                                   &spinAxisX, &spinAxisY, &spinAxisZ, &spinRate, &spinAngle })
+        v->push_back(0);
+
+    SetPosition(index, position);
+    SetRotation(index, rotation);
+    SetScale(index, scale);
+    SetSpin(index, { 0, 1, 0 }, 0);
+
+    Float4x4 model = MakeTransform(position, rotation, scale);
+    modelMatrices.push_back(model);
+    bounds.Add(localMin, localMax);
+    bounds.SetTransformed(index, localMin, localMax, model);
+    return index;
+}
+
+void InstanceSystem::SetPosition(size_t index, const Float3& position)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+}
+
+void InstanceSystem::SetRotation(size_t index, const Quat& rotation)
+{
+    rotationX[index] = rotation.x;
+    rotationY[index] = rotation.y;
+    rotationZ[index] = rotation.z;
+    rotationW[index] = rotation.w;
+}
+
+void InstanceSystem::SetScale(size_t index, const Float3& scale)
+{
+    scaleX[index] = scale.x;
+    scaleY[index] = scale.y;
+    scaleZ[index] = scale.z;
+}
+
+void InstanceSystem::SetSpin(size_t index, const Float3& axis, float rate, float angle)
+{
+    Float3 unit = Normalize(axis);
+    spinAxisX[index] = unit.x;
+    spinAxisY[index] = unit.y;
+    spinAxisZ[index] = unit.z;
+    spinRate[index] = rate;
+    spinAngle[index] = angle;
+}
+
+void InstanceSystem::Update(ThreadPool* pool, float deltaTime)
+{
+    ParallelFor(pool, GetCount(), [&](size_t begin, size_t end)
+    {
+        // spins a block at a time ahead of the matrices, which keeps the sincos calls out of the
+        // transform loop
+        Quat spins[SpinBlock];
+
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += SpinBlock)
+        {
+            size_t blockEnd = std::min(blockBegin + SpinBlock, end);
+
+            for (size_t i = blockBegin; i < blockEnd; i++)
+            {
+                // kept within a turn so the angle does not lose precision over a long run
+                float angle = spinAngle[i] + spinRate[i] * deltaTime;
+                if (angle > TwoPi)
+                    angle -= TwoPi;
+                else if (angle < -TwoPi)
+                    angle += TwoPi;
+
+                spinAngle[i] = angle;
+
+                Quat spin = Quat::Identity();
+                if (angle != 0)
+                {
+                    float s = std::sin(angle * 0.5f);
+                    spin = { spinAxisX[i] * s, spinAxisY[i] * s, spinAxisZ[i] * s, std::cos(angle * 0.5f) };
+                }
+
+                spins[i - blockBegin] = spin;
+            }
+
+            for (size_t i = blockBegin; i < blockEnd; i++)
+            {
+                Float3 position = { positionX[i], positionY[i], positionZ[i] };
+                Quat rotation = spins[i - blockBegin] * Quat { rotationX[i], rotationY[i], rotationZ[i], rotationW[i] };
+                Float3 scale = { scaleX[i], scaleY[i], scaleZ[i] };
+
+                modelMatrices[i] = MakeTransform(position, rotation, scale);
+                bounds.SetTransformed(i, localMin, localMax, modelMatrices[i]);
+            }
+        }
+    });
+}
+
+void InstanceSystem::WriteMatrices(const Float4x4& view, const uint32_t* instances, size_t count, InstanceMatrices* out, ThreadPool* pool) const
+{
+    ParallelFor(pool, count, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const Float4x4& model = modelMatrices[instances[i]];
+            out[i].modelMatrix = model;
+            out[i].modelViewMatrix = view * model;
+        }
+    });
+}
@@ -0,0 +1,78 @@
+//
+//  InstanceSystem.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Many copies of one mesh, drawn with a single instanced call. Positions, rotations, scales and
+// spins live in SoA arrays, one per component. Each frame:
+//
+// 1. Update: spins, model matrices and world bounds of every instance, for FrustumCulling
+// 2. CullBoxes on GetBounds() against the view
+// 3. WriteMatrices: model and model-view matrices of the visible instances, straight into the
+//    frame's upload buffer as InstanceUniforms (see ShaderTypes.h)
+//
+// Both passes split the instances across a ThreadPool, in chunks so that no two workers write the
+// same cache lines for long; a null pool runs them on the calling thread.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FrustumCulling.h"
+#include "SimdMath.h"
+#include "ThreadPool.h"
+
+// Layout of InstanceUniforms in ShaderTypes.h
+struct InstanceMatrices
+{
+    Float4x4 modelMatrix;
+    Float4x4 modelViewMatrix;
+};
+
+class InstanceSystem
+{
+    // Mesh bounds every instance transforms
+    Float3 localMin;
+    Float3 localMax;
+
+    std::vector<Float4x4> modelMatrices;
+    ObjectBounds bounds;
+
+public:
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+    std::vector<float> scaleX, scaleY, scaleZ;
+
+    // Turn about a unit axis applied after 'rotation', spinAngle radians so far. Update advances
+    // the angle, so animated instances need no per-frame SetRotation on the calling thread.
+    std::vector<float> spinAxisX, spinAxisY, spinAxisZ;
+    std::vector<float> spinRate, spinAngle;
+
+    InstanceSystem(const Float3& localMin, const Float3& localMax);
+
+    size_t GetCount() const { return positionX.size(); }
+
+    void Clear();
+    size_t Add(const Float3& position, const Quat& rotation, const Float3& scale = { 1, 1, 1 });
+
+    void SetPosition(size_t index, const Float3& position);
+    void SetRotation(size_t index, const Quat& rotation);
+    void SetScale(size_t index, const Float3& scale);
+
+    // 'rate' in radians per unit of Update's deltaTime; instances start without spin
+    void SetSpin(size_t index, const Float3& axis, float rate, float angle = 0);
+
+    // Advances every spin by its rate * deltaTime, then rebuilds the matrices and bounds
+    void Update(ThreadPool* pool, float deltaTime = 0);
+
+    // As of the last Update
+    const std::vector<Float4x4>& GetModelMatrices() const { return modelMatrices; }
+    const ObjectBounds& GetBounds() const { return bounds; }
+
+    // out[i] = { model, view * model } of instance instances[i]
+    void WriteMatrices(const Float4x4& view, const uint32_t* instances, size_t count, InstanceMatrices* out, ThreadPool* pool) const;
+};
@@ -0,0 +1,436 @@
+//
+//  MeshGenerator.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "MeshGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace
+{
+    const float Pi = 3.14159265358979f;
+
+    // Quads per stripe: the previous and the current row of a stripe, 2 * (StripeWidth + 1)
+    // vertices, stay within a 16-entry FIFO cache with two entries to spare. An exact fit only
+    // works when the stripe starts with the cache in step, which reordering breaks.
+    const int StripeWidth = 6;
+
+    class MeshBuilder
+    {
+        MeshData mesh;
+        std::vector<uint32_t> indices;
+
+    public:
+        void Reserve(size_t vertexCount, size_t indexCount)
+        {
+            mesh.positions.reserve(vertexCount);
+            mesh.texcoords.reserve(vertexCount);
+            indices.reserve(indexCount);
+        }
+
+        uint32_t AddVertex(const Float3& position, const Float2& texcoord)
+        {
+            mesh.positions.push_back(position);
+            mesh.texcoords.push_back(texcoord);
+            return (uint32_t)mesh.positions.size() - 1;
+        }
+
+        uint32_t GetVertexCount() const { return (uint32_t)mesh.positions.size(); }
+        Float3 GetPosition(uint32_t index) const { return mesh.positions[index]; }
+        Float2 GetTexcoord(uint32_t index) const { return mesh.texcoords[index]; }
+        void SetTexcoord(uint32_t index, const Float2& texcoord) { mesh.texcoords[index] = texcoord; }
+        std::vector<uint32_t>& GetIndices() { return indices; }
+
+        void AddTriangle(uint32_t a, uint32_t b, uint32_t c)
+        {
+            indices.push_back(a);
+            indices.push_back(b);
+            indices.push_back(c);
+        }
+
+        // 'top' and 'bottom' are the rows of vertices above and below, left to right seen from the front
+        void AddQuad(uint32_t topLeft, uint32_t topRight, uint32_t bottomLeft, uint32_t bottomRight)
+        {
+            AddTriangle(topLeft, bottomLeft, bottomRight);
+            AddTriangle(topLeft, bottomRight, topRight);
+        }
+
+        MeshData Finish()
+        {
+            if (mesh.positions.size() <= 0xFFFF)
+                mesh.indices16.assign(indices.begin(), indices.end());
+            else
+                mesh.indices32 = std::move(indices);
+
+            return std::move(mesh);
+        }
+    };
+
+    // Calls quad(column, row) for a columns x rows grid, stripe by stripe
+    template<typename QuadFn>
+    void ForEachQuadInStripes(int columns, int rows, QuadFn quad)
+    {
+        for (int stripe = 0; stripe < columns; stripe += StripeWidth)
+        {
+            int stripeEnd = std::min(stripe + StripeWidth, columns);
+            for (int row = 0; row < rows; row++)
+                for (int column = stripe; column < stripeEnd; column++)
+                    quad(column, row);
+        }
+    }
+
+    // Adds (columns + 1) x (rows + 1) vertices from vertex(column, row) and the grid's quads
+    template<typename VertexFn>
+    void AddGrid(MeshBuilder& builder, int columns, int rows, VertexFn vertex)
+    {
+        uint32_t base = builder.GetVertexCount();
+        for (int row = 0; row <= rows; row++)
+            for (int column = 0; column <= columns; column++)
+                vertex(column, row);
+
+        uint32_t stride = columns + 1;
+        ForEachQuadInStripes(columns, rows, [&](int column, int row)
+        {
+            uint32_t topLeft = base + row * stride + column;
+            builder.AddQuad(topLeft, topLeft + 1, topLeft + stride, topLeft + stride + 1);
+        });
+    }
+
+    // Point 'step' of 'steps' around the y axis on the unit circle, starting at +z. The last step
+    // wraps to exactly the first, so seam vertices match bit for bit.
+    Float3 CirclePoint(int step, int steps)
+    {
+        float phi = 2 * Pi * (step % steps) / steps;
+        return { std::sin(phi), 0, std::cos(phi) };
+    }
+
+    // Longitude from +z towards +x like CirclePoint and colatitude from +y, both in [0, 1]; u is 0
+    // at the poles
+    Float2 SphereTexcoord(const Float3& unit)
+    {
+        float u = std::atan2(unit.x, unit.z) / (2 * Pi);
+        if (u < 0) u += 1;
+
+        float v = std::acos(std::clamp(unit.y, -1.0f, 1.0f)) / Pi;
+        return { u, v };
+    }
+
+    // Splits vertices of triangles crossing u = 0 / 1 and gives each triangle at a pole its own pole
+    // vertex with the u of the other two; the first one takes over the original pole vertex
+    void FixSphericalTexcoords(MeshBuilder& builder)
+    {
+        std::vector<uint32_t>& indices = builder.GetIndices();
+        std::unordered_map<uint32_t, uint32_t> seamCopies;
+        std::unordered_map<uint32_t, bool> polesTaken;
+
+        auto isPole = [&](uint32_t index)
+        {
+            Float3 p = builder.GetPosition(index);
+            return p.x * p.x + p.z * p.z <= 1e-10f * (p.y * p.y);
+        };
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            uint32_t* triangle = &indices[i];
+
+            float minU = 1, maxU = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                if (isPole(triangle[k])) continue;
+                minU = std::min(minU, builder.GetTexcoord(triangle[k]).x);
+                maxU = std::max(maxU, builder.GetTexcoord(triangle[k]).x);
+            }
+
+            if (maxU - minU > 0.5f)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    if (isPole(triangle[k]) || builder.GetTexcoord(triangle[k]).x >= 0.5f) continue;
+
+                    auto [it, inserted] = seamCopies.try_emplace(triangle[k], 0);
+                    if (inserted)
+                    {
+                        Float2 texcoord = builder.GetTexcoord(triangle[k]);
+                        it->second = builder.AddVertex(builder.GetPosition(triangle[k]), { texcoord.x + 1, texcoord.y });
+                    }
+                    triangle[k] = it->second;
+                }
+            }
+
+            for (int k = 0; k < 3; k++)
+            {
+                if (!isPole(triangle[k])) continue;
+
+                float u = 0.5f * (builder.GetTexcoord(triangle[(k + 1) % 3]).x + builder.GetTexcoord(triangle[(k + 2) % 3]).x);
+                Float2 texcoord = { u, builder.GetTexcoord(triangle[k]).y };
+
+                bool& taken = polesTaken[triangle[k]];
+                if (taken)
+                {
+                    triangle[k] = builder.AddVertex(builder.GetPosition(triangle[k]), texcoord);
+                }
+                else
+                {
+                    builder.SetTexcoord(triangle[k], texcoord);
+                    taken = true;
+                }
+            }
+        }
+    }
+}
+
+MeshData GenerateBox(Float3 dimensions, int segmentsX, int segmentsY, int segmentsZ)
+{
+    // outward normal, then the face's u and v axes, counter-clockwise seen from outside
+    const Float3 faces[6][3] =
+    {
+        { { 1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } },
+        { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+        { { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } },
+        { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+        { { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } },
+    };
+
+    const int segments[3] = { std::max(segmentsX, 1), std::max(segmentsY, 1), std::max(segmentsZ, 1) };
+    auto segmentsAlong = [&](const Float3& axis) { return axis.x != 0 ? segments[0] : axis.y != 0 ? segments[1] : segments[2]; };
+
+    Float3 halfSize = dimensions * 0.5f;
+
+    MeshBuilder builder;
+    for (const auto& face : faces)
+    {
+        int columns = segmentsAlong(face[1]);
+        int rows = segmentsAlong(face[2]);
+
+        // rows run from the top of the face (v = 0) down. The offsets along the face axes are
+        // exact negations of each other from opposite ends, so faces meet without cracks.
+        AddGrid(builder, columns, rows, [&](int column, int row)
+        {
+            float x = (float)(2 * column - columns) / columns;
+            float y = (float)(rows - 2 * row) / rows;
+            Float3 position = (face[0] + face[1] * x + face[2] * y) * halfSize;
+            builder.AddVertex(position, { (float)column / columns, (float)row / rows });
+        });
+    }
+
+    return builder.Finish();
+}
+
+MeshData GenerateUvSphere(float radius, int segments, int rings)
+{
+    segments = std::max(segments, 3);
+    rings = std::max(rings, 2);
+
+    MeshBuilder builder;
+    builder.Reserve((size_t)(segments + 1) * (rings - 1) + 2 * (size_t)segments, (size_t)segments * (rings - 1) * 6);
+
+    // a vertex of its own per segment at the poles, so each pole triangle gets its own u; the
+    // rows in between repeat their first vertex at u = 1
+    for (int ring = 0; ring <= rings; ring++)
+    {
+        float v = (float)ring / rings;
+        bool pole = ring == 0 || ring == rings;
+
+        float theta = Pi * ring / rings;
+        float y = pole ? (ring == 0 ? radius : -radius) : radius * std::cos(theta);
+        float ringRadius = pole ? 0 : radius * std::sin(theta);
+
+        for (int segment = 0; segment < (pole ? segments : segments + 1); segment++)
+        {
+            float u = pole ? (segment + 0.5f) / segments : (float)segment / segments;
+            Float3 point = CirclePoint(segment, segments);
+            builder.AddVertex({ point.x * ringRadius, y, point.z * ringRadius }, { u, v });
+        }
+    }
+
+    uint32_t stride = segments + 1;
+    auto rowStart = [&](int ring) { return ring == 0 ? 0 : segments + (ring - 1) * stride; };
+
+    ForEachQuadInStripes(segments, rings, [&](int segment, int ring)
+    {
+        uint32_t topLeft = rowStart(ring) + segment;
+        uint32_t topRight = topLeft + 1;
+        uint32_t bottomLeft = rowStart(ring + 1) + segment;
+        uint32_t bottomRight = bottomLeft + 1;
+
+        if (ring == 0)
+            builder.AddTriangle(topLeft, bottomLeft, bottomRight);
+        else if (ring == rings - 1)
+            builder.AddTriangle(topLeft, bottomLeft, topRight);
+        else
+            builder.AddQuad(topLeft, topRight, bottomLeft, bottomRight);
+    });
+
+    return builder.Finish();
+}
+
+MeshData GenerateIcoSphere(float radius, int frequency)
+{
+    frequency = std::max(frequency, 1);
+
+    const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+    Float3 corners[12] =
+    {
+        { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+        { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+        { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 },
+    };
+
+    // turn about z so that corners 0 and 3 are the poles; otherwise an edge runs across the pole
+    // and the triangles next to it span half the texture
+    float length = std::sqrt(1 + t * t);
+    for (Float3& corner : corners)
+        corner = { (corner.x * t + corner.y) / length, (corner.y * t - corner.x) / length, corner.z };
+
+    const uint8_t faces[20][3] =
+    {
+        { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+        { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+        { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+        { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 },
+    };
+
+    size_t vertexCount = 10 * (size_t)frequency * frequency + 2;
+    MeshBuilder builder;
+    builder.Reserve(vertexCount + vertexCount / 8, 60 * (size_t)frequency * frequency);
+
+    // Points on face edges are shared with the neighbor face. Such a point is identified by the
+    // icosahedron corners it is a weighted sum of and the integer weights, ordered by corner.
+    std::unordered_map<uint64_t, uint32_t> shared;
+    shared.reserve(30 * (size_t)frequency);
+
+    auto addPoint = [&](const Float3& sum)
+    {
+        Float3 unit = Normalize(sum);
+        return builder.AddVertex(unit * radius, SphereTexcoord(unit));
+    };
+
+    auto sharedPoint = [&](const uint8_t* face, int wa, int wb, int wc)
+    {
+        std::pair<int, int> terms[3] = { { face[0], wa }, { face[1], wb }, { face[2], wc } };
+        std::sort(std::begin(terms), std::end(terms));
+
+        uint64_t key = 0;
+        Float3 sum = { 0, 0, 0 };
+        for (const auto& term : terms)
+        {
+            if (term.second == 0) continue;
+            key = (key << 20) | ((uint64_t)term.first << 16) | (uint64_t)term.second;
+            sum = sum + corners[term.first] * (float)term.second;
+        }
+
+        auto [it, inserted] = shared.try_emplace(key, 0);
+        if (inserted) it->second = addPoint(sum);
+        return it->second;
+    };
+
+    // Lattice point (row, column) of a face has weights (n - row, row - column, column); the
+    // triangles between two rows are emitted in stripes of columns like the grids
+    int n = frequency;
+    std::vector<uint32_t> lattice((size_t)(n + 1) * (n + 2) / 2);
+    auto point = [&](int row, int column) { return lattice[(size_t)row * (row + 1) / 2 + column]; };
+
+    for (const auto& face : faces)
+    {
+        for (int row = 0; row <= n; row++)
+        {
+            for (int column = 0; column <= row; column++)
+            {
+                int wa = n - row, wb = row - column, wc = column;
+                bool edge = wa == 0 || wb == 0 || wc == 0;
+
+                lattice[(size_t)row * (row + 1) / 2 + column] = edge
+                    ? sharedPoint(face, wa, wb, wc)
+                    : addPoint(corners[face[0]] * (float)wa + corners[face[1]] * (float)wb + corners[face[2]] * (float)wc);
+            }
+        }
+
+        for (int stripe = 0; stripe < n; stripe += StripeWidth)
+        {
+            int stripeEnd = std::min(stripe + StripeWidth, n);
+            for (int row = stripe; row < n; row++)
+            {
+                for (int column = stripe; column < std::min(stripeEnd, row + 1); column++)
+                {
+                    builder.AddTriangle(point(row, column), point(row + 1, column), point(row + 1, column + 1));
+                    if (column < row)
+                        builder.AddTriangle(point(row, column), point(row + 1, column + 1), point(row, column + 1));
+                }
+            }
+        }
+    }
+
+    FixSphericalTexcoords(builder);
+    return builder.Finish();
+}
+
+MeshData GeneratePlane(float width, float depth, int segmentsX, int segmentsZ)
+{
+    segmentsX = std::max(segmentsX, 1);
+    segmentsZ = std::max(segmentsZ, 1);
+
+    MeshBuilder builder;
+    builder.Reserve((size_t)(segmentsX + 1) * (segmentsZ + 1), (size_t)segmentsX * segmentsZ * 6);
+
+    AddGrid(builder, segmentsX, segmentsZ, [&](int column, int row)
+    {
+        float u = (float)column / segmentsX;
+        float v = (float)row / segmentsZ;
+        builder.AddVertex({ (u - 0.5f) * width, 0, (v - 0.5f) * depth }, { u, v });
+    });
+
+    return builder.Finish();
+}
+
+MeshData GenerateCylinder(float radius, float height, int segments, int rings, bool caps)
+{
+    segments = std::max(segments, 3);
+    rings = std::max(rings, 1);
+
+    MeshBuilder builder;
+    builder.Reserve((size_t)(segments + 1) * (rings + 1 + (caps ? 4 : 0)), (size_t)segments * (rings + (caps ? 1 : 0)) * 6);
+
+    // side, top to bottom, wrapping around once
+    AddGrid(builder, segments, rings, [&](int segment, int ring)
+    {
+        float u = (float)segment / segments;
+        float v = (float)ring / rings;
+        Float3 point = CirclePoint(segment, segments);
+        builder.AddVertex({ radius * point.x, (0.5f - v) * height, radius * point.z }, { u, v });
+    });
+
+    if (!caps) return builder.Finish();
+
+    for (int side = 0; side < 2; side++)
+    {
+        bool top = side == 0;
+        float y = top ? 0.5f * height : -0.5f * height;
+
+        // the texture seen from outside, +z towards the bottom of the top cap and the top of the bottom one
+        uint32_t center = builder.AddVertex({ 0, y, 0 }, { 0.5f, 0.5f });
+        uint32_t first = builder.GetVertexCount();
+        for (int segment = 0; segment < segments; segment++)
+        {
+            Float3 point = CirclePoint(segment, segments);
+            builder.AddVertex({ radius * point.x, y, radius * point.z }, { 0.5f + 0.5f * point.x, top ? 0.5f + 0.5f * point.z : 0.5f - 0.5f * point.z });
+        }
+
+        for (int segment = 0; segment < segments; segment++)
+        {
+            uint32_t a = first + segment;
+            uint32_t b = first + (segment + 1) % segments;
+            if (top)
+                builder.AddTriangle(center, a, b);
+            else
+                builder.AddTriangle(center, b, a);
+        }
+    }
+
+    return builder.Finish();
+}
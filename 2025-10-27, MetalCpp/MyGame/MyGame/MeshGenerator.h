@@ -0,0 +1,55 @@
+//
+//  MeshGenerator.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Procedural meshes as float streams for MeshOptimizer and MeshQuantizer: positions (stride 12)
+// and texcoords (stride 8) in separate streams, and an indexed triangle list, counter-clockwise
+// seen from outside, with 16-bit indices whenever the vertices allow it.
+//
+// Triangles are emitted in vertical stripes a few quads wide instead of whole rows, so a row
+// shares its top vertices with the row before while they are still in the post-transform cache.
+//
+// Texcoords follow ModelIO: v grows downwards, and the box maps the whole texture onto each face.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SimdMath.h"
+
+struct MeshData
+{
+    std::vector<Float3> positions;
+    std::vector<Float2> texcoords;
+    std::vector<uint16_t> indices16;    // MTLIndexTypeUInt16, when every index fits
+    std::vector<uint32_t> indices32;    // MTLIndexTypeUInt32 otherwise
+
+    size_t GetVertexCount() const { return positions.size(); }
+    size_t GetIndexCount() const { return Uses32BitIndices() ? indices32.size() : indices16.size(); }
+    bool Uses32BitIndices() const { return !indices32.empty(); }
+    const void* GetIndexData() const { return Uses32BitIndices() ? (const void*)indices32.data() : (const void*)indices16.data(); }
+    size_t GetIndexSize() const { return Uses32BitIndices() ? 4 : 2; }
+};
+
+// Centered at the origin, each face split into a grid along the box's own segment counts
+MeshData GenerateBox(Float3 dimensions, int segmentsX = 1, int segmentsY = 1, int segmentsZ = 1);
+
+// Latitude-longitude sphere around y; 'segments' around, 'rings' from pole to pole
+MeshData GenerateUvSphere(float radius, int segments, int rings);
+
+// Geodesic sphere from an icosahedron whose edges are split into 'frequency' parts, so
+// 20 * frequency^2 triangles of nearly equal size. Texcoords are spherical like the UV sphere,
+// with vertices duplicated along the seam and at the poles. Triangles across the seam get u up
+// to 1.2 and need a repeating sampler to show the texture there.
+MeshData GenerateIcoSphere(float radius, int frequency);
+
+// In the xz plane facing +y; u along +x, v along +z
+MeshData GeneratePlane(float width, float depth, int segmentsX = 1, int segmentsZ = 1);
+
+// Around y, centered at the origin; the caps are fans with their own vertices
+MeshData GenerateCylinder(float radius, float height, int segments, int rings = 1, bool caps = true);
@@ -0,0 +1,419 @@
+//
+//  MeshOptimizer.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // Forsyth's scoring: the LRU cache being modeled, the three vertices of the last triangle,
+    // and a boost for vertices with few triangles left so they are finished off
+    const int ScoreCacheSize = 32;
+    const float LastTriangleScore = 0.75f;
+    const float CacheDecayPower = 1.5f;
+    const float ValenceBoostScale = 2.0f;
+    const int MaxValenceInTable = 64;
+
+    struct ScoreTables
+    {
+        float cache[ScoreCacheSize];
+        float valence[MaxValenceInTable];
+
+        ScoreTables()
+        {
+            for (int i = 0; i < ScoreCacheSize; i++)
+            {
+                cache[i] = i < 3
+                    ? LastTriangleScore
+                    : std::pow(1.0f - (float)(i - 3) / (ScoreCacheSize - 3), CacheDecayPower);
+            }
+
+            for (int i = 0; i < MaxValenceInTable; i++)
+                valence[i] = i == 0 ? 0 : ValenceBoostScale / std::sqrt((float)i);
+        }
+    };
+
+    const ScoreTables& GetScoreTables()
+    {
+        static const ScoreTables tables;
+        return tables;
+    }
+
+    float VertexScore(int cachePosition, uint32_t liveTriangles)
+    {
+        if (liveTriangles == 0) return -1.0f;
+
+        const ScoreTables& tables = GetScoreTables();
+        float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+        score += liveTriangles < MaxValenceInTable
+            ? tables.valence[liveTriangles]
+            : ValenceBoostScale / std::sqrt((float)liveTriangles);
+        return score;
+    }
+
+    // Triangles of each vertex in one array, CSR style
+    struct VertexAdjacency
+    {
+        std::vector<uint32_t> offsets;      // vertexCount + 1
+        std::vector<uint32_t> triangles;
+
+        VertexAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+            : offsets(vertexCount + 1, 0)
+            , triangles(indexCount)
+        {
+            for (size_t i = 0; i < indexCount; i++)
+                offsets[indices[i] + 1]++;
+
+            for (size_t v = 0; v < vertexCount; v++)
+                offsets[v + 1] += offsets[v];
+
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indexCount; i++)
+                triangles[fill[indices[i]]++] = (uint32_t)(i / 3);
+        }
+    };
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize)
+{
+    // a vertex is in the FIFO while fewer than cacheSize misses happened since it was loaded
+    std::vector<uint64_t> loadedAt(vertexCount, 0);
+    std::vector<bool> used(vertexCount, false);
+    uint64_t misses = 0;
+    size_t usedCount = 0;
+
+    for (size_t i = 0; i < indexCount; i++)
+    {
+        uint32_t v = indices[i];
+        if (!used[v])
+        {
+            used[v] = true;
+            usedCount++;
+        }
+        else if (misses - loadedAt[v] < cacheSize)
+        {
+            continue;
+        }
+
+        misses++;
+        loadedAt[v] = misses;
+    }
+
+    size_t triangleCount = indexCount / 3;
+    return
+    {
+        (size_t)misses,
+        triangleCount ? (double)misses / triangleCount : 0.0,
+        usedCount ? (double)misses / usedCount : 0.0,
+    };
+}
+
+void OptimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) return;
+
+    // works on a copy so that destination may alias indices
+    std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+    VertexAdjacency adjacency(source.data(), source.size(), vertexCount);
+
+    // live triangles of vertex v are the first liveCount[v] entries of its adjacency range
+    std::vector<uint32_t> liveCount(vertexCount);
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        liveCount[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+        vertexScore[v] = VertexScore(-1, liveCount[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; t++)
+        triangleScore[t] = vertexScore[source[t * 3]] + vertexScore[source[t * 3 + 1]] + vertexScore[source[t * 3 + 2]];
+
+    uint32_t cache[ScoreCacheSize + 3];
+    uint32_t newCache[ScoreCacheSize + 3];
+    int cacheCount = 0;
+
+    size_t best = std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin();
+    size_t cursor = 0;
+
+    for (size_t output = 0; output < triangleCount; output++)
+    {
+        // nothing in the cache connects to an unemitted triangle: continue in input order
+        if (best == SIZE_MAX)
+        {
+            while (emitted[cursor]) cursor++;
+            best = cursor;
+        }
+
+        const uint32_t* triangle = &source[best * 3];
+        std::copy(triangle, triangle + 3, destination + output * 3);
+        emitted[best] = true;
+
+        for (int k = 0; k < 3; k++)
+        {
+            uint32_t v = triangle[k];
+            uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+            uint32_t* end = list + liveCount[v];
+            std::iter_swap(std::find(list, end, (uint32_t)best), end - 1);
+            liveCount[v]--;
+        }
+
+        // the triangle's vertices move to the front, the rest shift back
+        int newCount = 0;
+        for (int k = 0; k < 3; k++)
+            newCache[newCount++] = triangle[k];
+
+        for (int i = 0; i < cacheCount; i++)
+        {
+            uint32_t v = cache[i];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                newCache[newCount++] = v;
+        }
+
+        for (int i = ScoreCacheSize; i < newCount; i++)
+            cachePosition[newCache[i]] = -1;
+
+        cacheCount = std::min(newCount, ScoreCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        // rescore the cached vertices and the dropped ones, then their triangles
+        for (int i = 0; i < newCount; i++)
+        {
+            uint32_t v = newCache[i];
+            int position = i < ScoreCacheSize ? i : -1;
+            cachePosition[v] = position;
+
+            float score = VertexScore(position, liveCount[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            const uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+            for (uint32_t j = 0; j < liveCount[v]; j++)
+                triangleScore[list[j]] += delta;
+        }
+
+        best = SIZE_MAX;
+        float bestScore = -1e30f;
+        for (int i = 0; i < cacheCount; i++)
+        {
+            uint32_t v = cache[i];
+            const uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+            for (uint32_t j = 0; j < liveCount[v]; j++)
+            {
+                if (triangleScore[list[j]] > bestScore)
+                {
+                    bestScore = triangleScore[list[j]];
+                    best = list[j];
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+    // Cuts 'source' into clusters and writes them to 'destination', outward-facing ones first
+    void SortClusters(uint32_t* destination, const std::vector<uint32_t>& source, const Float3* positions, size_t vertexCount, double softAcmr, unsigned cacheSize)
+    {
+        // Cluster starts: where a triangle misses on all three vertices the cache starts over and
+        // moving the cluster costs little (hard boundary). Inside, a cluster is also cut as soon as
+        // its own ACMR drops to 'softAcmr' (soft boundary), which costs at most a few misses; 0 cuts
+        // at hard boundaries only.
+        std::vector<size_t> clusterStarts;
+        std::vector<uint64_t> loadedAt(vertexCount, 0);
+        size_t triangleCount = source.size() / 3;
+        uint64_t time = cacheSize + 1;
+        size_t clusterMisses = 0;
+        size_t clusterStart = 0;
+
+        auto touch = [&](uint32_t v)
+        {
+            if (time - loadedAt[v] < cacheSize) return 0;
+            loadedAt[v] = ++time;
+            return 1;
+        };
+
+        for (size_t t = 0; t < triangleCount; t++)
+        {
+            const uint32_t* triangle = &source[t * 3];
+
+            bool hard = t > 0 && time - loadedAt[triangle[0]] >= cacheSize && time - loadedAt[triangle[1]] >= cacheSize && time - loadedAt[triangle[2]] >= cacheSize;
+            bool soft = softAcmr > 0 && t > clusterStart && clusterMisses <= softAcmr * (t - clusterStart);
+
+            if (t == 0 || hard || soft)
+            {
+                clusterStarts.push_back(t);
+                clusterStart = t;
+                clusterMisses = 0;
+                if (soft && !hard) time += cacheSize;     // judge the new cluster on its own
+            }
+
+            clusterMisses += touch(triangle[0]) + touch(triangle[1]) + touch(triangle[2]);
+        }
+        clusterStarts.push_back(triangleCount);
+
+        // outward-facing clusters first: sort by how far the cluster faces away from the center
+        Float3 meshCenter = { 0, 0, 0 };
+        double area = 0;
+        std::vector<float> sortKeys(clusterStarts.size() - 1);
+
+        struct ClusterSums
+        {
+            Float3 centroid;
+            Float3 normal;
+            float area;
+        };
+        std::vector<ClusterSums> clusters(clusterStarts.size() - 1);
+
+        for (size_t c = 0; c + 1 < clusterStarts.size(); c++)
+        {
+            ClusterSums sums = { { 0, 0, 0 }, { 0, 0, 0 }, 0 };
+            for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++)
+            {
+                Float3 a = positions[source[t * 3]], b = positions[source[t * 3 + 1]], d = positions[source[t * 3 + 2]];
+                Float3 normal = Cross(b - a, d - a);
+                float triangleArea = Length(normal);
+
+                sums.centroid = sums.centroid + (a + b + d) * (triangleArea / 3);
+                sums.normal = sums.normal + normal;
+                sums.area += triangleArea;
+            }
+
+            clusters[c] = sums;
+            meshCenter = meshCenter + sums.centroid;
+            area += sums.area;
+        }
+
+        if (area > 0) meshCenter = meshCenter * (float)(1.0 / area);
+
+        for (size_t c = 0; c < clusters.size(); c++)
+        {
+            const ClusterSums& sums = clusters[c];
+            if (sums.area <= 0)
+                continue;
+
+            Float3 centroid = sums.centroid * (1.0f / sums.area);
+            sortKeys[c] = Dot(centroid - meshCenter, Normalize(sums.normal));
+        }
+
+        std::vector<uint32_t> order(clusters.size());
+        for (size_t c = 0; c < order.size(); c++) order[c] = (uint32_t)c;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+        size_t output = 0;
+        for (uint32_t c : order)
+        {
+            size_t begin = clusterStarts[c] * 3, end = clusterStarts[c + 1] * 3;
+            std::copy(source.begin() + begin, source.begin() + end, destination + output);
+            output += end - begin;
+        }
+    }
+}
+
+void OptimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount, const Float3* positions, size_t vertexCount, float threshold)
+{
+    const unsigned cacheSize = 16;
+
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+    double sourceAcmr = AnalyzeVertexCache(source.data(), source.size(), vertexCount, cacheSize).acmr;
+    double targetAcmr = sourceAcmr * threshold;
+
+    // The clusters are cut as if each started with a cold cache, but after a hard boundary the
+    // next triangles often still reuse vertices of the cluster before, and sorting loses that.
+    // So the result is measured, and the soft boundaries halved towards the source ACMR, then
+    // dropped, until it stays within the target; failing that the order is left as it is.
+    std::vector<uint32_t> sorted(source.size());
+    for (int attempt = 0; attempt < 4; attempt++)
+    {
+        double softAcmr = attempt < 3 ? sourceAcmr * (1 + (threshold - 1) / (1 << attempt)) : 0;
+        SortClusters(sorted.data(), source, positions, vertexCount, softAcmr, cacheSize);
+
+        if (AnalyzeVertexCache(sorted.data(), sorted.size(), vertexCount, cacheSize).acmr <= targetAcmr)
+        {
+            std::copy(sorted.begin(), sorted.end(), destination);
+            return;
+        }
+    }
+
+    std::copy(source.begin(), source.end(), destination);
+}
+
+size_t OptimizeVertexFetch(uint32_t* indices, size_t indexCount, Float3* positions, Float2* texcoords, size_t vertexCount)
+{
+    const uint32_t Unused = UINT32_MAX;
+    std::vector<uint32_t> remap(vertexCount, Unused);
+    uint32_t next = 0;
+
+    for (size_t i = 0; i < indexCount; i++)
+    {
+        uint32_t& target = remap[indices[i]];
+        if (target == Unused) target = next++;
+        indices[i] = target;
+    }
+
+    std::vector<Float3> newPositions(next);
+    std::vector<Float2> newTexcoords(texcoords ? next : 0);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        if (remap[v] == Unused) continue;
+        newPositions[remap[v]] = positions[v];
+        if (texcoords) newTexcoords[remap[v]] = texcoords[v];
+    }
+
+    std::copy(newPositions.begin(), newPositions.end(), positions);
+    if (texcoords) std::copy(newTexcoords.begin(), newTexcoords.end(), texcoords);
+
+    return next;
+}
+
+MeshOptimizationReport OptimizeMesh(MeshData& mesh, float overdrawThreshold, unsigned cacheSize)
+{
+    std::vector<uint32_t> indices;
+    if (mesh.Uses32BitIndices())
+        indices = std::move(mesh.indices32);
+    else
+        indices.assign(mesh.indices16.begin(), mesh.indices16.end());
+
+    size_t vertexCount = mesh.GetVertexCount();
+
+    MeshOptimizationReport report;
+    report.before = AnalyzeVertexCache(indices.data(), indices.size(), vertexCount, cacheSize);
+
+    // Forsyth's order is tuned for LRU; keep the input order when it already does better on FIFO,
+    // as the stripes from MeshGenerator do
+    std::vector<uint32_t> reordered(indices.size());
+    OptimizeVertexCache(reordered.data(), indices.data(), indices.size(), vertexCount);
+    if (AnalyzeVertexCache(reordered.data(), reordered.size(), vertexCount, cacheSize).acmr < report.before.acmr)
+        indices.swap(reordered);
+
+    OptimizeOverdraw(indices.data(), indices.data(), indices.size(), mesh.positions.data(), vertexCount, overdrawThreshold);
+
+    size_t newVertexCount = OptimizeVertexFetch(indices.data(), indices.size(), mesh.positions.data(), mesh.texcoords.data(), vertexCount);
+    mesh.positions.resize(newVertexCount);
+    mesh.texcoords.resize(newVertexCount);
+
+    report.after = AnalyzeVertexCache(indices.data(), indices.size(), newVertexCount, cacheSize);
+    report.verticesRemoved = vertexCount - newVertexCount;
+
+    mesh.indices16.clear();
+    mesh.indices32.clear();
+    if (newVertexCount <= 0xFFFF)
+        mesh.indices16.assign(indices.begin(), indices.end());
+    else
+        mesh.indices32 = std::move(indices);
+
+    return report;
+}
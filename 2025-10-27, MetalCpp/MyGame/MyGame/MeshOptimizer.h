@@ -0,0 +1,59 @@
+//
+//  MeshOptimizer.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Reorders indexed triangle lists for the GPU, at load time or offline on exported meshes:
+//
+// 1. OptimizeVertexCache: Forsyth's linear-speed greedy ordering, so that consecutive triangles
+//    reuse the vertices the post-transform cache still holds.
+// 2. OptimizeOverdraw: cuts that order into clusters where the cache restarts anyway and sorts
+//    the clusters to draw outward-facing ones first (Sander, Nehab and Barczak, "Fast Triangle
+//    Reordering for Vertex Locality and Reduced Overdraw"). The result's ACMR stays within
+//    'threshold' times the input's: the pass measures it and cuts fewer clusters, or keeps the
+//    input order, when sorting costs more. This only pays off on meshes that hide parts of
+//    themselves; convex ones have no overdraw left once back faces are culled.
+// 3. OptimizeVertexFetch: renumbers vertices in the order the index buffer first uses them, so
+//    vertex fetches walk memory forwards, and drops vertices nothing refers to.
+//
+// The result is measured with a FIFO cache model, which is closer to what current GPUs do than
+// the LRU model the ordering is scored with:
+// - ACMR: vertices transformed per triangle, 0.5 at best for large grids, 3 at worst
+// - ATVR: vertices transformed per vertex, 1 at best
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MeshGenerator.h"
+
+struct VertexCacheStats
+{
+    size_t verticesTransformed;
+    double acmr;
+    double atvr;
+};
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned cacheSize = 16);
+
+// 'destination' may be 'indices'
+void OptimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+// 'indices' should come from OptimizeVertexCache; 'destination' may be 'indices'
+void OptimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount, const Float3* positions, size_t vertexCount, float threshold = 1.05f);
+
+// Rewrites the indices and both vertex streams in place; returns the new vertex count
+size_t OptimizeVertexFetch(uint32_t* indices, size_t indexCount, Float3* positions, Float2* texcoords, size_t vertexCount);
+
+struct MeshOptimizationReport
+{
+    VertexCacheStats before;
+    VertexCacheStats after;
+    size_t verticesRemoved;
+};
+
+// All three passes on a generated or loaded mesh, picking 16 or 32-bit indices again
+MeshOptimizationReport OptimizeMesh(MeshData& mesh, float overdrawThreshold = 1.05f, unsigned cacheSize = 16);
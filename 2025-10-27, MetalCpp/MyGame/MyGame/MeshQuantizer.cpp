@@ -0,0 +1,177 @@
+//
+//  MeshQuantizer.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "MeshQuantizer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+
+    // NaN stays NaN, infinity and everything rounding to 65520 or more becomes infinity
+    if (magnitude > 0x7F800000) return (uint16_t)(sign | 0x7E00);
+    if (magnitude >= 0x477FF000) return (uint16_t)(sign | 0x7C00);
+
+    // below 2^-14: subnormal half, round(value * 2^24) with ties to even
+    if (magnitude < 0x38800000)
+    {
+        uint32_t exponent = magnitude >> 23;
+        if (exponent < 102) return (uint16_t)sign;
+
+        uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+        return (uint16_t)(sign | half);
+    }
+
+    // rebias the exponent from 127 to 15 and round away the low 13 mantissa bits, ties to even;
+    // a carry out of the mantissa correctly bumps the exponent
+    uint32_t half = (magnitude - 0x38000000) >> 13;
+    uint32_t remainder = magnitude & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+    return (uint16_t)(sign | half);
+}
+
+float HalfToFloat(uint16_t half)
+{
+    uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+
+    if (exponent == 0)
+    {
+        float value = std::ldexp((float)mantissa, -24);
+        return sign ? -value : value;
+    }
+
+    uint32_t bits = exponent == 31
+        ? sign | 0x7F800000 | (mantissa << 13)
+        : sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+Float3 QuantizedMesh::DecodePosition(size_t vertex) const
+{
+    // what the vertex fetch hands to the shader, then the shader's dequantization
+    const uint16_t* q = &positions[vertex * 4];
+    Float3 unorm = { q[0] / 65535.0f, q[1] / 65535.0f, q[2] / 65535.0f };
+    return positionOffset + positionScale * unorm;
+}
+
+Float2 QuantizedMesh::DecodeTexcoord(size_t vertex) const
+{
+    return { HalfToFloat(texcoords[vertex * 2]), HalfToFloat(texcoords[vertex * 2 + 1]) };
+}
+
+QuantizedMesh QuantizeMesh(const MeshData& mesh)
+{
+    size_t vertexCount = mesh.GetVertexCount();
+
+    QuantizedMesh result;
+    result.positions.resize(vertexCount * 4);
+    result.texcoords.resize(vertexCount * 2);
+
+    Float3 lo = vertexCount ? mesh.positions[0] : Float3 { 0, 0, 0 };
+    Float3 hi = lo;
+    for (const Float3& p : mesh.positions)
+    {
+        lo = Min(lo, p);
+        hi = Max(hi, p);
+    }
+
+    Float3 size = hi - lo;
+    result.positionOffset = lo;
+    result.positionScale = size;
+
+    // a flat axis keeps scale 0 and every value decodes to the minimum
+    auto quantize = [](float value, float lo, float size)
+    {
+        if (size <= 0) return (uint16_t)0;
+        float unorm = std::clamp((value - lo) / size, 0.0f, 1.0f);
+        return (uint16_t)std::lround(unorm * 65535.0f);
+    };
+
+    float maxTexcoord = 0;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        const Float3& p = mesh.positions[v];
+        uint16_t* q = &result.positions[v * 4];
+        q[0] = quantize(p.x, lo.x, size.x);
+        q[1] = quantize(p.y, lo.y, size.y);
+        q[2] = quantize(p.z, lo.z, size.z);
+        q[3] = 0;
+
+        const Float2& t = mesh.texcoords[v];
+        result.texcoords[v * 2] = FloatToHalf(t.x);
+        result.texcoords[v * 2 + 1] = FloatToHalf(t.y);
+        maxTexcoord = std::max({ maxTexcoord, std::fabs(t.x), std::fabs(t.y) });
+    }
+
+    result.maxPositionError = 0;
+    result.maxTexcoordError = 0;
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        result.maxPositionError = std::max(result.maxPositionError, Length(result.DecodePosition(v) - mesh.positions[v]));
+
+        Float2 t = result.DecodeTexcoord(v);
+        result.maxTexcoordError = std::max({ result.maxTexcoordError, std::fabs(t.x - mesh.texcoords[v].x), std::fabs(t.y - mesh.texcoords[v].y) });
+    }
+
+    // half a quantization step per axis plus float rounding in the decode; half an ulp of the
+    // largest texcoord, with the subnormal spacing 2^-24 as the floor
+    Float3 farthest = Max(Float3 { std::fabs(lo.x), std::fabs(lo.y), std::fabs(lo.z) }, Float3 { std::fabs(hi.x), std::fabs(hi.y), std::fabs(hi.z) });
+    result.positionErrorBound = 0.5f * Length(size) / 65535.0f + 4 * FLT_EPSILON * Length(farthest);
+
+    int exponent = 0;
+    std::frexp(maxTexcoord, &exponent);
+    result.texcoordErrorBound = std::ldexp(1.0f, std::max(exponent - 12, -25));
+
+    return result;
+}
+
+#ifdef __APPLE__
+MTL::VertexDescriptor* NewQuantizedVertexDescriptor(NS::UInteger positionAttribute, NS::UInteger texcoordAttribute, NS::UInteger positionBuffer, NS::UInteger texcoordBuffer)
+{
+    MTL::VertexDescriptor* descriptor = MTL::VertexDescriptor::alloc()->init();
+
+    MTL::VertexAttributeDescriptor* position = descriptor->attributes()->object(positionAttribute);
+    position->setFormat(MTL::VertexFormatUShort3Normalized);
+    position->setOffset(0);
+    position->setBufferIndex(positionBuffer);
+
+    MTL::VertexAttributeDescriptor* texcoord = descriptor->attributes()->object(texcoordAttribute);
+    texcoord->setFormat(MTL::VertexFormatHalf2);
+    texcoord->setOffset(0);
+    texcoord->setBufferIndex(texcoordBuffer);
+
+    MTL::VertexBufferLayoutDescriptor* positionLayout = descriptor->layouts()->object(positionBuffer);
+    positionLayout->setStride(QuantizedMesh::PositionStride);
+    positionLayout->setStepRate(1);
+    positionLayout->setStepFunction(MTL::VertexStepFunctionPerVertex);
+
+    MTL::VertexBufferLayoutDescriptor* texcoordLayout = descriptor->layouts()->object(texcoordBuffer);
+    texcoordLayout->setStride(QuantizedMesh::TexcoordStride);
+    texcoordLayout->setStepRate(1);
+    texcoordLayout->setStepFunction(MTL::VertexStepFunctionPerVertex);
+
+    return descriptor;
+}
+#endif
@@ -0,0 +1,65 @@
+//
+//  MeshQuantizer.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Compressed vertex streams: 12 instead of 20 bytes per vertex.
+//
+// - positions: 16-bit unsigned normalized per axis against the mesh bounds, stride 8
+//   (MTLVertexFormatUShort3Normalized, the fourth short is padding). The vertex stage gets
+//   values in [0, 1] and maps them back with position = positionOffset + positionScale * value.
+// - texcoords: half floats, stride 4 (MTLVertexFormatHalf2); exact for multiples of 1/1024,
+//   otherwise within 2^-12 in [0, 1] and 2^-11 up to 2.
+//
+// Both errors are measured on the mesh and returned next to the bounds that hold for any input.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MeshGenerator.h"
+#include "SimdMath.h"
+
+#ifdef __APPLE__
+#include "Metal/Metal.hpp"
+#endif
+
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+struct QuantizedMesh
+{
+    static constexpr size_t PositionStride = 8;
+    static constexpr size_t TexcoordStride = 4;
+
+    std::vector<uint16_t> positions;    // x, y, z, 0 per vertex
+    std::vector<uint16_t> texcoords;    // u, v per vertex, as halfs
+
+    // Dequantization constants, for Uniforms
+    Float3 positionOffset;              // bounds minimum
+    Float3 positionScale;               // bounds size
+
+    // Largest distance between a vertex and its decoded position, in mesh units
+    float maxPositionError;
+    float positionErrorBound;           // half a step along each axis
+    float maxTexcoordError;             // per component
+    float texcoordErrorBound;
+
+    size_t GetVertexCount() const { return positions.size() / 4; }
+    size_t GetVertexBytes() const { return GetVertexCount() * (PositionStride + TexcoordStride); }
+
+    Float3 DecodePosition(size_t vertex) const;
+    Float2 DecodeTexcoord(size_t vertex) const;
+};
+
+// Indices stay as they are in 'mesh'
+QuantizedMesh QuantizeMesh(const MeshData& mesh);
+
+#ifdef __APPLE__
+// Layout of QuantizedMesh's streams, positions and texcoords in buffers of their own
+MTL::VertexDescriptor* NewQuantizedVertexDescriptor(NS::UInteger positionAttribute, NS::UInteger texcoordAttribute, NS::UInteger positionBuffer, NS::UInteger texcoordBuffer);
+#endif
@@ -0,0 +1,335 @@
+//
+//  Meshlets.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "Meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // How much a candidate facing away from the meshlet's average normal costs on top of its
+    // distance; higher gives narrower cones for slightly less compact meshlets
+    const float ConeWeight = 0.5f;
+
+    // Cones whose triangles come this close to a right angle with the axis never cull; the apex
+    // would run off towards infinity
+    const float MinConeDot = 0.1f;
+
+    // Local indices are bytes
+    const size_t MaxMeshletVertices = 256;
+
+    // Triangles of each vertex in one array, CSR style
+    struct VertexAdjacency
+    {
+        std::vector<uint32_t> offsets;      // vertexCount + 1
+        std::vector<uint32_t> triangles;
+
+        VertexAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+            : offsets(vertexCount + 1, 0)
+            , triangles(indexCount)
+        {
+            for (size_t i = 0; i < indexCount; i++)
+                offsets[indices[i] + 1]++;
+
+            for (size_t v = 0; v < vertexCount; v++)
+                offsets[v + 1] += offsets[v];
+
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < indexCount; i++)
+                triangles[fill[indices[i]]++] = (uint32_t)(i / 3);
+        }
+    };
+
+    // 'triangles' are the mesh triangles of the meshlet, 'normals' their unit normals
+    MeshletBounds ComputeBounds(const uint32_t* vertices, size_t vertexCount, const std::vector<uint32_t>& triangles, const uint32_t* indices, const Float3* positions, const Float3* normals)
+    {
+        MeshletBounds bounds;
+
+        Float3 lo = positions[vertices[0]];
+        Float3 hi = lo;
+        for (size_t i = 1; i < vertexCount; i++)
+        {
+            lo = Min(lo, positions[vertices[i]]);
+            hi = Max(hi, positions[vertices[i]]);
+        }
+
+        bounds.center = (lo + hi) * 0.5f;
+        bounds.radius = 0;
+        for (size_t i = 0; i < vertexCount; i++)
+            bounds.radius = std::max(bounds.radius, Length(positions[vertices[i]] - bounds.center));
+
+        bounds.coneApex = bounds.center;
+        bounds.coneAxis = { 0, 0, 1 };
+        bounds.coneCutoff = 2;
+
+        // degenerate triangles have a zero normal and are never drawn, so they do not widen the cone
+        Float3 normalSum = { 0, 0, 0 };
+        for (uint32_t t : triangles)
+            normalSum = normalSum + normals[t];
+
+        float sumLength = Length(normalSum);
+        if (sumLength == 0) return bounds;
+
+        Float3 axis = normalSum * (1 / sumLength);
+        float minDot = 1;
+        for (uint32_t t : triangles)
+        {
+            if (Dot(normals[t], normals[t]) > 0)
+                minDot = std::min(minDot, Dot(normals[t], axis));
+        }
+
+        if (minDot <= MinConeDot) return bounds;
+
+        // the apex moves back along the axis until it lies behind or on every triangle's plane;
+        // from there, a view direction within the cutoff of the axis sees the back of all of them
+        float apexDistance = -INFINITY;
+        for (uint32_t t : triangles)
+        {
+            const Float3& n = normals[t];
+            if (Dot(n, n) == 0) continue;
+
+            float height = Dot(positions[indices[t * 3]] - bounds.center, n);
+            apexDistance = std::max(apexDistance, -height / Dot(n, axis));
+        }
+
+        bounds.coneApex = bounds.center - axis * apexDistance;
+        bounds.coneAxis = axis;
+        bounds.coneCutoff = std::sqrt(1 - minDot * minDot);
+        return bounds;
+    }
+}
+
+MeshletData BuildMeshlets(const MeshData& mesh, size_t maxVertices, size_t maxTriangles)
+{
+    maxVertices = std::clamp(maxVertices, (size_t)3, MaxMeshletVertices);
+    maxTriangles = std::max(maxTriangles, (size_t)1);
+
+    std::vector<uint32_t> indices;
+    if (mesh.Uses32BitIndices())
+        indices = mesh.indices32;
+    else
+        indices.assign(mesh.indices16.begin(), mesh.indices16.end());
+
+    MeshletData data;
+
+    size_t vertexCount = mesh.GetVertexCount();
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return data;
+
+    const Float3* positions = mesh.positions.data();
+    VertexAdjacency adjacency(indices.data(), triangleCount * 3, vertexCount);
+
+    std::vector<Float3> normals(triangleCount);
+    std::vector<Float3> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+    {
+        const Float3& a = positions[indices[t * 3]];
+        const Float3& b = positions[indices[t * 3 + 1]];
+        const Float3& c = positions[indices[t * 3 + 2]];
+
+        Float3 n = Cross(b - a, c - a);
+        float length = Length(n);
+        normals[t] = length > 0 ? n * (1 / length) : Float3 { 0, 0, 0 };
+        centroids[t] = (a + b + c) * (1.0f / 3);
+    }
+
+    // live triangles of vertex v are the first liveCount[v] entries of its adjacency range
+    std::vector<uint32_t> liveCount(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++)
+        liveCount[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<int> localIndex(vertexCount, -1);
+
+    // the meshlet being grown
+    Meshlet meshlet = { 0, 0, 0, 0 };
+    std::vector<uint32_t> meshletTriangles;
+    Float3 centroidSum = { 0, 0, 0 };
+    Float3 normalSum = { 0, 0, 0 };
+
+    size_t cursor = 0;
+    size_t seed = SIZE_MAX;
+
+    auto finishMeshlet = [&]()
+    {
+        data.meshlets.push_back(meshlet);
+        data.bounds.push_back(ComputeBounds(&data.vertices[meshlet.vertexOffset], meshlet.vertexCount, meshletTriangles, indices.data(), positions, normals.data()));
+
+        // the next meshlet starts at the most hemmed-in triangle along this one's border, filling
+        // corners first so that no ragged leftovers remain
+        seed = SIZE_MAX;
+        uint32_t seedLive = UINT32_MAX;
+        for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+        {
+            uint32_t v = data.vertices[meshlet.vertexOffset + i];
+            localIndex[v] = -1;
+
+            const uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+            for (uint32_t k = 0; k < liveCount[v]; k++)
+            {
+                const uint32_t* triangle = &indices[list[k] * 3];
+                uint32_t live = liveCount[triangle[0]] + liveCount[triangle[1]] + liveCount[triangle[2]];
+                if (live < seedLive)
+                {
+                    seed = list[k];
+                    seedLive = live;
+                }
+            }
+        }
+
+        meshlet = { (uint32_t)data.vertices.size(), (uint32_t)(data.triangles.size() / 3), 0, 0 };
+        meshletTriangles.clear();
+        centroidSum = { 0, 0, 0 };
+        normalSum = { 0, 0, 0 };
+    };
+
+    auto newVertices = [&](size_t t)
+    {
+        return (localIndex[indices[t * 3]] < 0) + (localIndex[indices[t * 3 + 1]] < 0) + (localIndex[indices[t * 3 + 2]] < 0);
+    };
+
+    for (size_t output = 0; output < triangleCount; )
+    {
+        size_t best = SIZE_MAX;
+
+        if (meshlet.triangleCount == 0)
+        {
+            // nothing left around the last meshlet: continue in input order
+            if (seed == SIZE_MAX)
+            {
+                while (emitted[cursor]) cursor++;
+                seed = cursor;
+            }
+
+            best = seed;
+        }
+        else
+        {
+            // fewest new vertices first, then the closest to the meshlet, weighted by facing
+            Float3 center = centroidSum * (1.0f / meshlet.triangleCount);
+            float axisLength = Length(normalSum);
+            Float3 axis = axisLength > 0 ? normalSum * (1 / axisLength) : Float3 { 0, 0, 0 };
+
+            int bestExtra = 4;
+            float bestCost = INFINITY;
+
+            for (uint32_t i = 0; i < meshlet.vertexCount; i++)
+            {
+                uint32_t v = data.vertices[meshlet.vertexOffset + i];
+                const uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+
+                for (uint32_t k = 0; k < liveCount[v]; k++)
+                {
+                    uint32_t t = list[k];
+                    int extra = newVertices(t);
+                    if (meshlet.vertexCount + extra > maxVertices) continue;
+
+                    float cost = Length(centroids[t] - center) * (1 + ConeWeight * (1 - Dot(normals[t], axis)));
+                    if (extra < bestExtra || (extra == bestExtra && cost < bestCost))
+                    {
+                        best = t;
+                        bestExtra = extra;
+                        bestCost = cost;
+                    }
+                }
+            }
+
+            if (best == SIZE_MAX)
+            {
+                finishMeshlet();
+                continue;
+            }
+        }
+
+        const uint32_t* triangle = &indices[best * 3];
+        for (int k = 0; k < 3; k++)
+        {
+            uint32_t v = triangle[k];
+            if (localIndex[v] < 0)
+            {
+                localIndex[v] = (int)meshlet.vertexCount++;
+                data.vertices.push_back(v);
+            }
+
+            data.triangles.push_back((uint8_t)localIndex[v]);
+
+            uint32_t* list = &adjacency.triangles[adjacency.offsets[v]];
+            uint32_t* end = list + liveCount[v];
+            std::iter_swap(std::find(list, end, (uint32_t)best), end - 1);
+            liveCount[v]--;
+        }
+
+        emitted[best] = true;
+        output++;
+
+        meshlet.triangleCount++;
+        meshletTriangles.push_back((uint32_t)best);
+        centroidSum = centroidSum + centroids[best];
+        normalSum = normalSum + normals[best];
+
+        if (meshlet.triangleCount == maxTriangles)
+            finishMeshlet();
+    }
+
+    if (meshlet.triangleCount > 0)
+        finishMeshlet();
+
+    return data;
+}
+
+std::vector<uint32_t> UnpackMeshletIndices(const MeshletData& data)
+{
+    std::vector<uint32_t> indices(data.triangles.size());
+    for (const Meshlet& meshlet : data.meshlets)
+    {
+        const uint8_t* local = &data.triangles[meshlet.triangleOffset * 3];
+        for (uint32_t i = 0; i < meshlet.triangleCount * 3; i++)
+            indices[meshlet.triangleOffset * 3 + i] = data.vertices[meshlet.vertexOffset + local[i]];
+    }
+
+    return indices;
+}
+
+MeshletCullStats CullMeshlets(const MeshletData& data, const Float4x4& modelView, const Float4x4& projection, std::vector<uint32_t>& visible)
+{
+    MeshletCullStats stats = { data.meshlets.size(), 0, 0, 0 };
+
+    // both tests run in mesh space: the planes of the whole transform, the camera moved back
+    Float4 planes[6];
+    ExtractFrustumPlanes(projection * modelView, planes);
+    Float3 camera = Inverse(modelView).columns[3].Xyz();
+
+    for (size_t i = 0; i < data.meshlets.size(); i++)
+    {
+        const MeshletBounds& bounds = data.bounds[i];
+
+        bool outside = false;
+        for (int p = 0; p < 6 && !outside; p++)
+            outside = Dot(planes[p].Xyz(), bounds.center) + planes[p].w < -bounds.radius;
+
+        if (outside)
+        {
+            stats.frustumCulled++;
+            continue;
+        }
+
+        // dot(normalize(apex - camera), axis) >= cutoff without the division; a camera right at
+        // the apex is behind every plane too
+        Float3 view = bounds.coneApex - camera;
+        if (Dot(view, bounds.coneAxis) >= bounds.coneCutoff * Length(view))
+        {
+            stats.backfaceCulled++;
+            continue;
+        }
+
+        visible.push_back((uint32_t)i);
+        stats.visibleTriangles += data.meshlets[i].triangleCount;
+    }
+
+    return stats;
+}
@@ -0,0 +1,73 @@
+//
+//  Meshlets.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Splits an indexed mesh into meshlets, small clusters of at most 64 vertices and 124 triangles
+// by default (sizes that suit mesh shaders too), each with bounds for culling it whole:
+//
+// - a bounding sphere, tested against the six frustum planes
+// - a normal cone: axis, cutoff and apex. Every triangle of the meshlet faces away from a camera
+//   for which dot(normalize(apex - camera), axis) >= cutoff, so it cannot pass backface culling
+//
+// Meshlets grow greedily across shared vertices, preferring triangles that add no new vertex, then
+// ones close to the meshlet and facing its way, so the cones stay narrow. They do not jump
+// between disconnected pieces of the mesh.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MeshGenerator.h"
+#include "SimdMath.h"
+
+struct Meshlet
+{
+    uint32_t vertexOffset;      // into MeshletData::vertices
+    uint32_t triangleOffset;    // into MeshletData::triangles, in triangles
+    uint32_t vertexCount;
+    uint32_t triangleCount;
+};
+
+struct MeshletBounds
+{
+    Float3 center;
+    float radius;
+
+    // Cutoff above 1 when the triangles spread too far to ever be backfacing together
+    Float3 coneApex;
+    Float3 coneAxis;
+    float coneCutoff;
+};
+
+struct MeshletData
+{
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;
+    std::vector<uint32_t> vertices;     // mesh vertex of each meshlet vertex
+    std::vector<uint8_t> triangles;     // three meshlet vertices per triangle
+
+    size_t GetMeshletCount() const { return meshlets.size(); }
+};
+
+MeshletData BuildMeshlets(const MeshData& mesh, size_t maxVertices = 64, size_t maxTriangles = 124);
+
+// Mesh indices of all meshlets, back to back: meshlet i's triangles start at index
+// meshlets[i].triangleOffset * 3, so runs of meshlets draw as ranges of one index buffer
+std::vector<uint32_t> UnpackMeshletIndices(const MeshletData& data);
+
+struct MeshletCullStats
+{
+    size_t meshlets;
+    size_t frustumCulled;
+    size_t backfaceCulled;
+    size_t visibleTriangles;
+};
+
+// Appends the meshlets a perspective camera may see to 'visible', in meshlet order.
+// 'modelView' maps the mesh to view space, 'projection' view space to Metal clip space.
+MeshletCullStats CullMeshlets(const MeshletData& data, const Float4x4& modelView, const Float4x4& projection, std::vector<uint32_t>& visible);
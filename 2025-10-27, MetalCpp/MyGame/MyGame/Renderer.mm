@@ -0,0 +1,442 @@
+//
+//  Renderer.mm
+//  MyGame
+//
+//  Created by 이승중 on 10/27/25.
+//
+
+#import <simd/simd.h>
+#import <QuartzCore/QuartzCore.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#import "Renderer.h"
+#import "FramePacer.h"
+#import "FrustumCulling.h"
+#import "InstanceSystem.h"
+#import "MeshGenerator.h"
+#import "MeshOptimizer.h"
+#import "MeshQuantizer.h"
+#import "SimdMath.h"
+#import "ThreadPool.h"
+#import "UploadRing.h"
+
+// Include header shared between C code here, which executes Metal API commands, and .metal files
+#import "ShaderTypes.h"
+
+// Upper bound of the in-flight depth; FramePacer picks the current one
+static const NSUInteger kMaxBuffersInFlight = 3;
+
+// Boxes on a square grid in the xy plane, kInstanceSpacing apart, the center one where the single
+// box used to be
+static const int kInstanceGridSize = 33;
+static const float kInstanceSpacing = 6.0f;
+static const size_t kInstanceCount = kInstanceGridSize * kInstanceGridSize;
+
+// Radians each box turns per frame
+static const float kSpinPerFrame = 0.01f;
+
+static_assert(sizeof(InstanceMatrices) == sizeof(InstanceUniforms), "InstanceMatrices must match the shader's InstanceUniforms");
+
+// Per-frame constants, instance matrices and other transient data come from one shared buffer,
+// see UploadRing.h
+static const size_t kUploadBytesPerFrame = 64 * 1024 + kInstanceCount * sizeof(InstanceUniforms);
+
+@implementation Renderer
+{
+    dispatch_semaphore_t _inFlightSemaphore;
+
+    // Semaphore slots taken out of circulation to keep the depth below kMaxBuffersInFlight
+    int _heldSlots;
+
+    FramePacer _framePacer;
+
+    // (GPU time, latency) of completed frames, filled by the completion handler
+    std::mutex _gpuTimingLock;
+    std::vector<std::pair<double, double>> _gpuTimings;
+
+    id <MTLDevice> _device;
+    id <MTLCommandQueue> _commandQueue;
+
+    id <MTLBuffer> _uploadBuffer;
+    id <MTLRenderPipelineState> _pipelineState;
+    id <MTLDepthStencilState> _depthState;
+    id <MTLTexture> _colorMap;
+    MTLVertexDescriptor *_mtlVertexDescriptor;
+
+    std::unique_ptr<UploadRing> _uploadRing;
+
+    uint64_t _frameValue;
+
+    // Last frame whose command buffer completed, written by the completion handler
+    std::atomic<uint64_t> _completedFrameValue;
+
+    size_t _uniformsOffset;
+
+    Uniforms* _uniforms;
+
+    Float4x4 _projectionMatrix;
+
+    id <MTLBuffer> _positionBuffer;
+    id <MTLBuffer> _texcoordBuffer;
+    id <MTLBuffer> _indexBuffer;
+    NSUInteger _indexCount;
+    MTLIndexType _indexType;
+
+    Float3 _positionOffset;
+    Float3 _positionScale;
+
+    /// Jobs of the per-frame instance updates; the render thread takes part in each
+    std::unique_ptr<ThreadPool> _jobPool;
+
+    std::unique_ptr<InstanceSystem> _instances;
+    std::vector<uint32_t> _visibleInstances;
+
+    size_t _instancesOffset;
+}
+
+-(nonnull instancetype)initWithMetalKitView:(nonnull MTKView *)view;
+{
+    self = [super init];
+    if(self)
+    {
+        _device = view.device;
+        _inFlightSemaphore = dispatch_semaphore_create(kMaxBuffersInFlight);
+
+        FramePacingSettings pacingSettings;
+        pacingSettings.frameBudget = 1.0 / view.preferredFramesPerSecond;
+        pacingSettings.maxDepth = (int)kMaxBuffersInFlight;
+        _framePacer = FramePacer(pacingSettings);
+
+        _jobPool = std::make_unique<ThreadPool>();
+
+        [self _loadMetalWithView:view];
+        [self _loadAssets];
+    }
+
+    return self;
+}
+
+- (void)_loadMetalWithView:(nonnull MTKView *)view;
+{
+    /// Load Metal state objects and initialize renderer dependent view properties
+
+    view.depthStencilPixelFormat = MTLPixelFormatDepth32Float_Stencil8;
+    view.colorPixelFormat = MTLPixelFormatBGRA8Unorm_sRGB;
+    view.sampleCount = 1;
+
+    /// Quantized streams, see MeshQuantizer.h: unorm16 positions at stride 8, half texcoords at stride 4
+    _mtlVertexDescriptor = (__bridge_transfer MTLVertexDescriptor *)NewQuantizedVertexDescriptor(VertexAttributePosition,
+                                                                                                 VertexAttributeTexcoord,
+                                                                                                 BufferIndexMeshPositions,
+                                                                                                 BufferIndexMeshGenerics);
+
+    id<MTLLibrary> defaultLibrary = [_device newDefaultLibrary];
+
+    id <MTLFunction> vertexFunction = [defaultLibrary newFunctionWithName:@"vertexShader"];
+
+    id <MTLFunction> fragmentFunction = [defaultLibrary newFunctionWithName:@"fragmentShader"];
+
+    MTLRenderPipelineDescriptor *pipelineStateDescriptor = [[MTLRenderPipelineDescriptor alloc] init];
+    pipelineStateDescriptor.label = @"MyPipeline";
+    pipelineStateDescriptor.rasterSampleCount = view.sampleCount;
+    pipelineStateDescriptor.vertexFunction = vertexFunction;
+    pipelineStateDescriptor.fragmentFunction = fragmentFunction;
+    pipelineStateDescriptor.vertexDescriptor = _mtlVertexDescriptor;
+    pipelineStateDescriptor.colorAttachments[0].pixelFormat = view.colorPixelFormat;
+    pipelineStateDescriptor.depthAttachmentPixelFormat = view.depthStencilPixelFormat;
+    pipelineStateDescriptor.stencilAttachmentPixelFormat = view.depthStencilPixelFormat;
+
+    NSError *error = NULL;
+    _pipelineState = [_device newRenderPipelineStateWithDescriptor:pipelineStateDescriptor error:&error];
+    if (!_pipelineState)
+    {
+        NSLog(@"Failed to created pipeline state, error %@", error);
+    }
+
+    MTLDepthStencilDescriptor *depthStateDesc = [[MTLDepthStencilDescriptor alloc] init];
+    depthStateDesc.depthCompareFunction = MTLCompareFunctionLess;
+    depthStateDesc.depthWriteEnabled = YES;
+    _depthState = [_device newDepthStencilStateWithDescriptor:depthStateDesc];
+
+    NSUInteger uploadBufferSize = kUploadBytesPerFrame * kMaxBuffersInFlight;
+
+    _uploadBuffer = [_device newBufferWithLength:uploadBufferSize
+                                         options:MTLResourceStorageModeShared];
+
+    _uploadBuffer.label = @"UploadBuffer";
+
+    _uploadRing = std::make_unique<UploadRing>(_uploadBuffer.contents, uploadBufferSize);
+
+    _commandQueue = [_device newCommandQueue];
+}
+
+- (void)_loadAssets
+{
+    /// Load assets into metal objects
+
+    NSError *error;
+
+    MeshData box = GenerateBox({4, 4, 4}, 2, 2, 2);
+    OptimizeMesh(box);
+
+    QuantizedMesh quantized = QuantizeMesh(box);
+    _positionOffset = quantized.positionOffset;
+    _positionScale = quantized.positionScale;
+
+    _positionBuffer = [_device newBufferWithBytes:quantized.positions.data()
+                                           length:quantized.GetVertexCount() * QuantizedMesh::PositionStride
+                                          options:MTLResourceStorageModeShared];
+    _positionBuffer.label = @"BoxPositions";
+
+    _texcoordBuffer = [_device newBufferWithBytes:quantized.texcoords.data()
+                                           length:quantized.GetVertexCount() * QuantizedMesh::TexcoordStride
+                                          options:MTLResourceStorageModeShared];
+    _texcoordBuffer.label = @"BoxTexcoords";
+
+    _indexBuffer = [_device newBufferWithBytes:box.GetIndexData()
+                                        length:box.GetIndexCount() * box.GetIndexSize()
+                                       options:MTLResourceStorageModeShared];
+    _indexBuffer.label = @"BoxIndices";
+
+    _indexCount = box.GetIndexCount();
+    _indexType = box.Uses32BitIndices() ? MTLIndexTypeUInt32 : MTLIndexTypeUInt16;
+
+    _instances = std::make_unique<InstanceSystem>(_positionOffset, _positionOffset + _positionScale);
+    for (int y = 0; y < kInstanceGridSize; y++)
+    {
+        for (int x = 0; x < kInstanceGridSize; x++)
+        {
+            Float3 position = { (x - kInstanceGridSize / 2) * kInstanceSpacing, (y - kInstanceGridSize / 2) * kInstanceSpacing, 0 };
+            size_t index = _instances->Add(position, Quat::Identity());
+
+            /// Every box spins about (1, 1, 0), a little out of phase with its neighbors
+            _instances->SetSpin(index, {1, 1, 0}, kSpinPerFrame, 0.05f * (position.x + position.y));
+        }
+    }
+
+    MTKTextureLoader* textureLoader = [[MTKTextureLoader alloc] initWithDevice:_device];
+
+    NSDictionary *textureLoaderOptions =
+    @{
+      MTKTextureLoaderOptionTextureUsage       : @(MTLTextureUsageShaderRead),
+      MTKTextureLoaderOptionTextureStorageMode : @(MTLStorageModePrivate)
+      };
+
+    _colorMap = [textureLoader newTextureWithName:@"ColorMap"
+                                      scaleFactor:1.0
+                                           bundle:nil
+                                          options:textureLoaderOptions
+                                            error:&error];
+
+    if(!_colorMap || error)
+    {
+        NSLog(@"Error creating texture %@", error.localizedDescription);
+    }
+}
+
+- (BOOL)_updateDynamicBufferState
+{
+    /// Reclaim upload memory of completed frames and allocate this frame's uniforms
+
+    _uploadRing->Retire(_completedFrameValue.load(std::memory_order_acquire));
+
+    _frameValue++;
+    _uploadRing->BeginFrame(_frameValue);
+
+    _uniforms = _uploadRing->Allocate<Uniforms>(_uniformsOffset);
+    if (!_uniforms)
+    {
+        NSLog(@"Upload buffer overrun, %zu bytes in flight", _uploadRing->GetBytesInFlight());
+        return NO;
+    }
+
+    return YES;
+}
+
+- (void)_updateGameState
+{
+    /// Update any game state before encoding renderint commands to our drawable
+
+    Uniforms * uniforms = _uniforms;
+
+    uniforms->projectionMatrix = ToSimd(_projectionMatrix);
+
+    uniforms->positionOffset = simd_make_float3(_positionOffset.x, _positionOffset.y, _positionOffset.z);
+    uniforms->positionScale = simd_make_float3(_positionScale.x, _positionScale.y, _positionScale.z);
+
+    Float4x4 viewMatrix = Float4x4::Translation(0.0, 0.0, -8.0);
+
+    /// Spins advance one frame in the same pooled pass that builds the matrices
+    _instances->Update(_jobPool.get(), 1);
+
+    Float4 planes[6];
+    ExtractFrustumPlanes(_projectionMatrix * viewMatrix, planes);
+    _visibleInstances.resize(_instances->GetCount());
+    _visibleInstances.resize(CullBoxes(_instances->GetBounds(), planes, _visibleInstances.data()));
+
+    /// Matrices of the visible instances go straight into this frame's upload memory
+    if (!_visibleInstances.empty())
+    {
+        InstanceMatrices* matrices = _uploadRing->Allocate<InstanceMatrices>(_instancesOffset, _visibleInstances.size());
+        if (matrices)
+        {
+            _instances->WriteMatrices(viewMatrix, _visibleInstances.data(), _visibleInstances.size(), matrices, _jobPool.get());
+        }
+        else
+        {
+            NSLog(@"Upload buffer overrun, %zu bytes in flight", _uploadRing->GetBytesInFlight());
+            _visibleInstances.clear();
+        }
+    }
+}
+
+- (double)_waitForFrameSlot
+{
+    /// Block until fewer than the pacer's depth of frames are in flight, and return the time blocked
+
+    CFTimeInterval waitStart = CACurrentMediaTime();
+
+    int slotsToHold = (int)kMaxBuffersInFlight - _framePacer.GetDepth();
+    while (_heldSlots > slotsToHold)
+    {
+        dispatch_semaphore_signal(_inFlightSemaphore);
+        _heldSlots--;
+    }
+
+    while (_heldSlots < slotsToHold)
+    {
+        dispatch_semaphore_wait(_inFlightSemaphore, DISPATCH_TIME_FOREVER);
+        _heldSlots++;
+    }
+
+    dispatch_semaphore_wait(_inFlightSemaphore, DISPATCH_TIME_FOREVER);
+
+    return CACurrentMediaTime() - waitStart;
+}
+
+- (void)_recordGpuTimings
+{
+    std::vector<std::pair<double, double>> timings;
+    {
+        std::lock_guard<std::mutex> lock(_gpuTimingLock);
+        timings.swap(_gpuTimings);
+    }
+
+    for (const auto& timing : timings)
+        _framePacer.RecordGpuFrame(timing.first, timing.second);
+}
+
+- (void)drawInMTKView:(nonnull MTKView *)view
+{
+    /// Per frame updates here
+
+    double waitTime = [self _waitForFrameSlot];
+
+    CFTimeInterval frameStart = CACurrentMediaTime();
+
+    [self _recordGpuTimings];
+
+    id <MTLCommandBuffer> commandBuffer = [_commandQueue commandBuffer];
+    commandBuffer.label = @"MyCommand";
+
+    BOOL uploaded = [self _updateDynamicBufferState];
+
+    /// Command buffers of one queue complete in order, so the last completed frame value only grows
+    __block dispatch_semaphore_t block_sema = _inFlightSemaphore;
+    uint64_t frameValue = _frameValue;
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer)
+     {
+         {
+             std::lock_guard<std::mutex> lock(self->_gpuTimingLock);
+             self->_gpuTimings.emplace_back(buffer.GPUEndTime - buffer.GPUStartTime, buffer.GPUEndTime - frameStart);
+         }
+
+         self->_completedFrameValue.store(frameValue, std::memory_order_release);
+         dispatch_semaphore_signal(block_sema);
+     }];
+
+    if(uploaded)
+    {
+        [self _updateGameState];
+    }
+
+    /// Delay getting the currentRenderPassDescriptor until we absolutely need it to avoid
+    ///   holding onto the drawable and blocking the display pipeline any longer than necessary
+    MTLRenderPassDescriptor* renderPassDescriptor = uploaded ? view.currentRenderPassDescriptor : nil;
+
+    if(renderPassDescriptor != nil) {
+
+        /// Final pass rendering code here
+
+        id <MTLRenderCommandEncoder> renderEncoder =
+        [commandBuffer renderCommandEncoderWithDescriptor:renderPassDescriptor];
+        renderEncoder.label = @"MyRenderEncoder";
+
+        [renderEncoder pushDebugGroup:@"DrawBox"];
+
+        [renderEncoder setFrontFacingWinding:MTLWindingCounterClockwise];
+        [renderEncoder setCullMode:MTLCullModeBack];
+        [renderEncoder setRenderPipelineState:_pipelineState];
+        [renderEncoder setDepthStencilState:_depthState];
+
+        [renderEncoder setVertexBuffer:_uploadBuffer
+                                offset:_uniformsOffset
+                               atIndex:BufferIndexUniforms];
+
+        [renderEncoder setFragmentBuffer:_uploadBuffer
+                                  offset:_uniformsOffset
+                                 atIndex:BufferIndexUniforms];
+
+        [renderEncoder setVertexBuffer:_positionBuffer
+                                offset:0
+                               atIndex:BufferIndexMeshPositions];
+
+        [renderEncoder setVertexBuffer:_texcoordBuffer
+                                offset:0
+                               atIndex:BufferIndexMeshGenerics];
+
+        [renderEncoder setFragmentTexture:_colorMap
+                                  atIndex:TextureIndexColor];
+
+        if (!_visibleInstances.empty())
+        {
+            [renderEncoder setVertexBuffer:_uploadBuffer
+                                    offset:_instancesOffset
+                                   atIndex:BufferIndexInstances];
+
+            [renderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                      indexCount:_indexCount
+                                       indexType:_indexType
+                                     indexBuffer:_indexBuffer
+                               indexBufferOffset:0
+                                   instanceCount:_visibleInstances.size()];
+        }
+
+        [renderEncoder popDebugGroup];
+
+        [renderEncoder endEncoding];
+
+        [commandBuffer presentDrawable:view.currentDrawable];
+    }
+
+    _uploadRing->EndFrame();
+
+    [commandBuffer commit];
+
+    _framePacer.RecordCpuFrame(CACurrentMediaTime() - frameStart, waitTime);
+}
+
+- (void)mtkView:(nonnull MTKView *)view drawableSizeWillChange:(CGSize)size
+{
+    /// Respond to drawable size or orientation changes here
+
+    float aspect = size.width / (float)size.height;
+    _projectionMatrix = Float4x4::PerspectiveRightHand(65.0f * (M_PI / 180.0f), aspect, 0.1f, 100.0f);
+}
+
+@end
@@ -25,7 +25,8 @@ typedef NS_ENUM(EnumBackingType, BufferIndex)
 {
     BufferIndexMeshPositions = 0,
     BufferIndexMeshGenerics  = 1,
-    BufferIndexUniforms      = 2
+    BufferIndexUniforms      = 2,
+    BufferIndexInstances     = 3
 };
 
 typedef NS_ENUM(EnumBackingType, VertexAttribute)
@@ -42,8 +43,18 @@ typedef NS_ENUM(EnumBackingType, TextureIndex)
 typedef struct
 {
     matrix_float4x4 projectionMatrix;
-    matrix_float4x4 modelViewMatrix;
+
+    // Mesh positions arrive as unorm16 within the mesh bounds: position = offset + scale * value
+    vector_float3 positionOffset;
+    vector_float3 positionScale;
 } Uniforms;
 
+// One per drawn instance, indexed by [[instance_id]]; InstanceMatrices in InstanceSystem.h
+typedef struct
+{
+    matrix_float4x4 modelMatrix;
+    matrix_float4x4 modelViewMatrix;
+} InstanceUniforms;
+
 #endif /* ShaderTypes_h */
 
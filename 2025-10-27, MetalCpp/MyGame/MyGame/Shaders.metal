@@ -28,12 +28,14 @@ typedef struct
 } ColorInOut;
 
 vertex ColorInOut vertexShader(Vertex in [[stage_in]],
-                               constant Uniforms & uniforms [[ buffer(BufferIndexUniforms) ]])
+                               uint instanceID [[instance_id]],
+                               constant Uniforms & uniforms [[ buffer(BufferIndexUniforms) ]],
+                               constant InstanceUniforms * instances [[ buffer(BufferIndexInstances) ]])
 {
     ColorInOut out;
 
-    float4 position = float4(in.position, 1.0);
-    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * position;
+    float4 position = float4(uniforms.positionOffset + uniforms.positionScale * in.position, 1.0);
+    out.position = uniforms.projectionMatrix * instances[instanceID].modelViewMatrix * position;
     out.texCoord = in.texCoord;
 
     return out;
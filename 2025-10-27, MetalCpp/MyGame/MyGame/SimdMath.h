@@ -0,0 +1,526 @@
+//
+//  SimdMath.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Portable vector, matrix and quaternion math.
+// Float4x4 is column-major with the same layout as matrix_float4x4 (four 16-byte aligned
+// columns), so it can be copied straight into Uniforms. The hot paths use SSE (AVX for the batch
+// functions when compiled with it) on x86 and NEON on arm64; define SIMDMATH_NO_SIMD to build the
+// scalar fallback everywhere, for comparison.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if !defined(SIMDMATH_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define SIMDMATH_SSE 1
+#include <immintrin.h>
+#if defined(__AVX__)
+#define SIMDMATH_AVX 1
+#endif
+#elif !defined(SIMDMATH_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SIMDMATH_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__APPLE__)
+#include <simd/simd.h>
+#endif
+
+struct Float2
+{
+    float x, y;
+};
+
+// Packed, 12 bytes, as in the position stream
+struct Float3
+{
+    float x, y, z;
+
+    Float3 operator+(const Float3& b) const { return { x + b.x, y + b.y, z + b.z }; }
+    Float3 operator-(const Float3& b) const { return { x - b.x, y - b.y, z - b.z }; }
+    Float3 operator-() const { return { -x, -y, -z }; }
+    Float3 operator*(float s) const { return { x * s, y * s, z * s }; }
+    Float3 operator*(const Float3& b) const { return { x * b.x, y * b.y, z * b.z }; }
+};
+
+struct alignas(16) Float4
+{
+    float x, y, z, w;
+
+    Float4 operator+(const Float4& b) const { return { x + b.x, y + b.y, z + b.z, w + b.w }; }
+    Float4 operator-(const Float4& b) const { return { x - b.x, y - b.y, z - b.z, w - b.w }; }
+    Float4 operator*(float s) const { return { x * s, y * s, z * s, w * s }; }
+
+    Float3 Xyz() const { return { x, y, z }; }
+};
+
+inline float Dot(const Float3& a, const Float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline float Dot(const Float4& a, const Float4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+inline float Length(const Float3& v) { return std::sqrt(Dot(v, v)); }
+
+inline Float3 Cross(const Float3& a, const Float3& b)
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+inline Float3 Normalize(const Float3& v)
+{
+    return v * (1.0f / Length(v));
+}
+
+inline Float3 Min(const Float3& a, const Float3& b) { return { std::fmin(a.x, b.x), std::fmin(a.y, b.y), std::fmin(a.z, b.z) }; }
+inline Float3 Max(const Float3& a, const Float3& b) { return { std::fmax(a.x, b.x), std::fmax(a.y, b.y), std::fmax(a.z, b.z) }; }
+
+struct alignas(16) Float4x4
+{
+    Float4 columns[4];
+
+    static Float4x4 Identity()
+    {
+        return { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } };
+    }
+
+    static Float4x4 Translation(float tx, float ty, float tz)
+    {
+        return { { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { tx, ty, tz, 1 } } };
+    }
+
+    static Float4x4 Scale(float sx, float sy, float sz)
+    {
+        return { { { sx, 0, 0, 0 }, { 0, sy, 0, 0 }, { 0, 0, sz, 0 }, { 0, 0, 0, 1 } } };
+    }
+
+    // Counter-clockwise about 'axis' when looking down it; the axis need not be normalized
+    static Float4x4 Rotation(float radians, Float3 axis)
+    {
+        axis = Normalize(axis);
+        float ct = std::cos(radians);
+        float st = std::sin(radians);
+        float ci = 1 - ct;
+        float x = axis.x, y = axis.y, z = axis.z;
+
+        return { {
+            { ct + x * x * ci,     y * x * ci + z * st, z * x * ci - y * st, 0 },
+            { x * y * ci - z * st,     ct + y * y * ci, z * y * ci + x * st, 0 },
+            { x * z * ci + y * st, y * z * ci - x * st,     ct + z * z * ci, 0 },
+            {                   0,                   0,                   0, 1 },
+        } };
+    }
+
+    // Right-handed view space looking down -z, clip space z in [0, 1] as Metal expects
+    static Float4x4 PerspectiveRightHand(float fovyRadians, float aspect, float nearZ, float farZ)
+    {
+        float ys = 1 / std::tan(fovyRadians * 0.5f);
+        float xs = ys / aspect;
+        float zs = farZ / (nearZ - farZ);
+
+        return { {
+            { xs,  0,          0,  0 },
+            {  0, ys,          0,  0 },
+            {  0,  0,         zs, -1 },
+            {  0,  0, nearZ * zs,  0 },
+        } };
+    }
+
+    static Float4x4 LookAtRightHand(const Float3& eye, const Float3& target, const Float3& up)
+    {
+        Float3 z = Normalize(eye - target);
+        Float3 x = Normalize(Cross(up, z));
+        Float3 y = Cross(z, x);
+
+        return { {
+            { x.x, y.x, z.x, 0 },
+            { x.y, y.y, z.y, 0 },
+            { x.z, y.z, z.z, 0 },
+            { -Dot(x, eye), -Dot(y, eye), -Dot(z, eye), 1 },
+        } };
+    }
+};
+
+// Scalar reference versions, also the fallback
+inline Float4 MultiplyScalar(const Float4x4& m, const Float4& v)
+{
+    const Float4* c = m.columns;
+    return {
+        c[0].x * v.x + c[1].x * v.y + c[2].x * v.z + c[3].x * v.w,
+        c[0].y * v.x + c[1].y * v.y + c[2].y * v.z + c[3].y * v.w,
+        c[0].z * v.x + c[1].z * v.y + c[2].z * v.z + c[3].z * v.w,
+        c[0].w * v.x + c[1].w * v.y + c[2].w * v.z + c[3].w * v.w,
+    };
+}
+
+inline Float4x4 MultiplyScalar(const Float4x4& a, const Float4x4& b)
+{
+    Float4x4 r;
+    for (int j = 0; j < 4; j++)
+        r.columns[j] = MultiplyScalar(a, b.columns[j]);
+    return r;
+}
+
+inline Float4 operator*(const Float4x4& m, const Float4& v)
+{
+#if defined(SIMDMATH_SSE)
+    __m128 x = _mm_set1_ps(v.x), y = _mm_set1_ps(v.y), z = _mm_set1_ps(v.z), w = _mm_set1_ps(v.w);
+    __m128 r = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(_mm_load_ps(&m.columns[0].x), x), _mm_mul_ps(_mm_load_ps(&m.columns[1].x), y)),
+        _mm_add_ps(_mm_mul_ps(_mm_load_ps(&m.columns[2].x), z), _mm_mul_ps(_mm_load_ps(&m.columns[3].x), w)));
+
+    Float4 result;
+    _mm_store_ps(&result.x, r);
+    return result;
+#elif defined(SIMDMATH_NEON)
+    float32x4_t vv = vld1q_f32(&v.x);
+    float32x4_t r = vmulq_laneq_f32(vld1q_f32(&m.columns[0].x), vv, 0);
+    r = vfmaq_laneq_f32(r, vld1q_f32(&m.columns[1].x), vv, 1);
+    r = vfmaq_laneq_f32(r, vld1q_f32(&m.columns[2].x), vv, 2);
+    r = vfmaq_laneq_f32(r, vld1q_f32(&m.columns[3].x), vv, 3);
+
+    Float4 result;
+    vst1q_f32(&result.x, r);
+    return result;
+#else
+    return MultiplyScalar(m, v);
+#endif
+}
+
+inline Float4x4 operator*(const Float4x4& a, const Float4x4& b)
+{
+#if defined(SIMDMATH_SSE) || defined(SIMDMATH_NEON)
+    Float4x4 r;
+    for (int j = 0; j < 4; j++)
+        r.columns[j] = a * b.columns[j];
+    return r;
+#else
+    return MultiplyScalar(a, b);
+#endif
+}
+
+inline Float4x4 Transpose(const Float4x4& m)
+{
+    const Float4* c = m.columns;
+    return { {
+        { c[0].x, c[1].x, c[2].x, c[3].x },
+        { c[0].y, c[1].y, c[2].y, c[3].y },
+        { c[0].z, c[1].z, c[2].z, c[3].z },
+        { c[0].w, c[1].w, c[2].w, c[3].w },
+    } };
+}
+
+// General inverse by cofactors; the matrix must not be singular
+inline Float4x4 Inverse(const Float4x4& m)
+{
+    const float* a = &m.columns[0].x;
+    float inv[16];
+
+    inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    float det = 1.0f / (a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12]);
+
+    Float4x4 r;
+    float* out = &r.columns[0].x;
+    for (int i = 0; i < 16; i++)
+        out[i] = inv[i] * det;
+    return r;
+}
+
+// Unit quaternion for rotations, (x, y, z) is the vector part
+struct alignas(16) Quat
+{
+    float x, y, z, w;
+
+    static Quat Identity() { return { 0, 0, 0, 1 }; }
+
+    // Same rotation as Float4x4::Rotation
+    static Quat FromAxisAngle(Float3 axis, float radians)
+    {
+        axis = Normalize(axis);
+        float s = std::sin(radians * 0.5f);
+        return { axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f) };
+    }
+
+    // Applies b first, then this
+    Quat operator*(const Quat& b) const
+    {
+        return {
+            w * b.x + x * b.w + y * b.z - z * b.y,
+            w * b.y - x * b.z + y * b.w + z * b.x,
+            w * b.z + x * b.y - y * b.x + z * b.w,
+            w * b.w - x * b.x - y * b.y - z * b.z,
+        };
+    }
+
+    Float3 Rotate(const Float3& v) const
+    {
+        Float3 u = { x, y, z };
+        Float3 t = Cross(u, v) * 2.0f;
+        return v + t * w + Cross(u, t);
+    }
+
+    Float4x4 ToMatrix() const
+    {
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+
+        return { {
+            { 1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0 },
+            { 2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0 },
+            { 2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0 },
+            { 0, 0, 0, 1 },
+        } };
+    }
+};
+
+inline Quat Normalize(const Quat& q)
+{
+    float s = 1.0f / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    return { q.x * s, q.y * s, q.z * s, q.w * s };
+}
+
+// Shortest-arc interpolation, falls back to normalized lerp when the rotations are close
+inline Quat Slerp(const Quat& a, Quat b, float t)
+{
+    float cosine = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    if (cosine < 0)
+    {
+        b = { -b.x, -b.y, -b.z, -b.w };
+        cosine = -cosine;
+    }
+
+    float wa = 1 - t, wb = t;
+    if (cosine < 0.9995f)
+    {
+        float angle = std::acos(cosine);
+        float s = 1.0f / std::sin(angle);
+        wa = std::sin((1 - t) * angle) * s;
+        wb = std::sin(t * angle) * s;
+    }
+
+    return Normalize(Quat { a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb });
+}
+
+// Rotation, then scale, then translation: T * R * S
+inline Float4x4 MakeTransform(const Float3& position, const Quat& rotation, const Float3& scale)
+{
+    Float4x4 m = rotation.ToMatrix();
+    m.columns[0] = m.columns[0] * scale.x;
+    m.columns[1] = m.columns[1] * scale.y;
+    m.columns[2] = m.columns[2] * scale.z;
+    m.columns[3] = { position.x, position.y, position.z, 1 };
+    return m;
+}
+
+// Planes (a, b, c, d) bounding the clip volume of 'm', e.g. projection * view, in the space 'm'
+// maps from: left, right, bottom, top, near (clip z >= 0 as in Metal), far. They are normalized,
+// so a * x + b * y + c * z + d is the signed distance, positive inside.
+inline void ExtractFrustumPlanes(const Float4x4& m, Float4 planes[6])
+{
+    const Float4* c = m.columns;
+    Float4 row0 = { c[0].x, c[1].x, c[2].x, c[3].x };
+    Float4 row1 = { c[0].y, c[1].y, c[2].y, c[3].y };
+    Float4 row2 = { c[0].z, c[1].z, c[2].z, c[3].z };
+    Float4 row3 = { c[0].w, c[1].w, c[2].w, c[3].w };
+
+    planes[0] = row3 + row0;
+    planes[1] = row3 - row0;
+    planes[2] = row3 + row1;
+    planes[3] = row3 - row1;
+    planes[4] = row2;
+    planes[5] = row3 - row2;
+
+    for (int i = 0; i < 6; i++)
+        planes[i] = planes[i] * (1 / Length(planes[i].Xyz()));
+}
+
+#if defined(__APPLE__)
+static_assert(sizeof(Float4x4) == sizeof(matrix_float4x4) && alignof(Float4x4) == alignof(matrix_float4x4));
+
+inline matrix_float4x4 ToSimd(const Float4x4& m)
+{
+    matrix_float4x4 r;
+    std::memcpy(&r, &m, sizeof(r));
+    return r;
+}
+#endif
+
+// Batch transforms over arrays of thousands of matrices or points. The SIMD versions keep the
+// shared matrix in registers across the whole array; with AVX two columns are done per instruction.
+// Optimizing compilers often vectorize the scalar loops as well, so measure before relying on a
+// gap (Tests/SimdMathBenchmark).
+
+// out[i] = left * right[i], e.g. view * model for every object. 'out' may alias 'right'.
+inline void MultiplyBatchScalar(const Float4x4& left, const Float4x4* right, Float4x4* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = MultiplyScalar(left, right[i]);
+}
+
+inline void MultiplyBatch(const Float4x4& left, const Float4x4* right, Float4x4* out, size_t count)
+{
+#if defined(SIMDMATH_AVX)
+    __m256 c0 = _mm256_broadcast_ps((const __m128*)&left.columns[0]);
+    __m256 c1 = _mm256_broadcast_ps((const __m128*)&left.columns[1]);
+    __m256 c2 = _mm256_broadcast_ps((const __m128*)&left.columns[2]);
+    __m256 c3 = _mm256_broadcast_ps((const __m128*)&left.columns[3]);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* b = &right[i].columns[0].x;
+        float* o = &out[i].columns[0].x;
+
+        for (int j = 0; j < 16; j += 8)
+        {
+            __m256 bj = _mm256_loadu_ps(b + j);
+            __m256 r = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(c0, _mm256_permute_ps(bj, 0x00)), _mm256_mul_ps(c1, _mm256_permute_ps(bj, 0x55))),
+                _mm256_add_ps(_mm256_mul_ps(c2, _mm256_permute_ps(bj, 0xAA)), _mm256_mul_ps(c3, _mm256_permute_ps(bj, 0xFF))));
+            _mm256_storeu_ps(o + j, r);
+        }
+    }
+#elif defined(SIMDMATH_SSE)
+    __m128 c0 = _mm_load_ps(&left.columns[0].x);
+    __m128 c1 = _mm_load_ps(&left.columns[1].x);
+    __m128 c2 = _mm_load_ps(&left.columns[2].x);
+    __m128 c3 = _mm_load_ps(&left.columns[3].x);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* b = &right[i].columns[0].x;
+        float* o = &out[i].columns[0].x;
+
+        for (int j = 0; j < 16; j += 4)
+        {
+            __m128 bj = _mm_load_ps(b + j);
+            __m128 r = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(bj, bj, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(bj, bj, 0x55))),
+                _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(bj, bj, 0xAA)), _mm_mul_ps(c3, _mm_shuffle_ps(bj, bj, 0xFF))));
+            _mm_store_ps(o + j, r);
+        }
+    }
+#elif defined(SIMDMATH_NEON)
+    float32x4_t c0 = vld1q_f32(&left.columns[0].x);
+    float32x4_t c1 = vld1q_f32(&left.columns[1].x);
+    float32x4_t c2 = vld1q_f32(&left.columns[2].x);
+    float32x4_t c3 = vld1q_f32(&left.columns[3].x);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const float* b = &right[i].columns[0].x;
+        float* o = &out[i].columns[0].x;
+
+        for (int j = 0; j < 16; j += 4)
+        {
+            float32x4_t bj = vld1q_f32(b + j);
+            float32x4_t r = vmulq_laneq_f32(c0, bj, 0);
+            r = vfmaq_laneq_f32(r, c1, bj, 1);
+            r = vfmaq_laneq_f32(r, c2, bj, 2);
+            r = vfmaq_laneq_f32(r, c3, bj, 3);
+            vst1q_f32(o + j, r);
+        }
+    }
+#else
+    MultiplyBatchScalar(left, right, out, count);
+#endif
+}
+
+// out[i] = left[i] * right[i]. 'out' may alias either input.
+inline void MultiplyBatchScalar(const Float4x4* left, const Float4x4* right, Float4x4* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = MultiplyScalar(left[i], right[i]);
+}
+
+inline void MultiplyBatch(const Float4x4* left, const Float4x4* right, Float4x4* out, size_t count)
+{
+#if defined(SIMDMATH_SSE) || defined(SIMDMATH_NEON)
+    for (size_t i = 0; i < count; i++)
+        out[i] = left[i] * right[i];
+#else
+    MultiplyBatchScalar(left, right, out, count);
+#endif
+}
+
+// out[i] = m * (points[i], 1)
+inline void TransformPointsScalar(const Float4x4& m, const Float3* points, Float4* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = MultiplyScalar(m, Float4 { points[i].x, points[i].y, points[i].z, 1 });
+}
+
+inline void TransformPoints(const Float4x4& m, const Float3* points, Float4* out, size_t count)
+{
+#if defined(SIMDMATH_AVX)
+    // two points per iteration, one per 128-bit lane
+    __m256 c0 = _mm256_broadcast_ps((const __m128*)&m.columns[0]);
+    __m256 c1 = _mm256_broadcast_ps((const __m128*)&m.columns[1]);
+    __m256 c2 = _mm256_broadcast_ps((const __m128*)&m.columns[2]);
+    __m256 c3 = _mm256_broadcast_ps((const __m128*)&m.columns[3]);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const Float3& p = points[i];
+        const Float3& q = points[i + 1];
+        __m256 x = _mm256_setr_m128(_mm_set1_ps(p.x), _mm_set1_ps(q.x));
+        __m256 y = _mm256_setr_m128(_mm_set1_ps(p.y), _mm_set1_ps(q.y));
+        __m256 z = _mm256_setr_m128(_mm_set1_ps(p.z), _mm_set1_ps(q.z));
+
+        __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)), _mm256_add_ps(_mm256_mul_ps(c2, z), c3));
+        _mm256_storeu_ps(&out[i].x, r);
+    }
+
+    for (; i < count; i++)
+        out[i] = m * Float4 { points[i].x, points[i].y, points[i].z, 1 };
+#elif defined(SIMDMATH_SSE)
+    __m128 c0 = _mm_load_ps(&m.columns[0].x);
+    __m128 c1 = _mm_load_ps(&m.columns[1].x);
+    __m128 c2 = _mm_load_ps(&m.columns[2].x);
+    __m128 c3 = _mm_load_ps(&m.columns[3].x);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Float3& p = points[i];
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p.x)), _mm_mul_ps(c1, _mm_set1_ps(p.y))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p.z)), c3));
+        _mm_store_ps(&out[i].x, r);
+    }
+#elif defined(SIMDMATH_NEON)
+    float32x4_t c0 = vld1q_f32(&m.columns[0].x);
+    float32x4_t c1 = vld1q_f32(&m.columns[1].x);
+    float32x4_t c2 = vld1q_f32(&m.columns[2].x);
+    float32x4_t c3 = vld1q_f32(&m.columns[3].x);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const Float3& p = points[i];
+        float32x4_t r = vfmaq_n_f32(c3, c0, p.x);
+        r = vfmaq_n_f32(r, c1, p.y);
+        r = vfmaq_n_f32(r, c2, p.z);
+        vst1q_f32(&out[i].x, r);
+    }
+#else
+    TransformPointsScalar(m, points, out, count);
+#endif
+}
@@ -0,0 +1,548 @@
+//
+//  SoftwareRasterizer.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+#include "MeshGenerator.h"
+
+namespace
+{
+    constexpr int SubpixelBits = 8;
+    constexpr int64_t SubpixelOne = 1 << SubpixelBits;
+
+    // Clip space x and y are kept within this many viewports, which bounds the fixed point range
+    constexpr float GuardBand = 8.0f;
+
+    float SrgbToLinear(float c)
+    {
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float LinearToSrgb(float c)
+    {
+        return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+
+    struct ColorTables
+    {
+        float decode[256];
+        uint8_t encode[4096];   // indexed by linear value * 4095
+
+        ColorTables()
+        {
+            for (int i = 0; i < 256; i++)
+                decode[i] = SrgbToLinear(i / 255.0f);
+
+            for (int i = 0; i < 4096; i++)
+                encode[i] = (uint8_t)std::lround(LinearToSrgb(i / 4095.0f) * 255.0f);
+        }
+    };
+
+    const ColorTables& GetColorTables()
+    {
+        static const ColorTables tables;
+        return tables;
+    }
+
+    uint8_t ToUnorm8(float value, bool srgb)
+    {
+        value = std::clamp(value, 0.0f, 1.0f);
+        if (srgb) return GetColorTables().encode[(int)(value * 4095.0f + 0.5f)];
+        return (uint8_t)(value * 255.0f + 0.5f);
+    }
+
+    struct ClipVertex
+    {
+        Float4 position;
+        float u;
+        float v;
+    };
+
+    ClipVertex Lerp(const ClipVertex& a, const ClipVertex& b, float t)
+    {
+        return {
+            a.position + (b.position - a.position) * t,
+            a.u + (b.u - a.u) * t,
+            a.v + (b.v - a.v) * t,
+        };
+    }
+
+    // Sutherland-Hodgman against one plane, keeping Dot(plane, position) >= 0
+    int ClipPolygon(const ClipVertex* in, int count, const Float4& plane, ClipVertex* out)
+    {
+        int outCount = 0;
+        for (int i = 0; i < count; i++)
+        {
+            const ClipVertex& a = in[i];
+            const ClipVertex& b = in[(i + 1) % count];
+            float da = Dot(plane, a.position);
+            float db = Dot(plane, b.position);
+
+            if (da >= 0) out[outCount++] = a;
+            if ((da >= 0) != (db >= 0)) out[outCount++] = Lerp(a, b, da / (da - db));
+        }
+        return outCount;
+    }
+
+    // A screen space triangle ready for the tiles, ordered so every edge function is positive
+    // inside, with attributes that interpolate linearly in screen space
+    struct Triangle
+    {
+        int64_t x[3];
+        int64_t y[3];
+        int64_t area;           // twice the area in subpixel units, positive
+        int minX, minY, maxX, maxY;
+
+        float z[3];
+        float q[3];             // 1 / w
+        float u[3];             // u / w
+        float v[3];             // v / w
+
+        // per pixel gradients of q, u / w and v / w, for the mip level
+        float dqdx, dqdy, dudx, dudy, dvdx, dvdy;
+    };
+
+    struct Edge
+    {
+        int64_t stepX;
+        int64_t stepY;
+        int64_t bias;           // 0 for top-left edges, -1 otherwise
+    };
+
+    // Edge opposite vertex i
+    Edge MakeEdge(const Triangle& t, int i)
+    {
+        int a = (i + 1) % 3, b = (i + 2) % 3;
+        int64_t dx = t.x[b] - t.x[a];
+        int64_t dy = t.y[b] - t.y[a];
+
+        bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+        return { -dy * SubpixelOne, dx * SubpixelOne, topLeft ? 0 : -1 };
+    }
+
+    int64_t EvaluateEdge(const Triangle& t, int i, int64_t px, int64_t py)
+    {
+        int a = (i + 1) % 3, b = (i + 2) % 3;
+        return (t.x[b] - t.x[a]) * (py - t.y[a]) - (t.y[b] - t.y[a]) * (px - t.x[a]);
+    }
+
+    bool SetupTriangle(const ClipVertex* v, int width, int height, Triangle& t)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            float q = 1.0f / v[i].position.w;
+            float sx = (v[i].position.x * q * 0.5f + 0.5f) * width;
+            float sy = (0.5f - v[i].position.y * q * 0.5f) * height;
+
+            t.x[i] = (int64_t)std::lround(sx * SubpixelOne);
+            t.y[i] = (int64_t)std::lround(sy * SubpixelOne);
+            t.z[i] = v[i].position.z * q;
+            t.q[i] = q;
+            t.u[i] = v[i].u * q;
+            t.v[i] = v[i].v * q;
+        }
+
+        // counter-clockwise in clip space is clockwise with y down, which gives a negative area
+        int64_t area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.y[1] - t.y[0]) * (t.x[2] - t.x[0]);
+        if (area >= 0) return false;
+
+        // swap two vertices so inside is positive for every edge
+        std::swap(t.x[1], t.x[2]);
+        std::swap(t.y[1], t.y[2]);
+        std::swap(t.z[1], t.z[2]);
+        std::swap(t.q[1], t.q[2]);
+        std::swap(t.u[1], t.u[2]);
+        std::swap(t.v[1], t.v[2]);
+        t.area = -area;
+
+        int64_t minX = std::min({ t.x[0], t.x[1], t.x[2] });
+        int64_t maxX = std::max({ t.x[0], t.x[1], t.x[2] });
+        int64_t minY = std::min({ t.y[0], t.y[1], t.y[2] });
+        int64_t maxY = std::max({ t.y[0], t.y[1], t.y[2] });
+
+        // pixels whose centers can be inside
+        t.minX = std::max(0, (int)((minX - SubpixelOne / 2) >> SubpixelBits));
+        t.minY = std::max(0, (int)((minY - SubpixelOne / 2) >> SubpixelBits));
+        t.maxX = std::min(width - 1, (int)((maxX - SubpixelOne / 2) >> SubpixelBits) + 1);
+        t.maxY = std::min(height - 1, (int)((maxY - SubpixelOne / 2) >> SubpixelBits) + 1);
+        if (t.minX > t.maxX || t.minY > t.maxY) return false;
+
+        // barycentric gradients per pixel
+        float dldx[3], dldy[3];
+        for (int i = 0; i < 3; i++)
+        {
+            Edge e = MakeEdge(t, i);
+            dldx[i] = (float)e.stepX / t.area;
+            dldy[i] = (float)e.stepY / t.area;
+        }
+
+        auto gradient = [](const float* d, const float* a) { return d[0] * a[0] + d[1] * a[1] + d[2] * a[2]; };
+        t.dqdx = gradient(dldx, t.q);
+        t.dqdy = gradient(dldy, t.q);
+        t.dudx = gradient(dldx, t.u);
+        t.dudy = gradient(dldy, t.u);
+        t.dvdx = gradient(dldx, t.v);
+        t.dvdy = gradient(dldy, t.v);
+        return true;
+    }
+
+    uint64_t RasterizeTriangle(const Triangle& t, int x0, int y0, int x1, int y1, const RasterTexture& texture, RasterFramebuffer& target)
+    {
+        x0 = std::max(x0, t.minX);
+        y0 = std::max(y0, t.minY);
+        x1 = std::min(x1, t.maxX);
+        y1 = std::min(y1, t.maxY);
+        if (x0 > x1 || y0 > y1) return 0;
+
+        Edge edges[3];
+        int64_t rowStart[3];
+        int64_t px = (int64_t)x0 * SubpixelOne + SubpixelOne / 2;
+        int64_t py = (int64_t)y0 * SubpixelOne + SubpixelOne / 2;
+        for (int i = 0; i < 3; i++)
+        {
+            edges[i] = MakeEdge(t, i);
+            rowStart[i] = EvaluateEdge(t, i, px, py) + edges[i].bias;
+        }
+
+        float inverseArea = 1.0f / t.area;
+        float texWidth = (float)texture.GetWidth();
+        float texHeight = (float)texture.GetHeight();
+        uint64_t shaded = 0;
+
+        for (int y = y0; y <= y1; y++)
+        {
+            int64_t e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+            size_t row = (size_t)y * target.width;
+
+            for (int x = x0; x <= x1; x++)
+            {
+                if ((e0 | e1 | e2) >= 0)
+                {
+                    float l0 = (e0 - edges[0].bias) * inverseArea;
+                    float l1 = (e1 - edges[1].bias) * inverseArea;
+                    float l2 = (e2 - edges[2].bias) * inverseArea;
+
+                    float z = l0 * t.z[0] + l1 * t.z[1] + l2 * t.z[2];
+                    float& depth = target.depth[row + x];
+
+                    // MTLCompareFunctionLess
+                    if (z < depth)
+                    {
+                        depth = z;
+
+                        float q = l0 * t.q[0] + l1 * t.q[1] + l2 * t.q[2];
+                        float w = 1.0f / q;
+                        float u = (l0 * t.u[0] + l1 * t.u[1] + l2 * t.u[2]) * w;
+                        float v = (l0 * t.v[0] + l1 * t.v[1] + l2 * t.v[2]) * w;
+
+                        // d(U / Q) = (dU - u dQ) / Q, in texels
+                        float dudx = (t.dudx - u * t.dqdx) * w * texWidth;
+                        float dudy = (t.dudy - u * t.dqdy) * w * texWidth;
+                        float dvdx = (t.dvdx - v * t.dqdx) * w * texHeight;
+                        float dvdy = (t.dvdy - v * t.dqdy) * w * texHeight;
+                        float rho2 = std::max(dudx * dudx + dvdx * dvdx, dudy * dudy + dvdy * dvdy);
+                        float lod = rho2 > 0 ? 0.5f * std::log2(rho2) : 0.0f;
+
+                        Float4 c = texture.Sample(u, v, lod);
+                        target.color[row + x] = ToUnorm8(c.x, target.srgb) | ToUnorm8(c.y, target.srgb) << 8 | ToUnorm8(c.z, target.srgb) << 16 | (uint32_t)ToUnorm8(c.w, false) << 24;
+                        shaded++;
+                    }
+                }
+
+                e0 += edges[0].stepX;
+                e1 += edges[1].stepX;
+                e2 += edges[2].stepX;
+            }
+
+            for (int i = 0; i < 3; i++)
+                rowStart[i] += edges[i].stepY;
+        }
+
+        return shaded;
+    }
+
+    template<typename Func>
+    void RunOnThreads(unsigned threadCount, Func&& func)
+    {
+        if (threadCount <= 1)
+        {
+            func(0u);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for (unsigned i = 1; i < threadCount; i++)
+            threads.emplace_back(func, i);
+
+        func(0u);
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+}
+
+RasterTexture::RasterTexture(const uint32_t* rgba, int width, int height, bool srgb)
+{
+    const ColorTables& tables = GetColorTables();
+
+    Level base { width, height, std::vector<Float4>((size_t)width * height) };
+    for (size_t i = 0; i < base.texels.size(); i++)
+    {
+        uint32_t c = rgba[i];
+        auto channel = [&](int shift) { return srgb ? tables.decode[(c >> shift) & 0xFF] : ((c >> shift) & 0xFF) / 255.0f; };
+        base.texels[i] = { channel(0), channel(8), channel(16), ((c >> 24) & 0xFF) / 255.0f };
+    }
+    levels.push_back(std::move(base));
+
+    while (levels.back().width > 1 || levels.back().height > 1)
+    {
+        const Level& prev = levels.back();
+        Level next { std::max(1, prev.width / 2), std::max(1, prev.height / 2), {} };
+        next.texels.resize((size_t)next.width * next.height);
+
+        for (int y = 0; y < next.height; y++)
+        {
+            int y0 = std::min(y * 2, prev.height - 1), y1 = std::min(y * 2 + 1, prev.height - 1);
+            for (int x = 0; x < next.width; x++)
+            {
+                int x0 = std::min(x * 2, prev.width - 1), x1 = std::min(x * 2 + 1, prev.width - 1);
+                const Float4* row0 = &prev.texels[(size_t)y0 * prev.width];
+                const Float4* row1 = &prev.texels[(size_t)y1 * prev.width];
+                next.texels[(size_t)y * next.width + x] = (row0[x0] + row0[x1] + row1[x0] + row1[x1]) * 0.25f;
+            }
+        }
+
+        levels.push_back(std::move(next));
+    }
+}
+
+RasterTexture RasterTexture::Checkerboard(int size, int tiles, uint32_t color0, uint32_t color1)
+{
+    std::vector<uint32_t> texels((size_t)size * size);
+    for (int y = 0; y < size; y++)
+        for (int x = 0; x < size; x++)
+            texels[(size_t)y * size + x] = ((x * tiles / size + y * tiles / size) & 1) ? color1 : color0;
+
+    return RasterTexture(texels.data(), size, size);
+}
+
+Float4 RasterTexture::SampleBilinear(const Level& level, float u, float v) const
+{
+    float x = u * level.width - 0.5f;
+    float y = v * level.height - 0.5f;
+    float fx = std::floor(x), fy = std::floor(y);
+    float tx = x - fx, ty = y - fy;
+
+    // clamp to edge
+    auto clampX = [&](float c) { return (size_t)std::clamp((int)c, 0, level.width - 1); };
+    auto clampY = [&](float c) { return (size_t)std::clamp((int)c, 0, level.height - 1); };
+    size_t x0 = clampX(fx), x1 = clampX(fx + 1);
+    size_t y0 = clampY(fy), y1 = clampY(fy + 1);
+
+    const Float4* row0 = &level.texels[y0 * level.width];
+    const Float4* row1 = &level.texels[y1 * level.width];
+    Float4 top = row0[x0] + (row0[x1] - row0[x0]) * tx;
+    Float4 bottom = row1[x0] + (row1[x1] - row1[x0]) * tx;
+    return top + (bottom - top) * ty;
+}
+
+Float4 RasterTexture::Sample(float u, float v, float lod) const
+{
+    lod = std::clamp(lod, 0.0f, (float)(levels.size() - 1));
+    int level = (int)lod;
+    float t = lod - level;
+
+    Float4 a = SampleBilinear(levels[level], u, v);
+    if (t == 0.0f) return a;
+
+    Float4 b = SampleBilinear(levels[level + 1], u, v);
+    return a + (b - a) * t;
+}
+
+RasterFramebuffer::RasterFramebuffer(int width, int height, bool srgb)
+    : width(width)
+    , height(height)
+    , srgb(srgb)
+    , color((size_t)width * height)
+    , depth((size_t)width * height)
+{
+    Clear(0xFF000000);
+}
+
+void RasterFramebuffer::Clear(uint32_t clearColor, float clearDepth)
+{
+    std::fill(color.begin(), color.end(), clearColor);
+    std::fill(depth.begin(), depth.end(), clearDepth);
+}
+
+bool RasterFramebuffer::WritePpm(const char* path) const
+{
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+
+    std::vector<uint8_t> rgb(color.size() * 3);
+    for (size_t i = 0; i < color.size(); i++)
+    {
+        rgb[i * 3 + 0] = color[i] & 0xFF;
+        rgb[i * 3 + 1] = (color[i] >> 8) & 0xFF;
+        rgb[i * 3 + 2] = (color[i] >> 16) & 0xFF;
+    }
+
+    bool ok = std::fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+SoftwareRasterizer::SoftwareRasterizer(unsigned threadCount)
+    : threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+RasterStats SoftwareRasterizer::DrawIndexed(const RasterMesh& mesh, const RasterUniforms& uniforms, const RasterTexture& texture, RasterFramebuffer& target) const
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // vertexShader
+    Float4x4 modelViewProjection = uniforms.projectionMatrix * uniforms.modelViewMatrix;
+    std::vector<Float4> clip(mesh.vertexCount);
+    TransformPoints(modelViewProjection, mesh.positions, clip.data(), mesh.vertexCount);
+
+    size_t triangleCount = mesh.indexCount / 3;
+    int tilesX = (target.width + TileSize - 1) / TileSize;
+    int tilesY = (target.height + TileSize - 1) / TileSize;
+    size_t tileCount = (size_t)tilesX * tilesY;
+
+    // setup and binning, each thread on a contiguous slice of the triangles
+    struct Setup
+    {
+        std::vector<Triangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;
+    };
+
+    std::vector<Setup> setups(threadCount);
+
+    const Float4 planes[] =
+    {
+        { 0, 0, 1, 0 },             // near, z >= 0
+        { 0, 0, -1, 1 },            // far, z <= w
+        { 1, 0, 0, GuardBand },
+        { -1, 0, 0, GuardBand },
+        { 0, 1, 0, GuardBand },
+        { 0, -1, 0, GuardBand },
+    };
+
+    RunOnThreads(threadCount, [&](unsigned thread)
+    {
+        Setup& setup = setups[thread];
+        setup.bins.resize(tileCount);
+
+        size_t first = triangleCount * thread / threadCount;
+        size_t last = triangleCount * (thread + 1) / threadCount;
+
+        auto index = [&](size_t i) -> uint32_t
+        {
+            return mesh.indices32 ? ((const uint32_t*)mesh.indices)[i] : ((const uint16_t*)mesh.indices)[i];
+        };
+
+        ClipVertex polygon[9], clipped[9];
+
+        for (size_t i = first; i < last; i++)
+        {
+            int count = 3;
+            bool inside = true;
+            for (int k = 0; k < 3; k++)
+            {
+                uint32_t vertex = index(i * 3 + k);
+                polygon[k] = { clip[vertex], mesh.texcoords[vertex].x, mesh.texcoords[vertex].y };
+
+                const Float4& p = polygon[k].position;
+                if (p.z < 0 || p.z > p.w || std::fabs(p.x) > GuardBand * p.w || std::fabs(p.y) > GuardBand * p.w) inside = false;
+            }
+
+            if (!inside)
+            {
+                for (const Float4& plane : planes)
+                {
+                    count = ClipPolygon(polygon, count, plane, clipped);
+                    std::copy(clipped, clipped + count, polygon);
+                    if (count < 3) break;
+                }
+            }
+
+            for (int k = 2; k < count; k++)
+            {
+                ClipVertex fan[3] = { polygon[0], polygon[k - 1], polygon[k] };
+
+                Triangle t;
+                if (!SetupTriangle(fan, target.width, target.height, t)) continue;
+
+                uint32_t id = (uint32_t)setup.triangles.size();
+                setup.triangles.push_back(t);
+
+                for (int ty = t.minY / TileSize; ty <= t.maxY / TileSize; ty++)
+                    for (int tx = t.minX / TileSize; tx <= t.maxX / TileSize; tx++)
+                        setup.bins[(size_t)ty * tilesX + tx].push_back(id);
+            }
+        }
+    });
+
+    // rasterization, one tile at a time per thread
+    std::atomic<size_t> nextTile { 0 };
+    std::atomic<uint64_t> shaded { 0 };
+
+    RunOnThreads(threadCount, [&](unsigned)
+    {
+        uint64_t count = 0;
+
+        for (size_t tile; (tile = nextTile.fetch_add(1, std::memory_order_relaxed)) < tileCount;)
+        {
+            int x0 = (int)(tile % tilesX) * TileSize;
+            int y0 = (int)(tile / tilesX) * TileSize;
+            int x1 = std::min(x0 + TileSize, target.width) - 1;
+            int y1 = std::min(y0 + TileSize, target.height) - 1;
+
+            // slices in order keep submission order within the tile
+            for (const Setup& setup : setups)
+                for (uint32_t id : setup.bins[tile])
+                    count += RasterizeTriangle(setup.triangles[id], x0, y0, x1, y1, texture, target);
+        }
+
+        shaded.fetch_add(count, std::memory_order_relaxed);
+    });
+
+    RasterStats stats {};
+    stats.triangles = triangleCount;
+    for (const Setup& setup : setups)
+        stats.trianglesRasterized += setup.triangles.size();
+    stats.fragmentsShaded = shaded.load();
+    stats.microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+RasterStats RenderRotatingBox(const SoftwareRasterizer& rasterizer, float rotation, const RasterTexture& texture, RasterFramebuffer& target)
+{
+    MeshData box = GenerateBox({ 4, 4, 4 });
+
+    // as in Renderer's _updateGameState and drawableSizeWillChange
+    RasterUniforms uniforms;
+    float aspect = (float)target.width / target.height;
+    uniforms.projectionMatrix = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), aspect, 0.1f, 100.0f);
+    uniforms.modelViewMatrix = Float4x4::Translation(0.0f, 0.0f, -8.0f) * Float4x4::Rotation(rotation, { 1, 1, 0 });
+
+    RasterMesh mesh { box.positions.data(), box.texcoords.data(), box.GetVertexCount(), box.GetIndexData(), box.Uses32BitIndices(), box.GetIndexCount() };
+
+    target.Clear(0xFF000000);
+    return rasterizer.DrawIndexed(mesh, uniforms, texture, target);
+}
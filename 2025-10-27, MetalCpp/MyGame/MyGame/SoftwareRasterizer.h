@@ -0,0 +1,123 @@
+//
+//  SoftwareRasterizer.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// CPU reference implementation of the MyGame render pipeline, for checking the shaders and
+// renderer changes without a Mac GPU.
+//
+// It runs the same stages as the Metal pipeline set up in Renderer.mm:
+// - vertexShader: clip position = projectionMatrix * modelViewMatrix * (position, 1)
+// - clipping against the near plane (clip z >= 0), viewport transform with y pointing down
+// - back-face culling with counter-clockwise front faces
+// - depth test MTLCompareFunctionLess with depth writes, depth cleared to 1
+// - fragmentShader: perspective-correct texCoord, trilinear sampling (linear min, mag and mip
+//   filters, clamp to edge), sRGB decode of the texture and encode of the target like the
+//   *_sRGB formats
+//
+// Triangles are set up in parallel and binned into 64x64 pixel tiles; each tile is then
+// rasterized by one thread, in submission order, so the result does not depend on the thread
+// count. Edges use 8-bit subpixel fixed point with the top-left fill rule.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SimdMath.h"
+
+// RGBA8 with a full mip chain, red in the low byte
+class RasterTexture
+{
+    struct Level
+    {
+        int width;
+        int height;
+        std::vector<Float4> texels;     // linear
+    };
+
+    std::vector<Level> levels;
+
+public:
+    // Builds the mip chain with a 2x2 box filter in linear space
+    RasterTexture(const uint32_t* rgba, int width, int height, bool srgb = true);
+
+    // 'tiles' by 'tiles' squares alternating between two colors
+    static RasterTexture Checkerboard(int size, int tiles, uint32_t color0, uint32_t color1);
+
+    int GetWidth() const { return levels[0].width; }
+    int GetHeight() const { return levels[0].height; }
+    int GetLevelCount() const { return (int)levels.size(); }
+
+    // Linear color, bilinear between texels and linear between the two nearest levels
+    Float4 Sample(float u, float v, float lod) const;
+
+private:
+    Float4 SampleBilinear(const Level& level, float u, float v) const;
+};
+
+class RasterFramebuffer
+{
+public:
+    int width;
+    int height;
+    bool srgb;
+    std::vector<uint32_t> color;    // RGBA8, red in the low byte
+    std::vector<float> depth;
+
+    RasterFramebuffer(int width, int height, bool srgb = true);
+
+    void Clear(uint32_t clearColor, float clearDepth = 1.0f);
+
+    // Binary PPM, alpha dropped
+    bool WritePpm(const char* path) const;
+};
+
+// The matrices the vertex shader uses: Uniforms and one instance's InstanceUniforms in
+// ShaderTypes.h; meshes here are not quantized
+struct RasterUniforms
+{
+    Float4x4 projectionMatrix;
+    Float4x4 modelViewMatrix;
+};
+
+// Split float streams as in MeshData: positions at stride 12, texcoords at stride 8
+struct RasterMesh
+{
+    const Float3* positions;
+    const Float2* texcoords;
+    size_t vertexCount;
+    const void* indices;
+    bool indices32;                 // MTLIndexTypeUInt32, otherwise UInt16
+    size_t indexCount;
+};
+
+struct RasterStats
+{
+    uint64_t triangles;             // submitted
+    uint64_t trianglesRasterized;   // after culling and clipping, clipped pieces counted apart
+    uint64_t fragmentsShaded;       // passed the depth test
+    double microseconds;
+};
+
+class SoftwareRasterizer
+{
+    unsigned threadCount;
+
+public:
+    static constexpr int TileSize = 64;
+
+    // 0 uses one thread per hardware thread
+    explicit SoftwareRasterizer(unsigned threadCount = 0);
+
+    unsigned GetThreadCount() const { return threadCount; }
+
+    RasterStats DrawIndexed(const RasterMesh& mesh, const RasterUniforms& uniforms, const RasterTexture& texture, RasterFramebuffer& target) const;
+};
+
+// The Renderer's center instance alone: the 4x4x4 box rotated about (1, 1, 0), 8 units in front
+// of the camera with a 65 degree field of view. Clears the target first.
+RasterStats RenderRotatingBox(const SoftwareRasterizer& rasterizer, float rotation, const RasterTexture& texture, RasterFramebuffer& target);
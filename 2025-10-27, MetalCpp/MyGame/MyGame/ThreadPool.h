@@ -0,0 +1,58 @@
+//
+//  ThreadPool.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops.
+// The calling thread takes part in every loop, so a pool with N threads runs N + 1 workers.
+class ThreadPool
+{
+    using RangeFunc = std::function<void(size_t begin, size_t end, size_t worker)>;
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // current loop, guarded by mutex except for the atomics
+    const RangeFunc* func;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> next;
+    size_t busyThreads;
+    uint64_t generation;
+    bool stopping;
+
+public:
+    // threadCount 0 uses one thread less than the hardware concurrency
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of distinct worker indices passed to loop bodies
+    size_t GetWorkerCount() const { return threads.size() + 1; }
+
+    // Calls func(begin, end, worker) over [0, count) in chunks of at most 'grain' items and returns
+    // when all chunks are done. Chunks are handed out dynamically, so the order is unspecified;
+    // 'worker' is stable for the duration of one call to func and is < GetWorkerCount().
+    void ParallelFor(size_t count, size_t grain, const RangeFunc& func);
+
+private:
+    void WorkerMain(size_t worker);
+    void RunChunks(size_t worker);
+};
@@ -0,0 +1,88 @@
+//
+//  UploadRing.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include "UploadRing.h"
+
+#include <algorithm>
+#include <cassert>
+
+UploadRing::UploadRing(void* base, size_t capacity)
+    : base((uint8_t*)base)
+    , capacity(capacity)
+    , head(0)
+    , used(0)
+    , frameOpen(false)
+    , frameValue(0)
+    , frameConsumed(0)
+    , frameStats {}
+    , stats {}
+{
+}
+
+void UploadRing::Retire(uint64_t completedValue)
+{
+    while (!inFlight.empty() && inFlight.front().value <= completedValue)
+    {
+        used -= inFlight.front().consumed;
+        inFlight.pop_front();
+    }
+
+    // nothing left in flight: start over at the beginning instead of wrapping later
+    if (used == 0 && !frameOpen) head = 0;
+}
+
+void UploadRing::BeginFrame(uint64_t value)
+{
+    assert(!frameOpen);
+    assert(inFlight.empty() || inFlight.back().value < value);
+
+    frameOpen = true;
+    frameValue = value;
+    frameConsumed = 0;
+    frameStats = {};
+}
+
+void UploadRing::EndFrame()
+{
+    assert(frameOpen);
+
+    frameOpen = false;
+    if (frameConsumed > 0) inFlight.push_back({ frameValue, frameConsumed });
+
+    stats.frames++;
+    stats.lastFrame = frameStats;
+}
+
+UploadAllocation UploadRing::Allocate(size_t size, size_t alignment)
+{
+    assert(frameOpen);
+    assert((alignment & (alignment - 1)) == 0);
+
+    size_t start = (head + alignment - 1) & ~(alignment - 1);
+
+    // does not fit before the end: skip the tail of the buffer and start at 0
+    if (start > capacity || size > capacity - start) start = 0;
+
+    size_t consumed = start >= head ? start + size - head : capacity - head + size;
+    if (used + consumed > capacity)
+    {
+        frameStats.overruns++;
+        stats.overruns++;
+        return { SIZE_MAX, nullptr };
+    }
+
+    head = start + size;
+    used += consumed;
+    frameConsumed += consumed;
+
+    frameStats.bytes += size;
+    frameStats.padding += consumed - size;
+    frameStats.allocations++;
+    stats.peakBytesInFlight = std::max(stats.peakBytesInFlight, used);
+
+    return { start, base ? base + start : nullptr };
+}
@@ -0,0 +1,97 @@
+//
+//  UploadRing.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+// Per-frame linear sub-allocator over one persistent, CPU-visible buffer.
+//
+// Every frame bump-allocates from where the previous frame stopped and wraps around at the end
+// of the buffer. A frame's memory is reused only after the frame is retired, by passing a
+// completion value (a command buffer completion counter or an MTLSharedEvent value) at least as
+// large as the value the frame was tagged with. An allocation that would overwrite memory of a
+// frame still in flight fails instead, and is counted as an overrun.
+//
+// The class only does the bookkeeping; it knows nothing about Metal, so it can be driven with
+// simulated completions.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+struct UploadAllocation
+{
+    size_t offset;      // into the buffer
+    void* data;         // base + offset, null if the ring has no base pointer
+
+    explicit operator bool() const { return offset != SIZE_MAX; }
+};
+
+struct UploadFrameStats
+{
+    size_t bytes;       // requested
+    size_t padding;     // lost to alignment and to wrapping at the end of the buffer
+    uint32_t allocations;
+    uint32_t overruns;  // allocations that failed
+};
+
+struct UploadRingStats
+{
+    uint64_t frames;
+    uint64_t overruns;
+    size_t peakBytesInFlight;
+    UploadFrameStats lastFrame;     // of the last EndFrame
+};
+
+class UploadRing
+{
+    struct Frame
+    {
+        uint64_t value;
+        size_t consumed;    // bytes including padding
+    };
+
+    uint8_t* base;
+    size_t capacity;
+    size_t head;
+    size_t used;            // by frames in flight and the open frame
+
+    std::deque<Frame> inFlight;
+    bool frameOpen;
+    uint64_t frameValue;
+    size_t frameConsumed;
+    UploadFrameStats frameStats;
+
+    UploadRingStats stats;
+
+public:
+    // 'base' is the buffer contents and may be null when only offsets are needed
+    UploadRing(void* base, size_t capacity);
+
+    // Frees the memory of every frame tagged with a value <= completedValue
+    void Retire(uint64_t completedValue);
+
+    // Allocations until EndFrame belong to a frame that is done once 'frameValue' completes.
+    // Values must increase from frame to frame.
+    void BeginFrame(uint64_t frameValue);
+    void EndFrame();
+
+    // 'alignment' must be a power of two; Metal wants 256 for constant buffer offsets on macOS
+    UploadAllocation Allocate(size_t size, size_t alignment = 256);
+
+    template<typename T>
+    T* Allocate(size_t& offset, size_t count = 1)
+    {
+        UploadAllocation allocation = Allocate(sizeof(T) * count, alignof(T) > 256 ? alignof(T) : 256);
+        offset = allocation.offset;
+        return (T*)allocation.data;
+    }
+
+    size_t GetCapacity() const { return capacity; }
+    size_t GetBytesInFlight() const { return used; }
+    size_t GetFramesInFlight() const { return inFlight.size(); }
+    const UploadRingStats& GetStats() const { return stats; }
+};
@@ -0,0 +1,36 @@
+//
+//  Benchmark.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Best wall time of 'repeats' runs of func, in seconds. The best run is the one least disturbed
+// by the rest of the system, which makes figures comparable between runs.
+template<typename Func>
+double MeasureSeconds(size_t repeats, Func&& func)
+{
+    double best = 1e30;
+    for (size_t i = 0; i < repeats; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best) best = elapsed.count();
+    }
+
+    return best;
+}
+
+// Keeps the compiler from dropping a computation whose result is otherwise unused
+template<typename T>
+void KeepResult(const T& value)
+{
+    static volatile const void* sink;
+    sink = &value;
+}
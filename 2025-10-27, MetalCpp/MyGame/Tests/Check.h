@@ -0,0 +1,22 @@
+//
+//  Check.h
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+// Test assertion that stays on in release builds: prints the failed expression and exits non-zero
+#define CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+        { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #expression); \
+            std::exit(1); \
+        } \
+    } while (false)
@@ -0,0 +1,229 @@
+//
+//  FramePacerTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Check.h"
+#include "FramePacer.h"
+
+namespace
+{
+    // A synthetic timeline of the renderer's loop. The CPU may start frame i once frame i - depth
+    // has completed on the GPU, which runs the frames one after another as they are submitted.
+    // Completions reach the pacer the way the completion handler's reports reach the renderer:
+    // by the time the CPU starts a frame, with the GPU time and the latency from CPU start to GPU
+    // end of the completed frame.
+    class Timeline
+    {
+        FramePacer& pacer;
+        std::vector<double> cpuStarts;
+        std::vector<double> gpuTimes;
+        std::vector<double> gpuEnds;
+        size_t reported = 0;
+        double cpuFree = 0;
+        double gpuFree = 0;
+
+    public:
+        std::vector<int> depths;        // the depth each frame ran with
+        std::vector<double> latencies;  // CPU start to GPU end
+        std::vector<double> waits;      // CPU blocked on a free slot
+
+        explicit Timeline(FramePacer& pacer) : pacer(pacer) {}
+
+        void RunFrame(double cpuSeconds, double gpuSeconds)
+        {
+            size_t frame = gpuEnds.size();
+            int depth = pacer.GetDepth();
+
+            double start = cpuFree;
+            if (frame >= (size_t)depth) start = std::max(start, gpuEnds[frame - depth]);
+
+            for (; reported < frame && gpuEnds[reported] <= start; reported++)
+                pacer.RecordGpuFrame(gpuTimes[reported], gpuEnds[reported] - cpuStarts[reported]);
+
+            double wait = start - cpuFree;
+            cpuStarts.push_back(start);
+            cpuFree = start + cpuSeconds;
+
+            gpuFree = std::max(cpuFree, gpuFree) + gpuSeconds;
+            gpuTimes.push_back(gpuSeconds);
+            gpuEnds.push_back(gpuFree);
+
+            depths.push_back(depth);
+            latencies.push_back(gpuFree - start);
+            waits.push_back(wait);
+
+            pacer.RecordCpuFrame(cpuSeconds, wait);
+        }
+
+        void Run(int frames, const std::function<double(int)>& cpu, const std::function<double(int)>& gpu)
+        {
+            for (int i = 0; i < frames; i++)
+                RunFrame(cpu(i), gpu(i));
+        }
+
+        // Frame period and latency over the last 'frames' frames
+        double GetPeriod(size_t frames) const { return (gpuEnds.back() - gpuEnds[gpuEnds.size() - 1 - frames]) / frames; }
+
+        double GetLatency(size_t frames) const
+        {
+            double sum = 0;
+            for (size_t i = latencies.size() - frames; i < latencies.size(); i++)
+                sum += latencies[i];
+
+            return sum / frames;
+        }
+
+        // The depth stayed put over the last 'frames' frames
+        bool IsSettled(size_t frames) const
+        {
+            return std::all_of(depths.end() - frames, depths.end(), [&](int d) { return d == depths.back(); });
+        }
+    };
+
+    std::function<double(int)> Fixed(double seconds)
+    {
+        return [seconds](int) { return seconds; };
+    }
+
+    // The scenarios quoted in the pacer's commit, at a 60 Hz budget and a 50 ms target
+    void TestSettledDepths()
+    {
+        // both fit in the budget together: one frame in flight, nothing queued
+        {
+            FramePacer pacer;
+            Timeline timeline(pacer);
+            timeline.Run(1500, Fixed(0.004), Fixed(0.006));
+            CHECK(pacer.GetDepth() == 1 && timeline.IsSettled(1000));
+            CHECK(timeline.GetLatency(500) < 0.0101);
+        }
+
+        // each fits but not both: overlap them, still at the GPU's pace
+        {
+            FramePacer pacer;
+            Timeline timeline(pacer);
+            timeline.Run(1500, Fixed(0.010), Fixed(0.010));
+            CHECK(pacer.GetDepth() == 2 && timeline.IsSettled(1000));
+            CHECK(timeline.GetPeriod(500) < 0.0101);
+            CHECK(timeline.waits.back() == 0);
+        }
+
+        // a GPU jittering between 12 and 20 ms needs the third frame to absorb its spikes
+        {
+            FramePacer pacer;
+            Timeline timeline(pacer);
+            timeline.Run(1500, Fixed(0.006), [](int i) { return 0.012 + ((i * 2654435761u >> 7) % 100) / 100.0 * 0.008; });
+            CHECK(pacer.GetDepth() == 3 && timeline.IsSettled(1000));
+            CHECK(timeline.GetLatency(500) < 0.050);
+        }
+
+        // a 25 ms GPU cannot make 60 Hz at any depth, and depth 3 would queue about 80 ms: back
+        // to one frame in flight
+        {
+            FramePacer pacer;
+            Timeline timeline(pacer);
+            timeline.Run(1500, Fixed(0.005), Fixed(0.025));
+            CHECK(pacer.GetDepth() == 1 && timeline.IsSettled(1000));
+            CHECK(timeline.GetLatency(500) < 0.0301);
+        }
+    }
+
+    // Lowering waits lowerAfterFrames consecutive frames per step and raising raiseAfterFrames,
+    // and nothing moves during warm-up
+    void TestHysteresis()
+    {
+        FramePacingSettings settings;
+        FramePacer pacer(settings);
+        CHECK(pacer.GetDepth() == settings.maxDepth);
+
+        // light load from the start: the pacer wants 1 as soon as warm-up is over
+        for (int i = 0; i < settings.warmUpFrames; i++)
+        {
+            pacer.RecordCpuFrame(0.002, 0);
+            CHECK(pacer.GetDepth() == 3);
+            pacer.RecordGpuFrame(0.003, 0.005);
+        }
+
+        CHECK(pacer.GetWantedDepth() == 1);
+        for (int i = 1; i < settings.lowerAfterFrames; i++)
+            pacer.RecordCpuFrame(0.002, 0);
+
+        CHECK(pacer.GetDepth() == 3);
+        pacer.RecordCpuFrame(0.002, 0);
+        CHECK(pacer.GetDepth() == 2);
+
+        // one step at a time
+        for (int i = 1; i < settings.lowerAfterFrames; i++)
+            pacer.RecordCpuFrame(0.002, 0);
+
+        CHECK(pacer.GetDepth() == 2);
+        pacer.RecordCpuFrame(0.002, 0);
+        CHECK(pacer.GetDepth() == 1 && pacer.GetStats().depthChanges == 2);
+
+        // a GPU too slow to take turns with the CPU asks for more: raised after raiseAfterFrames
+        // frames of it
+        for (int i = 0; i < 40; i++)
+            pacer.RecordGpuFrame(0.015, 0.020);
+
+        CHECK(pacer.GetWantedDepth() == 2);
+        for (int i = 1; i < settings.raiseAfterFrames; i++)
+            pacer.RecordCpuFrame(0.002, 0);
+
+        CHECK(pacer.GetDepth() == 1);
+        pacer.RecordCpuFrame(0.002, 0);
+        CHECK(pacer.GetDepth() == 2);
+    }
+
+    // One slow GPU frame in a light run widens the deviation enough for a quick raise, but only by
+    // one step, and the pacer settles back once it has decayed
+    void TestSingleSpike()
+    {
+        FramePacer pacer;
+        Timeline timeline(pacer);
+        timeline.Run(600, Fixed(0.004), Fixed(0.006));
+        CHECK(pacer.GetDepth() == 1);
+
+        uint64_t changes = pacer.GetStats().depthChanges;
+        timeline.Run(600, Fixed(0.004), [](int i) { return i == 0 ? 0.040 : 0.006; });
+        CHECK(*std::max_element(timeline.depths.begin() + 600, timeline.depths.end()) <= 2);
+        CHECK(pacer.GetDepth() == 1 && timeline.IsSettled(300));
+        CHECK(pacer.GetStats().depthChanges <= changes + 2);
+    }
+
+    // The depth stays within the configured range and the latency target caps raising
+    void TestLimits()
+    {
+        FramePacingSettings settings;
+        settings.minDepth = 2;
+        settings.maxDepth = 2;
+        FramePacer fixed(settings);
+        Timeline light(fixed);
+        light.Run(300, Fixed(0.004), Fixed(0.006));
+        CHECK(fixed.GetDepth() == 2 && fixed.GetStats().depthChanges == 0);
+
+        // jittery GPU that would want 3, with too little latency headroom for a third frame
+        settings = {};
+        settings.targetLatency = 0.030;
+        FramePacer capped(settings);
+        Timeline jittery(capped);
+        jittery.Run(1500, Fixed(0.006), [](int i) { return 0.012 + ((i * 2654435761u >> 7) % 100) / 100.0 * 0.008; });
+        CHECK(capped.GetDepth() < 3 && jittery.IsSettled(500));
+        CHECK(jittery.GetLatency(500) < settings.targetLatency);
+    }
+}
+
+int main()
+{
+    TestSettledDepths();
+    TestHysteresis();
+    TestSingleSpike();
+    TestLimits();
+    return 0;
+}
@@ -0,0 +1,106 @@
+//
+//  FrustumCullingBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Check.h"
+#include "FrustumCulling.h"
+
+namespace
+{
+    using CullFunction = size_t (*)(const ObjectBounds&, const Float4[6], uint32_t*);
+
+    struct Result
+    {
+        double objectsPerMicrosecond;
+        double culledShare;
+    };
+
+    Result Measure(const ObjectBounds& bounds, const std::vector<Float4>& planes, CullFunction cull, std::vector<uint32_t>& visible)
+    {
+        size_t views = planes.size() / 6;
+        size_t drawn = 0;
+        double seconds = MeasureSeconds(5, [&]()
+        {
+            drawn = 0;
+            for (size_t v = 0; v < views; v++)
+                drawn += cull(bounds, &planes[v * 6], visible.data());
+        });
+
+        double tested = (double)bounds.GetCount() * views;
+        return { tested / seconds * 1e-6, 1 - drawn / tested };
+    }
+}
+
+// Objects tested per microsecond for 50k boxes scattered over a 400 x 40 x 400 field, every third
+// one rotated, seen by 200 cameras from 5 units above the ground. Build it as
+// FrustumCullingBenchmarkAvx too to compare the SSE and AVX paths; -O3 may vectorize the scalar
+// loops as well.
+int main()
+{
+    const size_t objectCount = 50000;
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> uniform(-1, 1);
+    ObjectBounds bounds;
+    for (size_t i = 0; i < objectCount; i++)
+    {
+        Float3 center = { uniform(random) * 200, uniform(random) * 20, uniform(random) * 200 };
+        Float3 extent = { std::fabs(uniform(random)) * 2 + 0.1f, std::fabs(uniform(random)) * 2 + 0.1f, std::fabs(uniform(random)) * 2 + 0.1f };
+        size_t index = bounds.Add(center - extent, center + extent);
+        if (i % 3 == 0)
+        {
+            Float4x4 transform = Float4x4::Translation(center.x, center.y, center.z) * Float4x4::Rotation(uniform(random) * 3, { uniform(random), uniform(random), 1 }) * Float4x4::Scale(1, 2, 0.5f);
+            bounds.SetTransformed(index, extent * -1.0f, extent, transform);
+        }
+    }
+
+    Float4x4 projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.5f, 0.1f, 300.0f);
+    std::vector<Float4> planes(200 * 6);
+    for (size_t v = 0; v < 200; v++)
+    {
+        Float3 eye = { uniform(random) * 150, 5, uniform(random) * 150 };
+        Float3 target = { uniform(random) * 150, 0, uniform(random) * 150 };
+        ExtractFrustumPlanes(projection * Float4x4::LookAtRightHand(eye, target, { 0, 1, 0 }), &planes[v * 6]);
+    }
+
+    // the lists have to match before the times mean anything
+    std::vector<uint32_t> scalar(objectCount), simd(objectCount);
+    for (size_t v = 0; v < 200; v++)
+    {
+        size_t count = CullSpheresScalar(bounds, &planes[v * 6], scalar.data());
+        CHECK(CullSpheres(bounds, &planes[v * 6], simd.data()) == count && std::equal(scalar.begin(), scalar.begin() + count, simd.begin()));
+        count = CullBoxesScalar(bounds, &planes[v * 6], scalar.data());
+        CHECK(CullBoxes(bounds, &planes[v * 6], simd.data()) == count && std::equal(scalar.begin(), scalar.begin() + count, simd.begin()));
+    }
+
+#if defined(SIMDMATH_AVX)
+    const char* simdName = "AVX";
+#elif defined(SIMDMATH_SSE)
+    const char* simdName = "SSE";
+#elif defined(SIMDMATH_NEON)
+    const char* simdName = "NEON";
+#else
+    const char* simdName = "none";
+#endif
+
+    Result spheresScalar = Measure(bounds, planes, CullSpheresScalar, scalar);
+    Result spheres = Measure(bounds, planes, CullSpheres, simd);
+    Result boxesScalar = Measure(bounds, planes, CullBoxesScalar, scalar);
+    Result boxes = Measure(bounds, planes, CullBoxes, simd);
+
+    std::printf("%zu objects, %.0f%% culled by spheres, %.0f%% by boxes\n", objectCount, spheres.culledShare * 100, boxes.culledShare * 100);
+    std::printf("objects/us   spheres   boxes\n");
+    std::printf("scalar       %7.0f %7.0f\n", spheresScalar.objectsPerMicrosecond, boxesScalar.objectsPerMicrosecond);
+    std::printf("%-10s   %7.0f %7.0f\n", simdName, spheres.objectsPerMicrosecond, boxes.objectsPerMicrosecond);
+    return 0;
+}
@@ -0,0 +1,165 @@
+//
+//  FrustumCullingTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "FrustumCulling.h"
+
+namespace
+{
+    const Float4x4 Projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.5f, 0.1f, 300.0f);
+
+    // Scattered boxes, every third one rotated and scaled through SetTransformed
+    ObjectBounds MakeScene(size_t count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        ObjectBounds bounds;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Float3 center = { uniform(random) * 200, uniform(random) * 20, uniform(random) * 200 };
+            Float3 extent = { std::fabs(uniform(random)) * 2 + 0.1f, std::fabs(uniform(random)) * 2 + 0.1f, std::fabs(uniform(random)) * 2 + 0.1f };
+            size_t index = bounds.Add(center - extent, center + extent);
+            CHECK(index == i);
+
+            if (i % 3 == 0)
+            {
+                Float4x4 transform = Float4x4::Translation(center.x, center.y, center.z) * Float4x4::Rotation(uniform(random) * 3, { uniform(random), uniform(random), 1 }) * Float4x4::Scale(1, 2, 0.5f);
+                bounds.SetTransformed(index, extent * -1.0f, extent, transform);
+            }
+        }
+
+        return bounds;
+    }
+
+    bool InsideClipSpace(const Float4x4& transform, Float3 p)
+    {
+        Float4 clip = transform * Float4 { p.x, p.y, p.z, 1 };
+        return clip.w > 0 && std::fabs(clip.x) < clip.w * 0.999f && std::fabs(clip.y) < clip.w * 0.999f && clip.z > 0 && clip.z < clip.w * 0.999f;
+    }
+
+    // The SIMD paths give exactly the scalar lists, for counts that leave every possible tail, and
+    // no object with its sphere center or a corner or the center of its box in view is culled
+    void TestSimdMatchesScalar()
+    {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+
+        for (size_t count : { 0, 1, 3, 7, 8, 9, 17, 1000, 20003 })
+        {
+            ObjectBounds bounds = MakeScene(count, (unsigned)count);
+            std::vector<uint32_t> scalar(count + 1), simd(count + 1);
+
+            for (int view = 0; view < 50; view++)
+            {
+                Float3 eye = { uniform(random) * 150, 5, uniform(random) * 150 };
+                Float3 target = { uniform(random) * 150, 0, uniform(random) * 150 };
+                Float4x4 transform = Projection * Float4x4::LookAtRightHand(eye, target, { 0, 1, 0 });
+                Float4 planes[6];
+                ExtractFrustumPlanes(transform, planes);
+
+                size_t spheres = CullSpheresScalar(bounds, planes, scalar.data());
+                CHECK(CullSpheres(bounds, planes, simd.data()) == spheres);
+                CHECK(std::equal(scalar.begin(), scalar.begin() + spheres, simd.begin()));
+
+                std::vector<bool> sphereVisible(count);
+                for (size_t i = 0; i < spheres; i++)
+                    sphereVisible[scalar[i]] = true;
+
+                size_t boxes = CullBoxesScalar(bounds, planes, scalar.data());
+                CHECK(CullBoxes(bounds, planes, simd.data()) == boxes);
+                CHECK(std::equal(scalar.begin(), scalar.begin() + boxes, simd.begin()));
+
+                std::vector<bool> boxVisible(count);
+                for (size_t i = 0; i < boxes; i++)
+                {
+                    CHECK(i == 0 || scalar[i] > scalar[i - 1]);
+                    boxVisible[scalar[i]] = true;
+                }
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    Float3 center = { bounds.boxX[i], bounds.boxY[i], bounds.boxZ[i] };
+                    Float3 extent = { bounds.extentX[i], bounds.extentY[i], bounds.extentZ[i] };
+                    for (int corner = 0; corner < 9; corner++)
+                    {
+                        Float3 p = corner == 8 ? center : Float3 { center.x + (corner & 1 ? extent.x : -extent.x), center.y + (corner & 2 ? extent.y : -extent.y), center.z + (corner & 4 ? extent.z : -extent.z) };
+                        if (InsideClipSpace(transform, p)) CHECK(boxVisible[i]);
+                    }
+
+                    if (InsideClipSpace(transform, { bounds.sphereX[i], bounds.sphereY[i], bounds.sphereZ[i] })) CHECK(sphereVisible[i]);
+                }
+            }
+        }
+    }
+
+    // Both volumes of a transformed box hold its transformed corners
+    void TestTransformedBounds()
+    {
+        std::mt19937 random(3);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        ObjectBounds bounds;
+        bounds.Add({ 0, 0, 0 }, { 1, 1, 1 });
+
+        for (int i = 0; i < 1000; i++)
+        {
+            Float3 localMin = { uniform(random) - 1, uniform(random) - 1, uniform(random) - 1 };
+            Float3 localMax = { uniform(random) + 1, uniform(random) + 1, uniform(random) + 1 };
+            Float4x4 transform = Float4x4::Translation(uniform(random) * 50, uniform(random) * 50, uniform(random) * 50) * Float4x4::Rotation(uniform(random) * 3, { uniform(random), uniform(random), 1 })
+                * Float4x4::Scale(1 + std::fabs(uniform(random)) * 3, 1 + std::fabs(uniform(random)), 0.2f);
+            bounds.SetTransformed(0, localMin, localMax, transform);
+
+            Float3 sphere = { bounds.sphereX[0], bounds.sphereY[0], bounds.sphereZ[0] };
+            Float3 box = { bounds.boxX[0], bounds.boxY[0], bounds.boxZ[0] };
+            for (int corner = 0; corner < 8; corner++)
+            {
+                Float4 local = { corner & 1 ? localMax.x : localMin.x, corner & 2 ? localMax.y : localMin.y, corner & 4 ? localMax.z : localMin.z, 1 };
+                Float3 p = (transform * local).Xyz();
+                CHECK(Length(p - sphere) <= bounds.radius[0] * 1.0001f);
+                CHECK(std::fabs(p.x - box.x) <= bounds.extentX[0] * 1.0001f);
+                CHECK(std::fabs(p.y - box.y) <= bounds.extentY[0] * 1.0001f);
+                CHECK(std::fabs(p.z - box.z) <= bounds.extentZ[0] * 1.0001f);
+            }
+        }
+    }
+
+    // A camera at the origin looking down -z: objects straddling a plane stay, ones just outside
+    // it go, and a pole standing just outside the right plane reaches in with its sphere only
+    void TestPlanes()
+    {
+        Float4 planes[6];
+        ExtractFrustumPlanes(Float4x4::PerspectiveRightHand(90.0f * (3.14159265f / 180.0f), 1.0f, 1.0f, 100.0f), planes);
+
+        ObjectBounds bounds;
+        bounds.Add({ -1, -1, -11 }, { 1, 1, -9 });              // in front
+        bounds.Add({ -1, -1, 1 }, { 1, 1, 3 });                 // behind
+        bounds.Add({ -1, -1, -101 }, { 1, 1, -99 });            // across the far plane
+        bounds.Add({ -1, -1, -104 }, { 1, 1, -102 });           // past it
+        bounds.Add({ 9.5f, -1, -11 }, { 11.5f, 1, -9 });        // across the right plane
+        bounds.Add({ 11, -5, -10.5f }, { 12, 5, -9.5f });       // the pole
+
+        std::vector<uint32_t> visible(bounds.GetCount());
+        CHECK(CullBoxes(bounds, planes, visible.data()) == 3);
+        CHECK(visible[0] == 0 && visible[1] == 2 && visible[2] == 4);
+
+        CHECK(CullSpheres(bounds, planes, visible.data()) == 4);
+        CHECK(visible[3] == 5);
+    }
+}
+
+int main()
+{
+    TestSimdMatchesScalar();
+    TestTransformedBounds();
+    TestPlanes();
+    return 0;
+}
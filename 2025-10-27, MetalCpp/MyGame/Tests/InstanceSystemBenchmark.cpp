@@ -0,0 +1,103 @@
+//
+//  InstanceSystemBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "InstanceSystem.h"
+
+namespace
+{
+    const size_t InstanceCount = 100000;
+    const int Frames = 100;
+
+    struct FrameTimes
+    {
+        double spin;
+        double update;
+        double cull;
+        double write;
+        double visible;
+    };
+
+    // The renderer's frame for 100k spinning boxes over a 1000 x 40 x 1000 field, with the camera
+    // turning in place 10 units above it: Update, CullBoxes, WriteMatrices of the visible ones.
+    // 'serialSpin' sets every rotation on the calling thread first, as the renderer used to.
+    FrameTimes Measure(ThreadPool* pool, bool serialSpin)
+    {
+        std::mt19937 random(5);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        InstanceSystem instances({ -2, -2, -2 }, { 2, 2, 2 });
+        for (size_t i = 0; i < InstanceCount; i++)
+        {
+            Float3 position = { uniform(random) * 500, uniform(random) * 20, uniform(random) * 500 };
+            size_t index = instances.Add(position, Quat::Identity(), { 1 + uniform(random) * 0.5f, 1, 1 });
+            if (!serialSpin) instances.SetSpin(index, { 1, 1, 0 }, 0.01f, 0.05f * (position.x + position.y));
+        }
+
+        Float4x4 projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.5f, 0.1f, 1000.0f);
+        std::vector<uint32_t> visible(InstanceCount);
+        std::vector<InstanceMatrices> out(InstanceCount);
+        FrameTimes total = {};
+
+        for (int frame = 0; frame < Frames; frame++)
+        {
+            Float4x4 view = Float4x4::LookAtRightHand({ 0, 10, 0 }, { std::sin(frame * 0.06f) * 100, 0, std::cos(frame * 0.06f) * 100 }, { 0, 1, 0 });
+
+            if (serialSpin)
+            {
+                total.spin += MeasureSeconds(1, [&]()
+                {
+                    for (size_t i = 0; i < InstanceCount; i++)
+                        instances.SetRotation(i, Quat::FromAxisAngle({ 1, 1, 0 }, frame * 0.01f + 0.05f * (instances.positionX[i] + instances.positionY[i])));
+                });
+            }
+
+            total.update += MeasureSeconds(1, [&]() { instances.Update(pool, 1); });
+
+            size_t count = 0;
+            total.cull += MeasureSeconds(1, [&]()
+            {
+                Float4 planes[6];
+                ExtractFrustumPlanes(projection * view, planes);
+                count = CullBoxes(instances.GetBounds(), planes, visible.data());
+            });
+
+            total.write += MeasureSeconds(1, [&]() { instances.WriteMatrices(view, visible.data(), count, out.data(), pool); });
+            total.visible += count;
+        }
+
+        KeepResult(out);
+        return { total.spin / Frames, total.update / Frames, total.cull / Frames, total.write / Frames, total.visible / Frames };
+    }
+
+    void Print(const char* name, const FrameTimes& times)
+    {
+        double total = times.spin + times.update + times.cull + times.write;
+        std::printf("%-26s %7.0f  %6.2f  %6.2f  %6.2f  %6.2f  %6.2f\n", name, times.visible, times.spin * 1e3, times.update * 1e3, times.cull * 1e3, times.write * 1e3, total * 1e3);
+    }
+}
+
+// CPU time per frame of the instance passes, in milliseconds, with the spin advanced inside the
+// pooled Update and, for comparison, set serially beforehand (the spin column); on the calling
+// thread alone and with a pool of 3 threads
+int main()
+{
+    std::printf("%zu instances, %d frames\n", InstanceCount, Frames);
+    std::printf("                           visible    spin  update    cull   write   total\n");
+    Print("spin in Update", Measure(nullptr, false));
+    Print("serial SetRotation", Measure(nullptr, true));
+
+    ThreadPool pool(3);
+    Print("spin in Update, 3 threads", Measure(&pool, false));
+    Print("serial, 3 threads", Measure(&pool, true));
+    return 0;
+}
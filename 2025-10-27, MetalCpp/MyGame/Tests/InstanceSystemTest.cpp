@@ -0,0 +1,144 @@
+//
+//  InstanceSystemTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "InstanceSystem.h"
+
+namespace
+{
+    bool Near(const Float4x4& a, const Float4x4& b, float tolerance)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            const float* x = &a.columns[c].x;
+            const float* y = &b.columns[c].x;
+            for (int r = 0; r < 4; r++)
+            {
+                if (std::fabs(x[r] - y[r]) > tolerance * (1 + std::fabs(y[r]))) return false;
+            }
+        }
+
+        return true;
+    }
+
+    InstanceSystem MakeInstances(size_t count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        InstanceSystem instances({ -2, -2, -2 }, { 2, 2, 2 });
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t index = instances.Add({ uniform(random) * 500, uniform(random) * 20, uniform(random) * 500 }, Quat::FromAxisAngle({ uniform(random), uniform(random), 1 }, uniform(random) * 3), { 1 + uniform(random) * 0.5f, 1, 1 });
+            CHECK(index == i);
+            if (i % 4 != 0)
+                instances.SetSpin(index, { uniform(random), 1, uniform(random) }, uniform(random) * 0.1f, uniform(random) * 10);
+        }
+
+        return instances;
+    }
+
+    // A spinning instance's matrix is its rest rotation turned by the angle so far, across the
+    // wrap at a full turn; one without spin keeps its rotation
+    void TestSpin()
+    {
+        InstanceSystem instances({ -1, -1, -1 }, { 1, 1, 1 });
+        Quat rest = Quat::FromAxisAngle({ 0, 0, 1 }, 0.4f);
+        instances.Add({ 3, 4, 5 }, rest, { 2, 1, 1 });
+        instances.Add({ -3, 0, 0 }, rest);
+        instances.SetSpin(0, { 1, 1, 0 }, 0.05f, 0.3f);
+
+        for (int frame = 1; frame <= 400; frame++)
+        {
+            instances.Update(nullptr, 0.5f);
+            Float4x4 expected = MakeTransform({ 3, 4, 5 }, Quat::FromAxisAngle({ 1, 1, 0 }, 0.3f + frame * 0.025f) * rest, { 2, 1, 1 });
+            CHECK(Near(instances.GetModelMatrices()[0], expected, 1e-4f));
+            CHECK(std::fabs(instances.spinAngle[0]) <= 6.2832f);
+        }
+
+        CHECK(Near(instances.GetModelMatrices()[1], MakeTransform({ -3, 0, 0 }, rest, { 1, 1, 1 }), 1e-6f));
+
+        // bounds follow: the box around the spun, scaled cube holds its corners
+        const ObjectBounds& bounds = instances.GetBounds();
+        CHECK(bounds.GetCount() == 2);
+        for (int corner = 0; corner < 8; corner++)
+        {
+            Float4 local = { corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f, 1 };
+            Float3 p = (instances.GetModelMatrices()[0] * local).Xyz();
+            CHECK(std::fabs(p.x - bounds.boxX[0]) <= bounds.extentX[0] * 1.0001f);
+            CHECK(std::fabs(p.y - bounds.boxY[0]) <= bounds.extentY[0] * 1.0001f);
+            CHECK(std::fabs(p.z - bounds.boxZ[0]) <= bounds.extentZ[0] * 1.0001f);
+        }
+    }
+
+    // Chunks touch disjoint instances, so the pool changes nothing about the result
+    void TestSameResultForAnyPool()
+    {
+        InstanceSystem reference = MakeInstances(10007, 5);
+        InstanceSystem pooled = MakeInstances(10007, 5);
+        ThreadPool pool(3);
+
+        for (int frame = 0; frame < 5; frame++)
+        {
+            reference.Update(nullptr, 1);
+            pooled.Update(&pool, 1);
+        }
+
+        CHECK(std::memcmp(reference.GetModelMatrices().data(), pooled.GetModelMatrices().data(), reference.GetCount() * sizeof(Float4x4)) == 0);
+        CHECK(reference.spinAngle == pooled.spinAngle);
+        CHECK(reference.GetBounds().boxX == pooled.GetBounds().boxX);
+        CHECK(reference.GetBounds().radius == pooled.GetBounds().radius);
+    }
+
+    void TestWriteMatrices()
+    {
+        InstanceSystem instances = MakeInstances(3000, 9);
+        ThreadPool pool(2);
+        instances.Update(&pool, 1);
+
+        Float4x4 view = Float4x4::LookAtRightHand({ 0, 10, 0 }, { 30, 0, 100 }, { 0, 1, 0 });
+        std::vector<uint32_t> selected;
+        for (uint32_t i = 0; i < instances.GetCount(); i += 3)
+            selected.push_back(i);
+
+        std::vector<InstanceMatrices> out(selected.size());
+        instances.WriteMatrices(view, selected.data(), selected.size(), out.data(), &pool);
+
+        for (size_t k = 0; k < selected.size(); k++)
+        {
+            const Float4x4& model = instances.GetModelMatrices()[selected[k]];
+            CHECK(std::memcmp(&out[k].modelMatrix, &model, sizeof(Float4x4)) == 0);
+            CHECK(Near(out[k].modelViewMatrix, MultiplyScalar(view, model), 1e-5f));
+        }
+    }
+
+    void TestClear()
+    {
+        InstanceSystem instances = MakeInstances(10, 1);
+        instances.Clear();
+        CHECK(instances.GetCount() == 0 && instances.GetBounds().GetCount() == 0 && instances.spinRate.empty());
+
+        instances.Add({ 1, 2, 3 }, Quat::Identity());
+        instances.Update(nullptr, 1);
+        CHECK(instances.spinRate[0] == 0 && instances.spinAngle[0] == 0);
+        CHECK(Near(instances.GetModelMatrices()[0], Float4x4::Translation(1, 2, 3), 1e-6f));
+    }
+}
+
+int main()
+{
+    TestSpin();
+    TestSameResultForAnyPool();
+    TestWriteMatrices();
+    TestClear();
+    return 0;
+}
@@ -0,0 +1,44 @@
+//
+//  MeshGeneratorBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MeshGenerator.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+    template<typename Generate>
+    void Measure(const char* name, Generate&& generate)
+    {
+        MeshData mesh;
+        double seconds = MeasureSeconds(5, [&]() { mesh = generate(); });
+
+        std::vector<uint32_t> indices = mesh.Uses32BitIndices() ? mesh.indices32 : std::vector<uint32_t>(mesh.indices16.begin(), mesh.indices16.end());
+        double acmr = AnalyzeVertexCache(indices.data(), indices.size(), mesh.GetVertexCount()).acmr;
+
+        size_t triangles = mesh.GetIndexCount() / 3;
+        std::printf("%-22s %9zu  %8.2f ms  %7.1f  %5.3f\n", name, triangles, seconds * 1e3, triangles / seconds * 1e-6, acmr);
+    }
+}
+
+// Time to generate each shape, from a small sphere up to a couple of million triangles, and the
+// FIFO-16 ACMR of the order it comes out in
+int main()
+{
+    std::printf("mesh                   triangles        time   Mtri/s  ACMR\n");
+    Measure("uv sphere 100x100", []() { return GenerateUvSphere(1, 100, 100); });
+    Measure("uv sphere 1000x1000", []() { return GenerateUvSphere(1, 1000, 1000); });
+    Measure("icosphere 20", []() { return GenerateIcoSphere(1, 20); });
+    Measure("icosphere 256", []() { return GenerateIcoSphere(1, 256); });
+    Measure("plane 1000x1000", []() { return GeneratePlane(1, 1, 1000, 1000); });
+    Measure("cylinder 1000x1000", []() { return GenerateCylinder(1, 1, 1000, 1000); });
+    Measure("box 300^3", []() { return GenerateBox({ 1, 1, 1 }, 300, 300, 300); });
+    return 0;
+}
@@ -0,0 +1,135 @@
+//
+//  MeshGeneratorTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "Check.h"
+#include "MeshGenerator.h"
+#include "MeshOptimizer.h"
+
+namespace
+{
+    std::vector<uint32_t> GetIndices(const MeshData& mesh)
+    {
+        if (mesh.Uses32BitIndices()) return mesh.indices32;
+        return std::vector<uint32_t>(mesh.indices16.begin(), mesh.indices16.end());
+    }
+
+    // Every vertex used, and every triangle in range, not degenerate and counter-clockwise seen
+    // from outside: its normal points away from the center, or along 'up' for a flat mesh. When
+    // 'closed', edges are matched by position, so that the seam and pole duplicates only pass if
+    // they are bit-identical: each directed edge has to appear once and its reverse once, or the
+    // surface has a crack.
+    void CheckSurface(const MeshData& mesh, bool closed, Float3 up = { 0, 0, 0 })
+    {
+        using Point = std::tuple<float, float, float>;
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        std::map<std::pair<Point, Point>, int> edges;
+        std::vector<bool> referenced(mesh.GetVertexCount());
+
+        CHECK(mesh.texcoords.size() == mesh.GetVertexCount());
+        CHECK(indices.size() > 0 && indices.size() % 3 == 0);
+        CHECK(mesh.Uses32BitIndices() == (mesh.GetVertexCount() > 65535));
+
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            Float3 p[3];
+            for (int k = 0; k < 3; k++)
+            {
+                CHECK(indices[i + k] < mesh.GetVertexCount());
+                p[k] = mesh.positions[indices[i + k]];
+                referenced[indices[i + k]] = true;
+            }
+
+            Float3 normal = Cross(p[1] - p[0], p[2] - p[0]);
+            CHECK(Length(normal) > 1e-9f);
+
+            bool flat = up.x != 0 || up.y != 0 || up.z != 0;
+            CHECK(Dot(normal, flat ? up : p[0] + p[1] + p[2]) > 0);
+
+            for (int k = 0; k < 3; k++)
+            {
+                Float3 a = p[k];
+                Float3 b = p[(k + 1) % 3];
+                edges[{ { a.x, a.y, a.z }, { b.x, b.y, b.z } }]++;
+            }
+        }
+
+        for (bool used : referenced)
+            CHECK(used);
+
+        if (!closed) return;
+
+        for (const auto& [edge, count] : edges)
+        {
+            auto reverse = edges.find({ edge.second, edge.first });
+            CHECK(count == 1 && reverse != edges.end() && reverse->second == 1);
+        }
+    }
+
+    double GetAcmr(const MeshData& mesh)
+    {
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        return AnalyzeVertexCache(indices.data(), indices.size(), mesh.GetVertexCount()).acmr;
+    }
+
+    void TestShapes()
+    {
+        CheckSurface(GenerateBox({ 4, 4, 4 }, 2, 2, 2), true);
+        CheckSurface(GenerateBox({ 1, 2, 3 }, 3, 5, 7), true);
+        CheckSurface(GenerateUvSphere(1, 32, 16), true);
+        CheckSurface(GenerateUvSphere(2, 3, 2), true);
+        CheckSurface(GenerateIcoSphere(1, 1), true);
+        CheckSurface(GenerateIcoSphere(1, 9), true);
+        CheckSurface(GenerateIcoSphere(1, 20), true);
+        CheckSurface(GenerateCylinder(1, 2, 24, 3, true), true);
+        CheckSurface(GenerateCylinder(1, 2, 24, 3, false), false);
+        CheckSurface(GeneratePlane(2, 3, 10, 4), false, { 0, 1, 0 });
+
+        MeshData box = GenerateBox({ 4, 4, 4 }, 2, 2, 2);
+        CHECK(box.GetVertexCount() == 54 && box.GetIndexCount() == 48 * 3);
+        CHECK(GenerateUvSphere(1, 32, 16).GetVertexCount() == 33 * 15 + 2 * 32);
+        CHECK(GenerateIcoSphere(1, 20).GetIndexCount() == 20 * 20 * 20 * 3);
+        CHECK(GeneratePlane(1, 1, 10, 4).GetIndexCount() == 10 * 4 * 6);
+
+        // nothing for the optimizer to drop
+        for (MeshData mesh : { GenerateUvSphere(1, 64, 32), GenerateIcoSphere(1, 9) })
+            CHECK(OptimizeMesh(mesh).verticesRemoved == 0);
+    }
+
+    // Past 65535 vertices the indices switch to 32 bits, and the seams stay closed
+    void TestLargeMeshes()
+    {
+        MeshData sphere = GenerateUvSphere(1, 400, 400);
+        CHECK(sphere.Uses32BitIndices() && sphere.GetIndexSize() == 4);
+        CheckSurface(sphere, true);
+
+        MeshData plane = GeneratePlane(1, 1, 254, 254);
+        CHECK(!plane.Uses32BitIndices() && plane.GetVertexCount() == 255 * 255);
+        CheckSurface(plane, false, { 0, 1, 0 });
+    }
+
+    // The stripes keep a grid near the 0.5 vertices per triangle a FIFO of 16 allows; emitted
+    // row by row it would be 1.0, every vertex loaded twice
+    void TestCacheFriendlyOrder()
+    {
+        CHECK(GetAcmr(GenerateUvSphere(1, 100, 100)) < 0.61);
+        CHECK(GetAcmr(GenerateUvSphere(1, 400, 400)) < 0.60);
+        CHECK(GetAcmr(GenerateIcoSphere(1, 20)) < 0.66);
+        CHECK(GetAcmr(GenerateCylinder(1, 1, 200, 200, false)) < 0.61);
+    }
+}
+
+int main()
+{
+    TestShapes();
+    TestLargeMeshes();
+    TestCacheFriendlyOrder();
+    return 0;
+}
@@ -0,0 +1,264 @@
+//
+//  MeshOptimizerTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "MeshOptimizer.h"
+#include "SoftwareRasterizer.h"
+
+namespace
+{
+    std::vector<uint32_t> GetIndices(const MeshData& mesh)
+    {
+        if (mesh.Uses32BitIndices()) return mesh.indices32;
+        return std::vector<uint32_t>(mesh.indices16.begin(), mesh.indices16.end());
+    }
+
+    // Same triangles in a random order, as an exporter that knows nothing of caches might write them
+    void ShuffleTriangles(MeshData& mesh, unsigned seed)
+    {
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        std::vector<size_t> order(indices.size() / 3);
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+
+        std::mt19937 random(seed);
+        std::shuffle(order.begin(), order.end(), random);
+
+        std::vector<uint32_t> shuffled;
+        for (size_t t : order)
+            shuffled.insert(shuffled.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+
+        if (mesh.Uses32BitIndices())
+            mesh.indices32 = shuffled;
+        else
+            mesh.indices16.assign(shuffled.begin(), shuffled.end());
+    }
+
+    // Each triangle by the attributes of its corners, started at the smallest corner so that only
+    // the winding matters and not where the triangle starts; sorted, since the order changes
+    using Corner = std::array<float, 5>;
+    using Triangle = std::array<Corner, 3>;
+
+    std::vector<Triangle> GetTriangles(const MeshData& mesh)
+    {
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        std::vector<Triangle> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            Triangle triangle;
+            for (int k = 0; k < 3; k++)
+            {
+                Float3 p = mesh.positions[indices[i + k]];
+                Float2 t = mesh.texcoords[indices[i + k]];
+                triangle[k] = { p.x, p.y, p.z, t.x, t.y };
+            }
+
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // A FIFO of 16 transforms a vertex again once 16 others have been loaded after it
+    void TestAnalyzeVertexCache()
+    {
+        uint32_t strip[] = { 0, 1, 2, 2, 1, 3, 2, 3, 4, 4, 3, 5 };
+        VertexCacheStats stats = AnalyzeVertexCache(strip, 12, 6);
+        CHECK(stats.verticesTransformed == 6);
+        CHECK(stats.acmr == 1.5 && stats.atvr == 1.0);
+
+        std::vector<uint32_t> indices;
+        for (uint32_t v = 0; v < 18; v++)
+            indices.insert(indices.end(), { v, v, v });
+        indices.insert(indices.end(), { 2, 1, 17 });
+        stats = AnalyzeVertexCache(indices.data(), indices.size(), 18);
+        CHECK(stats.verticesTransformed == 18 + 1);
+        stats = AnalyzeVertexCache(indices.data(), indices.size(), 18, 32);
+        CHECK(stats.verticesTransformed == 18);
+    }
+
+    // Shuffled meshes come back with the same triangles and well under one vertex per triangle,
+    // each vertex transformed not much more than once
+    void TestShuffledMeshes()
+    {
+        MeshData meshes[] = { GenerateUvSphere(1, 100, 100), GeneratePlane(1, 1, 200, 200), GenerateIcoSphere(1, 20), GenerateCylinder(1, 2, 64, 64) };
+        for (MeshData& mesh : meshes)
+        {
+            ShuffleTriangles(mesh, 3);
+            std::vector<Triangle> before = GetTriangles(mesh);
+
+            MeshOptimizationReport report = OptimizeMesh(mesh);
+            CHECK(report.before.acmr > 2.5);
+            CHECK(report.after.acmr < 0.8);
+            CHECK(report.after.atvr < 1.6);
+            CHECK(GetTriangles(mesh) == before);
+        }
+    }
+
+    // The generators' stripes already fit the FIFO better than Forsyth's LRU-tuned order, so
+    // OptimizeMesh keeps them and the overdraw clusters cost at most the threshold
+    void TestKeepsBetterInputOrder()
+    {
+        for (MeshData sphere : { GenerateUvSphere(1, 100, 100), GenerateUvSphere(1, 64, 32), GenerateCylinder(1, 2, 64, 64) })
+        {
+            MeshOptimizationReport report = OptimizeMesh(sphere);
+            CHECK(report.before.acmr < 0.62);
+            CHECK(report.after.acmr <= report.before.acmr * 1.05);
+        }
+    }
+
+    // Clusters moved away from the vertices they shared with the cluster before them load those
+    // again; the pass measures what it did and never gives up more than 'threshold'
+    void TestOverdrawKeepsCacheEfficiency()
+    {
+        MeshData meshes[] = { GenerateBox({ 1, 1, 1 }, 7, 3, 5), GenerateUvSphere(1, 64, 32), GenerateIcoSphere(1, 9), GenerateCylinder(1, 2, 64, 64) };
+        for (const MeshData& mesh : meshes)
+        {
+            std::vector<uint32_t> indices = GetIndices(mesh);
+            OptimizeVertexCache(indices.data(), indices.data(), indices.size(), mesh.GetVertexCount());
+            double before = AnalyzeVertexCache(indices.data(), indices.size(), mesh.GetVertexCount()).acmr;
+
+            for (float threshold : { 1.0f, 1.05f, 1.5f })
+            {
+                std::vector<uint32_t> clustered(indices.size());
+                OptimizeOverdraw(clustered.data(), indices.data(), indices.size(), mesh.positions.data(), mesh.GetVertexCount(), threshold);
+                CHECK(AnalyzeVertexCache(clustered.data(), clustered.size(), mesh.GetVertexCount()).acmr <= before * threshold);
+            }
+        }
+    }
+
+    // An icosphere with bumps that hide each other from most directions; convex meshes have no
+    // overdraw to save once back faces are culled
+    MeshData GenerateBumpySphere(int frequency)
+    {
+        MeshData mesh = GenerateIcoSphere(1, frequency);
+        for (Float3& p : mesh.positions)
+        {
+            float theta = std::acos(std::clamp(p.y, -1.0f, 1.0f));
+            float phi = std::atan2(p.x, p.z);
+            p = p * (1 + 0.3f * std::sin(5 * theta) * std::sin(5 * phi));
+        }
+
+        return mesh;
+    }
+
+    // Fragments that passed the depth test per covered pixel, over cameras all around the mesh
+    double MeasureOverdraw(const MeshData& mesh, const std::vector<uint32_t>& indices)
+    {
+        SoftwareRasterizer rasterizer(1);
+        RasterTexture texture = RasterTexture::Checkerboard(64, 8, 0xFFFFFFFF, 0xFF000000);
+        RasterFramebuffer target(128, 128);
+        RasterMesh raster = { mesh.positions.data(), mesh.texcoords.data(), mesh.GetVertexCount(), indices.data(), true, indices.size() };
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        uint64_t shaded = 0, covered = 0;
+        for (int view = 0; view < 24; view++)
+        {
+            RasterUniforms uniforms;
+            uniforms.projectionMatrix = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1, 0.1f, 100);
+            uniforms.modelViewMatrix = Float4x4::LookAtRightHand(Normalize(Float3 { uniform(random), uniform(random), uniform(random) }) * 3.5f, { 0, 0, 0 }, { 0, 1, 0 });
+
+            target.Clear(0);
+            shaded += rasterizer.DrawIndexed(raster, uniforms, texture, target).fragmentsShaded;
+            for (float depth : target.depth)
+                covered += depth < 1;
+        }
+
+        return (double)shaded / covered;
+    }
+
+    // Drawing the outward-facing clusters first saves shading the bumps behind them
+    void TestOverdrawReduced()
+    {
+        MeshData mesh = GenerateBumpySphere(24);
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        OptimizeVertexCache(indices.data(), indices.data(), indices.size(), mesh.GetVertexCount());
+        double before = MeasureOverdraw(mesh, indices);
+        CHECK(before > 1.1);
+
+        std::vector<uint32_t> clustered(indices.size());
+        OptimizeOverdraw(clustered.data(), indices.data(), indices.size(), mesh.positions.data(), mesh.GetVertexCount());
+        double after = MeasureOverdraw(mesh, clustered);
+
+        std::vector<uint32_t> loose(indices.size());
+        OptimizeOverdraw(loose.data(), indices.data(), indices.size(), mesh.positions.data(), mesh.GetVertexCount(), 1.5f);
+        double afterLoose = MeasureOverdraw(mesh, loose);
+
+        std::fprintf(stderr, "overdraw %.3f, %.3f after the pass, %.3f at threshold 1.5\n", before, after, afterLoose);
+        CHECK(after < before - 0.02);
+        CHECK(afterLoose < after);
+    }
+
+    // Vertices come out in first-use order, unreferenced ones dropped, and the index size is
+    // chosen again from what is left
+    void TestVertexFetch()
+    {
+        MeshData mesh = GeneratePlane(1, 1, 300, 300);
+        CHECK(mesh.Uses32BitIndices());
+
+        // keep the first half of the stripes: too few vertices left to need 32-bit indices
+        mesh.indices32.resize(mesh.indices32.size() / 2);
+        ShuffleTriangles(mesh, 7);
+        std::vector<Triangle> before = GetTriangles(mesh);
+
+        MeshOptimizationReport report = OptimizeMesh(mesh);
+        CHECK(!mesh.Uses32BitIndices());
+        CHECK(report.verticesRemoved > 0 && mesh.GetVertexCount() + report.verticesRemoved == 301 * 301);
+        CHECK(mesh.texcoords.size() == mesh.GetVertexCount());
+        CHECK(GetTriangles(mesh) == before);
+
+        uint32_t next = 0;
+        for (uint16_t v : mesh.indices16)
+        {
+            CHECK(v <= next);
+            if (v == next) next++;
+        }
+
+        CHECK(next == mesh.GetVertexCount());
+    }
+
+    // Clustering only moves whole triangles, whatever the threshold
+    void TestOverdrawKeepsTriangles()
+    {
+        MeshData mesh = GenerateIcoSphere(1, 12);
+        std::vector<uint32_t> indices = GetIndices(mesh);
+        OptimizeVertexCache(indices.data(), indices.data(), indices.size(), mesh.GetVertexCount());
+        std::vector<Triangle> before = GetTriangles(mesh);
+
+        for (float threshold : { 1.0f, 1.05f, 1.5f, 3.0f })
+        {
+            std::vector<uint32_t> clustered(indices.size());
+            OptimizeOverdraw(clustered.data(), indices.data(), indices.size(), mesh.positions.data(), mesh.GetVertexCount(), threshold);
+
+            MeshData result = mesh;
+            result.indices16.assign(clustered.begin(), clustered.end());
+            CHECK(GetTriangles(result) == before);
+        }
+    }
+}
+
+int main()
+{
+    TestAnalyzeVertexCache();
+    TestShuffledMeshes();
+    TestKeepsBetterInputOrder();
+    TestOverdrawKeepsCacheEfficiency();
+    TestOverdrawReduced();
+    TestVertexFetch();
+    TestOverdrawKeepsTriangles();
+    return 0;
+}
@@ -0,0 +1,44 @@
+//
+//  MeshQuantizerBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "MeshQuantizer.h"
+
+namespace
+{
+    void Measure(const char* name, const MeshData& mesh)
+    {
+        QuantizedMesh quantized;
+        double seconds = MeasureSeconds(5, [&]() { quantized = QuantizeMesh(mesh); });
+
+        float diagonal = Length(quantized.positionScale);
+        std::printf("%-20s %8zu  %9zu  %9.3g  %7.2g  %6.2f  %9.3g  %9.3g  %7.2f ms\n", name, mesh.GetVertexCount(), quantized.GetVertexBytes(),
+            quantized.maxPositionError, quantized.maxPositionError / diagonal, quantized.maxPositionError / quantized.positionErrorBound,
+            quantized.maxTexcoordError, quantized.texcoordErrorBound, seconds * 1e3);
+    }
+}
+
+// Measured quantization error on the generators' meshes: position error absolute, relative to
+// the bounds diagonal and as a fraction of the bound, texcoord error against its bound, and the
+// time QuantizeMesh takes, error measurement included
+int main()
+{
+    MeshData offset = GenerateUvSphere(0.5f, 64, 32);
+    for (Float3& p : offset.positions)
+        p = p + Float3 { 1000, -200, 3 };
+
+    std::printf("mesh                 vertices      bytes  position  /diagonal  /bound   texcoord   tc bound       time\n");
+    Measure("box 2x2x2", GenerateBox({ 4, 4, 4 }, 2, 2, 2));
+    Measure("uv sphere 100x100", GenerateUvSphere(1, 100, 100));
+    Measure("icosphere 64, r 50", GenerateIcoSphere(50, 64));
+    Measure("cylinder 300x100", GenerateCylinder(3, 10, 300, 100));
+    Measure("plane 1000x1000", GeneratePlane(100, 100, 1000, 1000));
+    Measure("sphere at 1000", offset);
+    return 0;
+}
@@ -0,0 +1,147 @@
+//
+//  MeshQuantizerTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include "Check.h"
+#include "MeshQuantizer.h"
+
+namespace
+{
+    float FromBits(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, 4);
+        return value;
+    }
+
+    // Every half survives the trip through float, and NaNs stay NaNs
+    void TestHalfRoundTrip()
+    {
+        for (uint32_t h = 0; h < 65536; h++)
+        {
+            float value = HalfToFloat((uint16_t)h);
+            bool nan = (h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0;
+            CHECK(std::isnan(value) == nan);
+            if (nan)
+                CHECK((FloatToHalf(value) & 0x7C00) == 0x7C00 && (FloatToHalf(value) & 0x03FF) != 0);
+            else
+                CHECK(FloatToHalf(value) == h);
+        }
+    }
+
+    // Round to nearest even at the edges: overflow, the largest half, subnormals and underflow
+    void TestHalfRounding()
+    {
+        CHECK(FloatToHalf(1.0f) == 0x3C00);
+        CHECK(FloatToHalf(-0.0f) == 0x8000);
+        CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+        CHECK(FloatToHalf(65519.99f) == 0x7BFF);
+        CHECK(FloatToHalf(65520.0f) == 0x7C00);
+        CHECK(FloatToHalf(1e20f) == 0x7C00);
+        CHECK(FloatToHalf(-INFINITY) == 0xFC00);
+        CHECK(FloatToHalf(std::ldexp(1.0f, -14)) == 0x0400);
+        CHECK(FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001);
+        CHECK(FloatToHalf(std::ldexp(1.0f, -25)) == 0x0000);
+        CHECK(FloatToHalf(std::ldexp(1.5f, -25)) == 0x0001);
+        CHECK(FloatToHalf(std::ldexp(3.0f, -25)) == 0x0002);
+        CHECK(FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+        CHECK(FloatToHalf(1.0f + std::ldexp(3.0f, -11)) == 0x3C02);
+    }
+
+#ifdef __FLT16_MAX__
+    // Against the compiler's own conversion, where it has _Float16: random bit patterns, which are
+    // mostly out of range, and values spread over the range halfs cover
+    void TestHalfAgainstFloat16()
+    {
+        std::mt19937 random(1);
+        for (int i = 0; i < 4000000; i++)
+        {
+            float value = i % 2 ? FromBits(random()) : std::ldexp((float)(random() % 0x1000000), -(int)(random() % 40)) * (random() % 2 ? 1 : -1);
+            if (std::isnan(value)) continue;
+
+            _Float16 expected = (_Float16)value;
+            uint16_t bits;
+            std::memcpy(&bits, &expected, 2);
+            CHECK(FloatToHalf(value) == bits);
+        }
+    }
+#endif
+
+    // Every vertex decodes within half a step per axis, the reported maximum is the real one and
+    // stays under the bound; texcoords are within half a half's spacing at their magnitude
+    void CheckQuantized(const MeshData& mesh)
+    {
+        QuantizedMesh quantized = QuantizeMesh(mesh);
+        CHECK(quantized.GetVertexCount() == mesh.GetVertexCount());
+        CHECK(quantized.GetVertexBytes() == mesh.GetVertexCount() * 12);
+
+        float step[3] = { quantized.positionScale.x / 65535, quantized.positionScale.y / 65535, quantized.positionScale.z / 65535 };
+        float largestError = 0;
+        float largestTexcoordError = 0;
+        for (size_t v = 0; v < mesh.GetVertexCount(); v++)
+        {
+            Float3 original = mesh.positions[v];
+            Float3 decoded = quantized.DecodePosition(v);
+            float slack = 4 * FLT_EPSILON * Length(original);
+            CHECK(std::fabs(decoded.x - original.x) <= 0.5f * step[0] + slack);
+            CHECK(std::fabs(decoded.y - original.y) <= 0.5f * step[1] + slack);
+            CHECK(std::fabs(decoded.z - original.z) <= 0.5f * step[2] + slack);
+            largestError = std::max(largestError, Length(decoded - original));
+
+            Float2 texcoord = mesh.texcoords[v];
+            Float2 decodedTexcoord = quantized.DecodeTexcoord(v);
+            float spacingU = std::ldexp(1.0f, std::ilogb(std::max(std::fabs(texcoord.x), 0x1p-14f)) - 10);
+            float spacingV = std::ldexp(1.0f, std::ilogb(std::max(std::fabs(texcoord.y), 0x1p-14f)) - 10);
+            CHECK(std::fabs(decodedTexcoord.x - texcoord.x) <= 0.5f * spacingU);
+            CHECK(std::fabs(decodedTexcoord.y - texcoord.y) <= 0.5f * spacingV);
+            largestTexcoordError = std::max({ largestTexcoordError, std::fabs(decodedTexcoord.x - texcoord.x), std::fabs(decodedTexcoord.y - texcoord.y) });
+        }
+
+        CHECK(quantized.maxPositionError == largestError);
+        CHECK(quantized.maxTexcoordError == largestTexcoordError);
+        CHECK(quantized.maxPositionError <= quantized.positionErrorBound);
+        CHECK(quantized.maxTexcoordError <= quantized.texcoordErrorBound);
+
+        // half a step on each axis is at most half a step of the diagonal over 65535, 7.6e-6 of it
+        CHECK(quantized.maxPositionError <= 7.7e-6f * Length(quantized.positionScale) + 4 * FLT_EPSILON * Length(quantized.positionOffset + quantized.positionScale));
+    }
+
+    void TestMeshes()
+    {
+        CheckQuantized(GenerateBox({ 4, 4, 4 }, 2, 2, 2));
+        CheckQuantized(GenerateUvSphere(1, 100, 100));
+        CheckQuantized(GenerateIcoSphere(50, 64));
+        CheckQuantized(GenerateCylinder(3, 10, 300, 100));
+        CheckQuantized(GeneratePlane(100, 100, 1000, 1000));
+
+        // far from the origin the float positions themselves are coarse; the bound allows for it
+        MeshData offset = GenerateUvSphere(0.5f, 64, 32);
+        for (Float3& p : offset.positions)
+            p = p + Float3 { 1000, -200, 3 };
+        CheckQuantized(offset);
+
+        // texcoords that are multiples of 1/1024 come through exactly
+        QuantizedMesh plane = QuantizeMesh(GeneratePlane(1, 1, 1024, 2));
+        CHECK(plane.maxTexcoordError == 0);
+    }
+}
+
+int main()
+{
+    TestHalfRoundTrip();
+    TestHalfRounding();
+#ifdef __FLT16_MAX__
+    TestHalfAgainstFloat16();
+#endif
+    TestMeshes();
+    return 0;
+}
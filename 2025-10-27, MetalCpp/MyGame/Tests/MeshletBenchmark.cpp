@@ -0,0 +1,72 @@
+//
+//  MeshletBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MeshOptimizer.h"
+#include "Meshlets.h"
+
+namespace
+{
+    // Builds meshlets for an optimized mesh of about a unit in size, then culls them for 200
+    // cameras 2.5 units from the center, looking at random points near it
+    void Measure(const char* name, MeshData mesh)
+    {
+        OptimizeMesh(mesh);
+
+        MeshletData data;
+        double buildSeconds = MeasureSeconds(1, [&]() { data = BuildMeshlets(mesh); });
+
+        Float4x4 projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.5f, 0.1f, 100.0f);
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        std::vector<Float4x4> views;
+        for (int i = 0; i < 200; i++)
+        {
+            Float3 eye = Normalize(Float3 { uniform(random), uniform(random), uniform(random) }) * 2.5f;
+            Float3 target = { uniform(random) * 0.5f, uniform(random) * 0.5f, uniform(random) * 0.5f };
+            views.push_back(Float4x4::LookAtRightHand(eye, target, { 0, 1, 0 }));
+        }
+
+        std::vector<uint32_t> visible;
+        visible.reserve(data.meshlets.size());
+        MeshletCullStats total = {};
+        double cullSeconds = MeasureSeconds(5, [&]()
+        {
+            total = {};
+            for (const Float4x4& view : views)
+            {
+                visible.clear();
+                MeshletCullStats stats = CullMeshlets(data, view, projection, visible);
+                total.meshlets += stats.meshlets;
+                total.frustumCulled += stats.frustumCulled;
+                total.backfaceCulled += stats.backfaceCulled;
+                total.visibleTriangles += stats.visibleTriangles;
+            }
+        });
+
+        double triangles = mesh.GetIndexCount() / 3.0;
+        std::printf("%-20s %8.0f  %8zu  %5.1f  %7.2f s  %5.1f%%  %5.1f%%  %5.1f%%  %5.0f\n", name, triangles, data.meshlets.size(), triangles / data.meshlets.size(), buildSeconds,
+            100.0 * total.frustumCulled / total.meshlets, 100.0 * total.backfaceCulled / total.meshlets, 100.0 * total.visibleTriangles / (triangles * views.size()),
+            total.meshlets / cullSeconds * 1e-6);
+    }
+}
+
+// Meshlet build time for meshes of a million triangles and more, the share of meshlets the
+// frustum and the normal cones cull from outside, the share of triangles left to draw, and how
+// many meshlets CullMeshlets tests per microsecond
+int main()
+{
+    std::printf("mesh                triangles  meshlets  tris/m     build   frust   back    drawn  m/us\n");
+    Measure("uv sphere 1000x1000", GenerateUvSphere(1, 1000, 1000));
+    Measure("icosphere 256", GenerateIcoSphere(1, 256));
+    Measure("box 300^3", GenerateBox({ 2, 2, 2 }, 300, 300, 300));
+    return 0;
+}
@@ -0,0 +1,182 @@
+//
+//  MeshletTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "Check.h"
+#include "MeshOptimizer.h"
+#include "Meshlets.h"
+
+namespace
+{
+    using Triangle = std::array<uint32_t, 3>;
+
+    // Started at the smallest index so that only the winding matters; sorted, since the order changes
+    std::vector<Triangle> GetTriangles(const std::vector<uint32_t>& indices)
+    {
+        std::vector<Triangle> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            Triangle triangle = { indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // Limits hold, local indices stay inside their meshlet, no meshlet lists a vertex twice, every
+    // triangle of the mesh is in exactly one meshlet with its winding, and the spheres hold their
+    // vertices
+    void CheckMeshlets(const MeshData& mesh, const MeshletData& data)
+    {
+        std::vector<uint32_t> indices = mesh.Uses32BitIndices() ? mesh.indices32 : std::vector<uint32_t>(mesh.indices16.begin(), mesh.indices16.end());
+        CHECK(GetTriangles(UnpackMeshletIndices(data)) == GetTriangles(indices));
+        CHECK(data.bounds.size() == data.meshlets.size());
+
+        uint32_t triangleOffset = 0;
+        for (size_t i = 0; i < data.meshlets.size(); i++)
+        {
+            const Meshlet& meshlet = data.meshlets[i];
+            CHECK(meshlet.vertexCount <= 64 && meshlet.triangleCount <= 124 && meshlet.triangleCount > 0);
+            CHECK(meshlet.triangleOffset == triangleOffset);
+            triangleOffset += meshlet.triangleCount;
+
+            auto first = data.vertices.begin() + meshlet.vertexOffset;
+            CHECK(std::set<uint32_t>(first, first + meshlet.vertexCount).size() == meshlet.vertexCount);
+
+            for (uint32_t k = 0; k < meshlet.triangleCount * 3; k++)
+                CHECK(data.triangles[meshlet.triangleOffset * 3 + k] < meshlet.vertexCount);
+
+            const MeshletBounds& bounds = data.bounds[i];
+            for (uint32_t k = 0; k < meshlet.vertexCount; k++)
+                CHECK(Length(mesh.positions[first[k]] - bounds.center) <= bounds.radius * 1.000001f);
+        }
+    }
+
+    // From random cameras around and inside the mesh: no triangle that faces the camera and has
+    // a corner inside the frustum may be in a culled meshlet
+    void CheckCulling(const MeshData& mesh, const MeshletData& data)
+    {
+        Float3 lo = mesh.positions[0];
+        Float3 hi = lo;
+        for (const Float3& p : mesh.positions)
+        {
+            lo = Min(lo, p);
+            hi = Max(hi, p);
+        }
+
+        float extent = Length(hi - lo);
+        Float4x4 projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.5f, 0.1f, 100.0f);
+
+        std::mt19937 random(1);
+        std::uniform_real_distribution<float> uniform(-1, 1);
+        std::vector<uint32_t> visible;
+        size_t culled = 0;
+
+        for (int view = 0; view < 100; view++)
+        {
+            Float3 eye = { uniform(random) * extent, uniform(random) * extent, uniform(random) * extent };
+            Float3 target = { uniform(random) * extent * 0.3f, uniform(random) * extent * 0.3f, uniform(random) * extent * 0.3f };
+            Float4x4 modelView = Float4x4::LookAtRightHand(eye, target, { 0, 1, 0 });
+            Float4x4 transform = projection * modelView;
+
+            visible.clear();
+            MeshletCullStats stats = CullMeshlets(data, modelView, projection, visible);
+            CHECK(stats.meshlets == data.meshlets.size());
+            CHECK(visible.size() + stats.frustumCulled + stats.backfaceCulled == stats.meshlets);
+            CHECK(std::is_sorted(visible.begin(), visible.end()));
+            culled += stats.frustumCulled + stats.backfaceCulled;
+
+            std::vector<bool> isVisible(data.meshlets.size());
+            size_t visibleTriangles = 0;
+            for (uint32_t i : visible)
+            {
+                isVisible[i] = true;
+                visibleTriangles += data.meshlets[i].triangleCount;
+            }
+
+            CHECK(stats.visibleTriangles == visibleTriangles);
+
+            for (size_t i = 0; i < data.meshlets.size(); i++)
+            {
+                if (isVisible[i]) continue;
+
+                const Meshlet& meshlet = data.meshlets[i];
+                for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+                {
+                    Float3 p[3];
+                    for (int k = 0; k < 3; k++)
+                        p[k] = mesh.positions[data.vertices[meshlet.vertexOffset + data.triangles[(meshlet.triangleOffset + t) * 3 + k]]];
+
+                    Float3 normal = Cross(p[1] - p[0], p[2] - p[0]);
+                    bool front = Dot(eye - p[0], normal) > 1e-5f * Length(normal) * extent;
+
+                    bool inside = false;
+                    for (int k = 0; k < 3; k++)
+                    {
+                        Float4 clip = transform * Float4 { p[k].x, p[k].y, p[k].z, 1 };
+                        inside |= clip.w > 0 && std::fabs(clip.x) <= clip.w * 0.999f && std::fabs(clip.y) <= clip.w * 0.999f && clip.z >= 0 && clip.z <= clip.w * 0.999f;
+                    }
+
+                    CHECK(!(front && inside));
+                }
+            }
+        }
+
+        // and the tests do cull something
+        CHECK(culled > 0);
+    }
+
+    void TestMeshes()
+    {
+        MeshData meshes[] = { GenerateBox({ 4, 4, 4 }, 2, 2, 2), GenerateBox({ 4, 4, 4 }, 40, 40, 40), GenerateUvSphere(1, 100, 100), GenerateIcoSphere(1, 20), GeneratePlane(10, 10, 200, 200), GenerateCylinder(1, 3, 64, 32) };
+        for (MeshData& mesh : meshes)
+        {
+            OptimizeMesh(mesh);
+            MeshletData data = BuildMeshlets(mesh);
+            CheckMeshlets(mesh, data);
+            CheckCulling(mesh, data);
+        }
+
+        // straight from the generator, without the optimizer's vertex order
+        MeshData sphere = GenerateUvSphere(1, 100, 100);
+        MeshletData data = BuildMeshlets(sphere);
+        CheckMeshlets(sphere, data);
+        CheckCulling(sphere, data);
+    }
+
+    // From 5 radii out, 60% of a sphere faces away; the cones find most of it
+    void TestConesCullBackfaces()
+    {
+        MeshData sphere = GenerateIcoSphere(1, 40);
+        OptimizeMesh(sphere);
+        MeshletData data = BuildMeshlets(sphere);
+
+        Float4x4 projection = Float4x4::PerspectiveRightHand(65.0f * (3.14159265f / 180.0f), 1.0f, 0.1f, 100.0f);
+        Float4x4 modelView = Float4x4::LookAtRightHand({ 0, 0, 5 }, { 0, 0, 0 }, { 0, 1, 0 });
+        std::vector<uint32_t> visible;
+        MeshletCullStats stats = CullMeshlets(data, modelView, projection, visible);
+
+        CHECK(stats.frustumCulled == 0);
+        CHECK(stats.backfaceCulled > stats.meshlets * 45 / 100);
+        CHECK(stats.backfaceCulled < stats.meshlets * 60 / 100);
+    }
+}
+
+int main()
+{
+    TestMeshes();
+    TestConesCullBackfaces();
+    return 0;
+}
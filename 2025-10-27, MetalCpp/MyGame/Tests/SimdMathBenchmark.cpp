@@ -0,0 +1,71 @@
+//
+//  SimdMathBenchmark.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SimdMath.h"
+
+// Batch functions of SimdMath.h against their scalar references over 10k matrices or points, about
+// the size of a scene's worth of objects. SimdMathBenchmarkAvx is the same built with AVX.
+int main()
+{
+#if defined(SIMDMATH_AVX)
+    const char* path = "AVX";
+#elif defined(SIMDMATH_SSE)
+    const char* path = "SSE";
+#elif defined(SIMDMATH_NEON)
+    const char* path = "NEON";
+#else
+    const char* path = "scalar";
+#endif
+
+    const size_t count = 10000;
+    const size_t repeats = 200;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> value(-2, 2);
+
+    Float4x4 view;
+    for (Float4& column : view.columns)
+        column = { value(random), value(random), value(random), value(random) };
+
+    std::vector<Float4x4> models(count), out(count);
+    for (Float4x4& m : models)
+    {
+        for (Float4& column : m.columns)
+            column = { value(random), value(random), value(random), value(random) };
+    }
+
+    std::vector<Float3> points(count);
+    for (Float3& p : points)
+        p = { value(random), value(random), value(random) };
+
+    std::vector<Float4> transformed(count);
+
+    auto rate = [&](auto&& func)
+    {
+        double seconds = MeasureSeconds(repeats, func);
+        return count / seconds * 1e-6;
+    };
+
+    double batch = rate([&]() { MultiplyBatch(view, models.data(), out.data(), count); KeepResult(out[count / 2]); });
+    double batchScalar = rate([&]() { MultiplyBatchScalar(view, models.data(), out.data(), count); KeepResult(out[count / 2]); });
+    double pairs = rate([&]() { MultiplyBatch(models.data(), models.data(), out.data(), count); KeepResult(out[count / 2]); });
+    double pairsScalar = rate([&]() { MultiplyBatchScalar(models.data(), models.data(), out.data(), count); KeepResult(out[count / 2]); });
+    double transform = rate([&]() { TransformPoints(view, points.data(), transformed.data(), count); KeepResult(transformed[count / 2]); });
+    double transformScalar = rate([&]() { TransformPointsScalar(view, points.data(), transformed.data(), count); KeepResult(transformed[count / 2]); });
+
+    std::printf("%s path, millions per second\n", path);
+    std::printf("                      SIMD    scalar   speedup\n");
+    std::printf("view * model[i]     %6.1f    %6.1f    %5.1fx\n", batch, batchScalar, batch / batchScalar);
+    std::printf("left[i] * right[i]  %6.1f    %6.1f    %5.1fx\n", pairs, pairsScalar, pairs / pairsScalar);
+    std::printf("points              %6.1f    %6.1f    %5.1fx\n", transform, transformScalar, transform / transformScalar);
+    return 0;
+}
@@ -0,0 +1,131 @@
+//
+//  SimdMathTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "SimdMath.h"
+
+namespace
+{
+    float MaxDifference(const Float4x4& a, const Float4x4& b)
+    {
+        float difference = 0;
+        for (int j = 0; j < 4; j++)
+        {
+            const Float4& x = a.columns[j];
+            const Float4& y = b.columns[j];
+            difference = std::fmax(difference, std::fmax(std::fmax(std::fabs(x.x - y.x), std::fabs(x.y - y.y)), std::fmax(std::fabs(x.z - y.z), std::fabs(x.w - y.w))));
+        }
+
+        return difference;
+    }
+
+    float MaxDifference(const Float4& a, const Float4& b)
+    {
+        return std::fmax(std::fmax(std::fabs(a.x - b.x), std::fabs(a.y - b.y)), std::fmax(std::fabs(a.z - b.z), std::fabs(a.w - b.w)));
+    }
+
+    Float4x4 RandomMatrix(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> value(-2, 2);
+        Float4x4 m;
+        for (Float4& column : m.columns)
+            column = { value(random), value(random), value(random), value(random) };
+
+        return m;
+    }
+
+    void TestRotations()
+    {
+        Float3 axis = { 1, 1, 0 };
+        float angle = 0.7f;
+        Quat q = Quat::FromAxisAngle(axis, angle);
+        CHECK(MaxDifference(Float4x4::Rotation(angle, axis), q.ToMatrix()) < 1e-6f);
+
+        Float3 v = { 0.3f, -1, 2 };
+        Float4 rotated = Float4x4::Rotation(angle, axis) * Float4 { v.x, v.y, v.z, 0 };
+        CHECK(MaxDifference(rotated, Float4 { q.Rotate(v).x, q.Rotate(v).y, q.Rotate(v).z, 0 }) < 1e-5f);
+
+        // q * r applies r first, as the matrix product does
+        Quat r = Quat::FromAxisAngle({ 0, 0, 1 }, 0.4f);
+        CHECK(MaxDifference((q * r).ToMatrix(), q.ToMatrix() * r.ToMatrix()) < 1e-6f);
+
+        CHECK(MaxDifference(Slerp(Quat::Identity(), q, 0.5f).ToMatrix(), Quat::FromAxisAngle(axis, angle / 2).ToMatrix()) < 1e-6f);
+        CHECK(MaxDifference(Slerp(q, q, 0.3f).ToMatrix(), q.ToMatrix()) < 1e-6f);
+    }
+
+    void TestTransforms()
+    {
+        Quat q = Quat::FromAxisAngle({ 1, 1, 0 }, 0.7f);
+        Float4x4 m = MakeTransform({ 1, 2, 3 }, q, { 2, 3, 4 });
+        CHECK(MaxDifference(m, Float4x4::Translation(1, 2, 3) * q.ToMatrix() * Float4x4::Scale(2, 3, 4)) < 1e-6f);
+        CHECK(MaxDifference(m * Inverse(m), Float4x4::Identity()) < 1e-5f);
+        CHECK(MaxDifference(Transpose(Transpose(m)), m) == 0);
+
+        CHECK(MaxDifference(Float4x4::LookAtRightHand({ 0, 0, 8 }, { 0, 0, 0 }, { 0, 1, 0 }), Float4x4::Translation(0, 0, -8)) < 1e-6f);
+
+        // the near plane maps to clip z 0 and the far plane to w
+        Float4x4 projection = Float4x4::PerspectiveRightHand(1.0f, 1.5f, 0.1f, 100);
+        Float4 nearPoint = projection * Float4 { 0, 0, -0.1f, 1 };
+        Float4 farPoint = projection * Float4 { 0, 0, -100, 1 };
+        CHECK(std::fabs(nearPoint.z) < 1e-6f && std::fabs(farPoint.z / farPoint.w - 1) < 1e-6f);
+    }
+
+    // The SIMD paths, whichever this build compiles, against the scalar references
+    void TestBatchesMatchScalar()
+    {
+        std::mt19937 random(1);
+        const size_t count = 1001;      // odd, to reach the single-point tail of the AVX path
+
+        Float4x4 left = RandomMatrix(random);
+        std::vector<Float4x4> lefts(count), rights(count), simd(count), scalar(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            lefts[i] = RandomMatrix(random);
+            rights[i] = RandomMatrix(random);
+        }
+
+        MultiplyBatch(left, rights.data(), simd.data(), count);
+        MultiplyBatchScalar(left, rights.data(), scalar.data(), count);
+        for (size_t i = 0; i < count; i++)
+            CHECK(MaxDifference(simd[i], scalar[i]) < 1e-5f);
+
+        MultiplyBatch(lefts.data(), rights.data(), simd.data(), count);
+        MultiplyBatchScalar(lefts.data(), rights.data(), scalar.data(), count);
+        for (size_t i = 0; i < count; i++)
+            CHECK(MaxDifference(simd[i], scalar[i]) < 1e-5f);
+
+        // in place
+        std::vector<Float4x4> inPlace = rights;
+        MultiplyBatch(left, inPlace.data(), inPlace.data(), count);
+        MultiplyBatchScalar(left, rights.data(), scalar.data(), count);
+        for (size_t i = 0; i < count; i++)
+            CHECK(MaxDifference(inPlace[i], scalar[i]) < 1e-5f);
+
+        std::uniform_real_distribution<float> value(-2, 2);
+        std::vector<Float3> points(count);
+        for (Float3& p : points)
+            p = { value(random), value(random), value(random) };
+
+        std::vector<Float4> simdPoints(count), scalarPoints(count);
+        TransformPoints(left, points.data(), simdPoints.data(), count);
+        TransformPointsScalar(left, points.data(), scalarPoints.data(), count);
+        for (size_t i = 0; i < count; i++)
+            CHECK(MaxDifference(simdPoints[i], scalarPoints[i]) < 1e-5f);
+    }
+}
+
+int main()
+{
+    TestRotations();
+    TestTransforms();
+    TestBatchesMatchScalar();
+    return 0;
+}
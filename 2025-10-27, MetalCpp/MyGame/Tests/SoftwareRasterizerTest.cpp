@@ -0,0 +1,146 @@
+//
+//  SoftwareRasterizerTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Check.h"
+#include "SoftwareRasterizer.h"
+
+namespace
+{
+    const RasterUniforms ClipSpace = { Float4x4::Identity(), Float4x4::Identity() };
+
+    size_t CountUntouched(const RasterFramebuffer& target)
+    {
+        return std::count(target.depth.begin(), target.depth.end(), 1.0f);
+    }
+
+    // Tiles are rasterized one thread each in submission order, so the image may not depend on
+    // how many threads set up and bin the triangles
+    void TestSameImageForAnyThreadCount()
+    {
+        RasterTexture texture = RasterTexture::Checkerboard(256, 8, 0xFF2020E0, 0xFFE0E0E0);
+        RasterFramebuffer reference(800, 600);
+        RasterStats stats = RenderRotatingBox(SoftwareRasterizer(1), 0.8f, texture, reference);
+        CHECK(stats.triangles == 12 && stats.fragmentsShaded > 0);
+
+        for (unsigned threads : { 2u, 3u, 4u, 8u })
+        {
+            RasterFramebuffer target(800, 600);
+            RasterStats other = RenderRotatingBox(SoftwareRasterizer(threads), 0.8f, texture, target);
+            CHECK(target.color == reference.color);
+            CHECK(target.depth == reference.depth);
+            CHECK(other.fragmentsShaded == stats.fragmentsShaded);
+        }
+    }
+
+    // A fan around an off-center point covering the viewport, in a size that is not a multiple of
+    // the tile size: drawn one triangle at a time the fragments add up to every pixel exactly once
+    void TestSharedEdgesHaveNoGapsOrOverlaps()
+    {
+        RasterTexture texture = RasterTexture::Checkerboard(16, 2, 0xFFFFFFFF, 0xFF000000);
+        Float3 positions[] = { { -1, -1, 0.5f }, { 1, -1, 0.5f }, { 1, 1, 0.5f }, { -1, 1, 0.5f }, { 0.3f, -0.1f, 0.5f } };
+        Float2 texcoords[] = { { 0, 1 }, { 1, 1 }, { 1, 0 }, { 0, 0 }, { 0.5f, 0.5f } };
+        uint16_t indices[] = { 0, 1, 4, 1, 2, 4, 2, 3, 4, 3, 0, 4 };
+
+        RasterFramebuffer all(97, 71);
+        all.Clear(0);
+        SoftwareRasterizer rasterizer(3);
+        RasterStats stats = rasterizer.DrawIndexed({ positions, texcoords, 5, indices, false, 12 }, ClipSpace, texture, all);
+        CHECK(CountUntouched(all) == 0);
+        CHECK(stats.fragmentsShaded == 97 * 71);
+
+        uint64_t sum = 0;
+        for (int t = 0; t < 4; t++)
+        {
+            RasterFramebuffer one(97, 71);
+            one.Clear(0);
+            sum += rasterizer.DrawIndexed({ positions, texcoords, 5, indices + 3 * t, false, 3 }, ClipSpace, texture, one).fragmentsShaded;
+        }
+
+        CHECK(sum == 97 * 71);
+    }
+
+    void TestBackFacesAreCulled()
+    {
+        RasterTexture texture = RasterTexture::Checkerboard(16, 2, 0xFFFFFFFF, 0xFF000000);
+        Float3 positions[] = { { -1, -1, 0.5f }, { 1, -1, 0.5f }, { 0, 1, 0.5f } };
+        Float2 texcoords[] = { { 0, 1 }, { 1, 1 }, { 0.5f, 0 } };
+        uint32_t front[] = { 0, 1, 2 };
+        uint32_t back[] = { 0, 2, 1 };
+
+        RasterFramebuffer target(64, 64);
+        SoftwareRasterizer rasterizer(1);
+        target.Clear(0);
+        CHECK(rasterizer.DrawIndexed({ positions, texcoords, 3, front, true, 3 }, ClipSpace, texture, target).fragmentsShaded > 0);
+
+        target.Clear(0);
+        RasterStats stats = rasterizer.DrawIndexed({ positions, texcoords, 3, back, true, 3 }, ClipSpace, texture, target);
+        CHECK(stats.trianglesRasterized == 0 && stats.fragmentsShaded == 0);
+        CHECK(CountUntouched(target) == 64 * 64);
+    }
+
+    // A floor reaching behind the camera has to be clipped at the near plane, not dropped or
+    // projected through it: the lower half of the image is floor, the upper half sky
+    void TestNearPlaneClipping()
+    {
+        RasterTexture texture = RasterTexture::Checkerboard(256, 32, 0xFF2020E0, 0xFFE0E0E0);
+        Float3 positions[] = { { -50, -1, 50 }, { 50, -1, 50 }, { 50, -1, -50 }, { -50, -1, -50 } };
+        Float2 texcoords[] = { { 0, 1 }, { 1, 1 }, { 1, 0 }, { 0, 0 } };
+        uint16_t indices[] = { 0, 1, 2, 0, 2, 3 };
+        RasterUniforms uniforms = { Float4x4::PerspectiveRightHand(1.2f, 4.0f / 3, 0.1f, 100), Float4x4::Identity() };
+
+        RasterFramebuffer target(160, 120);
+        target.Clear(0);
+        RasterStats stats = SoftwareRasterizer(2).DrawIndexed({ positions, texcoords, 4, indices, false, 6 }, uniforms, texture, target);
+        CHECK(stats.trianglesRasterized > 2);
+
+        for (int x = 0; x < target.width; x++)
+        {
+            CHECK(target.depth[x] == 1.0f);
+            CHECK(target.depth[(target.height - 1) * target.width + x] < 1.0f);
+        }
+    }
+
+    // MTLCompareFunctionLess: the nearer triangle wins whichever is drawn first
+    void TestDepthTest()
+    {
+        RasterTexture red = RasterTexture::Checkerboard(4, 1, 0xFF0000FF, 0xFF0000FF);
+        RasterTexture blue = RasterTexture::Checkerboard(4, 1, 0xFFFF0000, 0xFFFF0000);
+        Float3 nearQuad[] = { { -1, -1, 0.2f }, { 1, -1, 0.2f }, { 1, 1, 0.2f }, { -1, 1, 0.2f } };
+        Float3 farQuad[] = { { -1, -1, 0.7f }, { 1, -1, 0.7f }, { 1, 1, 0.7f }, { -1, 1, 0.7f } };
+        Float2 texcoords[] = { { 0, 1 }, { 1, 1 }, { 1, 0 }, { 0, 0 } };
+        uint16_t indices[] = { 0, 1, 2, 0, 2, 3 };
+
+        SoftwareRasterizer rasterizer(1);
+        for (bool nearFirst : { true, false })
+        {
+            RasterFramebuffer target(32, 32);
+            target.Clear(0);
+            for (int pass = 0; pass < 2; pass++)
+            {
+                bool drawNear = (pass == 0) == nearFirst;
+                rasterizer.DrawIndexed({ drawNear ? nearQuad : farQuad, texcoords, 4, indices, false, 6 }, ClipSpace, drawNear ? red : blue, target);
+            }
+
+            CHECK(target.color[16 * 32 + 16] == 0xFF0000FF);
+            CHECK(target.depth[16 * 32 + 16] == 0.2f);
+        }
+    }
+}
+
+int main()
+{
+    TestSameImageForAnyThreadCount();
+    TestSharedEdgesHaveNoGapsOrOverlaps();
+    TestBackFacesAreCulled();
+    TestNearPlaneClipping();
+    TestDepthTest();
+    return 0;
+}
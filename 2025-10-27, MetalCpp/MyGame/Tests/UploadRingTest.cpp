@@ -0,0 +1,178 @@
+//
+//  UploadRingTest.cpp
+//  MyGame
+//
+//  Created by 이승중 on 10/19/26.
+//
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "UploadRing.h"
+
+namespace
+{
+    // Wrapping past the end of the buffer: the tail that does not fit is skipped and counted as
+    // padding, and what is at the start is only reused once its frame is retired
+    void TestWraparound()
+    {
+        UploadRing ring(nullptr, 1024);
+
+        ring.BeginFrame(1);
+        CHECK(ring.Allocate(512).offset == 0);
+        ring.EndFrame();
+
+        ring.BeginFrame(2);
+        CHECK(ring.Allocate(256).offset == 512);
+        ring.EndFrame();
+
+        // frame 1 is done, frame 2 still holds [512, 768)
+        ring.Retire(1);
+        CHECK(ring.GetBytesInFlight() == 256 && ring.GetFramesInFlight() == 1);
+
+        ring.BeginFrame(3);
+        UploadAllocation wrapped = ring.Allocate(512);
+        CHECK(wrapped && wrapped.offset == 0 && wrapped.data == nullptr);
+        ring.EndFrame();
+        CHECK(ring.GetStats().lastFrame.bytes == 512 && ring.GetStats().lastFrame.padding == 256);
+        CHECK(ring.GetBytesInFlight() == 1024);
+
+        // full until frame 2 completes, then frame 2's space comes back
+        ring.BeginFrame(4);
+        CHECK(!ring.Allocate(1, 1));
+        ring.EndFrame();
+
+        ring.Retire(2);
+        ring.BeginFrame(5);
+        CHECK(ring.Allocate(256).offset == 512);
+        ring.EndFrame();
+    }
+
+    // An allocation that would reach memory of a frame in flight fails, is counted, and leaves the
+    // frame able to make smaller allocations that still fit
+    void TestOverrun()
+    {
+        std::vector<uint8_t> buffer(4096);
+        UploadRing ring(buffer.data(), buffer.size());
+
+        ring.BeginFrame(1);
+        UploadAllocation first = ring.Allocate(3000);
+        CHECK(first && first.data == buffer.data());
+        ring.EndFrame();
+
+        ring.BeginFrame(2);
+        CHECK(!ring.Allocate(2000));
+        UploadAllocation small = ring.Allocate(500);
+        CHECK(small && small.offset == 3072 && small.data == buffer.data() + 3072);
+        ring.EndFrame();
+
+        const UploadRingStats& stats = ring.GetStats();
+        CHECK(stats.overruns == 1 && stats.lastFrame.overruns == 1 && stats.lastFrame.allocations == 1);
+        CHECK(stats.frames == 2);
+
+        // once everything completes the ring starts over at 0 rather than wrapping
+        ring.Retire(2);
+        CHECK(ring.GetBytesInFlight() == 0 && ring.GetFramesInFlight() == 0);
+        ring.BeginFrame(3);
+        CHECK(ring.Allocate(4096).offset == 0);
+        ring.EndFrame();
+        CHECK(ring.GetStats().lastFrame.padding == 0);
+    }
+
+    // 20k frames of random sizes and alignments, with the GPU completing frames after a random
+    // delay of up to three frames. Every byte remembers the frame that last wrote it; a byte handed
+    // out again while that frame is still in flight would be corruption.
+    void TestSimulatedCompletions()
+    {
+        std::vector<uint8_t> buffer(4096);
+        UploadRing ring(buffer.data(), buffer.size());
+        std::vector<int64_t> owner(buffer.size(), -1);
+
+        std::mt19937 random(1);
+        std::deque<uint64_t> pending;
+        uint64_t completed = 0;
+        uint64_t allocations = 0;
+        uint64_t wraps = 0;
+        size_t lastEnd = 0;
+
+        for (uint64_t frame = 1; frame <= 20000; frame++)
+        {
+            while (!pending.empty() && (pending.size() > 3 || random() % 2))
+            {
+                completed = pending.front();
+                pending.pop_front();
+            }
+
+            ring.Retire(completed);
+            CHECK(ring.GetFramesInFlight() <= pending.size());
+
+            ring.BeginFrame(frame);
+            for (int n = random() % 6; n > 0; n--)
+            {
+                size_t size = 1 + random() % 700;
+                size_t alignment = (size_t)1 << (random() % 9);
+                UploadAllocation allocation = ring.Allocate(size, alignment);
+                if (!allocation) continue;
+
+                CHECK(allocation.offset % alignment == 0);
+                CHECK(allocation.offset + size <= buffer.size());
+                CHECK(allocation.data == buffer.data() + allocation.offset);
+
+                for (size_t k = allocation.offset; k < allocation.offset + size; k++)
+                {
+                    CHECK(owner[k] <= (int64_t)completed || owner[k] == (int64_t)frame);
+                    owner[k] = (int64_t)frame;
+                }
+
+                if (allocation.offset < lastEnd) wraps++;
+                lastEnd = allocation.offset + size;
+                allocations++;
+            }
+
+            ring.EndFrame();
+            pending.push_back(frame);
+            CHECK(ring.GetBytesInFlight() <= ring.GetCapacity());
+        }
+
+        // the run has to have exercised both wrapping and overruns to mean anything
+        const UploadRingStats& stats = ring.GetStats();
+        CHECK(stats.frames == 20000);
+        CHECK(wraps > 1000 && stats.overruns > 100);
+        CHECK(stats.peakBytesInFlight <= buffer.size());
+        CHECK(allocations > 20000);
+
+        ring.Retire(UINT64_MAX);
+        CHECK(ring.GetBytesInFlight() == 0 && ring.GetFramesInFlight() == 0);
+    }
+
+    void TestTypedAllocate()
+    {
+        struct alignas(16) Uniforms
+        {
+            float values[20];
+        };
+
+        std::vector<uint8_t> buffer(2048);
+        UploadRing ring(buffer.data(), buffer.size());
+        ring.BeginFrame(1);
+
+        size_t offset = 1;
+        Uniforms* uniforms = ring.Allocate<Uniforms>(offset, 3);
+        CHECK(uniforms == (Uniforms*)buffer.data() && offset == 0);
+        CHECK(ring.Allocate<Uniforms>(offset) == (Uniforms*)(buffer.data() + 256) && offset == 256);
+        CHECK(ring.Allocate<Uniforms>(offset, 100) == nullptr && offset == SIZE_MAX);
+        ring.EndFrame();
+    }
+}
+
+int main()
+{
+    TestWraparound();
+    TestOverrun();
+    TestSimulatedCompletions();
+    TestTypedAllocate();
+    return 0;
+}